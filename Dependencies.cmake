@@ -146,6 +146,11 @@ link_directories(${GSL_LIBRARY_DIRS})
 
 # -------------------------------
 
+# Threads are used to distribute batches of problems across cores.
+find_package(Threads REQUIRED)
+
+# -------------------------------
+
 if(BUILD_TESTS)
   if(NOT BUILD_DEPENDENCIES)
     find_package(CATCH)
@@ -215,3 +220,47 @@ if(BUILD_TESTS)
     endif(NOT APPLE)
   endif(BUILD_TESTS_WITH_EIGEN)
 endif(BUILD_TESTS)
+
+# -------------------------------
+
+if(BUILD_BENCHMARKS)
+  if(NOT BUILD_DEPENDENCIES)
+    find_package(benchmark QUIET)
+  endif(NOT BUILD_DEPENDENCIES)
+
+  if(benchmark_FOUND)
+    set(BENCHMARK_FOUND TRUE)
+    set(BENCHMARK_LIBRARIES benchmark::benchmark)
+  else(benchmark_FOUND)
+    message(STATUS "Google Benchmark will be downloaded when ${CMAKE_PROJECT_NAME} is built")
+    ExternalProject_Add(google-benchmark
+      PREFIX ${EXTERNAL_PATH}/GoogleBenchmark
+      #--Download step--------------
+      URL https://github.com/google/benchmark/archive/v1.7.1.zip
+      TIMEOUT 30
+      #--Update/Patch step----------
+      UPDATE_COMMAND ""
+      PATCH_COMMAND ""
+      #--Configure step-------------
+      CMAKE_ARGS -DCMAKE_BUILD_TYPE=Release
+                 -DBENCHMARK_ENABLE_TESTING=OFF
+                 -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+                 -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR>
+      #--Output logging-------------
+      LOG_DOWNLOAD ON
+    )
+    ExternalProject_Get_Property(google-benchmark install_dir)
+    set(BENCHMARK_INCLUDE_DIRS ${install_dir}/include
+        CACHE INTERNAL "Path to include folder for Google Benchmark")
+    set(BENCHMARK_LIBRARY_DIRS ${install_dir}/lib
+        CACHE INTERNAL "Path to library folder for Google Benchmark")
+    set(BENCHMARK_LIBRARIES "benchmark")
+
+    if(NOT APPLE)
+      include_directories(SYSTEM AFTER "${BENCHMARK_INCLUDE_DIRS}")
+    else(APPLE)
+      set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -isystem \"${BENCHMARK_INCLUDE_DIRS}\"")
+    endif(NOT APPLE)
+    link_directories(${BENCHMARK_LIBRARY_DIRS})
+  endif(benchmark_FOUND)
+endif(BUILD_BENCHMARKS)
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Eci.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/analyticAtomSolver.hpp"
+#include "Atom/atom.hpp"
+
+namespace atom
+{
+namespace benchmarks
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef std::vector< Real > Vector6;
+typedef std::pair< Vector3, Vector3 > Velocities;
+
+//! Transfer problem used by benchmarks.
+struct TransferProblem
+{
+public:
+
+    //! Departure position [km].
+    Vector3 departurePosition;
+
+    //! Departure velocity that solves the problem [km/s].
+    Vector3 departureVelocity;
+
+    //! Departure epoch.
+    DateTime departureEpoch;
+
+    //! Arrival position [km].
+    Vector3 arrivalPosition;
+
+    //! Time-of-flight [min].
+    Real timeOfFlight;
+
+    //! Perturbed initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess;
+
+protected:
+
+private:
+};
+
+//! Set up transfer problem from departure state, by propagating departure state with SGP4/SDP4.
+TransferProblem setUpTransferProblem( const Vector6& departureState,
+                                      const Real timeOfFlight )
+{
+    TransferProblem problem;
+    problem.departureEpoch = DateTime( 63548650522376360 );
+    problem.timeOfFlight = timeOfFlight;
+    problem.departurePosition = Vector3( departureState.begin( ), departureState.begin( ) + 3 );
+    problem.departureVelocity = Vector3( departureState.begin( ) + 3, departureState.end( ) );
+
+    const Tle departureTle = convertCartesianStateToTwoLineElements< Real >(
+        departureState, problem.departureEpoch );
+    SGP4 sgp4( departureTle );
+    const Eci arrivalState = sgp4.FindPosition( timeOfFlight );
+
+    problem.arrivalPosition = Vector3( 3 );
+    problem.arrivalPosition[ 0 ] = arrivalState.Position( ).x;
+    problem.arrivalPosition[ 1 ] = arrivalState.Position( ).y;
+    problem.arrivalPosition[ 2 ] = arrivalState.Position( ).z;
+
+    // Perturb departure velocity by the same amounts as the tests.
+    problem.departureVelocityGuess = problem.departureVelocity;
+    problem.departureVelocityGuess[ 0 ] += 0.013;
+    problem.departureVelocityGuess[ 1 ] -= 0.074;
+    problem.departureVelocityGuess[ 2 ] += 0.026;
+
+    return problem;
+}
+
+//! Set up departure state in low-Earth orbit (SGP4) [km; km/s].
+Vector6 setUpLowEarthOrbitState( )
+{
+    Vector6 state( 6 );
+    state[ 0 ] = -3680.20448307549;
+    state[ 1 ] = -2573.44661796266;
+    state[ 2 ] = 5800.72628190982;
+    state[ 3 ] = 6.44661660560979;
+    state[ 4 ] = -1.14788435945363;
+    state[ 5 ] = 3.44659369332744;
+    return state;
+}
+
+//! Set up departure state in near-geostationary orbit (deep-space SDP4) [km; km/s].
+Vector6 setUpDeepSpaceState( )
+{
+    Vector6 state( 6 );
+    state[ 0 ] = 42164.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.0;
+    state[ 4 ] = 3.0746;
+    state[ 5 ] = 0.0268;
+    return state;
+}
+
+//! Benchmark Atom solver on fixture used by tests (free function, allocating solvers per call).
+void benchmarkExecuteAtomSolver( benchmark::State& state )
+{
+    const TransferProblem problem = setUpTransferProblem( setUpLowEarthOrbitState( ), 1000.0 );
+
+    int totalIterations = 0;
+    for ( auto _ : state )
+    {
+        int numberOfIterations = 0;
+        std::string solverStatusSummary;
+        const Velocities velocities = executeAtomSolver( problem.departurePosition,
+                                                         problem.departureEpoch,
+                                                         problem.arrivalPosition,
+                                                         problem.timeOfFlight,
+                                                         problem.departureVelocityGuess,
+                                                         solverStatusSummary,
+                                                         numberOfIterations );
+        benchmark::DoNotOptimize( velocities );
+        totalIterations += numberOfIterations;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+}
+BENCHMARK( benchmarkExecuteAtomSolver )->Unit( benchmark::kMillisecond );
+
+//! Benchmark Atom solver object, reused for all solves, for given solver type.
+void benchmarkAtomSolver( benchmark::State& state,
+                          const Vector6& departureState,
+                          const SolverType solverType,
+                          const bool isWarmStartEnabled )
+{
+    const TransferProblem problem
+        = setUpTransferProblem( departureState, static_cast< Real >( state.range( 0 ) ) );
+    AtomSolver< Real, Vector3 > solver(
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, solverType, isWarmStartEnabled );
+
+    int totalIterations = 0;
+    int totalResidualEvaluations = 0;
+    int totalNestedIterations = 0;
+    for ( auto _ : state )
+    {
+        int numberOfIterations = 0;
+        const Velocities velocities = solver.solve( problem.departurePosition,
+                                                    problem.departureEpoch,
+                                                    problem.arrivalPosition,
+                                                    problem.timeOfFlight,
+                                                    problem.departureVelocityGuess,
+                                                    numberOfIterations );
+        benchmark::DoNotOptimize( velocities );
+        totalIterations += numberOfIterations;
+        totalResidualEvaluations += solver.statistics( ).numberOfResidualEvaluations;
+        totalNestedIterations += solver.statistics( ).numberOfNestedIterations;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+    state.counters[ "residualEvaluations" ]
+        = benchmark::Counter( totalResidualEvaluations, benchmark::Counter::kAvgIterations );
+    state.counters[ "nestedIterations" ]
+        = benchmark::Counter( totalNestedIterations, benchmark::Counter::kAvgIterations );
+}
+
+//! Sweep over time-of-flight [min] in low-Earth orbit.
+BENCHMARK_CAPTURE( benchmarkAtomSolver, leoHybrids,
+                   setUpLowEarthOrbitState( ), hybridsSolver, false )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolver, leoHybridsj,
+                   setUpLowEarthOrbitState( ), hybridsjSolver, false )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolver, leoHybridsWarmStart,
+                   setUpLowEarthOrbitState( ), hybridsSolver, true )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+
+//! Sweep over time-of-flight [min] in deep space (SDP4).
+BENCHMARK_CAPTURE( benchmarkAtomSolver, deepSpaceHybrids,
+                   setUpDeepSpaceState( ), hybridsSolver, false )
+    ->Arg( 3600 )->Arg( 21600 )->Arg( 43200 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolver, deepSpaceHybridsj,
+                   setUpDeepSpaceState( ), hybridsjSolver, false )
+    ->Arg( 3600 )->Arg( 21600 )->Arg( 43200 )->Unit( benchmark::kMillisecond );
+
+//! Benchmark coarse and tight stages of two-stage solver in low-Earth orbit, reporting accuracy.
+void benchmarkAtomSolverTwoStage( benchmark::State& state,
+                                  const bool isCoarseStageEnabled,
+                                  const bool isRefinementStageEnabled )
+{
+    const TransferProblem problem = setUpTransferProblem(
+        setUpLowEarthOrbitState( ), static_cast< Real >( state.range( 0 ) ) );
+
+    // Set up solvers with default tolerances of coarse and refinement stages.
+    AtomSolver< Real, Vector3 > coarseSolver( Tle( ), kMU, kXKMPER, 1.0e-6, 1.0e-3, 50 );
+    AtomSolver< Real, Vector3 > solver( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100 );
+
+    int totalIterations = 0;
+    Real finalResidualNorm = 0.0;
+    Velocities velocities;
+    for ( auto _ : state )
+    {
+        int numberOfIterations = 0;
+        velocities.first = problem.departureVelocityGuess;
+        if ( isCoarseStageEnabled )
+        {
+            velocities = coarseSolver.solve( problem.departurePosition,
+                                             problem.departureEpoch,
+                                             problem.arrivalPosition,
+                                             problem.timeOfFlight,
+                                             velocities.first,
+                                             numberOfIterations );
+            totalIterations += numberOfIterations;
+            finalResidualNorm = coarseSolver.statistics( ).finalResidualNorm;
+        }
+        if ( isRefinementStageEnabled )
+        {
+            velocities = solver.solve( problem.departurePosition,
+                                       problem.departureEpoch,
+                                       problem.arrivalPosition,
+                                       problem.timeOfFlight,
+                                       velocities.first,
+                                       numberOfIterations );
+            totalIterations += numberOfIterations;
+            finalResidualNorm = solver.statistics( ).finalResidualNorm;
+        }
+        benchmark::DoNotOptimize( velocities );
+    }
+
+    // Compute error of departure velocity with respect to departure state of problem [km/s].
+    Real departureVelocityError = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        const Real error = velocities.first[ i ] - problem.departureVelocity[ i ];
+        departureVelocityError += error * error;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+    state.counters[ "departureVelocityError[m/s]" ]
+        = benchmark::Counter( 1.0e3 * std::sqrt( departureVelocityError ) );
+    state.counters[ "arrivalPositionError[m]" ] = benchmark::Counter( 1.0e3 * finalResidualNorm );
+}
+
+//! Sweep over time-of-flight [min] in low-Earth orbit, for coarse, tight and two-stage solves.
+BENCHMARK_CAPTURE( benchmarkAtomSolverTwoStage, leoCoarse, true, false )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolverTwoStage, leoTight, false, true )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolverTwoStage, leoTwoStage, true, true )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+
+//! Benchmark analytic fast path in low-Earth orbit, for given analytic propagation model.
+void benchmarkAtomSolverFastPath( benchmark::State& state,
+                                  const AnalyticPropagationModel propagationModel )
+{
+    const TransferProblem problem = setUpTransferProblem(
+        setUpLowEarthOrbitState( ), static_cast< Real >( state.range( 0 ) ) );
+    AtomSolver< Real, Vector3 > solver( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100 );
+
+    int totalIterations = 0;
+    int totalAnalyticIterations = 0;
+    int totalAnalyticConvergences = 0;
+    Vector3 analyticDepartureVelocity( 3 );
+    for ( auto _ : state )
+    {
+        int numberOfAnalyticIterations = 0;
+        const SolverStatus analyticStatus
+            = executeAnalyticAtomSolver( problem.departurePosition,
+                                         problem.arrivalPosition,
+                                         problem.timeOfFlight,
+                                         problem.departureVelocityGuess,
+                                         analyticDepartureVelocity,
+                                         numberOfAnalyticIterations,
+                                         propagationModel );
+
+        int numberOfIterations = 0;
+        const Velocities velocities
+            = solver.solve( problem.departurePosition,
+                            problem.departureEpoch,
+                            problem.arrivalPosition,
+                            problem.timeOfFlight,
+                            ( analyticStatus == solverConverged ) ? analyticDepartureVelocity
+                                                                  : problem.departureVelocityGuess,
+                            numberOfIterations );
+        benchmark::DoNotOptimize( velocities );
+        totalIterations += numberOfIterations;
+        totalAnalyticIterations += numberOfAnalyticIterations;
+        totalAnalyticConvergences += ( analyticStatus == solverConverged ) ? 1 : 0;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+    state.counters[ "analyticIterations" ]
+        = benchmark::Counter( totalAnalyticIterations, benchmark::Counter::kAvgIterations );
+    state.counters[ "analyticConverged" ]
+        = benchmark::Counter( totalAnalyticConvergences, benchmark::Counter::kAvgIterations );
+}
+
+//! Sweep over time-of-flight [min] in low-Earth orbit, for two-body and J2-secular fast paths.
+BENCHMARK_CAPTURE( benchmarkAtomSolverFastPath, leoTwoBody, twoBodyPropagationModel )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( benchmarkAtomSolverFastPath, leoJ2Secular, j2SecularPropagationModel )
+    ->Arg( 500 )->Arg( 1000 )->Arg( 2000 )->Arg( 4000 )->Unit( benchmark::kMillisecond );
+
+//! Benchmark single evaluation of Atom residual function (including nested conversion).
+void benchmarkAtomResiduals( benchmark::State& state )
+{
+    const TransferProblem problem = setUpTransferProblem( setUpLowEarthOrbitState( ), 1000.0 );
+
+    SolverWorkspace tleWorkspace( 6 );
+    AtomParameters< Real, Vector3 > parameters( problem.departurePosition,
+                                                problem.departureEpoch,
+                                                problem.arrivalPosition,
+                                                problem.timeOfFlight,
+                                                kMU,
+                                                kXKMPER,
+                                                Tle( ),
+                                                1.0e-10,
+                                                1.0e-5,
+                                                100,
+                                                &tleWorkspace );
+
+    gsl_vector* independentVariables = gsl_vector_alloc( 3 );
+    gsl_vector* residuals = gsl_vector_alloc( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        gsl_vector_set( independentVariables, i, problem.departureVelocityGuess[ i ] );
+    }
+
+    for ( auto _ : state )
+    {
+        computeAtomResiduals< Real, Vector3 >( independentVariables, &parameters, residuals );
+        benchmark::DoNotOptimize( residuals->data );
+    }
+
+    gsl_vector_free( residuals );
+    gsl_vector_free( independentVariables );
+
+    state.SetItemsProcessed( state.iterations( ) );
+}
+BENCHMARK( benchmarkAtomResiduals )->Unit( benchmark::kMicrosecond );
+
+} // namespace benchmarks
+} // namespace atom
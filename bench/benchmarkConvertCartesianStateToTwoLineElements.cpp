@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include <Astro/astro.hpp>
+
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/convertCartesianStatesToTwoLineElements.hpp"
+
+namespace atom
+{
+namespace benchmarks
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector6;
+
+//! Set up target Cartesian state used by tests [km; km/s].
+Vector6 setUpCartesianState( )
+{
+    Vector6 cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+    return cartesianState;
+}
+
+//! Benchmark Cartesian-to-TLE conversion (free function, allocating solver per call).
+void benchmarkConvertCartesianStateToTwoLineElements( benchmark::State& state )
+{
+    const Vector6 cartesianState = setUpCartesianState( );
+    const DateTime epoch;
+
+    int totalIterations = 0;
+    for ( auto _ : state )
+    {
+        NoSolverDiagnostics diagnostics;
+        int numberOfIterations = 0;
+        const Tle tle = convertCartesianStateToTwoLineElements< Real, Vector6 >(
+            cartesianState, epoch, diagnostics, numberOfIterations );
+        benchmark::DoNotOptimize( tle );
+        totalIterations += numberOfIterations;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+}
+BENCHMARK( benchmarkConvertCartesianStateToTwoLineElements )->Unit( benchmark::kMicrosecond );
+
+//! Benchmark Cartesian-to-TLE converter object, reused for all conversions.
+void benchmarkTleFitter( benchmark::State& state, const SolverType solverType )
+{
+    const Vector6 cartesianState = setUpCartesianState( );
+    const DateTime epoch;
+    TleFitter< Real, Vector6 > fitter( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, solverType );
+
+    int totalIterations = 0;
+    int totalResidualEvaluations = 0;
+    for ( auto _ : state )
+    {
+        int numberOfIterations = 0;
+        const Tle tle = fitter.solve( cartesianState, epoch, numberOfIterations );
+        benchmark::DoNotOptimize( tle );
+        totalIterations += numberOfIterations;
+        totalResidualEvaluations += fitter.statistics( ).numberOfResidualEvaluations;
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+    state.counters[ "iterations" ]
+        = benchmark::Counter( totalIterations, benchmark::Counter::kAvgIterations );
+    state.counters[ "residualEvaluations" ]
+        = benchmark::Counter( totalResidualEvaluations, benchmark::Counter::kAvgIterations );
+}
+BENCHMARK_CAPTURE( benchmarkTleFitter, hybrids, hybridsSolver )->Unit( benchmark::kMicrosecond );
+BENCHMARK_CAPTURE( benchmarkTleFitter, hybridsj, hybridsjSolver )->Unit( benchmark::kMicrosecond );
+
+//! Benchmark bulk Cartesian-to-TLE conversion of stream of states, for given number of threads.
+void benchmarkConvertCartesianStatesToTwoLineElements( benchmark::State& state )
+{
+    // Set up stream of states, perturbing target state per state.
+    const Vector6 cartesianState = setUpCartesianState( );
+    const std::size_t numberOfStates = 1024;
+    std::vector< Real > cartesianStates( 6 * numberOfStates );
+    for ( std::size_t i = 0; i < numberOfStates; i++ )
+    {
+        for ( int j = 0; j < 6; j++ )
+        {
+            cartesianStates[ 6 * i + j ] = cartesianState[ j ] * ( 1.0 + 1.0e-6 * i );
+        }
+    }
+    const std::vector< DateTime > epochs( numberOfStates, DateTime( ) );
+
+    std::vector< char > records( numberOfStates * kTwoLineElementsRecordSize );
+    std::vector< SolverStatus > statuses( numberOfStates );
+    for ( auto _ : state )
+    {
+        convertCartesianStatesToTwoLineElements( &cartesianStates[ 0 ],
+                                                 &epochs[ 0 ],
+                                                 numberOfStates,
+                                                 &records[ 0 ],
+                                                 &statuses[ 0 ],
+                                                 static_cast< unsigned int >( state.range( 0 ) ) );
+        benchmark::DoNotOptimize( records.data( ) );
+    }
+
+    state.SetItemsProcessed( state.iterations( ) * numberOfStates );
+    state.SetBytesProcessed( state.iterations( ) * numberOfStates * kTwoLineElementsRecordSize );
+}
+BENCHMARK( benchmarkConvertCartesianStatesToTwoLineElements )
+    ->Arg( 1 )->Arg( 2 )->Arg( 4 )->Arg( 8 )->Unit( benchmark::kMillisecond )->UseRealTime( );
+
+//! Benchmark writing TLE lines to record.
+void benchmarkWriteTwoLineElements( benchmark::State& state )
+{
+    const Tle tle( "ISS (ZARYA)",
+                   "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+                   "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537" );
+    char record[ kTwoLineElementsRecordSize ];
+
+    for ( auto _ : state )
+    {
+        writeTwoLineElements( tle, record );
+        benchmark::DoNotOptimize( record );
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+}
+BENCHMARK( benchmarkWriteTwoLineElements );
+
+//! Benchmark single evaluation of Cartesian-to-TLE residual function.
+void benchmarkCartesianToTwoLineElementResiduals( benchmark::State& state )
+{
+    const Vector6 cartesianState = setUpCartesianState( );
+    CartesianToTwoLineElementsParameters< Real, Vector6 > parameters(
+        cartesianState, kMU, kXKMPER, Tle( ) );
+    parameters.workingTle.updateEpoch( DateTime( ) );
+
+    // Use osculating elements of target state as independent variables.
+    const Vector6 keplerianElements
+        = astro::convertCartesianToKeplerianElements( cartesianState, kMU );
+    gsl_vector* independentVariables = gsl_vector_alloc( 6 );
+    gsl_vector* residuals = gsl_vector_alloc( 6 );
+    for ( int i = 0; i < 6; i++ )
+    {
+        gsl_vector_set( independentVariables, i, keplerianElements[ i ] );
+    }
+
+    for ( auto _ : state )
+    {
+        computeCartesianToTwoLineElementResiduals< Real, Vector6 >(
+            independentVariables, &parameters, residuals );
+        benchmark::DoNotOptimize( residuals->data );
+    }
+
+    gsl_vector_free( residuals );
+    gsl_vector_free( independentVariables );
+
+    state.SetItemsProcessed( state.iterations( ) );
+}
+BENCHMARK( benchmarkCartesianToTwoLineElementResiduals );
+
+} // namespace benchmarks
+} // namespace atom
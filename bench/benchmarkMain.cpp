@@ -0,0 +1,9 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN( );
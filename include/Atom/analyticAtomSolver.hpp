@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_ANALYTIC_ATOM_SOLVER_H
+#define ATOM_ANALYTIC_ATOM_SOLVER_H
+
+#include <algorithm>
+#include <cmath>
+
+#include <libsgp4/Globals.h>
+
+#include "Atom/solverStatus.hpp"
+#include "Atom/twoBodyFunctions.hpp"
+#include "Atom/vectorTraits.hpp"
+
+namespace atom
+{
+
+//! Analytic propagation models used to approximate SGP4/SDP4 dynamics.
+enum AnalyticPropagationModel
+{
+    //! Two-body (Kepler) dynamics.
+    twoBodyPropagationModel,
+
+    //! Two-body dynamics with secular J2 perturbations.
+    j2SecularPropagationModel
+};
+
+//! Compute residuals of Atom system using analytic propagation model.
+/*!
+ * Computes the residuals of the Atom system, i.e., the difference between the arrival position
+ * reached from the departure state and the target arrival position, normalized by the Earth mean
+ * radius, using an analytic propagation model instead of the nested Cartesian-to-TLE conversion
+ * and the SGP4/SDP4 propagator. This function does not allocate any memory.
+ *
+ * @sa executeAnalyticAtomSolver, computeAtomResiduals
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureVelocity           Cartesian velocity vector at departure [km/s]
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [s]
+ * @param  propagationModel            Analytic propagation model
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  earthJ2                     Earth J2 zonal harmonic coefficient [-]
+ * @param  residuals                   Computed residuals [-]
+ */
+template< typename Real, typename Vector3 >
+void computeAnalyticAtomResiduals( const Vector3& departurePosition,
+                                   const Real departureVelocity[ 3 ],
+                                   const Vector3& arrivalPosition,
+                                   const Real timeOfFlight,
+                                   const AnalyticPropagationModel propagationModel,
+                                   const Real earthGravitationalParameter,
+                                   const Real earthMeanRadius,
+                                   const Real earthJ2,
+                                   Real residuals[ 3 ] );
+
+//! Solve 3x3 linear system.
+/*!
+ * Solves a 3x3 linear system using Cramer's rule. This function does not allocate any memory.
+ *
+ * @tparam Real     Type for reals
+ * @param  matrix   Matrix of linear system
+ * @param  vector   Right-hand side of linear system
+ * @param  solution Solution of linear system
+ * @return          Flag indicating if matrix is non-singular and solution is finite
+ */
+template< typename Real >
+bool solveLinearSystem3( const Real matrix[ 3 ][ 3 ],
+                         const Real vector[ 3 ],
+                         Real solution[ 3 ] );
+
+//! Execute Atom solver using analytic propagation model.
+/*!
+ * Executes the Atom solver for the Atom system approximated with an analytic propagation model
+ * (see computeAnalyticAtomResiduals), which is several orders of magnitude cheaper to evaluate
+ * than the full system. For orbits that are dominated by J2 perturbations, e.g., in low Earth
+ * orbit, the solution of the system approximated with secular J2 perturbations is much closer
+ * to the solution of the full system than the solution of the Lambert problem, and is therefore
+ * used as initial guess for the full system (see executeAtomSolverFastPath).
+ *
+ * The approximated system is solved using the Levenberg-Marquardt method, with a Jacobian
+ * approximated by central differences. For multi-revolution transfers the Jacobian is dominated by
+ * the sensitivity of the along-track position to the orbital energy and is close to singular, so
+ * that undamped Newton steps tend to jump to solutions with different numbers of revolutions. The
+ * best iterate found is returned as departure velocity if the solver does not converge. This
+ * function does not allocate any memory other than the departure velocity, and never throws
+ * exceptions.
+ *
+ * @sa computeAnalyticAtomResiduals, executeAtomSolverFastPath
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuess      Initial guess for the departure velocity [km/s]
+ * @param  departureVelocity           Departure velocity found by solver [km/s]
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  propagationModel            Analytic propagation model
+ *                                     [default: j2SecularPropagationModel]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  earthJ2                     Earth J2 zonal harmonic coefficient [-] [default: J2_SGP]
+ * @param  absoluteTolerance           Absolute tolerance on residuals used to check if solver has
+ *                                     converged [default: 1.0e-10]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100]
+ * @param  velocityStep                Step in departure velocity used to approximate Jacobian by
+ *                                     central differences [km/s] [default: 1.0e-6]
+ * @return                             Status of solver
+ */
+template< typename Real, typename Vector3 >
+SolverStatus executeAnalyticAtomSolver(
+    const Vector3& departurePosition,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    Vector3& departureVelocity,
+    int& numberOfIterations,
+    const AnalyticPropagationModel propagationModel = j2SecularPropagationModel,
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real earthJ2 = kXJ2,
+    const Real absoluteTolerance = 1.0e-10,
+    const int maximumIterations = 100,
+    const Real velocityStep = 1.0e-6 );
+
+//! Compute residuals of Atom system using analytic propagation model.
+template< typename Real, typename Vector3 >
+void computeAnalyticAtomResiduals( const Vector3& departurePosition,
+                                   const Real departureVelocity[ 3 ],
+                                   const Vector3& arrivalPosition,
+                                   const Real timeOfFlight,
+                                   const AnalyticPropagationModel propagationModel,
+                                   const Real earthGravitationalParameter,
+                                   const Real earthMeanRadius,
+                                   const Real earthJ2,
+                                   Real residuals[ 3 ] )
+{
+    const Real velocity[ 3 ] = { departureVelocity[ 0 ],
+                                 departureVelocity[ 1 ],
+                                 departureVelocity[ 2 ] };
+    const Real position[ 3 ] = { departurePosition[ 0 ],
+                                 departurePosition[ 1 ],
+                                 departurePosition[ 2 ] };
+
+    Real propagatedPosition[ 3 ];
+    Real propagatedVelocity[ 3 ];
+    propagateJ2SecularState( position,
+                             velocity,
+                             timeOfFlight,
+                             earthGravitationalParameter,
+                             earthMeanRadius,
+                             ( propagationModel == j2SecularPropagationModel ) ? earthJ2 : 0.0,
+                             propagatedPosition,
+                             propagatedVelocity );
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        residuals[ i ] = ( propagatedPosition[ i ] - arrivalPosition[ i ] ) / earthMeanRadius;
+    }
+}
+
+//! Solve 3x3 linear system.
+template< typename Real >
+bool solveLinearSystem3( const Real matrix[ 3 ][ 3 ],
+                         const Real vector[ 3 ],
+                         Real solution[ 3 ] )
+{
+    // Compute adjugate of matrix.
+    Real adjugate[ 3 ][ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            adjugate[ j ][ i ] = matrix[ ( i + 1 ) % 3 ][ ( j + 1 ) % 3 ]
+                                 * matrix[ ( i + 2 ) % 3 ][ ( j + 2 ) % 3 ]
+                                 - matrix[ ( i + 1 ) % 3 ][ ( j + 2 ) % 3 ]
+                                   * matrix[ ( i + 2 ) % 3 ][ ( j + 1 ) % 3 ];
+        }
+    }
+
+    const Real determinant = matrix[ 0 ][ 0 ] * adjugate[ 0 ][ 0 ]
+                             + matrix[ 0 ][ 1 ] * adjugate[ 1 ][ 0 ]
+                             + matrix[ 0 ][ 2 ] * adjugate[ 2 ][ 0 ];
+    if ( determinant == 0.0 || !std::isfinite( determinant ) )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        solution[ i ] = ( adjugate[ i ][ 0 ] * vector[ 0 ]
+                          + adjugate[ i ][ 1 ] * vector[ 1 ]
+                          + adjugate[ i ][ 2 ] * vector[ 2 ] ) / determinant;
+        if ( !std::isfinite( solution[ i ] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! Execute Atom solver using analytic propagation model.
+template< typename Real, typename Vector3 >
+SolverStatus executeAnalyticAtomSolver( const Vector3& departurePosition,
+                                        const Vector3& arrivalPosition,
+                                        const Real timeOfFlight,
+                                        const Vector3& departureVelocityGuess,
+                                        Vector3& departureVelocity,
+                                        int& numberOfIterations,
+                                        const AnalyticPropagationModel propagationModel,
+                                        const Real earthGravitationalParameter,
+                                        const Real earthMeanRadius,
+                                        const Real earthJ2,
+                                        const Real absoluteTolerance,
+                                        const int maximumIterations,
+                                        const Real velocityStep )
+{
+    // Convert time-of-flight from minutes to seconds, which are used by the analytic propagation
+    // models.
+    const Real timeOfFlightInSeconds = timeOfFlight * kSECONDS_PER_DAY / kMINUTES_PER_DAY;
+
+    Real velocity[ 3 ] = { departureVelocityGuess[ 0 ],
+                           departureVelocityGuess[ 1 ],
+                           departureVelocityGuess[ 2 ] };
+    Real residuals[ 3 ];
+    computeAnalyticAtomResiduals( departurePosition, velocity, arrivalPosition,
+                                  timeOfFlightInSeconds, propagationModel,
+                                  earthGravitationalParameter, earthMeanRadius, earthJ2,
+                                  residuals );
+    Real residualNorm = std::sqrt( residuals[ 0 ] * residuals[ 0 ]
+                                   + residuals[ 1 ] * residuals[ 1 ]
+                                   + residuals[ 2 ] * residuals[ 2 ] );
+
+    SolverStatus status = solverMaximumIterationsReached;
+    if ( !std::isfinite( residualNorm ) )
+    {
+        status = solverStuck;
+    }
+
+    Real damping = 1.0e-3;
+    numberOfIterations = 0;
+    while ( status == solverMaximumIterationsReached && numberOfIterations < maximumIterations )
+    {
+        if ( std::fabs( residuals[ 0 ] ) < absoluteTolerance
+             && std::fabs( residuals[ 1 ] ) < absoluteTolerance
+             && std::fabs( residuals[ 2 ] ) < absoluteTolerance )
+        {
+            status = solverConverged;
+            break;
+        }
+
+        ++numberOfIterations;
+
+        // Approximate Jacobian with respect to departure velocity by central differences.
+        Real jacobian[ 3 ][ 3 ];
+        for ( int j = 0; j < 3; j++ )
+        {
+            Real forwardVelocity[ 3 ] = { velocity[ 0 ], velocity[ 1 ], velocity[ 2 ] };
+            Real backwardVelocity[ 3 ] = { velocity[ 0 ], velocity[ 1 ], velocity[ 2 ] };
+            forwardVelocity[ j ] += velocityStep;
+            backwardVelocity[ j ] -= velocityStep;
+
+            Real forwardResiduals[ 3 ];
+            Real backwardResiduals[ 3 ];
+            computeAnalyticAtomResiduals( departurePosition, forwardVelocity, arrivalPosition,
+                                          timeOfFlightInSeconds, propagationModel,
+                                          earthGravitationalParameter, earthMeanRadius, earthJ2,
+                                          forwardResiduals );
+            computeAnalyticAtomResiduals( departurePosition, backwardVelocity, arrivalPosition,
+                                          timeOfFlightInSeconds, propagationModel,
+                                          earthGravitationalParameter, earthMeanRadius, earthJ2,
+                                          backwardResiduals );
+
+            for ( int i = 0; i < 3; i++ )
+            {
+                jacobian[ i ][ j ]
+                    = ( forwardResiduals[ i ] - backwardResiduals[ i ] ) / ( 2.0 * velocityStep );
+            }
+        }
+
+        // Compute normal matrix and gradient of least-squares problem.
+        Real normalMatrix[ 3 ][ 3 ];
+        Real gradient[ 3 ];
+        for ( int i = 0; i < 3; i++ )
+        {
+            gradient[ i ] = jacobian[ 0 ][ i ] * residuals[ 0 ]
+                            + jacobian[ 1 ][ i ] * residuals[ 1 ]
+                            + jacobian[ 2 ][ i ] * residuals[ 2 ];
+            for ( int j = 0; j < 3; j++ )
+            {
+                normalMatrix[ i ][ j ] = jacobian[ 0 ][ i ] * jacobian[ 0 ][ j ]
+                                         + jacobian[ 1 ][ i ] * jacobian[ 1 ][ j ]
+                                         + jacobian[ 2 ][ i ] * jacobian[ 2 ][ j ];
+            }
+        }
+
+        // Compute Levenberg-Marquardt step, increasing damping until residuals decrease; the
+        // solver is stuck if they do not decrease.
+        bool isStepAccepted = false;
+        for ( int k = 0; k < 30 && !isStepAccepted; k++ )
+        {
+            Real dampedMatrix[ 3 ][ 3 ];
+            for ( int i = 0; i < 3; i++ )
+            {
+                for ( int j = 0; j < 3; j++ )
+                {
+                    dampedMatrix[ i ][ j ] = normalMatrix[ i ][ j ];
+                }
+                dampedMatrix[ i ][ i ] += damping * normalMatrix[ i ][ i ];
+            }
+
+            Real step[ 3 ];
+            if ( !solveLinearSystem3( dampedMatrix, gradient, step ) )
+            {
+                break;
+            }
+
+            const Real trialVelocity[ 3 ] = { velocity[ 0 ] - step[ 0 ],
+                                              velocity[ 1 ] - step[ 1 ],
+                                              velocity[ 2 ] - step[ 2 ] };
+            Real trialResiduals[ 3 ];
+            computeAnalyticAtomResiduals( departurePosition, trialVelocity, arrivalPosition,
+                                          timeOfFlightInSeconds, propagationModel,
+                                          earthGravitationalParameter, earthMeanRadius, earthJ2,
+                                          trialResiduals );
+            const Real trialResidualNorm
+                = std::sqrt( trialResiduals[ 0 ] * trialResiduals[ 0 ]
+                             + trialResiduals[ 1 ] * trialResiduals[ 1 ]
+                             + trialResiduals[ 2 ] * trialResiduals[ 2 ] );
+
+            if ( trialResidualNorm < residualNorm )
+            {
+                for ( int i = 0; i < 3; i++ )
+                {
+                    velocity[ i ] = trialVelocity[ i ];
+                    residuals[ i ] = trialResiduals[ i ];
+                }
+                residualNorm = trialResidualNorm;
+                damping = std::max( 0.1 * damping, Real( 1.0e-12 ) );
+                isStepAccepted = true;
+            }
+            else
+            {
+                damping *= 10.0;
+            }
+        }
+
+        if ( !isStepAccepted )
+        {
+            status = solverStuck;
+        }
+    }
+
+    if ( status == solverMaximumIterationsReached
+         && std::fabs( residuals[ 0 ] ) < absoluteTolerance
+         && std::fabs( residuals[ 1 ] ) < absoluteTolerance
+         && std::fabs( residuals[ 2 ] ) < absoluteTolerance )
+    {
+        status = solverConverged;
+    }
+
+    departureVelocity = createVector< Vector3 >( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureVelocity[ i ] = velocity[ i ];
+    }
+
+    return status;
+}
+
+} // namespace atom
+
+#endif // ATOM_ANALYTIC_ATOM_SOLVER_H
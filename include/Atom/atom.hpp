@@ -7,24 +7,59 @@
 #ifndef ATOM_SOLVER_H
 #define ATOM_SOLVER_H
 
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_multiroots.h>
 #include <gsl/gsl_vector.h>
 
 #include <libsgp4/DateTime.h>
 #include <libsgp4/Eci.h>
-#include <libsgp4/SGP4.h>
+#include <libsgp4/Globals.h>
 #include <libsgp4/Tle.h>
+#include <libsgp4/Vector.h>
 
+#include "Atom/atomSolutionCache.hpp"
 #include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/lambertSolver.hpp"
+#include "Atom/memoizedSgp4Propagator.hpp"
+#include "Atom/precompiledInstantiations.hpp"
+#include "Atom/printFunctions.hpp"
+#include "Atom/solverCancellation.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatistics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+#include "Atom/tleConversionCache.hpp"
+#include "Atom/twoBodyFunctions.hpp"
+#include "Atom/vectorTraits.hpp"
 
 namespace atom
 {
 
+//! Converged transfer computed by Atom solver.
+/*!
+ * Data structure with the departure TLE and arrival state of the transfer found by the Atom
+ * solver, together with the final residuals. They are captured from the last evaluation of the
+ * residual function if it was evaluated at the final departure velocity, which avoids repeating
+ * the nested Cartesian-to-TLE conversion and the propagation once the solver has converged.
+ *
+ * @sa executeAtomSolver, AtomSolver
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+struct AtomTransfer;
+
 //! Execute Atom solver.
 /*!
  * Executes Atom solver to find the transfer orbit connecting two positions. The epoch of the
@@ -49,7 +84,7 @@ namespace atom
  * @param  departurePosition           Cartesian position vector at departure [km]
  * @param  departureEpoch              Modified Julian Date (MJD) of departure
  * @param  arrivalPosition             Cartesian position vector at arrival [km]
- * @param  timeOfFlight                Time-of-Flight for orbital transfer [s]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
  * @param  departureVelocityGuess      Initial guess for the departure velocity (serves as initial
  *                                     guess for the internal root-finding procedure) [km/s]
  * @param  solverStatusSummary         Status of non-linear solver printed as a table
@@ -67,6 +102,15 @@ namespace atom
  *                                     solver reaches this limit, the loop will be broken and the
  *                                     solver status will report that it has not converged
  *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver, used for the Atom solver and the nested
+ *                                     Cartesian-to-TLE conversions. If hybridsjSolver is selected,
+ *                                     the Jacobians are approximated using two-body dynamics
+ *                                     instead of finite differences [default: hybridsSolver].
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started using the mean elements found by the previous
+ *                                     conversion. If the hybridsjSolver is selected, the
+ *                                     tolerances of the nested conversions are also adapted to the
+ *                                     residuals of the Atom solver [default: false].
  * @return                             Departure and arrival velocities (stored in that order)
  */
 template< typename Real, typename Vector3 >
@@ -83,7 +127,9 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
     const Real earthMeanRadius = kXKMPER,
     const Real absoluteTolerance = 1.0e-10,
     const Real relativeTolerance = 1.0e-5,
-    const int maximumIterations = 100 );
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const bool isWarmStartEnabled = false );
 
 //! Execute Atom solver.
 /*!
@@ -113,7 +159,7 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
  * @param  departurePosition      Cartesian position vector at departure [km]
  * @param  departureEpoch         Modified Julian Date (MJD) of departure
  * @param  arrivalPosition        Cartesian position vector at arrival [km]
- * @param  timeOfFlight           Time-of-Flight for orbital transfer [s]
+ * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
  * @param  departureVelocityGuess Initial guess for the departure velocity (serves as initial
  *                                guess for the internal root-finding procedure) [km/s]
  * @return                        Departure and arrival velocities (stored in that order)
@@ -126,6 +172,206 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
     const Real timeOfFlight,
     const Vector3& departureVelocityGuess );
 
+//! Execute Atom solver.
+/*!
+ * Executes Atom solver to find the transfer orbit connecting two positions. The epoch of the
+ * departure position and the Time-of-flight need to be specified.
+ *
+ * This is a function overload that computes the initial guess for the departure velocity by
+ * solving the Lambert problem for the given positions and time-of-flight.
+ *
+ * @sa     executeAtomSolver, computeAtomDepartureVelocityGuess
+ * @tparam Real              Type for reals
+ * @tparam Vector3           Type for 3-vector of reals
+ * @param  departurePosition Cartesian position vector at departure [km]
+ * @param  departureEpoch    Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition   Cartesian position vector at arrival [km]
+ * @param  timeOfFlight      Time-of-Flight for orbital transfer [min]
+ * @return                   Departure and arrival velocities (stored in that order)
+ */
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight );
+
+//! Compute initial guess for departure velocity used by Atom solver.
+/*!
+ * Computes an initial guess for the departure velocity used by the Atom solver, by solving the
+ * Lambert problem for the given positions and time-of-flight. The prograde solution with the
+ * lowest departure speed, over all feasible numbers of revolutions, is selected.
+ *
+ * @sa     executeAtomSolver, computeLambertDepartureVelocityGuess
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @return                             Initial guess for the departure velocity [km/s]
+ */
+template< typename Real, typename Vector3 >
+Vector3 computeAtomDepartureVelocityGuess( const Vector3& departurePosition,
+                                           const Vector3& arrivalPosition,
+                                           const Real timeOfFlight,
+                                           const Real earthGravitationalParameter = kMU );
+
+//! Execute Atom solver.
+/*!
+ * Executes Atom solver to find the transfer orbit connecting two positions. The epoch of the
+ * departure position and the Time-of-flight need to be specified.
+ *
+ * Details of the underlying non-linear system and algorithm are catalogued by
+ * Kumar, et al. (2014).
+ *
+ * This is a function overload that passes the state of the non-linear solver to a diagnostics
+ * policy at every iteration, instead of printing a solver status summary table. Using
+ * NoSolverDiagnostics ensures that no diagnostics are generated at all. The nested
+ * Cartesian-to-TLE conversions never generate diagnostics.
+ *
+ * @sa     executeAtomSolver, NoSolverDiagnostics, SolverIterationTrace, SolverSummaryTable
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @tparam Diagnostics                 Type for solver diagnostics policy
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuess      Initial guess for the departure velocity [km/s]
+ * @param  diagnostics                 Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @return                             Departure and arrival velocities (stored in that order)
+ */
+template< typename Real, typename Vector3, typename Diagnostics >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const bool isWarmStartEnabled = false );
+
+//! Execute Atom solver.
+/*!
+ * Executes Atom solver to find the transfer orbit connecting two positions. The epoch of the
+ * departure position and the Time-of-flight need to be specified.
+ *
+ * This is a function overload that uses the GSL solvers allocated in the given workspaces, instead
+ * of allocating new solvers for the Atom solver and for every nested Cartesian-to-TLE conversion.
+ * This avoids allocating and freeing memory for every solve when many solves are executed in
+ * sequence, e.g., by a worker thread in a batch run.
+ *
+ * If the solver status is set, the solver does not throw exceptions. Instead, the status of the
+ * solver is returned, together with the departure velocity corresponding to the last iteration of
+ * the solver. The arrival velocity is set to NaN if it cannot be computed. Otherwise, an
+ * exception is thrown if the solver gets stuck, if a nested Cartesian-to-TLE conversion gets
+ * stuck or if the SGP4/SDP4 propagator fails.
+ *
+ * If the cancellation token is set, it is checked between iterations of the solver and between
+ * iterations of the nested Cartesian-to-TLE conversions. If the token is cancelled, the solver
+ * stops at its current iterate, with status solverCancelled. Since the GSL solvers only accept
+ * iterates that reduce the residuals, this is the best iterate found so far. The arrival velocity
+ * and the converged transfer are returned if the last evaluation of the residual function was at
+ * this iterate.
+ *
+ * @sa     executeAtomSolver, executeAtomSolverBatch, executeAtomSolverAsync, SolverWorkspace,
+ *         SolverStatus, SolverCancellation
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @tparam Diagnostics                 Type for solver diagnostics policy
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuess      Initial guess for the departure velocity [km/s]
+ * @param  atomWorkspace               Workspace for Atom solver (dimension 3)
+ * @param  tleWorkspace                Workspace for nested Cartesian-to-TLE conversions
+ *                                     (dimension 6)
+ * @param  diagnostics                 Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @param  statistics                  Statistics collected by solver, including the statistics of
+ *                                     the nested Cartesian-to-TLE conversions; if it is not set,
+ *                                     no statistics are collected [default: 0]
+ * @param  status                      Status of solver; if it is not set, exceptions are thrown if
+ *                                     the solver fails [default: 0]
+ * @param  tleWarmStart                Warm-start state of nested Cartesian-to-TLE conversions,
+ *                                     which is only used if warm starts are enabled and is
+ *                                     carried over to subsequent solves; if it is not set, a
+ *                                     warm-start state is set up for the solve [default: 0]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     which is shared by all conversions of the solve, including
+ *                                     the final conversion of the converged departure state; if it
+ *                                     is not set, no conversions are cached [default: 0]
+ * @param  transfer                    Converged transfer (departure TLE, arrival state and final
+ *                                     residuals); if it is not set, the transfer is not stored
+ *                                     [default: 0]
+ * @param  cancellation                Cancellation token checked between iterations; if it is not
+ *                                     set, the solver cannot be cancelled [default: 0]
+ * @param  propagator                  SGP4/SDP4 propagator used by residual function and nested
+ *                                     Cartesian-to-TLE conversions, which is reused by subsequent
+ *                                     solves; if it is not set, a propagator is set up for the
+ *                                     solve [default: 0]
+ * @return                             Departure and arrival velocities (stored in that order)
+ */
+template< typename Real, typename Vector3, typename Diagnostics >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    SolverWorkspace& atomWorkspace,
+    SolverWorkspace& tleWorkspace,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const bool isWarmStartEnabled = false,
+    SolverStatistics< Real >* statistics = 0,
+    SolverStatus* status = 0,
+    TleFitWarmStart< Real >* tleWarmStart = 0,
+    TleConversionCache< Real >* tleCache = 0,
+    AtomTransfer< Real, Vector3 >* transfer = 0,
+    const SolverCancellation* cancellation = 0,
+    MemoizedSgp4Propagator* propagator = 0 );
+
 //! Compute residuals to execute Atom solver.
 /*!
  * Evaluates system of non-linear equations and computes residuals to execute the Atom solver. The
@@ -153,6 +399,48 @@ int computeAtomResiduals( const gsl_vector* independentVariables,
                           void* parameters,
                           gsl_vector* residuals );
 
+//! Compute Jacobian to execute Atom solver.
+/*!
+ * Computes an approximation of the Jacobian of the residual function used to execute the Atom
+ * solver. The SGP4/SDP4 dynamics are approximated by two-body dynamics, such that the partial
+ * derivatives of the arrival position with respect to the departure velocity are computed by
+ * central differences of cheap two-body propagations, instead of evaluating the residual function
+ * (and thus the nested Cartesian-to-TLE conversion) three more times. The residual function itself
+ * is not approximated, so the converged departure velocity is not affected by this approximation.
+ *
+ * @sa computeAtomResiduals, propagateTwoBodyState
+ * @tparam Real                 Type for reals
+ * @tparam Vector3              Type for 3-vector of reals
+ * @param  independentVariables Vector of independent variables used by the root-finder
+ * @param  parameters           Parameters required to compute the objective function
+ * @param  jacobian             Matrix of computed partial derivatives of residuals
+ * @return                      GSL flag indicating success or failure
+ */
+template< typename Real, typename Vector3 >
+int computeAtomJacobian( const gsl_vector* independentVariables,
+                         void* parameters,
+                         gsl_matrix* jacobian );
+
+//! Compute residuals and Jacobian to execute Atom solver.
+/*!
+ * Computes residuals and an approximation of the Jacobian of the residual function used to execute
+ * the Atom solver.
+ *
+ * @sa computeAtomResiduals, computeAtomJacobian
+ * @tparam Real                 Type for reals
+ * @tparam Vector3              Type for 3-vector of reals
+ * @param  independentVariables Vector of independent variables used by the root-finder
+ * @param  parameters           Parameters required to compute the objective function
+ * @param  residuals            Vector of computed residuals
+ * @param  jacobian             Matrix of computed partial derivatives of residuals
+ * @return                      GSL flag indicating success or failure
+ */
+template< typename Real, typename Vector3 >
+int computeAtomResidualsAndJacobian( const gsl_vector* independentVariables,
+                                     void* parameters,
+                                     gsl_vector* residuals,
+                                     gsl_matrix* jacobian );
+
 //! Parameter struct used by Atom residual function.
 /*!
  * Data structure with parameters used to compute Atom residual function.
@@ -164,6 +452,465 @@ int computeAtomResiduals( const gsl_vector* independentVariables,
 template< typename Real, typename Vector3 >
 struct AtomParameters;
 
+//! Atom solver that owns its GSL solvers.
+/*!
+ * Solver that owns the workspaces of the GSL solvers (Atom solver and nested Cartesian-to-TLE
+ * conversions), the reference TLE and the constants and tolerances used to execute the Atom
+ * solver. The workspaces are allocated once on construction, such that repeated solves do not
+ * allocate and free memory for the GSL solvers. The free executeAtomSolver functions that allocate
+ * solvers are thin wrappers around this class. The statistics of the last solve are always
+ * collected and can be retrieved after every solve.
+ *
+ * Solvers cannot be copied, since they own the GSL solvers. A solver must not be used by more
+ * than one thread at a time; use one solver per thread instead (see executeAtomSolverBatch).
+ *
+ * @sa executeAtomSolver, SolverWorkspace, TleFitter
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+class AtomSolver
+{
+public:
+
+    //! Constructor taking settings of solver.
+    /*!
+     * Constructor taking settings of solver, allocating memory for GSL solvers.
+     *
+     * @param aReferenceTle                 Reference Two Line Elements [default: 0-TLE]
+     * @param anEarthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+     *                                      [default: mu_SGP]
+     * @param anEarthMeanRadius             Earth mean radius [km] [default: R_SGP]
+     * @param anAbsoluteTolerance           Absolute tolerance used to check if root-finder has
+     *                                      converged [default: 1.0e-10]
+     * @param aRelativeTolerance            Relative tolerance used to check if root-finder has
+     *                                      converged [default: 1.0e-5]
+     * @param someMaximumIterations         Maximum number of solver iterations permitted
+     *                                      [default: 100]
+     * @param aSolverType                   Type of GSL solver [default: hybridsSolver]
+     * @param anIsWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions
+     *                                      are warm-started [default: false]
+     * @param aTleCache                     Cache of converged nested Cartesian-to-TLE conversions,
+     *                                      which may be shared by many solvers; if it is not set,
+     *                                      no conversions are cached [default: 0]
+     * @param aSolutionCache                Cache of converged solutions, which may be shared by
+     *                                      many solvers; if it is not set, no solutions are cached
+     *                                      [default: 0]
+     */
+    explicit AtomSolver( const Tle& aReferenceTle = Tle( ),
+                         const Real anEarthGravitationalParameter = kMU,
+                         const Real anEarthMeanRadius = kXKMPER,
+                         const Real anAbsoluteTolerance = 1.0e-10,
+                         const Real aRelativeTolerance = 1.0e-5,
+                         const int someMaximumIterations = 100,
+                         const SolverType aSolverType = hybridsSolver,
+                         const bool anIsWarmStartEnabled = false,
+                         TleConversionCache< Real >* aTleCache = 0,
+                         AtomSolutionCache< Real, Vector3 >* aSolutionCache = 0 )
+        : referenceTle( aReferenceTle ),
+          earthGravitationalParameter( anEarthGravitationalParameter ),
+          earthMeanRadius( anEarthMeanRadius ),
+          absoluteTolerance( anAbsoluteTolerance ),
+          relativeTolerance( aRelativeTolerance ),
+          maximumIterations( someMaximumIterations ),
+          isWarmStartEnabled( anIsWarmStartEnabled ),
+          tleCache( aTleCache ),
+          solutionCache( aSolutionCache ),
+          atomWorkspace( 3, aSolverType ),
+          tleWorkspace( 6, aSolverType ),
+          solverStatistics( ),
+          solverTransfer( ),
+          propagator( )
+    { }
+
+    //! Execute Atom solver.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions, passing the state
+     * of the non-linear solver to the given diagnostics policy.
+     *
+     * @sa executeAtomSolver
+     * @tparam Diagnostics            Type for solver diagnostics policy
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @param  diagnostics            Diagnostics policy that records state of non-linear solver
+     * @param  numberOfIterations     Number of iterations completed by solver
+     * @return                        Departure and arrival velocities (stored in that order)
+     */
+    template< typename Diagnostics >
+    const std::pair< Vector3, Vector3 > solve( const Vector3& departurePosition,
+                                               const DateTime& departureEpoch,
+                                               const Vector3& arrivalPosition,
+                                               const Real timeOfFlight,
+                                               const Vector3& departureVelocityGuess,
+                                               Diagnostics& diagnostics,
+                                               int& numberOfIterations )
+    {
+        return executeSolve( departurePosition,
+                             departureEpoch,
+                             arrivalPosition,
+                             timeOfFlight,
+                             departureVelocityGuess,
+                             diagnostics,
+                             numberOfIterations,
+                             0,
+                             0 );
+    }
+
+    //! Execute Atom solver.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions.
+     *
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @param  numberOfIterations     Number of iterations completed by solver
+     * @return                        Departure and arrival velocities (stored in that order)
+     */
+    const std::pair< Vector3, Vector3 > solve( const Vector3& departurePosition,
+                                               const DateTime& departureEpoch,
+                                               const Vector3& arrivalPosition,
+                                               const Real timeOfFlight,
+                                               const Vector3& departureVelocityGuess,
+                                               int& numberOfIterations )
+    {
+        NoSolverDiagnostics diagnostics;
+        return solve( departurePosition,
+                      departureEpoch,
+                      arrivalPosition,
+                      timeOfFlight,
+                      departureVelocityGuess,
+                      diagnostics,
+                      numberOfIterations );
+    }
+
+    //! Execute Atom solver.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions.
+     *
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @return                        Departure and arrival velocities (stored in that order)
+     */
+    const std::pair< Vector3, Vector3 > solve( const Vector3& departurePosition,
+                                               const DateTime& departureEpoch,
+                                               const Vector3& arrivalPosition,
+                                               const Real timeOfFlight,
+                                               const Vector3& departureVelocityGuess )
+    {
+        int dummyint = 0;
+        return solve( departurePosition,
+                      departureEpoch,
+                      arrivalPosition,
+                      timeOfFlight,
+                      departureVelocityGuess,
+                      dummyint );
+    }
+
+    //! Execute Atom solver.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions, using the solution
+     * of the Lambert problem as initial guess for the departure velocity.
+     *
+     * @sa computeAtomDepartureVelocityGuess
+     * @param  departurePosition Cartesian position vector at departure [km]
+     * @param  departureEpoch    Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition   Cartesian position vector at arrival [km]
+     * @param  timeOfFlight      Time-of-Flight for orbital transfer [min]
+     * @return                   Departure and arrival velocities (stored in that order)
+     */
+    const std::pair< Vector3, Vector3 > solve( const Vector3& departurePosition,
+                                               const DateTime& departureEpoch,
+                                               const Vector3& arrivalPosition,
+                                               const Real timeOfFlight )
+    {
+        return solve( departurePosition,
+                      departureEpoch,
+                      arrivalPosition,
+                      timeOfFlight,
+                      computeAtomDepartureVelocityGuess( departurePosition,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         earthGravitationalParameter ) );
+    }
+
+    //! Execute Atom solver without throwing exceptions.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions, passing the state
+     * of the non-linear solver to the given diagnostics policy. No exceptions are thrown if the
+     * solver fails; the status of the solver is returned instead.
+     *
+     * @sa executeAtomSolver, SolverStatus
+     * @tparam Diagnostics            Type for solver diagnostics policy
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @param  velocities             Departure and arrival velocities (stored in that order); the
+     *                                arrival velocity is set to NaN if it cannot be computed
+     * @param  diagnostics            Diagnostics policy that records state of non-linear solver
+     * @param  numberOfIterations     Number of iterations completed by solver
+     * @param  cancellation           Cancellation token checked between iterations; if it is not
+     *                                set, the solver cannot be cancelled [default: 0]
+     * @return                        Status of solver
+     */
+    template< typename Diagnostics >
+    SolverStatus trySolve( const Vector3& departurePosition,
+                           const DateTime& departureEpoch,
+                           const Vector3& arrivalPosition,
+                           const Real timeOfFlight,
+                           const Vector3& departureVelocityGuess,
+                           std::pair< Vector3, Vector3 >& velocities,
+                           Diagnostics& diagnostics,
+                           int& numberOfIterations,
+                           const SolverCancellation* cancellation = 0 )
+    {
+        SolverStatus status = solverConverged;
+        velocities = executeSolve( departurePosition,
+                                   departureEpoch,
+                                   arrivalPosition,
+                                   timeOfFlight,
+                                   departureVelocityGuess,
+                                   diagnostics,
+                                   numberOfIterations,
+                                   &status,
+                                   cancellation );
+        return status;
+    }
+
+    //! Execute Atom solver without throwing exceptions.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions. No exceptions are
+     * thrown if the solver fails; the status of the solver is returned instead.
+     *
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @param  velocities             Departure and arrival velocities (stored in that order)
+     * @return                        Status of solver
+     */
+    SolverStatus trySolve( const Vector3& departurePosition,
+                           const DateTime& departureEpoch,
+                           const Vector3& arrivalPosition,
+                           const Real timeOfFlight,
+                           const Vector3& departureVelocityGuess,
+                           std::pair< Vector3, Vector3 >& velocities )
+    {
+        NoSolverDiagnostics diagnostics;
+        int dummyint = 0;
+        return trySolve( departurePosition,
+                         departureEpoch,
+                         arrivalPosition,
+                         timeOfFlight,
+                         departureVelocityGuess,
+                         velocities,
+                         diagnostics,
+                         dummyint );
+    }
+
+    //! Get statistics collected by last solve.
+    /*!
+     * Returns statistics collected by last solve executed by solver.
+     *
+     * @return Statistics collected by last solve
+     */
+    const SolverStatistics< Real >& statistics( ) const
+    {
+        return solverStatistics;
+    }
+
+    //! Get transfer found by last solve.
+    /*!
+     * Returns departure TLE, arrival state and final residuals of transfer found by last solve
+     * executed by solver.
+     *
+     * @return Transfer found by last solve
+     */
+    const AtomTransfer< Real, Vector3 >& transfer( ) const
+    {
+        return solverTransfer;
+    }
+
+    //! Reference TLE.
+    const Tle referenceTle;
+
+    //! Earth gravitational parameter [km^3 s^-2].
+    const Real earthGravitationalParameter;
+
+    //! Earth mean radius [km].
+    const Real earthMeanRadius;
+
+    //! Absolute tolerance [-].
+    const Real absoluteTolerance;
+
+    //! Relative tolerance [-].
+    const Real relativeTolerance;
+
+    //! Maximum number of iterations.
+    const int maximumIterations;
+
+    //! Flag indicating if nested Cartesian-to-TLE conversions are warm-started.
+    const bool isWarmStartEnabled;
+
+    //! Cache of converged nested Cartesian-to-TLE conversions.
+    TleConversionCache< Real >* const tleCache;
+
+    //! Cache of converged solutions.
+    AtomSolutionCache< Real, Vector3 >* const solutionCache;
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    AtomSolver( const AtomSolver& );
+
+    //! Assignment operator (disabled).
+    AtomSolver& operator=( const AtomSolver& );
+
+    //! Execute Atom solver, looking up transfer in cache of converged solutions.
+    /*!
+     * Executes Atom solver to find the transfer orbit connecting two positions. If the cache of
+     * converged solutions is set, a converged solution of the same transfer is returned directly
+     * and the solver is seeded with the departure velocity of a nearby converged transfer, instead
+     * of the given initial guess. Converged solutions are stored in the cache.
+     *
+     * @sa executeAtomSolver, AtomSolutionCache
+     * @tparam Diagnostics            Type for solver diagnostics policy
+     * @param  departurePosition      Cartesian position vector at departure [km]
+     * @param  departureEpoch         Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition        Cartesian position vector at arrival [km]
+     * @param  timeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param  departureVelocityGuess Initial guess for the departure velocity [km/s]
+     * @param  diagnostics            Diagnostics policy that records state of non-linear solver
+     * @param  numberOfIterations     Number of iterations completed by solver
+     * @param  status                 Status of solver; if it is not set, exceptions are thrown if
+     *                                the solver fails
+     * @param  cancellation           Cancellation token checked between iterations
+     * @return                        Departure and arrival velocities (stored in that order)
+     */
+    template< typename Diagnostics >
+    const std::pair< Vector3, Vector3 > executeSolve( const Vector3& departurePosition,
+                                                      const DateTime& departureEpoch,
+                                                      const Vector3& arrivalPosition,
+                                                      const Real timeOfFlight,
+                                                      const Vector3& departureVelocityGuess,
+                                                      Diagnostics& diagnostics,
+                                                      int& numberOfIterations,
+                                                      SolverStatus* status,
+                                                      const SolverCancellation* cancellation )
+    {
+        // Look up transfer in cache of converged solutions. A converged solution of the same
+        // transfer is returned without executing the solver.
+        CachedAtomSolution< Real, Vector3 > cachedSolution;
+        const AtomSolutionCacheLookup lookup
+            = ( solutionCache != 0 )
+                ? solutionCache->find( departurePosition,
+                                       departureEpoch,
+                                       arrivalPosition,
+                                       timeOfFlight,
+                                       absoluteTolerance,
+                                       cachedSolution )
+                : solutionCacheMiss;
+        if ( lookup == solutionCacheHit )
+        {
+            numberOfIterations = 0;
+            diagnostics.recordStatus( GSL_SUCCESS );
+            solverStatistics.reset( );
+            solverTransfer.isAvailable = true;
+            solverTransfer.departureTle = cachedSolution.departureTle;
+            solverTransfer.arrivalState = cachedSolution.arrivalState;
+            solverTransfer.finalResiduals = cachedSolution.finalResiduals;
+            if ( status != 0 )
+            {
+                *status = solverConverged;
+            }
+            return std::make_pair( cachedSolution.departureVelocity,
+                                   cachedSolution.arrivalVelocity );
+        }
+
+        // Execute solver, seeded with departure velocity of nearby converged transfer if it is
+        // found.
+        SolverStatus solveStatus = solverConverged;
+        const std::pair< Vector3, Vector3 > velocities
+            = executeAtomSolver( departurePosition,
+                                 departureEpoch,
+                                 arrivalPosition,
+                                 timeOfFlight,
+                                 ( lookup == solutionCacheSeed )
+                                    ? cachedSolution.departureVelocity : departureVelocityGuess,
+                                 atomWorkspace,
+                                 tleWorkspace,
+                                 diagnostics,
+                                 numberOfIterations,
+                                 referenceTle,
+                                 earthGravitationalParameter,
+                                 earthMeanRadius,
+                                 absoluteTolerance,
+                                 relativeTolerance,
+                                 maximumIterations,
+                                 isWarmStartEnabled,
+                                 &solverStatistics,
+                                 &solveStatus,
+                                 static_cast< TleFitWarmStart< Real >* >( 0 ),
+                                 tleCache,
+                                 &solverTransfer,
+                                 cancellation,
+                                 &propagator );
+        if ( status != 0 )
+        {
+            *status = solveStatus;
+        }
+        else if ( hasSolverFailed( solveStatus ) )
+        {
+            throw std::runtime_error( printSolverStatus( solveStatus ) );
+        }
+
+        // Store converged solution in cache.
+        if ( solutionCache != 0 && solveStatus == solverConverged && solverTransfer.isAvailable )
+        {
+            cachedSolution.departureVelocity = velocities.first;
+            cachedSolution.arrivalVelocity = velocities.second;
+            cachedSolution.departureTle = solverTransfer.departureTle;
+            cachedSolution.arrivalState = solverTransfer.arrivalState;
+            cachedSolution.finalResiduals = solverTransfer.finalResiduals;
+            cachedSolution.absoluteTolerance = absoluteTolerance;
+            solutionCache->insert( departurePosition,
+                                   departureEpoch,
+                                   arrivalPosition,
+                                   timeOfFlight,
+                                   cachedSolution );
+        }
+
+        return velocities;
+    }
+
+    //! Workspace for Atom solver.
+    SolverWorkspace atomWorkspace;
+
+    //! Workspace for nested Cartesian-to-TLE conversions.
+    SolverWorkspace tleWorkspace;
+
+    //! Statistics collected by last solve.
+    SolverStatistics< Real > solverStatistics;
+
+    //! Transfer found by last solve.
+    AtomTransfer< Real, Vector3 > solverTransfer;
+
+    //! SGP4/SDP4 propagator, allocated once for all solves executed by solver.
+    MemoizedSgp4Propagator propagator;
+};
+
 //! Execute Atom solver.
 template< typename Real, typename Vector3 >
 const std::pair< Vector3, Vector3 > executeAtomSolver(
@@ -179,9 +926,133 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
     const Real earthMeanRadius,
     const Real absoluteTolerance,
     const Real relativeTolerance,
-    const int maximumIterations )
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled )
+{
+    // Set up diagnostics policy to print solver status summary table.
+    SolverSummaryTable summary( printAtomSolverStateTableHeader( ) );
+
+    try
+    {
+        const std::pair< Vector3, Vector3 > velocities = executeAtomSolver(
+            departurePosition,
+            departureEpoch,
+            arrivalPosition,
+            timeOfFlight,
+            departureVelocityGuess,
+            summary,
+            numberOfIterations,
+            referenceTle,
+            earthGravitationalParameter,
+            earthMeanRadius,
+            absoluteTolerance,
+            relativeTolerance,
+            maximumIterations,
+            solverType,
+            isWarmStartEnabled );
+
+        // Write summary table to solver status summary string.
+        solverStatusSummary = summary.str( );
+
+        return velocities;
+    }
+    catch ( const std::runtime_error& )
+    {
+        std::cerr << "GSL solver status: " << summary.status( ) << std::endl;
+        std::cerr << summary.str( ) << std::endl;
+        std::cerr << std::endl;
+        solverStatusSummary = summary.str( );
+        throw;
+    }
+}
+
+//! Execute Atom solver.
+template< typename Real, typename Vector3, typename Diagnostics >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled )
+{
+    // Set up solver, allocating workspaces for Atom solver and nested Cartesian-to-TLE
+    // conversions.
+    AtomSolver< Real, Vector3 > solver( referenceTle,
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled );
+
+    return solver.solve( departurePosition,
+                         departureEpoch,
+                         arrivalPosition,
+                         timeOfFlight,
+                         departureVelocityGuess,
+                         diagnostics,
+                         numberOfIterations );
+}
+
+//! Execute Atom solver.
+template< typename Real, typename Vector3, typename Diagnostics >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    SolverWorkspace& atomWorkspace,
+    SolverWorkspace& tleWorkspace,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const bool isWarmStartEnabled,
+    SolverStatistics< Real >* statistics,
+    SolverStatus* status,
+    TleFitWarmStart< Real >* tleWarmStart,
+    TleConversionCache< Real >* tleCache,
+    AtomTransfer< Real, Vector3 >* transfer,
+    const SolverCancellation* cancellation,
+    MemoizedSgp4Propagator* propagator )
 {
-    // Set up parameters for residual function.
+    // Reset statistics and start timing solve.
+    double startTime = 0.0;
+    if ( statistics != 0 )
+    {
+        statistics->reset( );
+        startTime = getSolverClockTime( );
+    }
+
+    // Set up warm-start state for nested Cartesian-to-TLE conversions, unless it is carried over
+    // from previous solves.
+    TleFitWarmStart< Real > localTleWarmStart;
+    if ( tleWarmStart == 0 || !isWarmStartEnabled )
+    {
+        tleWarmStart = &localTleWarmStart;
+    }
+
+    // Set up parameters for residual function. The tolerances of the nested conversions are only
+    // adapted if the Jacobian of the Atom residual function is not computed using finite
+    // differences, since finite differences require the nested conversions to be converged
+    // tightly.
     AtomParameters< Real, Vector3 > parameters( departurePosition,
                                                 departureEpoch,
                                                 arrivalPosition,
@@ -191,123 +1062,233 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
                                                 referenceTle,
                                                 absoluteTolerance,
                                                 relativeTolerance,
-                                                maximumIterations );
-
-    // Set up residual function.
-    gsl_multiroot_function atomFunction
+                                                maximumIterations,
+                                                &tleWorkspace,
+                                                isWarmStartEnabled ? tleWarmStart : 0,
+                                                isWarmStartEnabled
+                                                && atomWorkspace.solverType == hybridsjSolver,
+                                                statistics,
+                                                tleCache,
+                                                cancellation,
+                                                propagator );
+
+    // Set up residual function and Jacobian functions (only used if solver requires Jacobian).
+    gsl_multiroot_function_fdf atomFunction
         = {
-            &computeAtomResiduals< Real, Vector3 >, 3, &parameters
+            &computeAtomResiduals< Real, Vector3 >,
+            &computeAtomJacobian< Real, Vector3 >,
+            &computeAtomResidualsAndJacobian< Real, Vector3 >,
+            3,
+            &parameters
           };
 
     // Set initial guess.
-    gsl_vector* initialGuess = gsl_vector_alloc( 3 );
+    gsl_vector* initialGuess = atomWorkspace.initialGuess;
     for ( int i = 0; i < 3; i++ )
     {
         gsl_vector_set( initialGuess, i, departureVelocityGuess[ i ] );
     }
 
-    // Set up solver type (derivative free).
-    const gsl_multiroot_fsolver_type* solverType = gsl_multiroot_fsolver_hybrids;
+    // Set solver allocated in workspace to use residual function with initial guess. This
+    // evaluates the residual function at the initial guess, which fails if the nested
+    // Cartesian-to-TLE conversion or the SGP4/SDP4 propagator fails.
+    int solverStatus = atomWorkspace.set( atomFunction );
 
-    // Allocate memory for solver.
-    gsl_multiroot_fsolver* solver = gsl_multiroot_fsolver_alloc( solverType, 3 );
+     // Declare iteration counter.
+    int counter = 0;
 
-    // Set solver to use residual function with initial guess.
-    gsl_multiroot_fsolver_set( solver, &atomFunction, initialGuess );
+    // Declare flag indicating if solver has been cancelled.
+    bool isCancelled = false;
 
-     // Declare current solver status and iteration counter.
-    int solverStatus = false;
-    int counter = 0;
+    if ( solverStatus == GSL_SUCCESS )
+    {
+        do
+        {
+            // Record current state of solver.
+            diagnostics.recordIteration(
+                counter, atomWorkspace.x( ), atomWorkspace.f( ), atomWorkspace.dx( ) );
+
+            // Check if solver has been cancelled; if it is cancelled, stop at current iterate.
+            if ( cancellation != 0 && cancellation->isCancelled( ) )
+            {
+                isCancelled = true;
+                break;
+            }
+
+            // Increment iteration counter.
+            ++counter;
+            // Execute solver iteration.
+            solverStatus = atomWorkspace.iterate( );
+
+            // Check if solver is stuck; if it is stuck, break from loop.
+            if ( solverStatus )
+            {
+                break;
+            }
+
+            // Check if root has been found (within tolerance).
+            solverStatus = gsl_multiroot_test_delta(
+              atomWorkspace.dx( ), atomWorkspace.x( ), absoluteTolerance, relativeTolerance );
+        } while ( solverStatus == GSL_CONTINUE && counter < maximumIterations );
+    }
 
-    // Set up buffer to store solver status summary table.
-    std::ostringstream summary;
+    // Save number of iterations.
+    numberOfIterations = ( counter > 0 ) ? counter - 1 : 0;
 
-    // Print header for summary table to buffer.
-    summary << printAtomSolverStateTableHeader( );
+    // Record final status of solver.
+    diagnostics.recordStatus( solverStatus );
+
+    // Determine status of solver.
+    SolverStatus atomStatus
+        = ( solverStatus == GSL_SUCCESS ) ? solverConverged
+        : ( isCancelled || parameters.isCancelled ) ? solverCancelled
+        : ( solverStatus == GSL_CONTINUE ) ? solverMaximumIterationsReached
+        : ( parameters.isPropagationFailed ) ? solverPropagationFailed
+        : ( parameters.isNestedConversionFailed ) ? solverNestedConversionFailed
+        : solverStuck;
+
+    // Store final departure velocity.
+    Vector3 departureVelocity = createVector< Vector3 >( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureVelocity[ i ] = gsl_vector_get( atomWorkspace.x( ), i );
+    }
 
-    do
+    // Set arrival velocity to NaN, such that it is undefined if it cannot be computed.
+    Vector3 arrivalVelocity = createVector< Vector3 >( 3 );
+    for ( int i = 0; i < 3; i++ )
     {
-        // Print current state of solver for summary table.
-        summary << printAtomSolverState( counter, solver );
+        arrivalVelocity[ i ] = std::numeric_limits< Real >::quiet_NaN( );
+    }
 
-        // Increment iteration counter.
-        ++counter;
-        // Execute solver iteration.
-        solverStatus = gsl_multiroot_fsolver_iterate( solver );
+    // Set converged transfer to the last evaluation of the residual function. The last evaluation
+    // is at the final departure velocity, unless it was rejected by the solver or was used to
+    // approximate the Jacobian using finite differences. If the solver was cancelled, the transfer
+    // is only set if it is available without executing another conversion.
+    Tle departureTle = parameters.lastDepartureTle;
+    Eci arrivalState = parameters.lastArrivalState;
+    bool isArrivalStateAvailable = false;
 
-        // Check if solver is stuck; if it is stuck, break from loop.
-        if ( solverStatus )
+    if ( ( !hasSolverFailed( atomStatus ) || atomStatus == solverCancelled )
+         && parameters.isLastEvaluationAt( atomWorkspace.x( ) ) )
+    {
+        isArrivalStateAvailable = true;
+    }
+    else if ( !hasSolverFailed( atomStatus ) )
+    {
+        // Set final departure velocity in preallocated departure state [km; km/s].
+        std::vector< Real >& departureState = parameters.departureState;
+        for ( int i = 0; i < 3; i++ )
         {
-            std::cerr << "GSL solver status: " << solverStatus << std::endl;
-            std::cerr << summary.str( ) << std::endl;
-            std::cerr << std::endl;
-            throw std::runtime_error( "ERROR: Non-linear solver is stuck!" );
+            departureState[ i + 3 ] = departureVelocity[ i ];
         }
 
-        // Check if root has been found (within tolerance).
-        solverStatus = gsl_multiroot_test_delta(
-          solver->dx, solver->x, absoluteTolerance, relativeTolerance );
-    } while ( solverStatus == GSL_CONTINUE && counter < maximumIterations );
+        // Convert departure state to TLE. If conversions are cached, the conversion of an earlier
+        // residual evaluation at the final departure velocity is reused.
+        NoSolverDiagnostics tleDiagnostics;
+        SolverStatistics< Real > tleStatistics;
+        SolverStatus tleStatus = solverConverged;
+        int dummyint = 0;
+        departureTle = convertCartesianStateToTwoLineElements< Real >(
+            departureState,
+            departureEpoch,
+            tleWorkspace,
+            *tleWarmStart,
+            tleDiagnostics,
+            dummyint,
+            referenceTle,
+            earthGravitationalParameter,
+            earthMeanRadius,
+            absoluteTolerance,
+            relativeTolerance,
+            maximumIterations,
+            ( statistics != 0 ) ? &tleStatistics : 0,
+            &tleStatus,
+            &parameters.propagator,
+            tleCache );
+
+        if ( statistics != 0 )
+        {
+            statistics->recordNestedConversion( tleStatistics );
+        }
 
-    // Save number of iterations.
-    numberOfIterations = counter - 1;
+        if ( hasSolverFailed( tleStatus ) )
+        {
+            atomStatus = ( tleStatus == solverPropagationFailed )
+                ? solverPropagationFailed : solverNestedConversionFailed;
+        }
+        else
+        {
+            // Propagate departure TLE by time-of-flight using SGP4 propagator.
+            try
+            {
+                const double conversionStartTime
+                    = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+                parameters.propagator.setTle( departureTle );
+                const double propagationStartTime
+                    = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+                arrivalState = parameters.propagator.findPosition( timeOfFlight );
+                if ( statistics != 0 )
+                {
+                    const double propagationEndTime = getSolverClockTime( );
+                    statistics->conversionTime += propagationStartTime - conversionStartTime;
+                    statistics->propagationTime += propagationEndTime - propagationStartTime;
+                }
+                isArrivalStateAvailable = true;
+            }
+            catch ( const std::runtime_error& )
+            {
+                atomStatus = solverPropagationFailed;
+            }
+        }
+    }
 
-    // Print final status of solver to buffer.
-    summary << std::endl;
-    summary << "Status of non-linear solver: " << gsl_strerror( solverStatus ) << std::endl;
-    summary << std::endl;
+    if ( isArrivalStateAvailable )
+    {
+        arrivalVelocity[ 0 ] = arrivalState.Velocity( ).x;
+        arrivalVelocity[ 1 ] = arrivalState.Velocity( ).y;
+        arrivalVelocity[ 2 ] = arrivalState.Velocity( ).z;
 
-    // Write buffer contents to solver status summary string.
-    solverStatusSummary = summary.str( );
+        if ( transfer != 0 )
+        {
+            transfer->departureTle = departureTle;
+            transfer->arrivalState = arrivalState;
+        }
+    }
 
-    // Store final departure velocity.
-    Vector3 departureVelocity( 3 );
-    for ( int i = 0; i < 3; i++ )
+    // Store final residuals of converged transfer.
+    if ( transfer != 0 )
     {
-        departureVelocity[ i ] = gsl_vector_get( solver->x, i );
+        transfer->isAvailable = isArrivalStateAvailable;
+        for ( int i = 0; i < 3; i++ )
+        {
+            transfer->finalResiduals[ i ] = gsl_vector_get( atomWorkspace.f( ), i );
+        }
     }
 
-    // Set departure state [km/s].
-    std::vector< Real > departureState( 6 );
-    for ( int i = 0; i < 3; i++ )
+    // Store remaining statistics. The time that is not spent in the residual function or in the
+    // final conversion is spent in the GSL solver.
+    if ( statistics != 0 )
     {
-        departureState[ i ] = departurePosition[ i ];
+        statistics->numberOfIterations = numberOfIterations;
+        statistics->finalResidualNorm = computeResidualNorm< Real >( atomWorkspace.f( ) );
+        statistics->totalTime = getSolverClockTime( ) - startTime;
+        statistics->solverTime
+            = statistics->totalTime - statistics->propagationTime - statistics->conversionTime;
     }
-    for ( int i = 0; i < 3; i++ )
+
+    // Return status of solver if it is requested, else throw if solver failed.
+    if ( status != 0 )
     {
-        departureState[ i + 3 ] = departureVelocity[ i ];
+        *status = atomStatus;
+    }
+    else if ( hasSolverFailed( atomStatus ) )
+    {
+        throw std::runtime_error( printSolverStatus( atomStatus ) );
     }
-
-    // Convert departure state to TLE.
-    std::string dummyString = "";
-    int dummyint = 0;
-    const Tle departureTle = convertCartesianStateToTwoLineElements< Real >(
-        departureState,
-        departureEpoch,
-        dummyString,
-        dummyint,
-        referenceTle,
-        earthGravitationalParameter,
-        earthMeanRadius,
-        absoluteTolerance,
-        relativeTolerance,
-        maximumIterations );
-
-    // Propagate departure TLE by time-of-flight using SGP4 propagator.
-    SGP4 sgp4( departureTle );
-    Eci arrivalState = sgp4.FindPosition( timeOfFlight );
-
-    Vector3 arrivalVelocity( 3 );
-    arrivalVelocity[ 0 ] = arrivalState.Velocity( ).x;
-    arrivalVelocity[ 1 ] = arrivalState.Velocity( ).y;
-    arrivalVelocity[ 2 ] = arrivalState.Velocity( ).z;
-
-    // Free up memory.
-    gsl_multiroot_fsolver_free( solver );
-    gsl_vector_free( initialGuess );
 
     // Return departure and arrival velocities.
-    return std::make_pair< Vector3, Vector3 >( departureVelocity, arrivalVelocity );
+    return std::make_pair( departureVelocity, arrivalVelocity );
 }
 
 //! Execute Atom solver.
@@ -319,103 +1300,277 @@ const std::pair< Vector3, Vector3 > executeAtomSolver(
     const Real timeOfFlight,
     const Vector3& departureVelocityGuess )
 {
-    std::string dummyString = "";
+    NoSolverDiagnostics diagnostics;
     int dummyint = 0;
     return executeAtomSolver( departurePosition,
                               departureEpoch,
                               arrivalPosition,
                               timeOfFlight,
                               departureVelocityGuess,
-                              dummyString,
+                              diagnostics,
                               dummyint );
 }
 
+//! Execute Atom solver.
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolver(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight )
+{
+    return executeAtomSolver(
+        departurePosition,
+        departureEpoch,
+        arrivalPosition,
+        timeOfFlight,
+        computeAtomDepartureVelocityGuess( departurePosition, arrivalPosition, timeOfFlight ) );
+}
+
+//! Compute initial guess for departure velocity used by Atom solver.
+template< typename Real, typename Vector3 >
+Vector3 computeAtomDepartureVelocityGuess( const Vector3& departurePosition,
+                                           const Vector3& arrivalPosition,
+                                           const Real timeOfFlight,
+                                           const Real earthGravitationalParameter )
+{
+    // The Lambert solver measures time in seconds, whereas the Atom time-of-flight is in minutes.
+    return computeLambertDepartureVelocityGuess(
+        departurePosition,
+        arrivalPosition,
+        timeOfFlight * kSECONDS_PER_DAY / kMINUTES_PER_DAY,
+        earthGravitationalParameter );
+}
+
 //! Compute residuals to execute Atom solver.
 template< typename Real, typename Vector3 >
 int computeAtomResiduals( const gsl_vector* independentVariables,
                           void* parameters,
                           gsl_vector* residuals )
 {
-    // Store parameters locally.
-    const Vector3 departurePosition = static_cast< AtomParameters< Real, Vector3 >* >(
-        parameters )->departurePosition;
+    // Access parameters by reference, to avoid copying them for every evaluation.
+    AtomParameters< Real, Vector3 >& atomParameters
+        = *static_cast< AtomParameters< Real, Vector3 >* >( parameters );
+
+    const DateTime& departureEpoch = atomParameters.departureEpoch;
+    const Vector3& targetPosition = atomParameters.targetPosition;
+    const Real timeOfFlight = atomParameters.timeOfFlight;
+    const Real earthMeanRadius = atomParameters.earthMeanRadius;
+    const Tle& referenceTle = atomParameters.referenceTle;
+    const Real absoluteTolerance = atomParameters.absoluteTolerance;
+    const Real relativeTolerance = atomParameters.relativeTolerance;
+    const int maximumIterations = atomParameters.maximumIterations;
+
+    // Invalidate last evaluation, which is only stored if this evaluation succeeds.
+    atomParameters.hasLastEvaluation = false;
+
+    // Set departure velocity in preallocated departure state [km; km/s]. The departure position
+    // is set once on construction of the parameters.
+    std::vector< Real >& departureState = atomParameters.departureState;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureState[ i + 3 ] = gsl_vector_get( independentVariables, i );
+    }
 
-    const DateTime departureEpoch
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->departureEpoch;
+    // Adapt absolute tolerance of nested conversion to residuals of previous evaluation, such that
+    // the nested conversion is only converged as tightly as needed by the Atom solver. The
+    // tolerance is bounded to ensure that the conversion remains accurate far from the root.
+    Real tleAbsoluteTolerance = absoluteTolerance;
+    if ( atomParameters.isTleToleranceAdaptive && atomParameters.lastResidualNorm > 0.0 )
+    {
+        tleAbsoluteTolerance
+            = std::max( absoluteTolerance,
+                        std::min( 1.0e-3 * atomParameters.lastResidualNorm, Real( 1.0e-6 ) ) );
+    }
 
-    const Vector3 targetPosition = static_cast< AtomParameters< Real, Vector3 >* >(
-        parameters )->targetPosition;
+    // Use workspace for nested solver owned by parameters if no workspace is given, such that no
+    // memory is allocated for an evaluation.
+    SolverWorkspace& tleWorkspace = ( atomParameters.tleWorkspace != 0 )
+                                    ? *atomParameters.tleWorkspace
+                                    : *atomParameters.localTleWorkspace;
+
+    // Fit departure TLE to departure state, warm-starting nested solver if it is enabled. The
+    // parameters of the nested conversion are set up once per solve and reference the
+    // preallocated departure state, such that the working TLE that holds the departure TLE is
+    // updated in place and no TLE is copied for every evaluation. The nested conversion reports
+    // failures through its status, which is translated to flags in the parameters below.
+    TleFitWarmStart< Real >* tleWarmStart = atomParameters.tleWarmStart;
+    SolverStatistics< Real >* statistics = atomParameters.statistics;
+    atomParameters.coldTleStart.hasElementOffsets = false;
+    NoSolverDiagnostics diagnostics;
+    int dummyint = 0;
+    const SolverStatus tleStatus
+        = fitTwoLineElements( atomParameters.tleParameters,
+                              departureEpoch,
+                              tleWorkspace,
+                              ( tleWarmStart != 0 ) ? *tleWarmStart : atomParameters.coldTleStart,
+                              diagnostics,
+                              dummyint,
+                              referenceTle,
+                              tleAbsoluteTolerance,
+                              relativeTolerance,
+                              maximumIterations,
+                              atomParameters.tleCache,
+                              atomParameters.cancellation );
+    const Tle& departureTle = atomParameters.tleParameters.workingTle;
+    if ( statistics != 0 )
+    {
+        ++statistics->numberOfResidualEvaluations;
+        statistics->recordNestedConversion( atomParameters.tleStatistics );
+    }
 
-    const Real timeOfFlight
-        = static_cast< AtomParameters< Real, Vector3 >* >(
-            parameters )->timeOfFlight;
+    // Flag failure of nested conversion and report it to the GSL solver, which stops iterating.
+    if ( hasSolverFailed( tleStatus ) )
+    {
+        if ( tleStatus == solverPropagationFailed )
+        {
+            atomParameters.isPropagationFailed = true;
+        }
+        else if ( tleStatus == solverCancelled )
+        {
+            atomParameters.isCancelled = true;
+        }
+        else
+        {
+            atomParameters.isNestedConversionFailed = true;
+        }
+        return GSL_EFAILED;
+    }
 
-    const Real earthGravitationalParameter
-        = static_cast< AtomParameters< Real, Vector3 >* >(
-            parameters )->earthGravitationalParameter;
+    // Propagate departure TLE by time-of-flight using SGP4 propagator. The propagator is shared
+    // with the nested conversion, such that it is not re-initialized if the last evaluation of the
+    // nested residual function was at the converged TLE. If the departure TLE cannot be
+    // initialized or decays before arrival, the runtime error thrown by the propagator is caught
+    // and the evaluation is flagged as a propagation failure.
+    try
+    {
+        const double conversionStartTime = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+        atomParameters.propagator.setTle( departureTle );
+        const double propagationStartTime = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+        Eci arrivalState = atomParameters.propagator.findPosition( timeOfFlight );
+        if ( statistics != 0 )
+        {
+            const double propagationEndTime = getSolverClockTime( );
+            statistics->conversionTime += propagationStartTime - conversionStartTime;
+            statistics->propagationTime += propagationEndTime - propagationStartTime;
+        }
 
-    const Real earthMeanRadius
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->earthMeanRadius;
+        // Evaluate system of non-linear equations and store residuals.
+        gsl_vector_set( residuals, 0,
+                        ( arrivalState.Position( ).x - targetPosition[ 0 ] ) / earthMeanRadius );
+        gsl_vector_set( residuals, 1,
+                        ( arrivalState.Position( ).y - targetPosition[ 1 ] ) / earthMeanRadius );
+        gsl_vector_set( residuals, 2,
+                        ( arrivalState.Position( ).z - targetPosition[ 2 ] ) / earthMeanRadius );
+
+        // Store departure TLE and arrival state, such that they are not recomputed if the solver
+        // converges at this evaluation.
+        atomParameters.lastDepartureTle = departureTle;
+        atomParameters.lastArrivalState = arrivalState;
+    }
+    catch ( const std::runtime_error& )
+    {
+        atomParameters.isPropagationFailed = true;
+        return GSL_EFAILED;
+    }
 
-    const Tle referenceTle
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->referenceTle;
+    for ( int i = 0; i < 3; i++ )
+    {
+        atomParameters.lastDepartureVelocity[ i ] = departureState[ i + 3 ];
+    }
+    atomParameters.lastTleAbsoluteTolerance = tleAbsoluteTolerance;
+    atomParameters.hasLastEvaluation = true;
 
-    const Real absoluteTolerance
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->absoluteTolerance;
+    // Store norm of residuals to adapt tolerance of next nested conversion.
+    atomParameters.lastResidualNorm = computeResidualNorm< Real >( residuals );
 
-    const Real relativeTolerance
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->relativeTolerance;
+    return GSL_SUCCESS;
+}
 
-    const int maximumIterations
-        = static_cast< AtomParameters< Real, Vector3 >* >( parameters )->maximumIterations;
+//! Compute Jacobian to execute Atom solver.
+template< typename Real, typename Vector3 >
+int computeAtomJacobian( const gsl_vector* independentVariables,
+                         void* parameters,
+                         gsl_matrix* jacobian )
+{
+    const AtomParameters< Real, Vector3 >& atomParameters
+        = *static_cast< AtomParameters< Real, Vector3 >* >( parameters );
 
-    // Set Departure state [km; km/s].
-    std::vector< Real > departureVelocity( 3 );
-    for ( int i = 0; i < 3; i++ )
+    if ( atomParameters.statistics != 0 )
     {
-        departureVelocity[ i ] = gsl_vector_get( independentVariables, i );
+        ++atomParameters.statistics->numberOfJacobianEvaluations;
     }
 
-    std::vector< Real > departureState( 6 );
+    Real departurePosition[ 3 ];
+    Real departureVelocity[ 3 ];
     for ( int i = 0; i < 3; i++ )
     {
-        departureState[ i ] = departurePosition[ i ];
+        departurePosition[ i ] = atomParameters.departurePosition[ i ];
+        departureVelocity[ i ] = gsl_vector_get( independentVariables, i );
     }
-    for ( int i = 0; i < 3; i++ )
+
+    Real forwardPosition[ 3 ];
+    Real backwardPosition[ 3 ];
+    Real dummyVelocity[ 3 ];
+
+    // The two-body propagator measures time in seconds, whereas the time-of-flight of the Atom
+    // problem is given in minutes, as required by the SGP4/SDP4 propagator.
+    const Real timeOfFlight = atomParameters.timeOfFlight * kSECONDS_PER_DAY / kMINUTES_PER_DAY;
+
+    // Compute partial derivatives of two-body arrival position with respect to departure velocity,
+    // using central differences.
+    for ( int j = 0; j < 3; j++ )
     {
-        departureState[ i + 3 ] = departureVelocity[ i ];
+        const Real velocityStep
+            = 1.0e-6 * std::max( std::fabs( departureVelocity[ j ] ), Real( 1.0 ) );
+
+        departureVelocity[ j ] += velocityStep;
+        propagateTwoBodyState( departurePosition,
+                               departureVelocity,
+                               timeOfFlight,
+                               atomParameters.earthGravitationalParameter,
+                               forwardPosition,
+                               dummyVelocity );
+
+        departureVelocity[ j ] -= 2.0 * velocityStep;
+        propagateTwoBodyState( departurePosition,
+                               departureVelocity,
+                               timeOfFlight,
+                               atomParameters.earthGravitationalParameter,
+                               backwardPosition,
+                               dummyVelocity );
+
+        departureVelocity[ j ] += velocityStep;
+
+        // Scale partial derivatives in the same way as the residuals.
+        for ( int i = 0; i < 3; i++ )
+        {
+            gsl_matrix_set( jacobian, i, j,
+                            ( forwardPosition[ i ] - backwardPosition[ i ] )
+                            / ( 2.0 * velocityStep * atomParameters.earthMeanRadius ) );
+        }
     }
 
-    // Convert departure state to TLE.
-    std::string dummyString = "";
-    int dummyint = 0;
-    const Tle departureTle = convertCartesianStateToTwoLineElements(
-        departureState,
-        departureEpoch,
-        dummyString,
-        dummyint,
-        referenceTle,
-        earthGravitationalParameter,
-        earthMeanRadius,
-        absoluteTolerance,
-        relativeTolerance,
-        maximumIterations );
-
-    // Propagate departure TLE by time-of-flight using SGP4 propagator.
-    SGP4 sgp4( departureTle );
-    Eci arrivalState = sgp4.FindPosition( timeOfFlight );
-
-    // Evaluate system of non-linear equations and store residuals.
-    gsl_vector_set( residuals, 0,
-                    ( arrivalState.Position( ).x - targetPosition[ 0 ] ) / earthMeanRadius );
-    gsl_vector_set( residuals, 1,
-                    ( arrivalState.Position( ).y - targetPosition[ 1 ] ) / earthMeanRadius );
-    gsl_vector_set( residuals, 2,
-                    ( arrivalState.Position( ).z - targetPosition[ 2 ] ) / earthMeanRadius );
-
     return GSL_SUCCESS;
 }
 
+//! Compute residuals and Jacobian to execute Atom solver.
+template< typename Real, typename Vector3 >
+int computeAtomResidualsAndJacobian( const gsl_vector* independentVariables,
+                                     void* parameters,
+                                     gsl_vector* residuals,
+                                     gsl_matrix* jacobian )
+{
+    const int residualStatus
+        = computeAtomResiduals< Real, Vector3 >( independentVariables, parameters, residuals );
+    if ( residualStatus != GSL_SUCCESS )
+    {
+        return residualStatus;
+    }
+
+    return computeAtomJacobian< Real, Vector3 >( independentVariables, parameters, jacobian );
+}
+
 //! Parameter struct used by Atom residual function.
 template< typename Real, typename Vector3 >
 struct AtomParameters
@@ -429,13 +1584,35 @@ public:
      * @param aDeparturePosition            Cartesian departure position [km]
      * @param aDepartureEpoch               Modified Julian Date (MJD) of departure
      * @param aTargetPosition               Target Cartesian position [km]
-     * @param aTimeOfFlight                 Time-of-Flight (TOF) [s]
+     * @param aTimeOfFlight                 Time-of-Flight (TOF) [min]
      * @param anEarthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
      * @param anEarthMeanRadius             Earth mean radius [km]
      * @param aReferenceTle                 Reference Two-Line-Elements
      * @param anAbsoluteTolerance           Absolute tolerance used to check for convergence
      * @param aRelativeTolerance            Relative tolerance used to check for convergence
      * @param someMaximumIterations         Maximum number of solver iterations permitted
+     * @param aTleWorkspace                 Workspace reused for nested Cartesian-to-TLE
+     *                                      conversions; if it is not set, a workspace owned by the
+     *                                      parameters is allocated on construction [default: 0]
+     * @param aTleWarmStart                 Warm-start state for nested Cartesian-to-TLE
+     *                                      conversions; if it is not set, or if the workspace is
+     *                                      not set, every conversion is started cold [default: 0]
+     * @param anIsTleToleranceAdaptive      Flag indicating if the absolute tolerance of nested
+     *                                      Cartesian-to-TLE conversions is adapted to the
+     *                                      residuals of the previous evaluation [default: false]
+     * @param someStatistics                Statistics updated by residual function and Jacobian;
+     *                                      if it is not set, no statistics are collected
+     *                                      [default: 0]
+     * @param aTleCache                     Cache of converged nested Cartesian-to-TLE conversions;
+     *                                      if it is not set, no conversions are cached
+     *                                      [default: 0]
+     * @param aCancellation                 Cancellation token checked by nested Cartesian-to-TLE
+     *                                      conversions; if it is not set, the conversions cannot
+     *                                      be cancelled [default: 0]
+     * @param aPropagator                   SGP4/SDP4 propagator shared by residual function and
+     *                                      nested Cartesian-to-TLE conversions, which may be
+     *                                      reused by many solves; if it is not set, the propagator
+     *                                      owned by the parameters is used [default: 0]
      */
     AtomParameters(
         const Vector3& aDeparturePosition,
@@ -447,7 +1624,14 @@ public:
         const Tle& aReferenceTle,
         const Real anAbsoluteTolerance,
         const Real aRelativeTolerance,
-        const int someMaximumIterations )
+        const int someMaximumIterations,
+        SolverWorkspace* aTleWorkspace = 0,
+        TleFitWarmStart< Real >* aTleWarmStart = 0,
+        const bool anIsTleToleranceAdaptive = false,
+        SolverStatistics< Real >* someStatistics = 0,
+        TleConversionCache< Real >* aTleCache = 0,
+        const SolverCancellation* aCancellation = 0,
+        MemoizedSgp4Propagator* aPropagator = 0 )
         : departurePosition( aDeparturePosition ),
           departureEpoch( aDepartureEpoch ),
           targetPosition( aTargetPosition ),
@@ -457,8 +1641,40 @@ public:
           referenceTle( aReferenceTle ),
           absoluteTolerance( anAbsoluteTolerance ),
           relativeTolerance( aRelativeTolerance ),
-          maximumIterations( someMaximumIterations )
-    { }
+          maximumIterations( someMaximumIterations ),
+          tleWorkspace( aTleWorkspace ),
+          tleWarmStart( aTleWarmStart ),
+          isTleToleranceAdaptive( anIsTleToleranceAdaptive ),
+          statistics( someStatistics ),
+          tleCache( aTleCache ),
+          cancellation( aCancellation ),
+          isPropagationFailed( false ),
+          isNestedConversionFailed( false ),
+          isCancelled( false ),
+          lastResidualNorm( -1.0 ),
+          departureState( 6 ),
+          localTleWorkspace( ( aTleWorkspace == 0 ) ? new SolverWorkspace( 6 ) : 0 ),
+          coldTleStart( ),
+          localPropagator( ),
+          propagator( ( aPropagator != 0 ) ? *aPropagator : localPropagator ),
+          tleStatistics( ),
+          tleParameters( departureState,
+                         anEarthGravitationalParameter,
+                         anEarthMeanRadius,
+                         aReferenceTle,
+                         ( someStatistics != 0 ) ? &tleStatistics : 0,
+                         &propagator ),
+          hasLastEvaluation( false ),
+          lastDepartureVelocity( createVector< Vector3 >( 3 ) ),
+          lastTleAbsoluteTolerance( 0.0 ),
+          lastDepartureTle( ),
+          lastArrivalState( DateTime( ), Vector( ), Vector( ) )
+    {
+        for ( int i = 0; i < 3; i++ )
+        {
+            departureState[ i ] = aDeparturePosition[ i ];
+        }
+    }
 
     //! Departure position in Cartesian elements [km].
     const Vector3 departurePosition;
@@ -469,7 +1685,7 @@ public:
     //! Target position in Cartesian elements [km].
     const Vector3 targetPosition;
 
-    //! Time-of-Flight (TOF) [s].
+    //! Time-of-Flight (TOF) [min].
     const Real timeOfFlight;
 
     //! Earth gravitational parameter [km^3 s^-2].
@@ -490,11 +1706,210 @@ public:
     //! Maximum number of iterations.
     const int maximumIterations;
 
+    //! Workspace for nested Cartesian-to-TLE conversions.
+    SolverWorkspace* const tleWorkspace;
+
+    //! Warm-start state for nested Cartesian-to-TLE conversions.
+    TleFitWarmStart< Real >* const tleWarmStart;
+
+    //! Flag indicating if tolerance of nested Cartesian-to-TLE conversions is adaptive.
+    const bool isTleToleranceAdaptive;
+
+    //! Statistics collected by residual function and Jacobian.
+    SolverStatistics< Real >* const statistics;
+
+    //! Cache of converged nested Cartesian-to-TLE conversions.
+    TleConversionCache< Real >* const tleCache;
+
+    //! Cancellation token checked by nested Cartesian-to-TLE conversions.
+    const SolverCancellation* const cancellation;
+
+    //! Flag indicating if the SGP4/SDP4 propagator failed during an evaluation.
+    bool isPropagationFailed;
+
+    //! Flag indicating if a nested Cartesian-to-TLE conversion failed during an evaluation.
+    bool isNestedConversionFailed;
+
+    //! Flag indicating if a nested Cartesian-to-TLE conversion was cancelled during an evaluation.
+    bool isCancelled;
+
+    //! Norm of residuals computed by last evaluation of residual function (negative if unset).
+    Real lastResidualNorm;
+
+    //! Departure state preallocated for residual function [km; km/s].
+    std::vector< Real > departureState;
+
+    //! Workspace for nested Cartesian-to-TLE conversions owned by parameters, allocated once if no
+    //! workspace is given.
+    std::unique_ptr< SolverWorkspace > localTleWorkspace;
+
+    //! Warm-start state used to start nested Cartesian-to-TLE conversions cold, if no warm-start
+    //! state is given. It is reset before every conversion.
+    TleFitWarmStart< Real > coldTleStart;
+
+    //! SGP4/SDP4 propagator owned by parameters, used if no propagator is given.
+    MemoizedSgp4Propagator localPropagator;
+
+    //! SGP4/SDP4 propagator shared by residual function and nested Cartesian-to-TLE conversions,
+    //! such that the converged TLE of a nested conversion is propagated without re-initializing
+    //! the propagator.
+    MemoizedSgp4Propagator& propagator;
+
+    //! Statistics collected by last nested Cartesian-to-TLE conversion.
+    SolverStatistics< Real > tleStatistics;
+
+    //! Parameters of nested Cartesian-to-TLE conversions, referencing the departure state. Their
+    //! working TLE holds the departure TLE found by the last nested conversion.
+    CartesianToTwoLineElementsParameters< Real, std::vector< Real > > tleParameters;
+
+    //! Check if last evaluation of residual function can be reused for departure velocity.
+    /*!
+     * Checks if the last evaluation of the residual function succeeded at the given departure
+     * velocity, with a nested conversion converged to the absolute tolerance of the solver.
+     * @param  departureVelocity Departure velocity [km/s]
+     * @return                   Flag indicating if last evaluation can be reused
+     */
+    bool isLastEvaluationAt( const gsl_vector* departureVelocity ) const
+    {
+        if ( !hasLastEvaluation || lastTleAbsoluteTolerance > absoluteTolerance )
+        {
+            return false;
+        }
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            if ( gsl_vector_get( departureVelocity, i ) != lastDepartureVelocity[ i ] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //! Flag indicating if last evaluation of residual function succeeded.
+    bool hasLastEvaluation;
+
+    //! Departure velocity of last evaluation of residual function [km/s].
+    Vector3 lastDepartureVelocity;
+
+    //! Absolute tolerance of nested conversion of last evaluation of residual function.
+    Real lastTleAbsoluteTolerance;
+
+    //! Departure TLE found by nested conversion of last evaluation of residual function.
+    Tle lastDepartureTle;
+
+    //! Arrival state computed by last evaluation of residual function.
+    Eci lastArrivalState;
+
 protected:
 
 private:
 };
 
+//! Converged transfer computed by Atom solver.
+template< typename Real, typename Vector3 >
+struct AtomTransfer
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up transfer that is not available, with final residuals set to
+     * NaN.
+     */
+    AtomTransfer( )
+        : isAvailable( false ),
+          departureTle( ),
+          arrivalState( DateTime( ), Vector( ), Vector( ) ),
+          finalResiduals( createVector< Vector3 >( 3 ) )
+    {
+        for ( int i = 0; i < 3; i++ )
+        {
+            finalResiduals[ i ] = std::numeric_limits< Real >::quiet_NaN( );
+        }
+    }
+
+    //! Flag indicating if departure TLE and arrival state have been computed.
+    bool isAvailable;
+
+    //! TLE of departure state, found by nested Cartesian-to-TLE conversion.
+    Tle departureTle;
+
+    //! Arrival state, computed by propagating departure TLE by time-of-flight [km; km/s].
+    Eci arrivalState;
+
+    //! Final residuals of Atom solver [-].
+    Vector3 finalResiduals;
+
+protected:
+
+private:
+};
+
+#ifdef ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
+//! Declare explicit instantiations of Atom solver for Real set to double and given vector type.
+/*!
+ * Declares explicit instantiations of the Atom solver, its solver class and its residual functions
+ * for Real set to double and the given type for 3-vector of reals.
+ *
+ * @sa precompiledInstantiations.hpp
+ */
+#define ATOM_EXTERN_ATOM_SOLVER_TEMPLATES( ... )                                                   \
+    ATOM_EXTERN_TEMPLATE class AtomSolver< double, __VA_ARGS__ >;                                  \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ > executeAtomSolver(            \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__&, std::string&, int&, const Tle&, const double, const double,            \
+        const double, const double, const int, const SolverType, const bool );                     \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ > executeAtomSolver(            \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__& );                                                                      \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ > executeAtomSolver(            \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double );                   \
+    ATOM_EXTERN_TEMPLATE __VA_ARGS__ computeAtomDepartureVelocityGuess(                            \
+        const __VA_ARGS__&, const __VA_ARGS__&, const double, const double );                      \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ >                               \
+    executeAtomSolver< double, __VA_ARGS__, NoSolverDiagnostics >(                                 \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__&, NoSolverDiagnostics&, int&, const Tle&, const double, const double,    \
+        const double, const double, const int, const SolverType, const bool );                     \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ >                               \
+    executeAtomSolver< double, __VA_ARGS__, SolverSummaryTable >(                                  \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__&, SolverSummaryTable&, int&, const Tle&, const double, const double,     \
+        const double, const double, const int, const SolverType, const bool );                     \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ >                               \
+    executeAtomSolver< double, __VA_ARGS__, NoSolverDiagnostics >(                                 \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__&, SolverWorkspace&, SolverWorkspace&, NoSolverDiagnostics&, int&,        \
+        const Tle&, const double, const double, const double, const double, const int, const bool, \
+        SolverStatistics< double >*, SolverStatus*, TleFitWarmStart< double >*,                    \
+        TleConversionCache< double >*, AtomTransfer< double, __VA_ARGS__ >*,                       \
+        const SolverCancellation*, MemoizedSgp4Propagator* );                                      \
+    ATOM_EXTERN_TEMPLATE const std::pair< __VA_ARGS__, __VA_ARGS__ >                               \
+    executeAtomSolver< double, __VA_ARGS__, SolverSummaryTable >(                                  \
+        const __VA_ARGS__&, const DateTime&, const __VA_ARGS__&, const double,                     \
+        const __VA_ARGS__&, SolverWorkspace&, SolverWorkspace&, SolverSummaryTable&, int&,         \
+        const Tle&, const double, const double, const double, const double, const int, const bool, \
+        SolverStatistics< double >*, SolverStatus*, TleFitWarmStart< double >*,                    \
+        TleConversionCache< double >*, AtomTransfer< double, __VA_ARGS__ >*,                       \
+        const SolverCancellation*, MemoizedSgp4Propagator* );                                      \
+    ATOM_EXTERN_TEMPLATE int computeAtomResiduals< double, __VA_ARGS__ >(                          \
+        const gsl_vector*, void*, gsl_vector* );                                                   \
+    ATOM_EXTERN_TEMPLATE int computeAtomJacobian< double, __VA_ARGS__ >(                           \
+        const gsl_vector*, void*, gsl_matrix* );                                                   \
+    ATOM_EXTERN_TEMPLATE int computeAtomResidualsAndJacobian< double, __VA_ARGS__ >(               \
+        const gsl_vector*, void*, gsl_vector*, gsl_matrix* );
+
+ATOM_EXTERN_ATOM_SOLVER_TEMPLATES( std::vector< double > )
+ATOM_EXTERN_ATOM_SOLVER_TEMPLATES( std::array< double, 3 > )
+#ifdef ATOM_USE_PRECOMPILED_EIGEN_INSTANTIATIONS
+ATOM_EXTERN_ATOM_SOLVER_TEMPLATES( Eigen::Vector3d )
+#endif
+
+#endif // ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
 } // namespace atom
 
 #endif // ATOM_SOLVER_H
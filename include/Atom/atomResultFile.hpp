@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_RESULT_FILE_H
+#define ATOM_RESULT_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/memoryMappedFile.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/vectorTraits.hpp"
+
+namespace atom
+{
+
+//! Columns of Atom result file.
+/*!
+ * Columns stored in an Atom result file. Each column holds one value per record, stored
+ * contiguously for all records, such that a single quantity is read for a batch without reading
+ * the other quantities. The departure TLE is stored as its epoch and six mean elements, in the
+ * units used by the TLE. The trace column holds a fixed number of iterations per record, each
+ * stored as the independent variables, residuals and step of the solver (nine values).
+ *
+ * @sa AtomResultWriter, AtomResultReader
+ */
+enum AtomResultColumn
+{
+    //! Departure velocity along x-axis [km/s] (double).
+    departureVelocityXColumn,
+
+    //! Departure velocity along y-axis [km/s] (double).
+    departureVelocityYColumn,
+
+    //! Departure velocity along z-axis [km/s] (double).
+    departureVelocityZColumn,
+
+    //! Arrival velocity along x-axis [km/s] (double).
+    arrivalVelocityXColumn,
+
+    //! Arrival velocity along y-axis [km/s] (double).
+    arrivalVelocityYColumn,
+
+    //! Arrival velocity along z-axis [km/s] (double).
+    arrivalVelocityZColumn,
+
+    //! Change in velocity at departure [km/s] (double; NaN if not set).
+    departureDeltaVColumn,
+
+    //! Change in velocity at arrival [km/s] (double; NaN if not set).
+    arrivalDeltaVColumn,
+
+    //! Epoch of departure TLE [ticks] (int64; zero if TLE is not available).
+    departureTleEpochColumn,
+
+    //! Mean inclination of departure TLE [deg] (double).
+    departureTleInclinationColumn,
+
+    //! Mean right ascending node of departure TLE [deg] (double).
+    departureTleRightAscendingNodeColumn,
+
+    //! Mean eccentricity of departure TLE [-] (double).
+    departureTleEccentricityColumn,
+
+    //! Mean argument of perigee of departure TLE [deg] (double).
+    departureTleArgumentPerigeeColumn,
+
+    //! Mean mean anomaly of departure TLE [deg] (double).
+    departureTleMeanAnomalyColumn,
+
+    //! Mean motion of departure TLE [rev/day] (double).
+    departureTleMeanMotionColumn,
+
+    //! Per-iteration trace of solver (double; nine values per stored iteration).
+    traceColumn,
+
+    //! Number of iterations completed by solver (int32).
+    numberOfIterationsColumn,
+
+    //! Status of solver (int32; SolverStatus).
+    statusColumn,
+
+    //! GSL flag indicating status of solver (int32).
+    solverStatusColumn,
+
+    //! Number of iterations stored in trace (int32).
+    traceLengthColumn,
+
+    //! Flag indicating if record has been written (uint8).
+    isWrittenColumn,
+
+    //! Number of columns.
+    numberOfAtomResultColumns
+};
+
+//! Header of Atom result file.
+/*!
+ * Data structure stored at the start of an Atom result file, holding the layout of the columns.
+ * Integers are stored in the byte order of the machine that wrote the file. The reader checks the
+ * byte-order mark and rejects files written with a different byte order.
+ *
+ * @sa AtomResultWriter, AtomResultReader
+ */
+struct AtomResultFileHeader;
+
+//! Get size of value stored per record in column of Atom result file.
+/*!
+ * Returns the size of the value stored per record in a given column of an Atom result file.
+ *
+ * @sa AtomResultColumn
+ * @param  column        Column of result file
+ * @param  traceCapacity Maximum number of iterations stored in trace per record
+ * @return               Size of value stored per record [bytes]
+ */
+inline std::size_t getAtomResultColumnRecordSize( const AtomResultColumn column,
+                                                  const std::size_t traceCapacity );
+
+//! Set layout of Atom result file.
+/*!
+ * Sets the header of an Atom result file for a given number of records, computing the offsets of
+ * the columns, which are aligned to 8 bytes.
+ *
+ * @sa AtomResultFileHeader
+ * @param  numberOfRecords Number of records stored in file
+ * @param  traceCapacity   Maximum number of iterations stored in trace per record
+ * @param  header          Header of result file
+ * @return                 Size of result file [bytes]
+ */
+inline std::size_t setAtomResultFileLayout( const std::size_t numberOfRecords,
+                                            const std::size_t traceCapacity,
+                                            AtomResultFileHeader& header );
+
+//! Writer of Atom result file.
+/*!
+ * Writer that stores solutions computed by the Atom solver in a compact, columnar binary file,
+ * which is memory-mapped, such that solutions are written in place without buffered I/O. The file
+ * is created for a fixed number of records when the writer is constructed, and every record is
+ * addressed by its index, e.g., the index of the problem in a batch.
+ *
+ * Records with different indices can be written concurrently by different threads without
+ * synchronization. Records that are not written are flagged as such in the file. The file is
+ * complete once the writer is destroyed, or once flush is called.
+ *
+ * @sa AtomResultReader, AtomResultColumn, executeAtomSolverBatch
+ */
+class AtomResultWriter;
+
+//! Reader of Atom result file.
+/*!
+ * Reader that maps an Atom result file for reading. Single records are read into Atom solutions,
+ * and whole columns are accessed in place as contiguous arrays.
+ *
+ * @sa AtomResultWriter, AtomResultColumn
+ */
+class AtomResultReader;
+
+//! Get size of value stored per record in column of Atom result file.
+inline std::size_t getAtomResultColumnRecordSize( const AtomResultColumn column,
+                                                  const std::size_t traceCapacity )
+{
+    if ( column == traceColumn )
+    {
+        return 9 * traceCapacity * sizeof( double );
+    }
+
+    if ( column == departureTleEpochColumn )
+    {
+        return sizeof( std::int64_t );
+    }
+
+    if ( column == isWrittenColumn )
+    {
+        return sizeof( std::uint8_t );
+    }
+
+    if ( column >= numberOfIterationsColumn )
+    {
+        return sizeof( std::int32_t );
+    }
+
+    return sizeof( double );
+}
+
+//! Header of Atom result file.
+struct AtomResultFileHeader
+{
+public:
+
+    //! Identifier of file format.
+    char magic[ 8 ];
+
+    //! Byte-order mark, set to 0x01020304 by the writer.
+    std::uint32_t byteOrderMark;
+
+    //! Version of file format.
+    std::uint32_t version;
+
+    //! Number of records stored in file.
+    std::uint64_t numberOfRecords;
+
+    //! Maximum number of iterations stored in trace per record.
+    std::uint64_t traceCapacity;
+
+    //! Offsets of columns from start of file [bytes].
+    std::uint64_t columnOffsets[ numberOfAtomResultColumns ];
+
+protected:
+
+private:
+};
+
+//! Set layout of Atom result file.
+inline std::size_t setAtomResultFileLayout( const std::size_t numberOfRecords,
+                                            const std::size_t traceCapacity,
+                                            AtomResultFileHeader& header )
+{
+    std::memset( &header, 0, sizeof( AtomResultFileHeader ) );
+    std::memcpy( header.magic, "ATOMRES", 8 );
+    header.byteOrderMark = 0x01020304;
+    header.version = 1;
+    header.numberOfRecords = numberOfRecords;
+    header.traceCapacity = traceCapacity;
+
+    std::size_t offset = ( sizeof( AtomResultFileHeader ) + 7 ) / 8 * 8;
+    for ( int i = 0; i < numberOfAtomResultColumns; i++ )
+    {
+        header.columnOffsets[ i ] = offset;
+        offset += getAtomResultColumnRecordSize( static_cast< AtomResultColumn >( i ),
+                                                 traceCapacity ) * numberOfRecords;
+        offset = ( offset + 7 ) / 8 * 8;
+    }
+
+    return offset;
+}
+
+//! Writer of Atom result file.
+class AtomResultWriter
+{
+public:
+
+    //! Constructor that creates result file.
+    /*!
+     * Constructor that creates a result file for a given number of records, truncating any
+     * existing file with the same name. If the trace capacity is set, up to that number of
+     * iterations of the solver are stored per record.
+     *
+     * @throws std::runtime_error If the file cannot be created or mapped
+     * @param  fileName          Name of result file
+     * @param  aNumberOfRecords  Number of records stored in file
+     * @param  aTraceCapacity    Maximum number of iterations stored in trace per record
+     *                           [default: 0]
+     */
+    AtomResultWriter( const std::string& fileName,
+                      const std::size_t aNumberOfRecords,
+                      const std::size_t aTraceCapacity = 0 )
+        : header( ),
+          file( fileName, setAtomResultFileLayout( aNumberOfRecords, aTraceCapacity, header ) )
+    {
+        std::memcpy( file.data( ), &header, sizeof( AtomResultFileHeader ) );
+    }
+
+    //! Write solution to record.
+    /*!
+     * Writes a solution computed by the Atom solver to the record with the given index. The
+     * departure TLE is written if the converged transfer is available. If the iteration trace is
+     * set, the first iterations stored in the trace are written, up to the trace capacity.
+     *
+     * @throws std::runtime_error If the index is out of range
+     * @tparam Real            Type for reals
+     * @tparam Vector3         Type for 3-vector of reals
+     * @param  index           Index of record
+     * @param  solution        Solution computed by Atom solver
+     * @param  departureDeltaV Change in velocity at departure [km/s] [default: NaN]
+     * @param  arrivalDeltaV   Change in velocity at arrival [km/s] [default: NaN]
+     * @param  trace           Iteration trace of solver [default: 0]
+     */
+    template< typename Real, typename Vector3 >
+    void write( const std::size_t index,
+                const AtomSolution< Real, Vector3 >& solution,
+                const Real departureDeltaV = std::numeric_limits< Real >::quiet_NaN( ),
+                const Real arrivalDeltaV = std::numeric_limits< Real >::quiet_NaN( ),
+                const SolverIterationTrace< Real >* trace = 0 )
+    {
+        if ( index >= header.numberOfRecords )
+        {
+            throw std::runtime_error( "ERROR: Index of record of result file is out of range!" );
+        }
+
+        column< double >( departureVelocityXColumn )[ index ] = solution.departureVelocity[ 0 ];
+        column< double >( departureVelocityYColumn )[ index ] = solution.departureVelocity[ 1 ];
+        column< double >( departureVelocityZColumn )[ index ] = solution.departureVelocity[ 2 ];
+        column< double >( arrivalVelocityXColumn )[ index ] = solution.arrivalVelocity[ 0 ];
+        column< double >( arrivalVelocityYColumn )[ index ] = solution.arrivalVelocity[ 1 ];
+        column< double >( arrivalVelocityZColumn )[ index ] = solution.arrivalVelocity[ 2 ];
+        column< double >( departureDeltaVColumn )[ index ] = departureDeltaV;
+        column< double >( arrivalDeltaVColumn )[ index ] = arrivalDeltaV;
+
+        const double nan = std::numeric_limits< double >::quiet_NaN( );
+        const Tle& tle = solution.transfer.departureTle;
+        const bool isTleAvailable = solution.transfer.isAvailable;
+        column< std::int64_t >( departureTleEpochColumn )[ index ]
+            = isTleAvailable ? tle.Epoch( ).Ticks( ) : 0;
+        column< double >( departureTleInclinationColumn )[ index ]
+            = isTleAvailable ? tle.Inclination( true ) : nan;
+        column< double >( departureTleRightAscendingNodeColumn )[ index ]
+            = isTleAvailable ? tle.RightAscendingNode( true ) : nan;
+        column< double >( departureTleEccentricityColumn )[ index ]
+            = isTleAvailable ? tle.Eccentricity( ) : nan;
+        column< double >( departureTleArgumentPerigeeColumn )[ index ]
+            = isTleAvailable ? tle.ArgumentPerigee( true ) : nan;
+        column< double >( departureTleMeanAnomalyColumn )[ index ]
+            = isTleAvailable ? tle.MeanAnomaly( true ) : nan;
+        column< double >( departureTleMeanMotionColumn )[ index ]
+            = isTleAvailable ? tle.MeanMotion( ) : nan;
+
+        column< std::int32_t >( numberOfIterationsColumn )[ index ]
+            = solution.numberOfIterations;
+        column< std::int32_t >( statusColumn )[ index ] = solution.status;
+        column< std::int32_t >( solverStatusColumn )[ index ] = solution.solverStatus;
+
+        std::size_t traceLength = 0;
+        if ( trace != 0 )
+        {
+            const std::vector< SolverIterationRecord< Real > >& records = trace->records( );
+            traceLength = records.size( ) < header.traceCapacity
+                          ? records.size( ) : header.traceCapacity;
+
+            double* traceValues
+                = column< double >( traceColumn ) + 9 * header.traceCapacity * index;
+            for ( std::size_t j = 0; j < traceLength; j++ )
+            {
+                writeTraceValues( records[ j ].independentVariables, traceValues + 9 * j );
+                writeTraceValues( records[ j ].residuals, traceValues + 9 * j + 3 );
+                writeTraceValues( records[ j ].step, traceValues + 9 * j + 6 );
+            }
+        }
+        column< std::int32_t >( traceLengthColumn )[ index ]
+            = static_cast< std::int32_t >( traceLength );
+
+        column< std::uint8_t >( isWrittenColumn )[ index ] = 1;
+    }
+
+    //! Write back written records to file.
+    /*!
+     * Writes back the records written so far to the file and waits until they are written.
+     */
+    void flush( )
+    {
+        file.flush( );
+    }
+
+    //! Get number of records stored in file.
+    std::size_t numberOfRecords( ) const
+    {
+        return header.numberOfRecords;
+    }
+
+    //! Get maximum number of iterations stored in trace per record.
+    std::size_t traceCapacity( ) const
+    {
+        return header.traceCapacity;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    AtomResultWriter( const AtomResultWriter& );
+
+    //! Assignment operator (disabled).
+    AtomResultWriter& operator=( const AtomResultWriter& );
+
+    //! Get pointer to first value of column.
+    template< typename T >
+    T* column( const AtomResultColumn resultColumn )
+    {
+        return reinterpret_cast< T* >( static_cast< char* >( file.data( ) )
+                                       + header.columnOffsets[ resultColumn ] );
+    }
+
+    //! Write values of vector to trace, padding with NaN.
+    template< typename Real >
+    static void writeTraceValues( const std::vector< Real >& vector, double* values )
+    {
+        for ( std::size_t i = 0; i < 3; i++ )
+        {
+            values[ i ] = i < vector.size( )
+                          ? vector[ i ] : std::numeric_limits< double >::quiet_NaN( );
+        }
+    }
+
+    //! Header of result file.
+    AtomResultFileHeader header;
+
+    //! Memory-mapped result file.
+    MemoryMappedFile file;
+};
+
+//! Reader of Atom result file.
+class AtomResultReader
+{
+public:
+
+    //! Constructor that maps result file.
+    /*!
+     * Constructor that maps an existing result file for reading, and checks its header.
+     *
+     * @throws std::runtime_error If the file cannot be mapped, if it is not an Atom result file,
+     *                            or if it was written on a machine with a different byte order
+     * @param  fileName Name of result file
+     */
+    explicit AtomResultReader( const std::string& fileName )
+        : file( fileName ),
+          header( )
+    {
+        if ( file.size( ) < sizeof( AtomResultFileHeader ) )
+        {
+            throw std::runtime_error( "ERROR: File " + fileName + " is not an Atom result file!" );
+        }
+        std::memcpy( &header, file.data( ), sizeof( AtomResultFileHeader ) );
+
+        if ( std::memcmp( header.magic, "ATOMRES", 8 ) != 0 || header.version != 1 )
+        {
+            throw std::runtime_error( "ERROR: File " + fileName + " is not an Atom result file!" );
+        }
+
+        if ( header.byteOrderMark != 0x01020304 )
+        {
+            throw std::runtime_error(
+                "ERROR: Byte order of result file " + fileName + " is not supported!" );
+        }
+
+        AtomResultFileHeader layout;
+        if ( setAtomResultFileLayout( header.numberOfRecords, header.traceCapacity, layout )
+                != file.size( )
+             || std::memcmp( &layout, &header, sizeof( AtomResultFileHeader ) ) != 0 )
+        {
+            throw std::runtime_error( "ERROR: Result file " + fileName + " is truncated!" );
+        }
+    }
+
+    //! Get number of records stored in file.
+    std::size_t numberOfRecords( ) const
+    {
+        return header.numberOfRecords;
+    }
+
+    //! Get maximum number of iterations stored in trace per record.
+    std::size_t traceCapacity( ) const
+    {
+        return header.traceCapacity;
+    }
+
+    //! Get pointer to first value of column.
+    /*!
+     * Returns a pointer to the value of the first record in a given column, such that the values
+     * of all records are accessed in place as a contiguous array. The type of the values is given
+     * for each column by AtomResultColumn.
+     *
+     * @throws std::runtime_error If the size of the type does not match the values of the column
+     * @tparam T            Type for values of column
+     * @param  resultColumn Column of result file
+     * @return              Pointer to value of first record in column
+     */
+    template< typename T >
+    const T* column( const AtomResultColumn resultColumn ) const
+    {
+        const std::size_t valueSize = ( resultColumn == traceColumn )
+            ? sizeof( double ) : getAtomResultColumnRecordSize( resultColumn, 0 );
+        if ( sizeof( T ) != valueSize )
+        {
+            throw std::runtime_error( "ERROR: Type does not match column of result file!" );
+        }
+
+        return reinterpret_cast< const T* >( static_cast< const char* >( file.data( ) )
+                                             + header.columnOffsets[ resultColumn ] );
+    }
+
+    //! Check if record has been written.
+    /*!
+     * Checks if the record with the given index has been written.
+     *
+     * @throws std::runtime_error If the index is out of range
+     * @param  index Index of record
+     * @return       Flag indicating if record has been written
+     */
+    bool isWritten( const std::size_t index ) const
+    {
+        checkIndex( index );
+        return column< std::uint8_t >( isWrittenColumn )[ index ] != 0;
+    }
+
+    //! Read solution from record.
+    /*!
+     * Reads the velocities, number of iterations and status of the solution stored in the record
+     * with the given index. The converged transfer is not stored, and is set to not available; the
+     * departure TLE is read using readDepartureTle.
+     *
+     * @throws std::runtime_error If the index is out of range
+     * @tparam Real     Type for reals
+     * @tparam Vector3  Type for 3-vector of reals
+     * @param  index    Index of record
+     * @param  solution Solution read from record
+     */
+    template< typename Real, typename Vector3 >
+    void read( const std::size_t index, AtomSolution< Real, Vector3 >& solution ) const
+    {
+        checkIndex( index );
+
+        solution.departureVelocity = createVector< Vector3 >( 3 );
+        solution.arrivalVelocity = createVector< Vector3 >( 3 );
+        solution.departureVelocity[ 0 ] = column< double >( departureVelocityXColumn )[ index ];
+        solution.departureVelocity[ 1 ] = column< double >( departureVelocityYColumn )[ index ];
+        solution.departureVelocity[ 2 ] = column< double >( departureVelocityZColumn )[ index ];
+        solution.arrivalVelocity[ 0 ] = column< double >( arrivalVelocityXColumn )[ index ];
+        solution.arrivalVelocity[ 1 ] = column< double >( arrivalVelocityYColumn )[ index ];
+        solution.arrivalVelocity[ 2 ] = column< double >( arrivalVelocityZColumn )[ index ];
+
+        solution.numberOfIterations = column< std::int32_t >( numberOfIterationsColumn )[ index ];
+        solution.status
+            = static_cast< SolverStatus >( column< std::int32_t >( statusColumn )[ index ] );
+        solution.solverStatus = column< std::int32_t >( solverStatusColumn )[ index ];
+        solution.transfer = AtomTransfer< Real, Vector3 >( );
+    }
+
+    //! Read departure TLE from record.
+    /*!
+     * Reads the departure TLE stored in the record with the given index, by updating the epoch and
+     * mean elements of the given TLE. If this TLE is the reference TLE used by the solver, the TLE
+     * found by the nested Cartesian-to-TLE conversion is recovered.
+     *
+     * @throws std::runtime_error If the index is out of range
+     * @param  index Index of record
+     * @param  tle   Reference TLE, updated with departure TLE stored in record
+     * @return       Flag indicating if departure TLE is available
+     */
+    bool readDepartureTle( const std::size_t index, Tle& tle ) const
+    {
+        checkIndex( index );
+
+        const std::int64_t epoch = column< std::int64_t >( departureTleEpochColumn )[ index ];
+        if ( epoch == 0 )
+        {
+            return false;
+        }
+
+        tle.updateEpoch( DateTime( epoch ) );
+        tle.updateMeanElements( column< double >( departureTleInclinationColumn )[ index ],
+                                column< double >( departureTleRightAscendingNodeColumn )[ index ],
+                                column< double >( departureTleEccentricityColumn )[ index ],
+                                column< double >( departureTleArgumentPerigeeColumn )[ index ],
+                                column< double >( departureTleMeanAnomalyColumn )[ index ],
+                                column< double >( departureTleMeanMotionColumn )[ index ] );
+        return true;
+    }
+
+    //! Read iteration trace from record.
+    /*!
+     * Reads the iterations of the solver stored in the trace of the record with the given index.
+     *
+     * @throws std::runtime_error If the index is out of range
+     * @tparam Real    Type for reals
+     * @param  index   Index of record
+     * @param  records Records of iterations stored in trace
+     */
+    template< typename Real >
+    void readTrace( const std::size_t index,
+                    std::vector< SolverIterationRecord< Real > >& records ) const
+    {
+        checkIndex( index );
+
+        const std::size_t traceLength = column< std::int32_t >( traceLengthColumn )[ index ];
+        const double* traceValues = column< double >( traceColumn )
+                                    + 9 * header.traceCapacity * index;
+
+        records.resize( traceLength );
+        for ( std::size_t j = 0; j < traceLength; j++ )
+        {
+            records[ j ].iteration = static_cast< int >( j );
+            records[ j ].independentVariables.assign( traceValues + 9 * j,
+                                                      traceValues + 9 * j + 3 );
+            records[ j ].residuals.assign( traceValues + 9 * j + 3, traceValues + 9 * j + 6 );
+            records[ j ].step.assign( traceValues + 9 * j + 6, traceValues + 9 * j + 9 );
+        }
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    AtomResultReader( const AtomResultReader& );
+
+    //! Assignment operator (disabled).
+    AtomResultReader& operator=( const AtomResultReader& );
+
+    //! Check that index of record is in range.
+    void checkIndex( const std::size_t index ) const
+    {
+        if ( index >= header.numberOfRecords )
+        {
+            throw std::runtime_error( "ERROR: Index of record of result file is out of range!" );
+        }
+    }
+
+    //! Memory-mapped result file.
+    MemoryMappedFile file;
+
+    //! Header of result file.
+    AtomResultFileHeader header;
+};
+
+} // namespace atom
+
+#endif // ATOM_RESULT_FILE_H
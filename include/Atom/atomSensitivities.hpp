@@ -0,0 +1,559 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SENSITIVITIES_H
+#define ATOM_SENSITIVITIES_H
+
+#include <cmath>
+#include <limits>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/memoizedSgp4Propagator.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+
+namespace atom
+{
+
+//! Indices of inputs of Atom solver in sensitivities.
+enum AtomSensitivityInputIndices
+{
+    departurePositionInputIndex = 0,
+    arrivalPositionInputIndex = 3,
+    departureEpochInputIndex = 6,
+    timeOfFlightInputIndex = 7,
+    numberOfSensitivityInputs = 8
+};
+
+//! Sensitivities of converged Atom solution with respect to inputs of Atom solver.
+template< typename Real >
+struct AtomSensitivities;
+
+//! Compute sensitivities of converged Atom solution.
+/*!
+ * Computes the Jacobian of the Atom system at a converged departure velocity and the sensitivities
+ * of the departure and arrival velocities with respect to the inputs of the Atom solver, i.e., the
+ * departure position, the arrival position, the departure epoch and the time-of-flight. This
+ * makes gradients of the velocities, e.g., of the Delta V of a transfer optimized by an outer loop,
+ * available without re-solving the transfer for perturbed inputs.
+ *
+ * At the root of the Atom system, \f$\bar{R}(\bar{v}_{0}, \bar{p}) = 0\f$, the implicit-function
+ * theorem relates the sensitivities of the departure velocity to the partial derivatives of the
+ * residuals:
+ *  \f[
+ *      \frac{d\bar{v}_{0}}{d\bar{p}}
+ *          = -\left(\frac{\partial\bar{R}}{\partial\bar{v}_{0}}\right)^{-1}
+ *            \frac{\partial\bar{R}}{\partial\bar{p}}
+ *  \f]
+ * and the sensitivities of the arrival velocity follow from the chain rule. The partial
+ * derivatives with respect to the departure velocity, departure position, departure epoch and
+ * time-of-flight are computed using central differences of the SGP4/SDP4 residual function, each
+ * of which executes one (warm-started) nested Cartesian-to-TLE conversion, such that the
+ * sensitivities take 16 evaluations of the residual function instead of repeated solves. The
+ * residuals depend linearly on the arrival position, such that these partial derivatives are
+ * exact.
+ *
+ * The Jacobian maintained by the GSL solvers is not used, since the derivative-free solver does
+ * not expose it and the solver that uses a Jacobian is supplied with the two-body approximation
+ * (see computeAtomJacobian). The accuracy of the sensitivities is limited by the tolerances of the
+ * nested conversions; the steps must be large compared to the noise that these tolerances
+ * introduce in the arrival position.
+ *
+ * @sa executeAtomSolver, AtomSensitivities, computeAtomResiduals
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocity           Converged departure velocity [km/s]
+ * @param  tleWorkspace                Workspace for nested Cartesian-to-TLE conversions
+ *                                     (dimension 6)
+ * @param  sensitivities               Sensitivities of converged solution, only available if the
+ *                                     computation succeeds
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used by nested conversions
+ *                                     [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used by nested conversions
+ *                                     [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of iterations of nested conversions
+ *                                     [default: 100]
+ * @param  velocityStep                Step used to perturb departure velocity [km/s]
+ *                                     [default: 1.0e-5]
+ * @param  positionStep                Step used to perturb departure position [km]
+ *                                     [default: 1.0e-2]
+ * @param  timeStep                    Step used to perturb departure epoch and time-of-flight
+ *                                     [min] [default: 1.0e-3]
+ * @return                             Status of computation: solverConverged if it succeeds,
+ *                                     solverNestedConversionFailed or solverPropagationFailed if
+ *                                     an evaluation of the residual function fails, and
+ *                                     solverStuck if the Jacobian is singular
+ */
+template< typename Real, typename Vector3 >
+SolverStatus computeAtomSensitivities( const Vector3& departurePosition,
+                                       const DateTime& departureEpoch,
+                                       const Vector3& arrivalPosition,
+                                       const Real timeOfFlight,
+                                       const Vector3& departureVelocity,
+                                       SolverWorkspace& tleWorkspace,
+                                       AtomSensitivities< Real >& sensitivities,
+                                       const Tle& referenceTle = Tle( ),
+                                       const Real earthGravitationalParameter = kMU,
+                                       const Real earthMeanRadius = kXKMPER,
+                                       const Real absoluteTolerance = 1.0e-10,
+                                       const Real relativeTolerance = 1.0e-5,
+                                       const int maximumIterations = 100,
+                                       const Real velocityStep = 1.0e-5,
+                                       const Real positionStep = 1.0e-2,
+                                       const Real timeStep = 1.0e-3 );
+
+//! Compute sensitivities of converged Atom solution.
+/*!
+ * Computes the Jacobian of the Atom system at a converged departure velocity and the sensitivities
+ * of the departure and arrival velocities with respect to the inputs of the Atom solver. This is
+ * a function overload that allocates a workspace for the nested Cartesian-to-TLE conversions.
+ *
+ * @sa computeAtomSensitivities, AtomSensitivities
+ * @tparam Real              Type for reals
+ * @tparam Vector3           Type for 3-vector of reals
+ * @param  departurePosition Cartesian position vector at departure [km]
+ * @param  departureEpoch    Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition   Cartesian position vector at arrival [km]
+ * @param  timeOfFlight      Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocity Converged departure velocity [km/s]
+ * @param  sensitivities     Sensitivities of converged solution, only available if the
+ *                           computation succeeds
+ * @return                   Status of computation
+ */
+template< typename Real, typename Vector3 >
+SolverStatus computeAtomSensitivities( const Vector3& departurePosition,
+                                       const DateTime& departureEpoch,
+                                       const Vector3& arrivalPosition,
+                                       const Real timeOfFlight,
+                                       const Vector3& departureVelocity,
+                                       AtomSensitivities< Real >& sensitivities );
+
+//! Evaluate Atom transfer for given inputs.
+/*!
+ * Evaluates the residuals of the Atom system and the arrival velocity for the given inputs and
+ * departure velocity, executing one nested Cartesian-to-TLE conversion. This function is used to
+ * compute the central differences of the sensitivities.
+ *
+ * @sa computeAtomSensitivities, computeAtomResiduals
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocity           Departure velocity, stored in GSL vector [km/s]
+ * @param  tleWorkspace                Workspace for nested Cartesian-to-TLE conversions
+ * @param  tleWarmStart                Warm-start state of nested Cartesian-to-TLE conversions
+ * @param  propagator                  SGP4/SDP4 propagator shared by all evaluations
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used by nested conversion
+ * @param  relativeTolerance           Relative tolerance used by nested conversion
+ * @param  maximumIterations           Maximum number of iterations of nested conversion
+ * @param  residuals                   Residuals of Atom system, stored in GSL vector [-]
+ * @param  arrivalVelocity             Arrival velocity [km/s]
+ * @return                             Status of evaluation
+ */
+template< typename Real, typename Vector3 >
+SolverStatus evaluateAtomTransfer( const Vector3& departurePosition,
+                                   const DateTime& departureEpoch,
+                                   const Vector3& arrivalPosition,
+                                   const Real timeOfFlight,
+                                   const gsl_vector* departureVelocity,
+                                   SolverWorkspace& tleWorkspace,
+                                   TleFitWarmStart< Real >& tleWarmStart,
+                                   MemoizedSgp4Propagator& propagator,
+                                   const Tle& referenceTle,
+                                   const Real earthGravitationalParameter,
+                                   const Real earthMeanRadius,
+                                   const Real absoluteTolerance,
+                                   const Real relativeTolerance,
+                                   const int maximumIterations,
+                                   gsl_vector* residuals,
+                                   Real arrivalVelocity[ 3 ] );
+
+//! Compute sensitivities of converged Atom solution.
+template< typename Real, typename Vector3 >
+SolverStatus computeAtomSensitivities( const Vector3& departurePosition,
+                                       const DateTime& departureEpoch,
+                                       const Vector3& arrivalPosition,
+                                       const Real timeOfFlight,
+                                       const Vector3& departureVelocity,
+                                       SolverWorkspace& tleWorkspace,
+                                       AtomSensitivities< Real >& sensitivities,
+                                       const Tle& referenceTle,
+                                       const Real earthGravitationalParameter,
+                                       const Real earthMeanRadius,
+                                       const Real absoluteTolerance,
+                                       const Real relativeTolerance,
+                                       const int maximumIterations,
+                                       const Real velocityStep,
+                                       const Real positionStep,
+                                       const Real timeStep )
+{
+    sensitivities = AtomSensitivities< Real >( );
+
+    // Set up storage shared by all evaluations. The nested conversions are warm-started, since
+    // all evaluations convert departure states close to the converged departure state.
+    gsl_vector* velocity = gsl_vector_alloc( 3 );
+    gsl_vector* forwardResiduals = gsl_vector_alloc( 3 );
+    gsl_vector* backwardResiduals = gsl_vector_alloc( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        gsl_vector_set( velocity, i, departureVelocity[ i ] );
+    }
+    TleFitWarmStart< Real > tleWarmStart;
+    MemoizedSgp4Propagator propagator;
+    Real forwardArrivalVelocity[ 3 ];
+    Real backwardArrivalVelocity[ 3 ];
+
+    // Partial derivatives of residuals (i.e., Jacobian of Atom system) and arrival velocity with
+    // respect to departure velocity and inputs.
+    Real jacobian[ 3 ][ 3 ];
+    Real arrivalVelocityPartials[ 3 ][ 3 ];
+    Real residualsInputPartials[ 3 ][ numberOfSensitivityInputs ];
+    Real arrivalVelocityInputPartials[ 3 ][ numberOfSensitivityInputs ];
+
+    SolverStatus status = solverConverged;
+
+    // Compute partial derivatives with respect to departure velocity, departure position,
+    // departure epoch and time-of-flight, using central differences. Columns 0-2 perturb the
+    // departure velocity, columns 3-5 the departure position, column 6 the departure epoch and
+    // column 7 the time-of-flight.
+    const int numberOfPerturbedColumns = 8;
+    for ( int j = 0; j < numberOfPerturbedColumns && status == solverConverged; j++ )
+    {
+        Vector3 forwardDeparturePosition( departurePosition );
+        Vector3 backwardDeparturePosition( departurePosition );
+        DateTime forwardDepartureEpoch = departureEpoch;
+        DateTime backwardDepartureEpoch = departureEpoch;
+        Real forwardTimeOfFlight = timeOfFlight;
+        Real backwardTimeOfFlight = timeOfFlight;
+        Real step = 0.0;
+
+        if ( j < 3 )
+        {
+            step = velocityStep;
+            gsl_vector_set( velocity, j, departureVelocity[ j ] + step );
+        }
+        else if ( j < 6 )
+        {
+            step = positionStep;
+            forwardDeparturePosition[ j - 3 ] += step;
+            backwardDeparturePosition[ j - 3 ] -= step;
+        }
+        else if ( j == 6 )
+        {
+            // The epochs are rounded to whole ticks, such that the step is recomputed from the
+            // perturbed epochs.
+            forwardDepartureEpoch = departureEpoch.AddMinutes( timeStep );
+            backwardDepartureEpoch = departureEpoch.AddMinutes( -timeStep );
+            step = 0.5 * static_cast< Real >( forwardDepartureEpoch.Ticks( )
+                                              - backwardDepartureEpoch.Ticks( ) ) / 6.0e7;
+        }
+        else
+        {
+            step = timeStep;
+            forwardTimeOfFlight += step;
+            backwardTimeOfFlight -= step;
+        }
+
+        status = evaluateAtomTransfer( forwardDeparturePosition,
+                                       forwardDepartureEpoch,
+                                       arrivalPosition,
+                                       forwardTimeOfFlight,
+                                       velocity,
+                                       tleWorkspace,
+                                       tleWarmStart,
+                                       propagator,
+                                       referenceTle,
+                                       earthGravitationalParameter,
+                                       earthMeanRadius,
+                                       absoluteTolerance,
+                                       relativeTolerance,
+                                       maximumIterations,
+                                       forwardResiduals,
+                                       forwardArrivalVelocity );
+        if ( status != solverConverged )
+        {
+            break;
+        }
+
+        if ( j < 3 )
+        {
+            gsl_vector_set( velocity, j, departureVelocity[ j ] - step );
+        }
+
+        status = evaluateAtomTransfer( backwardDeparturePosition,
+                                       backwardDepartureEpoch,
+                                       arrivalPosition,
+                                       backwardTimeOfFlight,
+                                       velocity,
+                                       tleWorkspace,
+                                       tleWarmStart,
+                                       propagator,
+                                       referenceTle,
+                                       earthGravitationalParameter,
+                                       earthMeanRadius,
+                                       absoluteTolerance,
+                                       relativeTolerance,
+                                       maximumIterations,
+                                       backwardResiduals,
+                                       backwardArrivalVelocity );
+
+        if ( j < 3 )
+        {
+            gsl_vector_set( velocity, j, departureVelocity[ j ] );
+        }
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            const Real residualsPartial
+                = ( gsl_vector_get( forwardResiduals, i ) - gsl_vector_get( backwardResiduals, i ) )
+                  / ( 2.0 * step );
+            const Real arrivalVelocityPartial
+                = ( forwardArrivalVelocity[ i ] - backwardArrivalVelocity[ i ] ) / ( 2.0 * step );
+            if ( j < 3 )
+            {
+                jacobian[ i ][ j ] = residualsPartial;
+                arrivalVelocityPartials[ i ][ j ] = arrivalVelocityPartial;
+            }
+            else
+            {
+                // Skip columns of arrival position, which are set below.
+                const int input = ( j < 6 ) ? departurePositionInputIndex + j - 3
+                                            : ( j == 6 ) ? departureEpochInputIndex
+                                                         : timeOfFlightInputIndex;
+                residualsInputPartials[ i ][ input ] = residualsPartial;
+                arrivalVelocityInputPartials[ i ][ input ] = arrivalVelocityPartial;
+            }
+        }
+    }
+
+    gsl_vector_free( backwardResiduals );
+    gsl_vector_free( forwardResiduals );
+    gsl_vector_free( velocity );
+
+    if ( status != solverConverged )
+    {
+        return status;
+    }
+
+    // Set partial derivatives with respect to arrival position, which are exact since the
+    // residuals depend linearly on the arrival position and the arrival velocity does not depend
+    // on it.
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int k = 0; k < 3; k++ )
+        {
+            residualsInputPartials[ i ][ arrivalPositionInputIndex + k ]
+                = ( i == k ) ? -1.0 / earthMeanRadius : 0.0;
+            arrivalVelocityInputPartials[ i ][ arrivalPositionInputIndex + k ] = 0.0;
+        }
+    }
+
+    // Invert Jacobian of Atom system using its adjugate.
+    Real adjugate[ 3 ][ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            adjugate[ j ][ i ] = jacobian[ ( i + 1 ) % 3 ][ ( j + 1 ) % 3 ]
+                                 * jacobian[ ( i + 2 ) % 3 ][ ( j + 2 ) % 3 ]
+                                 - jacobian[ ( i + 1 ) % 3 ][ ( j + 2 ) % 3 ]
+                                 * jacobian[ ( i + 2 ) % 3 ][ ( j + 1 ) % 3 ];
+        }
+    }
+    const Real determinant = jacobian[ 0 ][ 0 ] * adjugate[ 0 ][ 0 ]
+                             + jacobian[ 0 ][ 1 ] * adjugate[ 1 ][ 0 ]
+                             + jacobian[ 0 ][ 2 ] * adjugate[ 2 ][ 0 ];
+    if ( determinant == 0.0 || !std::isfinite( determinant ) )
+    {
+        return solverStuck;
+    }
+
+    // Compute sensitivities of departure velocity using the implicit-function theorem, and
+    // sensitivities of arrival velocity using the chain rule.
+    for ( int k = 0; k < numberOfSensitivityInputs; k++ )
+    {
+        for ( int i = 0; i < 3; i++ )
+        {
+            Real sensitivity = 0.0;
+            for ( int j = 0; j < 3; j++ )
+            {
+                sensitivity -= adjugate[ i ][ j ] * residualsInputPartials[ j ][ k ];
+            }
+            sensitivities.departureVelocitySensitivities[ i ][ k ] = sensitivity / determinant;
+        }
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            Real sensitivity = arrivalVelocityInputPartials[ i ][ k ];
+            for ( int j = 0; j < 3; j++ )
+            {
+                sensitivity += arrivalVelocityPartials[ i ][ j ]
+                               * sensitivities.departureVelocitySensitivities[ j ][ k ];
+            }
+            sensitivities.arrivalVelocitySensitivities[ i ][ k ] = sensitivity;
+        }
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            sensitivities.jacobian[ i ][ j ] = jacobian[ i ][ j ];
+        }
+    }
+    sensitivities.isAvailable = true;
+
+    return solverConverged;
+}
+
+//! Compute sensitivities of converged Atom solution.
+template< typename Real, typename Vector3 >
+SolverStatus computeAtomSensitivities( const Vector3& departurePosition,
+                                       const DateTime& departureEpoch,
+                                       const Vector3& arrivalPosition,
+                                       const Real timeOfFlight,
+                                       const Vector3& departureVelocity,
+                                       AtomSensitivities< Real >& sensitivities )
+{
+    SolverWorkspace tleWorkspace( 6 );
+    return computeAtomSensitivities( departurePosition,
+                                     departureEpoch,
+                                     arrivalPosition,
+                                     timeOfFlight,
+                                     departureVelocity,
+                                     tleWorkspace,
+                                     sensitivities );
+}
+
+//! Evaluate Atom transfer for given inputs.
+template< typename Real, typename Vector3 >
+SolverStatus evaluateAtomTransfer( const Vector3& departurePosition,
+                                   const DateTime& departureEpoch,
+                                   const Vector3& arrivalPosition,
+                                   const Real timeOfFlight,
+                                   const gsl_vector* departureVelocity,
+                                   SolverWorkspace& tleWorkspace,
+                                   TleFitWarmStart< Real >& tleWarmStart,
+                                   MemoizedSgp4Propagator& propagator,
+                                   const Tle& referenceTle,
+                                   const Real earthGravitationalParameter,
+                                   const Real earthMeanRadius,
+                                   const Real absoluteTolerance,
+                                   const Real relativeTolerance,
+                                   const int maximumIterations,
+                                   gsl_vector* residuals,
+                                   Real arrivalVelocity[ 3 ] )
+{
+    AtomParameters< Real, Vector3 > parameters( departurePosition,
+                                                departureEpoch,
+                                                arrivalPosition,
+                                                timeOfFlight,
+                                                earthGravitationalParameter,
+                                                earthMeanRadius,
+                                                referenceTle,
+                                                absoluteTolerance,
+                                                relativeTolerance,
+                                                maximumIterations,
+                                                &tleWorkspace,
+                                                &tleWarmStart,
+                                                false,
+                                                0,
+                                                0,
+                                                0,
+                                                &propagator );
+
+    if ( computeAtomResiduals< Real, Vector3 >( departureVelocity, &parameters, residuals )
+         != GSL_SUCCESS )
+    {
+        return parameters.isPropagationFailed
+            ? solverPropagationFailed : solverNestedConversionFailed;
+    }
+
+    arrivalVelocity[ 0 ] = parameters.lastArrivalState.Velocity( ).x;
+    arrivalVelocity[ 1 ] = parameters.lastArrivalState.Velocity( ).y;
+    arrivalVelocity[ 2 ] = parameters.lastArrivalState.Velocity( ).z;
+
+    return solverConverged;
+}
+
+//! Sensitivities of converged Atom solution with respect to inputs of Atom solver.
+/*!
+ * Data structure with the Jacobian of the Atom system at a converged departure velocity and the
+ * sensitivities of the departure and arrival velocities with respect to the inputs of the Atom
+ * solver. The columns of the sensitivities are ordered as given by AtomSensitivityInputIndices:
+ * departure position [km], arrival position [km], departure epoch [min] and time-of-flight [min].
+ *
+ * @sa computeAtomSensitivities
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+struct AtomSensitivities
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up sensitivities that are not available, set to NaN.
+     */
+    AtomSensitivities( )
+        : isAvailable( false )
+    {
+        const Real notANumber = std::numeric_limits< Real >::quiet_NaN( );
+        for ( int i = 0; i < 3; i++ )
+        {
+            for ( int j = 0; j < 3; j++ )
+            {
+                jacobian[ i ][ j ] = notANumber;
+            }
+
+            for ( int k = 0; k < numberOfSensitivityInputs; k++ )
+            {
+                departureVelocitySensitivities[ i ][ k ] = notANumber;
+                arrivalVelocitySensitivities[ i ][ k ] = notANumber;
+            }
+        }
+    }
+
+    //! Flag indicating if sensitivities have been computed.
+    bool isAvailable;
+
+    //! Jacobian of Atom residuals with respect to departure velocity [(km/s)^-1].
+    Real jacobian[ 3 ][ 3 ];
+
+    //! Sensitivities of departure velocity with respect to inputs [km/s per unit of input].
+    Real departureVelocitySensitivities[ 3 ][ numberOfSensitivityInputs ];
+
+    //! Sensitivities of arrival velocity with respect to inputs [km/s per unit of input].
+    Real arrivalVelocitySensitivities[ 3 ][ numberOfSensitivityInputs ];
+
+protected:
+
+private:
+};
+
+} // namespace atom
+
+#endif // ATOM_SENSITIVITIES_H
@@ -0,0 +1,638 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLUTION_CACHE_H
+#define ATOM_SOLUTION_CACHE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Eci.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+#include <libsgp4/Vector.h>
+
+namespace atom
+{
+
+//! Result of lookup in cache of converged Atom solutions.
+enum AtomSolutionCacheLookup
+{
+    solutionCacheMiss,
+    solutionCacheSeed,
+    solutionCacheHit
+};
+
+//! Converged Atom solution stored in cache.
+template< typename Real, typename Vector3 >
+struct CachedAtomSolution
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up empty solution.
+     */
+    CachedAtomSolution( )
+        : departureVelocity( ),
+          arrivalVelocity( ),
+          departureTle( ),
+          arrivalState( DateTime( ), Vector( ), Vector( ) ),
+          finalResiduals( ),
+          absoluteTolerance( 0.0 )
+    { }
+
+    //! Departure velocity [km/s].
+    Vector3 departureVelocity;
+
+    //! Arrival velocity [km/s].
+    Vector3 arrivalVelocity;
+
+    //! TLE of departure state, found by nested Cartesian-to-TLE conversion.
+    Tle departureTle;
+
+    //! Arrival state, computed by propagating departure TLE by time-of-flight [km; km/s].
+    Eci arrivalState;
+
+    //! Final residuals of Atom solver [-].
+    Vector3 finalResiduals;
+
+    //! Absolute tolerance used by solver.
+    Real absoluteTolerance;
+
+protected:
+
+private:
+};
+
+//! Bounded cache of converged Atom solutions, indexed by transfer geometry.
+/*!
+ * Thread-safe cache that stores the solutions found by converged Atom solves, such that repeated
+ * queries for the same transfer return the converged solution directly, and queries for slightly
+ * shifted transfers (e.g., planning reruns after a small update of the departure epoch) are
+ * seeded with the departure velocity of the nearest converged transfer instead of a cold initial
+ * guess.
+ *
+ * Solutions are indexed in a k-d tree over the normalized transfer geometry, i.e., the departure
+ * and arrival positions divided by the length scale and the departure epoch and time-of-flight
+ * divided by the time scale. The defaults are canonical units, such that a time offset is weighed
+ * like the distance covered in that time on a circular orbit at the Earth's surface. A lookup
+ * finds the nearest stored solution: if it lies within the hit distance and has been converged to
+ * an absolute tolerance at least as tight as the tolerance requested, it is a hit; otherwise, if it
+ * lies within the seed distance, it is a seed.
+ *
+ * A cache must only be shared by solvers that use the same reference TLE, Earth constants and
+ * relative tolerance. New solutions are inserted as leaves of the k-d tree. If a leaf is inserted
+ * deeper than log_{3/2}(n) for n stored solutions, the subtree rooted at the deepest ancestor that
+ * is unbalanced (a child holding more than two thirds of its solutions) is rebuilt, as in a
+ * scapegoat tree. The depth of the tree is thus bounded, also if solutions are inserted in sorted
+ * order (e.g., increasing departure epochs), such that inserting and finding solutions takes
+ * amortized logarithmic time. Once the capacity of the cache is reached, the oldest half of the
+ * stored solutions is evicted and the k-d tree is rebuilt.
+ *
+ * A cache can be shared by many threads, e.g., the threads of a batch run, since all operations
+ * lock the cache. Caches cannot be copied, since they own the mutex.
+ *
+ * @sa AtomSolver, TleConversionCache
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+class AtomSolutionCache
+{
+public:
+
+    //! Constructor taking settings of cache.
+    /*!
+     * Constructor taking settings of cache, setting up empty cache.
+     *
+     * @param aCapacity     Maximum number of solutions stored; if it is set to zero, no solutions
+     *                      are stored [default: 4096]
+     * @param aHitDistance  Normalized distance within which a stored solution is returned
+     *                      directly [-] [default: 1.0e-9]
+     * @param aSeedDistance Normalized distance within which a stored solution seeds the solver
+     *                      [-] [default: 1.0e-2]
+     * @param aLengthScale  Scale used to normalize positions [km] [default: R_SGP]
+     * @param aTimeScale    Scale used to normalize epochs and times-of-flight [min]
+     *                      [default: sqrt( R_SGP^3 / mu_SGP )]
+     */
+    explicit AtomSolutionCache(
+        const std::size_t aCapacity = 4096,
+        const Real aHitDistance = 1.0e-9,
+        const Real aSeedDistance = 1.0e-2,
+        const Real aLengthScale = kXKMPER,
+        const Real aTimeScale = std::sqrt( kXKMPER * kXKMPER * kXKMPER / kMU ) / 60.0 )
+        : maximumSize( aCapacity ),
+          hitDistance( aHitDistance ),
+          seedDistance( aSeedDistance ),
+          lengthScale( aLengthScale ),
+          timeScale( aTimeScale ),
+          entries( ),
+          root( -1 ),
+          insertionPath( ),
+          hitCounter( 0 ),
+          seedCounter( 0 ),
+          missCounter( 0 )
+    { }
+
+    //! Find converged solution for transfer.
+    /*!
+     * Finds stored solution nearest to given transfer geometry.
+     *
+     * @param  departurePosition Cartesian position vector at departure [km]
+     * @param  departureEpoch    Modified Julian Date (MJD) of departure
+     * @param  arrivalPosition   Cartesian position vector at arrival [km]
+     * @param  timeOfFlight      Time-of-Flight for orbital transfer [min]
+     * @param  absoluteTolerance Absolute tolerance requested for solve
+     * @param  solution          Nearest converged solution, only set for hits and seeds
+     * @return                   Result of lookup
+     */
+    AtomSolutionCacheLookup find( const Vector3& departurePosition,
+                                  const DateTime& departureEpoch,
+                                  const Vector3& arrivalPosition,
+                                  const Real timeOfFlight,
+                                  const Real absoluteTolerance,
+                                  CachedAtomSolution< Real, Vector3 >& solution )
+    {
+        Real coordinates[ numberOfCoordinates ];
+        computeCoordinates(
+            departurePosition, departureEpoch, arrivalPosition, timeOfFlight, coordinates );
+
+        std::lock_guard< std::mutex > lock( mutex );
+        int nearestEntry = -1;
+        Real nearestSquaredDistance = std::numeric_limits< Real >::max( );
+        findNearest( root, coordinates, nearestEntry, nearestSquaredDistance );
+
+        if ( nearestEntry < 0 || nearestSquaredDistance > seedDistance * seedDistance )
+        {
+            ++missCounter;
+            return solutionCacheMiss;
+        }
+
+        solution = entries[ nearestEntry ].solution;
+        if ( nearestSquaredDistance <= hitDistance * hitDistance
+             && solution.absoluteTolerance <= absoluteTolerance )
+        {
+            ++hitCounter;
+            return solutionCacheHit;
+        }
+
+        ++seedCounter;
+        return solutionCacheSeed;
+    }
+
+    //! Insert converged solution for transfer.
+    /*!
+     * Inserts solution found by converged solve of given transfer, evicting the oldest half of the
+     * stored solutions if the capacity of the cache is reached. A solution stored within the hit
+     * distance is replaced, unless it has been converged to a tighter absolute tolerance than the
+     * given solution, in which case the stored solution is kept.
+     *
+     * @param departurePosition Cartesian position vector at departure [km]
+     * @param departureEpoch    Modified Julian Date (MJD) of departure
+     * @param arrivalPosition   Cartesian position vector at arrival [km]
+     * @param timeOfFlight      Time-of-Flight for orbital transfer [min]
+     * @param solution          Converged solution
+     */
+    void insert( const Vector3& departurePosition,
+                 const DateTime& departureEpoch,
+                 const Vector3& arrivalPosition,
+                 const Real timeOfFlight,
+                 const CachedAtomSolution< Real, Vector3 >& solution )
+    {
+        if ( maximumSize == 0 )
+        {
+            return;
+        }
+
+        Entry entry;
+        computeCoordinates(
+            departurePosition, departureEpoch, arrivalPosition, timeOfFlight, entry.coordinates );
+        entry.solution = solution;
+
+        std::lock_guard< std::mutex > lock( mutex );
+        int nearestEntry = -1;
+        Real nearestSquaredDistance = std::numeric_limits< Real >::max( );
+        findNearest( root, entry.coordinates, nearestEntry, nearestSquaredDistance );
+        if ( nearestEntry >= 0 && nearestSquaredDistance <= hitDistance * hitDistance )
+        {
+            if ( solution.absoluteTolerance <= entries[ nearestEntry ].solution.absoluteTolerance )
+            {
+                entries[ nearestEntry ].solution = solution;
+            }
+            return;
+        }
+
+        if ( entries.size( ) == maximumSize )
+        {
+            entries.erase( entries.begin( ),
+                           entries.begin( ) + ( entries.size( ) + 1 ) / 2 );
+            rebuildTree( );
+        }
+
+        entries.push_back( entry );
+        insertIntoTree( static_cast< int >( entries.size( ) ) - 1 );
+
+        // Rebuild unbalanced subtree if new leaf is too deep.
+        if ( static_cast< double >( insertionPath.size( ) )
+             > std::log( static_cast< double >( entries.size( ) ) ) / std::log( 1.5 ) )
+        {
+            rebuildScapegoatSubtree( static_cast< int >( entries.size( ) ) - 1 );
+        }
+    }
+
+    //! Get depth of k-d tree.
+    /*!
+     * Returns the number of nodes on the longest path from the root of the k-d tree to a leaf
+     * (zero if the cache is empty).
+     * @return Depth of k-d tree
+     */
+    std::size_t depth( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return computeSubtreeDepth( root );
+    }
+
+    //! Remove all stored solutions and reset counters.
+    void clear( )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        entries.clear( );
+        insertionPath.clear( );
+        root = -1;
+        hitCounter = 0;
+        seedCounter = 0;
+        missCounter = 0;
+    }
+
+    //! Get number of stored solutions.
+    std::size_t size( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return entries.size( );
+    }
+
+    //! Get maximum number of stored solutions.
+    std::size_t capacity( ) const
+    {
+        return maximumSize;
+    }
+
+    //! Get number of lookups that found a converged solution.
+    std::size_t numberOfHits( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return hitCounter;
+    }
+
+    //! Get number of lookups that found a solution to seed the solver.
+    std::size_t numberOfSeeds( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return seedCounter;
+    }
+
+    //! Get number of lookups that did not find a nearby solution.
+    std::size_t numberOfMisses( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return missCounter;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    AtomSolutionCache( const AtomSolutionCache& );
+
+    //! Assignment operator (disabled).
+    AtomSolutionCache& operator=( const AtomSolutionCache& );
+
+    //! Number of normalized coordinates of transfer geometry.
+    static const int numberOfCoordinates = 8;
+
+    //! Stored solution, which is a node of the k-d tree.
+    struct Entry
+    {
+    public:
+
+        //! Default constructor.
+        Entry( )
+            : solution( ),
+              axis( 0 ),
+              left( -1 ),
+              right( -1 )
+        { }
+
+        //! Normalized coordinates of transfer geometry [-].
+        Real coordinates[ numberOfCoordinates ];
+
+        //! Converged solution.
+        CachedAtomSolution< Real, Vector3 > solution;
+
+        //! Coordinate used to split children of node.
+        int axis;
+
+        //! Index of child with smaller or equal coordinate along axis (-1 if it does not exist).
+        int left;
+
+        //! Index of child with larger or equal coordinate along axis (-1 if it does not exist).
+        int right;
+
+    protected:
+
+    private:
+    };
+
+    //! Comparison of stored solutions along coordinate axis, used to rebuild k-d tree.
+    struct CompareAlongAxis
+    {
+    public:
+
+        //! Constructor taking stored solutions and coordinate axis.
+        CompareAlongAxis( const std::vector< Entry >& someEntries, const int anAxis )
+            : entries( someEntries ),
+              axis( anAxis )
+        { }
+
+        //! Check if first stored solution precedes second stored solution along axis.
+        bool operator( )( const int firstEntry, const int secondEntry ) const
+        {
+            return entries[ firstEntry ].coordinates[ axis ]
+                   < entries[ secondEntry ].coordinates[ axis ];
+        }
+
+        //! Stored solutions.
+        const std::vector< Entry >& entries;
+
+        //! Coordinate axis.
+        const int axis;
+
+    protected:
+
+    private:
+    };
+
+    //! Compute normalized coordinates of transfer geometry.
+    void computeCoordinates( const Vector3& departurePosition,
+                             const DateTime& departureEpoch,
+                             const Vector3& arrivalPosition,
+                             const Real timeOfFlight,
+                             Real* coordinates ) const
+    {
+        for ( int i = 0; i < 3; i++ )
+        {
+            coordinates[ i ] = departurePosition[ i ] / lengthScale;
+            coordinates[ i + 3 ] = arrivalPosition[ i ] / lengthScale;
+        }
+
+        // Convert epoch from ticks (microseconds since 0001-01-01) to minutes since J2000, such
+        // that nearby epochs are resolved to well below the hit distance.
+        const long long j2000Ticks = 63082324800000000LL;
+        coordinates[ 6 ] = static_cast< Real >( departureEpoch.Ticks( ) - j2000Ticks )
+                           / 6.0e7 / timeScale;
+        coordinates[ 7 ] = timeOfFlight / timeScale;
+    }
+
+    //! Find stored solution nearest to given coordinates in subtree.
+    void findNearest( const int node,
+                      const Real* coordinates,
+                      int& nearestEntry,
+                      Real& nearestSquaredDistance ) const
+    {
+        if ( node < 0 )
+        {
+            return;
+        }
+
+        const Entry& entry = entries[ node ];
+        Real squaredDistance = 0.0;
+        for ( int i = 0; i < numberOfCoordinates; i++ )
+        {
+            const Real difference = coordinates[ i ] - entry.coordinates[ i ];
+            squaredDistance += difference * difference;
+        }
+
+        if ( squaredDistance < nearestSquaredDistance )
+        {
+            nearestEntry = node;
+            nearestSquaredDistance = squaredDistance;
+        }
+
+        // Search subtree on the side of the splitting plane that contains the coordinates first,
+        // and the other subtree only if it can contain a nearer solution.
+        const Real axisDifference = coordinates[ entry.axis ] - entry.coordinates[ entry.axis ];
+        const int nearChild = ( axisDifference < 0.0 ) ? entry.left : entry.right;
+        const int farChild = ( axisDifference < 0.0 ) ? entry.right : entry.left;
+        findNearest( nearChild, coordinates, nearestEntry, nearestSquaredDistance );
+        if ( axisDifference * axisDifference < nearestSquaredDistance )
+        {
+            findNearest( farChild, coordinates, nearestEntry, nearestSquaredDistance );
+        }
+    }
+
+    //! Insert stored solution into k-d tree, as leaf below existing nodes.
+    /*!
+     * Inserts stored solution into k-d tree, storing the ancestors of the new leaf, from the root
+     * down to its parent, in the insertion path.
+     * @param newEntry Index of stored solution
+     */
+    void insertIntoTree( const int newEntry )
+    {
+        Entry& entry = entries[ newEntry ];
+        entry.left = -1;
+        entry.right = -1;
+        insertionPath.clear( );
+
+        if ( root < 0 )
+        {
+            entry.axis = 0;
+            root = newEntry;
+            return;
+        }
+
+        int node = root;
+        while ( true )
+        {
+            insertionPath.push_back( node );
+            Entry& parent = entries[ node ];
+            int& child = ( entry.coordinates[ parent.axis ] < parent.coordinates[ parent.axis ] )
+                ? parent.left : parent.right;
+            if ( child < 0 )
+            {
+                entry.axis = ( parent.axis + 1 ) % numberOfCoordinates;
+                child = newEntry;
+                return;
+            }
+            node = child;
+        }
+    }
+
+    //! Rebuild subtree rooted at deepest unbalanced ancestor of new leaf.
+    /*!
+     * Walks up the insertion path of the given new leaf, counting the stored solutions in the
+     * subtrees, until it finds an ancestor with a child that holds more than two thirds of the
+     * solutions of the ancestor, and rebuilds the subtree rooted at that ancestor. Such an
+     * ancestor exists if the leaf is deeper than log_{3/2}(n) for n stored solutions.
+     * @param newEntry Index of new leaf
+     */
+    void rebuildScapegoatSubtree( const int newEntry )
+    {
+        int child = newEntry;
+        std::size_t childSize = 1;
+        for ( int i = static_cast< int >( insertionPath.size( ) ) - 1; i >= 0; i-- )
+        {
+            const int node = insertionPath[ i ];
+            const Entry& entry = entries[ node ];
+            const int sibling = ( entry.left == child ) ? entry.right : entry.left;
+            const std::size_t size = childSize + computeSubtreeSize( sibling ) + 1;
+
+            if ( 3 * childSize > 2 * size )
+            {
+                std::vector< int > indices;
+                indices.reserve( size );
+                collectSubtree( node, indices );
+                const int subtree = buildSubtree( indices.begin( ), indices.end( ), entry.axis );
+
+                if ( i == 0 )
+                {
+                    root = subtree;
+                }
+                else
+                {
+                    Entry& parent = entries[ insertionPath[ i - 1 ] ];
+                    ( ( parent.left == node ) ? parent.left : parent.right ) = subtree;
+                }
+                return;
+            }
+
+            child = node;
+            childSize = size;
+        }
+    }
+
+    //! Compute number of stored solutions in subtree.
+    std::size_t computeSubtreeSize( const int node ) const
+    {
+        if ( node < 0 )
+        {
+            return 0;
+        }
+
+        return 1 + computeSubtreeSize( entries[ node ].left )
+                 + computeSubtreeSize( entries[ node ].right );
+    }
+
+    //! Compute depth of subtree.
+    std::size_t computeSubtreeDepth( const int node ) const
+    {
+        if ( node < 0 )
+        {
+            return 0;
+        }
+
+        return 1 + std::max( computeSubtreeDepth( entries[ node ].left ),
+                             computeSubtreeDepth( entries[ node ].right ) );
+    }
+
+    //! Collect indices of stored solutions in subtree.
+    void collectSubtree( const int node, std::vector< int >& indices ) const
+    {
+        if ( node < 0 )
+        {
+            return;
+        }
+
+        indices.push_back( node );
+        collectSubtree( entries[ node ].left, indices );
+        collectSubtree( entries[ node ].right, indices );
+    }
+
+    //! Rebuild balanced k-d tree from stored solutions.
+    void rebuildTree( )
+    {
+        std::vector< int > indices( entries.size( ) );
+        for ( std::size_t i = 0; i < indices.size( ); i++ )
+        {
+            indices[ i ] = static_cast< int >( i );
+        }
+
+        root = buildSubtree( indices.begin( ), indices.end( ), 0 );
+    }
+
+    //! Build balanced subtree from given stored solutions, splitting at median along axis.
+    int buildSubtree( const std::vector< int >::iterator first,
+                      const std::vector< int >::iterator last,
+                      const int axis )
+    {
+        if ( first == last )
+        {
+            return -1;
+        }
+
+        // Split at median along axis. Solutions that are equal to the median along the axis can be
+        // stored in either subtree, such that the subtrees are balanced even if many solutions
+        // share a coordinate, e.g., transfers that only differ in time-of-flight.
+        const std::vector< int >::iterator median = first + ( last - first ) / 2;
+        std::nth_element( first, median, last, CompareAlongAxis( entries, axis ) );
+
+        Entry& entry = entries[ *median ];
+        entry.axis = axis;
+        const int nextAxis = ( axis + 1 ) % numberOfCoordinates;
+        const int node = *median;
+        const int left = buildSubtree( first, median, nextAxis );
+        const int right = buildSubtree( median + 1, last, nextAxis );
+        entries[ node ].left = left;
+        entries[ node ].right = right;
+        return node;
+    }
+
+    //! Maximum number of stored solutions.
+    const std::size_t maximumSize;
+
+    //! Normalized distance within which a stored solution is returned directly [-].
+    const Real hitDistance;
+
+    //! Normalized distance within which a stored solution seeds the solver [-].
+    const Real seedDistance;
+
+    //! Scale used to normalize positions [km].
+    const Real lengthScale;
+
+    //! Scale used to normalize epochs and times-of-flight [min].
+    const Real timeScale;
+
+    //! Stored solutions, ordered from oldest to newest, which are the nodes of the k-d tree.
+    std::vector< Entry > entries;
+
+    //! Index of root node of k-d tree (-1 if cache is empty).
+    int root;
+
+    //! Ancestors of last inserted leaf, from root down to its parent, reused for every insertion.
+    std::vector< int > insertionPath;
+
+    //! Number of lookups that found a converged solution.
+    std::size_t hitCounter;
+
+    //! Number of lookups that found a solution to seed the solver.
+    std::size_t seedCounter;
+
+    //! Number of lookups that did not find a nearby solution.
+    std::size_t missCounter;
+
+    //! Mutex that locks cache.
+    mutable std::mutex mutex;
+};
+
+} // namespace atom
+
+#endif // ATOM_SOLUTION_CACHE_H
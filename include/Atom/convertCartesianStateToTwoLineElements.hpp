@@ -13,23 +13,44 @@
 #include <string>
 #include <vector>
 
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_multiroots.h>
 #include <gsl/gsl_vector.h>
 
 #include <libsgp4/DateTime.h>
 #include <libsgp4/Eci.h>
 #include <libsgp4/Globals.h>
-#include <libsgp4/SGP4.h>
 #include <libsgp4/Tle.h>
 
 #include <Astro/astro.hpp>
 #include <SML/sml.hpp>
 
+#include <Atom/memoizedSgp4Propagator.hpp>
 #include <Atom/printFunctions.hpp>
+#include <Atom/precompiledInstantiations.hpp>
+#include <Atom/solverCancellation.hpp>
+#include <Atom/solverDiagnostics.hpp>
+#include <Atom/solverStatistics.hpp>
+#include <Atom/solverStatus.hpp>
+#include <Atom/solverWorkspace.hpp>
+#include <Atom/tleConversionCache.hpp>
+#include <Atom/twoBodyFunctions.hpp>
 
 namespace atom
 {
 
+//! Warm-start state for Cartesian-to-TLE conversions.
+/*!
+ * Data structure with the state that is carried over from one Cartesian-to-TLE conversion to the
+ * next, to warm-start the solver.
+ *
+ * @sa convertCartesianStateToTwoLineElements
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+struct TleFitWarmStart;
+
 //! Convert Cartesian state to TLE (Two Line Elements).
 /*!
  * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
@@ -64,6 +85,10 @@ namespace atom
  *                                     solver reaches this limit, the loop will be broken and the
  *                                     solver status will report that it has not converged
  *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver. If hybridsjSolver is selected, the
+ *                                     Jacobian is approximated analytically using two-body
+ *                                     dynamics instead of using finite differences
+ *                                     [default: hybridsSolver].
  * @return                             TLE object that generates target Cartesian state when
  *                                     propagated with SGP4 propagator to target epoch
  */
@@ -78,8 +103,184 @@ const Tle convertCartesianStateToTwoLineElements(
     const Real earthMeanRadius = kXKMPER,
     const Real absoluteTolerance = 1.0e-10,
     const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver );
+
+//! Convert Cartesian state to TLE (Two Line Elements).
+/*!
+ * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
+ *
+ * This function makes use of a root-finder to solve a non-linear system. Locating the root of the
+ * non-linear system corresponds finding the TLE that, when evaluated at its epoch using the
+ * SGP4/SDP4 propagator (Vallado, 2012), yields the target Cartesian state (within tolerance).
+ *
+ * Details of the underlying non-linear system and algorithm are catalogued by
+ * Kumar, et al. (2014).
+ *
+ * This is a function overload that passes the state of the non-linear solver to a diagnostics
+ * policy at every iteration, instead of printing a solver status summary table. Using
+ * NoSolverDiagnostics ensures that no diagnostics are generated at all.
+ *
+ * @sa     convertCartesianStateToTwoLineElements, NoSolverDiagnostics, SolverIterationTrace,
+ *         SolverSummaryTable
+ * @tparam Real                        Type for reals
+ * @tparam Vector6                     Type for 6-vector of reals
+ * @tparam Diagnostics                 Type for solver diagnostics policy
+ * @param  cartesianState              Cartesian state [km; km/s]
+ * @param  epoch                       Epoch associated with Cartesian state, stored in a
+ *                                     DateTime object
+ * @param  diagnostics                 Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @return                             TLE object that generates target Cartesian state when
+ *                                     propagated with SGP4 propagator to target epoch
+ */
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver );
+
+//! Convert Cartesian state to TLE (Two Line Elements).
+/*!
+ * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
+ *
+ * This is a function overload that uses the GSL solver allocated in the given workspace, instead
+ * of allocating a new solver. This avoids allocating and freeing memory for every conversion when
+ * many conversions are executed in sequence. The type of GSL solver is set by the workspace.
+ *
+ * @sa     convertCartesianStateToTwoLineElements, SolverWorkspace
+ * @tparam Real                        Type for reals
+ * @tparam Vector6                     Type for 6-vector of reals
+ * @tparam Diagnostics                 Type for solver diagnostics policy
+ * @param  cartesianState              Cartesian state [km; km/s]
+ * @param  epoch                       Epoch associated with Cartesian state, stored in a
+ *                                     DateTime object
+ * @param  workspace                   Workspace for GSL solver of dimension 6
+ * @param  diagnostics                 Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @return                             TLE object that generates target Cartesian state when
+ *                                     propagated with SGP4 propagator to target epoch
+ */
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    SolverWorkspace& workspace,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
     const int maximumIterations = 100 );
 
+//! Convert Cartesian state to TLE (Two Line Elements).
+/*!
+ * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
+ *
+ * This is a function overload that warm-starts the GSL solver allocated in the given workspace.
+ * The difference between the mean elements found by the previous conversion and the osculating
+ * Keplerian elements of its target state is stored in the warm-start state. This difference is
+ * added to the osculating Keplerian elements of the current target state to generate the initial
+ * guess, instead of using the osculating Keplerian elements directly. If the target states of
+ * successive conversions are close, as is the case for the nested conversions executed by the
+ * Atom solver, the initial guess is much closer to the root and fewer iterations are needed. The
+ * warm-start state is updated after every conversion that converges.
+ *
+ * If the solver status is set, the conversion does not throw exceptions. Instead, the status of
+ * the solver is returned, together with the TLE corresponding to the last iteration of the
+ * solver. Otherwise, an exception is thrown if the solver gets stuck or if the SGP4/SDP4
+ * propagator fails.
+ *
+ * If the cancellation token is set, it is checked between iterations of the solver. If the token
+ * is cancelled, the conversion stops at the current iterate, with status solverCancelled.
+ *
+ * @sa     convertCartesianStateToTwoLineElements, SolverWorkspace, TleFitWarmStart, SolverStatus,
+ *         SolverCancellation
+ * @tparam Real                        Type for reals
+ * @tparam Vector6                     Type for 6-vector of reals
+ * @tparam Diagnostics                 Type for solver diagnostics policy
+ * @param  cartesianState              Cartesian state [km; km/s]
+ * @param  epoch                       Epoch associated with Cartesian state, stored in a
+ *                                     DateTime object
+ * @param  workspace                   Workspace for GSL solver of dimension 6
+ * @param  warmStart                   Warm-start state, updated by conversion
+ * @param  diagnostics                 Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations          Number of iterations completed by solver
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  statistics                  Statistics collected by solver; if it is not set, no
+ *                                     statistics are collected [default: 0]
+ * @param  status                      Status of solver; if it is not set, exceptions are thrown if
+ *                                     the solver fails [default: 0]
+ * @param  propagator                  SGP4/SDP4 propagator used by residual function, which holds
+ *                                     the TLE of the last evaluation after the conversion; if it is
+ *                                     not set, a propagator is set up for the conversion
+ *                                     [default: 0]
+ * @param  cache                       Cache of converged conversions; if a converged TLE is found
+ *                                     for the Cartesian state, it is returned without executing
+ *                                     the solver, else the converged TLE is stored in the cache. If
+ *                                     it is not set, no conversions are cached [default: 0]
+ * @param  cancellation                Cancellation token checked between iterations; if it is not
+ *                                     set, the conversion cannot be cancelled [default: 0]
+ * @return                             TLE object that generates target Cartesian state when
+ *                                     propagated with SGP4 propagator to target epoch
+ */
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    SolverWorkspace& workspace,
+    TleFitWarmStart< Real >& warmStart,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    SolverStatistics< Real >* statistics = 0,
+    SolverStatus* status = 0,
+    MemoizedSgp4Propagator* propagator = 0,
+    TleConversionCache< Real >* cache = 0,
+    const SolverCancellation* cancellation = 0 );
+
 //! Convert Cartesian state to TLE (Two Line Elements).
 /*!
  * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
@@ -139,6 +340,48 @@ int computeCartesianToTwoLineElementResiduals( const gsl_vector* independentVari
                                                void* parameters,
                                                gsl_vector* residuals );
 
+//! Compute Jacobian for converting Cartesian state to TLE.
+/*!
+ * Computes an approximation of the Jacobian of the residual function used to find the TLE
+ * corresponding with a target Cartesian state. The SGP4/SDP4 dynamics are approximated by
+ * two-body dynamics, such that the partial derivatives of the Cartesian state with respect to the
+ * mean elements are computed analytically, instead of evaluating the residual function six more
+ * times to compute finite differences. The residual function itself is not approximated, so the
+ * converged TLE is not affected by this approximation.
+ *
+ * @sa computeCartesianToTwoLineElementResiduals, computeKeplerianToCartesianJacobian
+ * @tparam Real                 Type for reals
+ * @tparam Vector6              Type for 6-vector of reals
+ * @param  independentVariables Vector of independent variables used by the root-finder
+ * @param  parameters           Parameters required to compute the objective function
+ * @param  jacobian             Matrix of computed partial derivatives of residuals
+ * @return                      GSL flag indicating success or failure
+ */
+template< typename Real, typename Vector6 >
+int computeCartesianToTwoLineElementJacobian( const gsl_vector* independentVariables,
+                                              void* parameters,
+                                              gsl_matrix* jacobian );
+
+//! Compute residuals and Jacobian for converting Cartesian state to TLE.
+/*!
+ * Computes residuals and an approximation of the Jacobian of the residual function used to find
+ * the TLE corresponding with a target Cartesian state.
+ *
+ * @sa computeCartesianToTwoLineElementResiduals, computeCartesianToTwoLineElementJacobian
+ * @tparam Real                 Type for reals
+ * @tparam Vector6              Type for 6-vector of reals
+ * @param  independentVariables Vector of independent variables used by the root-finder
+ * @param  parameters           Parameters required to compute the objective function
+ * @param  residuals            Vector of computed residuals
+ * @param  jacobian             Matrix of computed partial derivatives of residuals
+ * @return                      GSL flag indicating success or failure
+ */
+template< typename Real, typename Vector6 >
+int computeCartesianToTwoLineElementResidualsAndJacobian( const gsl_vector* independentVariables,
+                                                          void* parameters,
+                                                          gsl_vector* residuals,
+                                                          gsl_matrix* jacobian );
+
 //! Update TLE mean elements.
 /*!
  * Updates mean elements stored in TLE based on current osculating elements. This function
@@ -156,6 +399,22 @@ const Tle updateTleMeanElements( const gsl_vector* newKeplerianElements,
                                  const Tle& oldTle,
                                  const Real earthGravitationalParameter );
 
+//! Update TLE mean elements in place.
+/*!
+ * Updates mean elements stored in given TLE based on current osculating elements, without copying
+ * the TLE. This function does not allocate any memory and is used by the residual function.
+ *
+ * @sa updateTleMeanElements
+ * @tparam Real                        Real type
+ * @param  newKeplerianElements        New Keplerian elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  tle                         TLE in which the mean elements are replaced
+ */
+template< typename Real >
+void updateTleMeanElements( const gsl_vector* newKeplerianElements,
+                            const Real earthGravitationalParameter,
+                            Tle& tle );
+
 //! Parameter struct used by Cartesian-to-TLE residual function.
 /*!
  * Data structure with parameters used to compute Cartesian-to-TLE residual function.
@@ -167,6 +426,324 @@ const Tle updateTleMeanElements( const gsl_vector* newKeplerianElements,
 template< typename Real, typename Vector6 >
 struct CartesianToTwoLineElementsParameters;
 
+//! Fit TLE (Two Line Elements) to Cartesian state using given parameters.
+/*!
+ * Fits TLE to the target Cartesian state referenced by the given parameters of the residual
+ * function, storing the TLE in the working TLE of the parameters. This is the conversion executed
+ * by convertCartesianStateToTwoLineElements, for callers that convert many states using the same
+ * parameters, e.g., the nested conversions executed by the Atom solver, for which the target state
+ * is updated in place.
+ *
+ * The working TLE is reset to the reference TLE in place, before the solver is executed. Since the
+ * storage of the working TLE is reused, no TLE is copied into newly allocated memory, neither to
+ * set up the conversion nor to return the converted TLE. The osculating elements used to set the
+ * initial guess are computed in place as well, such that the conversion does not allocate any
+ * memory. The conversion does not throw exceptions; the status of the solver is returned instead.
+ *
+ * @sa     convertCartesianStateToTwoLineElements, CartesianToTwoLineElementsParameters,
+ *         SolverWorkspace, TleFitWarmStart, SolverStatus
+ * @tparam Real               Type for reals
+ * @tparam Vector6            Type for 6-vector of reals
+ * @tparam Diagnostics        Type for solver diagnostics policy
+ * @param  parameters         Parameters of residual function, referencing target Cartesian
+ *                            state [km; km/s]; the working TLE holds the converted TLE once the
+ *                            conversion has finished
+ * @param  epoch              Epoch associated with Cartesian state, stored in a DateTime object
+ * @param  workspace          Workspace for GSL solver of dimension 6
+ * @param  warmStart          Warm-start state, updated by conversion
+ * @param  diagnostics        Diagnostics policy that records state of non-linear solver
+ * @param  numberOfIterations Number of iterations completed by solver
+ * @param  referenceTle       Reference Two Line Elements
+ * @param  absoluteTolerance  Absolute tolerance used to check if root-finder has converged
+ * @param  relativeTolerance  Relative tolerance used to check if root-finder has converged
+ * @param  maximumIterations  Maximum number of solver iterations permitted
+ * @param  cache              Cache of converged conversions; if it is not set, no conversions
+ *                            are cached [default: 0]
+ * @param  cancellation       Cancellation token checked between iterations; if it is not set, the
+ *                            conversion cannot be cancelled [default: 0]
+ * @return                    Status of solver
+ */
+template< typename Real, typename Vector6, typename Diagnostics >
+SolverStatus fitTwoLineElements( CartesianToTwoLineElementsParameters< Real, Vector6 >& parameters,
+                                 const DateTime& epoch,
+                                 SolverWorkspace& workspace,
+                                 TleFitWarmStart< Real >& warmStart,
+                                 Diagnostics& diagnostics,
+                                 int& numberOfIterations,
+                                 const Tle& referenceTle,
+                                 const Real absoluteTolerance,
+                                 const Real relativeTolerance,
+                                 const int maximumIterations,
+                                 TleConversionCache< Real >* cache = 0,
+                                 const SolverCancellation* cancellation = 0 );
+
+//! Cartesian-to-TLE converter that owns its GSL solver.
+/*!
+ * Converter that owns the workspace of the GSL solver, the warm-start state, the reference TLE and
+ * the constants and tolerances used to convert Cartesian states to TLEs. The workspace is
+ * allocated once on construction, such that repeated conversions do not allocate and free memory
+ * for the GSL solver. The free convertCartesianStateToTwoLineElements functions that allocate a
+ * solver are thin wrappers around this class. The statistics of the last conversion are always
+ * collected and can be retrieved after every conversion.
+ *
+ * Converters cannot be copied, since they own the GSL solver. A converter must not be used by more
+ * than one thread at a time.
+ *
+ * @sa convertCartesianStateToTwoLineElements, SolverWorkspace, TleFitWarmStart
+ * @tparam Real    Type for reals
+ * @tparam Vector6 Type for 6-vector of reals
+ */
+template< typename Real, typename Vector6 >
+class TleFitter
+{
+public:
+
+    //! Constructor taking settings of converter.
+    /*!
+     * Constructor taking settings of converter, allocating memory for GSL solver.
+     *
+     * @param aReferenceTle                 Reference Two Line Elements [default: 0-TLE]
+     * @param anEarthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+     *                                      [default: mu_SGP]
+     * @param anEarthMeanRadius             Earth mean radius [km] [default: R_SGP]
+     * @param anAbsoluteTolerance           Absolute tolerance used to check if root-finder has
+     *                                      converged [default: 1.0e-10]
+     * @param aRelativeTolerance            Relative tolerance used to check if root-finder has
+     *                                      converged [default: 1.0e-5]
+     * @param someMaximumIterations         Maximum number of solver iterations permitted
+     *                                      [default: 100]
+     * @param aSolverType                   Type of GSL solver [default: hybridsSolver]
+     * @param anIsWarmStartEnabled          Flag indicating if each conversion is warm-started by
+     *                                      the previous conversion [default: false]
+     */
+    explicit TleFitter( const Tle& aReferenceTle = Tle( ),
+                        const Real anEarthGravitationalParameter = kMU,
+                        const Real anEarthMeanRadius = kXKMPER,
+                        const Real anAbsoluteTolerance = 1.0e-10,
+                        const Real aRelativeTolerance = 1.0e-5,
+                        const int someMaximumIterations = 100,
+                        const SolverType aSolverType = hybridsSolver,
+                        const bool anIsWarmStartEnabled = false )
+        : referenceTle( aReferenceTle ),
+          earthGravitationalParameter( anEarthGravitationalParameter ),
+          earthMeanRadius( anEarthMeanRadius ),
+          absoluteTolerance( anAbsoluteTolerance ),
+          relativeTolerance( aRelativeTolerance ),
+          maximumIterations( someMaximumIterations ),
+          isWarmStartEnabled( anIsWarmStartEnabled ),
+          workspace( 6, aSolverType ),
+          warmStart( ),
+          solverStatistics( )
+    { }
+
+    //! Convert Cartesian state to TLE.
+    /*!
+     * Converts a given Cartesian state (position, velocity) to an equivalent TLE, passing the
+     * state of the non-linear solver to the given diagnostics policy.
+     *
+     * @sa convertCartesianStateToTwoLineElements
+     * @tparam Diagnostics        Type for solver diagnostics policy
+     * @param  cartesianState     Cartesian state [km; km/s]
+     * @param  epoch              Epoch associated with Cartesian state
+     * @param  diagnostics        Diagnostics policy that records state of non-linear solver
+     * @param  numberOfIterations Number of iterations completed by solver
+     * @return                    TLE object that generates target Cartesian state when
+     *                            propagated with SGP4 propagator to target epoch
+     */
+    template< typename Diagnostics >
+    const Tle solve( const Vector6& cartesianState,
+                     const DateTime& epoch,
+                     Diagnostics& diagnostics,
+                     int& numberOfIterations )
+    {
+        // Start cold if warm start is disabled.
+        if ( !isWarmStartEnabled )
+        {
+            warmStart.hasElementOffsets = false;
+        }
+
+        return convertCartesianStateToTwoLineElements( cartesianState,
+                                                       epoch,
+                                                       workspace,
+                                                       warmStart,
+                                                       diagnostics,
+                                                       numberOfIterations,
+                                                       referenceTle,
+                                                       earthGravitationalParameter,
+                                                       earthMeanRadius,
+                                                       absoluteTolerance,
+                                                       relativeTolerance,
+                                                       maximumIterations,
+                                                       &solverStatistics,
+                                                       0,
+                                                       &propagator );
+    }
+
+    //! Convert Cartesian state to TLE.
+    /*!
+     * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
+     *
+     * @param  cartesianState     Cartesian state [km; km/s]
+     * @param  epoch              Epoch associated with Cartesian state
+     * @param  numberOfIterations Number of iterations completed by solver
+     * @return                    TLE object that generates target Cartesian state when
+     *                            propagated with SGP4 propagator to target epoch
+     */
+    const Tle solve( const Vector6& cartesianState,
+                     const DateTime& epoch,
+                     int& numberOfIterations )
+    {
+        NoSolverDiagnostics diagnostics;
+        return solve( cartesianState, epoch, diagnostics, numberOfIterations );
+    }
+
+    //! Convert Cartesian state to TLE.
+    /*!
+     * Converts a given Cartesian state (position, velocity) to an equivalent TLE.
+     *
+     * @param  cartesianState Cartesian state [km; km/s]
+     * @param  epoch          Epoch associated with Cartesian state
+     * @return                TLE object that generates target Cartesian state when propagated
+     *                        with SGP4 propagator to target epoch
+     */
+    const Tle solve( const Vector6& cartesianState, const DateTime& epoch )
+    {
+        int dummyint = 0;
+        return solve( cartesianState, epoch, dummyint );
+    }
+
+    //! Convert Cartesian state to TLE without throwing exceptions.
+    /*!
+     * Converts a given Cartesian state (position, velocity) to an equivalent TLE, passing the
+     * state of the non-linear solver to the given diagnostics policy. No exceptions are thrown if
+     * the solver fails; the status of the solver is returned instead.
+     *
+     * @sa convertCartesianStateToTwoLineElements, SolverStatus
+     * @tparam Diagnostics        Type for solver diagnostics policy
+     * @param  cartesianState     Cartesian state [km; km/s]
+     * @param  epoch              Epoch associated with Cartesian state
+     * @param  tle                TLE object that generates target Cartesian state when propagated
+     *                            with SGP4 propagator to target epoch (TLE corresponding to last
+     *                            iteration if solver failed)
+     * @param  diagnostics        Diagnostics policy that records state of non-linear solver
+     * @param  numberOfIterations Number of iterations completed by solver
+     * @return                    Status of solver
+     */
+    template< typename Diagnostics >
+    SolverStatus trySolve( const Vector6& cartesianState,
+                           const DateTime& epoch,
+                           Tle& tle,
+                           Diagnostics& diagnostics,
+                           int& numberOfIterations )
+    {
+        // Start cold if warm start is disabled.
+        if ( !isWarmStartEnabled )
+        {
+            warmStart.hasElementOffsets = false;
+        }
+
+        SolverStatus status = solverConverged;
+        tle = convertCartesianStateToTwoLineElements( cartesianState,
+                                                      epoch,
+                                                      workspace,
+                                                      warmStart,
+                                                      diagnostics,
+                                                      numberOfIterations,
+                                                      referenceTle,
+                                                      earthGravitationalParameter,
+                                                      earthMeanRadius,
+                                                      absoluteTolerance,
+                                                      relativeTolerance,
+                                                      maximumIterations,
+                                                      &solverStatistics,
+                                                      &status,
+                                                      &propagator );
+        return status;
+    }
+
+    //! Convert Cartesian state to TLE without throwing exceptions.
+    /*!
+     * Converts a given Cartesian state (position, velocity) to an equivalent TLE. No exceptions
+     * are thrown if the solver fails; the status of the solver is returned instead.
+     *
+     * @param  cartesianState Cartesian state [km; km/s]
+     * @param  epoch          Epoch associated with Cartesian state
+     * @param  tle            TLE object that generates target Cartesian state when propagated
+     *                        with SGP4 propagator to target epoch
+     * @return                Status of solver
+     */
+    SolverStatus trySolve( const Vector6& cartesianState, const DateTime& epoch, Tle& tle )
+    {
+        NoSolverDiagnostics diagnostics;
+        int dummyint = 0;
+        return trySolve( cartesianState, epoch, tle, diagnostics, dummyint );
+    }
+
+    //! Reset warm-start state.
+    /*!
+     * Resets warm-start state, such that the next conversion starts cold, e.g., when the next
+     * Cartesian state is unrelated to the previous one.
+     */
+    void resetWarmStart( )
+    {
+        warmStart.hasElementOffsets = false;
+    }
+
+    //! Get statistics collected by last conversion.
+    /*!
+     * Returns statistics collected by last conversion executed by converter.
+     *
+     * @return Statistics collected by last conversion
+     */
+    const SolverStatistics< Real >& statistics( ) const
+    {
+        return solverStatistics;
+    }
+
+    //! Reference TLE.
+    const Tle referenceTle;
+
+    //! Earth gravitational parameter [km^3 s^-2].
+    const Real earthGravitationalParameter;
+
+    //! Earth mean radius [km].
+    const Real earthMeanRadius;
+
+    //! Absolute tolerance [-].
+    const Real absoluteTolerance;
+
+    //! Relative tolerance [-].
+    const Real relativeTolerance;
+
+    //! Maximum number of iterations.
+    const int maximumIterations;
+
+    //! Flag indicating if conversions are warm-started.
+    const bool isWarmStartEnabled;
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    TleFitter( const TleFitter& );
+
+    //! Assignment operator (disabled).
+    TleFitter& operator=( const TleFitter& );
+
+    //! Workspace for GSL solver.
+    SolverWorkspace workspace;
+
+    //! Warm-start state, carried over from one conversion to the next.
+    TleFitWarmStart< Real > warmStart;
+
+    //! Statistics collected by last conversion.
+    SolverStatistics< Real > solverStatistics;
+
+    //! SGP4/SDP4 propagator, allocated once for all conversions.
+    MemoizedSgp4Propagator propagator;
+};
+
 //! Convert Cartesian state to TLE (Two Line Elements).
 template< typename Real, typename Vector6 >
 const Tle convertCartesianStateToTwoLineElements(
@@ -179,96 +756,333 @@ const Tle convertCartesianStateToTwoLineElements(
     const Real earthMeanRadius,
     const Real absoluteTolerance,
     const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType )
+{
+    // Set up diagnostics policy to print solver status summary table.
+    SolverSummaryTable summary( printCartesianToTleSolverStateTableHeader( ) );
+
+    try
+    {
+        const Tle convertedTle = convertCartesianStateToTwoLineElements(
+            cartesianState,
+            epoch,
+            summary,
+            numberOfIterations,
+            referenceTle,
+            earthGravitationalParameter,
+            earthMeanRadius,
+            absoluteTolerance,
+            relativeTolerance,
+            maximumIterations,
+            solverType );
+
+        // Write summary table to solver status summary string.
+        solverStatusSummary = summary.str( );
+
+        return convertedTle;
+    }
+    catch ( const std::runtime_error& )
+    {
+        std::cerr << "GSL solver status: " << summary.status( ) << std::endl;
+        std::cerr << summary.str( ) << std::endl;
+        std::cerr << std::endl;
+        solverStatusSummary = summary.str( );
+        throw;
+    }
+}
+
+//! Convert Cartesian state to TLE (Two Line Elements).
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType )
+{
+    // Set up converter, allocating workspace for solver.
+    TleFitter< Real, Vector6 > fitter( referenceTle,
+                                       earthGravitationalParameter,
+                                       earthMeanRadius,
+                                       absoluteTolerance,
+                                       relativeTolerance,
+                                       maximumIterations,
+                                       solverType );
+
+    return fitter.solve( cartesianState, epoch, diagnostics, numberOfIterations );
+}
+
+//! Convert Cartesian state to TLE (Two Line Elements).
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    SolverWorkspace& workspace,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
     const int maximumIterations )
 {
-    // Store reference TLE as new TLE and update epoch.
-    Tle newTle = referenceTle;
-    newTle.updateEpoch( epoch );
+    // Set up warm-start state without previous conversion, such that solver is started cold.
+    TleFitWarmStart< Real > coldStart;
+
+    return convertCartesianStateToTwoLineElements( cartesianState,
+                                                   epoch,
+                                                   workspace,
+                                                   coldStart,
+                                                   diagnostics,
+                                                   numberOfIterations,
+                                                   referenceTle,
+                                                   earthGravitationalParameter,
+                                                   earthMeanRadius,
+                                                   absoluteTolerance,
+                                                   relativeTolerance,
+                                                   maximumIterations );
+}
 
-    // Set up parameters for residual function.
+//! Convert Cartesian state to TLE (Two Line Elements).
+template< typename Real, typename Vector6, typename Diagnostics >
+const Tle convertCartesianStateToTwoLineElements(
+    const Vector6& cartesianState,
+    const DateTime& epoch,
+    SolverWorkspace& workspace,
+    TleFitWarmStart< Real >& warmStart,
+    Diagnostics& diagnostics,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    SolverStatistics< Real >* statistics,
+    SolverStatus* status,
+    MemoizedSgp4Propagator* propagator,
+    TleConversionCache< Real >* cache,
+    const SolverCancellation* cancellation )
+{
+    // Set up parameters for residual function. The reference TLE is copied once into the working
+    // TLE, which is updated in place by the residual function.
     CartesianToTwoLineElementsParameters< Real, Vector6 > parameters(
-        cartesianState, earthGravitationalParameter, earthMeanRadius, newTle );
+        cartesianState,
+        earthGravitationalParameter,
+        earthMeanRadius,
+        referenceTle,
+        statistics,
+        propagator );
+
+    const SolverStatus conversionStatus = fitTwoLineElements( parameters,
+                                                              epoch,
+                                                              workspace,
+                                                              warmStart,
+                                                              diagnostics,
+                                                              numberOfIterations,
+                                                              referenceTle,
+                                                              absoluteTolerance,
+                                                              relativeTolerance,
+                                                              maximumIterations,
+                                                              cache,
+                                                              cancellation );
+
+    // Return status of conversion if it is requested, else throw if solver failed.
+    if ( status != 0 )
+    {
+        *status = conversionStatus;
+    }
+    else if ( hasSolverFailed( conversionStatus ) )
+    {
+        throw std::runtime_error( printSolverStatus( conversionStatus ) );
+    }
+
+    return parameters.workingTle;
+}
+
+//! Fit TLE (Two Line Elements) to Cartesian state using given parameters.
+template< typename Real, typename Vector6, typename Diagnostics >
+SolverStatus fitTwoLineElements( CartesianToTwoLineElementsParameters< Real, Vector6 >& parameters,
+                                 const DateTime& epoch,
+                                 SolverWorkspace& workspace,
+                                 TleFitWarmStart< Real >& warmStart,
+                                 Diagnostics& diagnostics,
+                                 int& numberOfIterations,
+                                 const Tle& referenceTle,
+                                 const Real absoluteTolerance,
+                                 const Real relativeTolerance,
+                                 const int maximumIterations,
+                                 TleConversionCache< Real >* cache,
+                                 const SolverCancellation* cancellation )
+{
+    const Vector6& cartesianState = parameters.targetState;
+    const Real earthGravitationalParameter = parameters.earthGravitationalParameter;
+    SolverStatistics< Real >* statistics = parameters.statistics;
+
+    // Reset statistics and start timing conversion.
+    double startTime = 0.0;
+    if ( statistics != 0 )
+    {
+        statistics->reset( );
+        startTime = getSolverClockTime( );
+    }
 
-    // Set up residual function.
-    gsl_multiroot_function cartesianToTwoLineElementsFunction
+    // Return converged TLE directly if the conversion has been cached. The warm-start state is not
+    // updated, since the solver is not executed.
+    if ( cache != 0
+         && cache->find(
+            cartesianState, epoch, referenceTle, absoluteTolerance, parameters.workingTle ) )
+    {
+        numberOfIterations = 0;
+        diagnostics.recordStatus( GSL_SUCCESS );
+        if ( statistics != 0 )
+        {
+            statistics->totalTime = getSolverClockTime( ) - startTime;
+            statistics->solverTime = statistics->totalTime;
+        }
+        return solverConverged;
+    }
+
+    // Reset working TLE to reference TLE in place and update its epoch. The flag indicating if the
+    // propagator failed is reset, since the parameters may have been used by earlier conversions.
+    parameters.workingTle = referenceTle;
+    parameters.workingTle.updateEpoch( epoch );
+    parameters.isPropagationFailed = false;
+
+    // Set up residual function and Jacobian functions (only used if solver requires Jacobian).
+    gsl_multiroot_function_fdf cartesianToTwoLineElementsFunction
         = { &computeCartesianToTwoLineElementResiduals< Real, Vector6 >,
+            &computeCartesianToTwoLineElementJacobian< Real, Vector6 >,
+            &computeCartesianToTwoLineElementResidualsAndJacobian< Real, Vector6 >,
             6,
             &parameters };
 
-    // Compute current state in Keplerian elements.
-    const Vector6 keplerianElements = astro::convertCartesianToKeplerianElements(
-        cartesianState, earthGravitationalParameter );
+    // Compute current state in Keplerian elements, without allocating memory.
+    const double keplerianConversionStartTime = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+    Real keplerianElements[ 6 ];
+    computeKeplerianElements( cartesianState, earthGravitationalParameter, keplerianElements );
+    if ( statistics != 0 )
+    {
+        statistics->conversionTime += getSolverClockTime( ) - keplerianConversionStartTime;
+    }
 
-    // Set initial guess.
-    gsl_vector* initialGuess = gsl_vector_alloc( 6 );
+    // Set initial guess, corrected by difference between mean and osculating elements found by
+    // previous conversion if it is available.
+    gsl_vector* initialGuess = workspace.initialGuess;
     for ( int i = 0; i < 6; i++ )
     {
-        gsl_vector_set( initialGuess, i, keplerianElements[ i ] );
+        gsl_vector_set( initialGuess, i,
+                        warmStart.hasElementOffsets
+                            ? keplerianElements[ i ] + warmStart.elementOffsets[ i ]
+                            : keplerianElements[ i ] );
     }
 
-    // Set up solver type (derivative free).
-    const gsl_multiroot_fsolver_type* solverType = gsl_multiroot_fsolver_hybrids;
-
-    // Allocate memory for solver.
-    gsl_multiroot_fsolver* solver = gsl_multiroot_fsolver_alloc( solverType, 6 );
+    // Set solver allocated in workspace to use residual function with initial guess. This
+    // evaluates the residual function at the initial guess, which fails if the SGP4/SDP4
+    // propagator fails.
+    int solverStatus = workspace.set( cartesianToTwoLineElementsFunction );
 
-    // Set solver to use residual function with initial guess.
-    gsl_multiroot_fsolver_set( solver, &cartesianToTwoLineElementsFunction, initialGuess );
-
-     // Declare current solver status and iteration counter.
-    int solverStatus = false;
+     // Declare iteration counter.
     int counter = 0;
 
-    // Set up buffer to store solver status summary table.
-    std::ostringstream summary;
-
-    // Print header for summary table to buffer.
-    summary << printCartesianToTleSolverStateTableHeader( );
+    // Declare flag indicating if conversion has been cancelled.
+    bool isCancelled = false;
 
-    do
+    if ( solverStatus == GSL_SUCCESS )
     {
-        // Print current state of solver for summary table.
-        summary << printCartesianToTleSolverState( counter, solver );
-
-        // Increment iteration counter.
-        ++counter;
-
-        // Execute solver iteration.
-        solverStatus = gsl_multiroot_fsolver_iterate( solver );
-
-        // Check if solver is stuck; if it is stuck, break from loop.
-        if ( solverStatus )
+        do
         {
-            std::cerr << "GSL solver status: " << solverStatus << std::endl;
-            std::cerr << summary.str( ) << std::endl;
-            std::cerr << std::endl;
-            throw std::runtime_error( "ERROR: Non-linear solver is stuck!" );
-        }
-
-        // Check if root has been found (within tolerance).
-        solverStatus = gsl_multiroot_test_delta(
-          solver->dx, solver->x, absoluteTolerance, relativeTolerance );
-    } while ( solverStatus == GSL_CONTINUE && counter < maximumIterations );
+            // Record current state of solver.
+            diagnostics.recordIteration(
+                counter, workspace.x( ), workspace.f( ), workspace.dx( ) );
+
+            // Check if conversion has been cancelled; if it is cancelled, stop at current iterate.
+            if ( cancellation != 0 && cancellation->isCancelled( ) )
+            {
+                isCancelled = true;
+                break;
+            }
+
+            // Increment iteration counter.
+            ++counter;
+
+            // Execute solver iteration.
+            solverStatus = workspace.iterate( );
+
+            // Check if solver is stuck; if it is stuck, break from loop.
+            if ( solverStatus )
+            {
+                break;
+            }
+
+            // Check if root has been found (within tolerance).
+            solverStatus = gsl_multiroot_test_delta(
+              workspace.dx( ), workspace.x( ), absoluteTolerance, relativeTolerance );
+        } while ( solverStatus == GSL_CONTINUE && counter < maximumIterations );
+    }
 
     // Save number of iterations.
-    numberOfIterations = counter - 1;
-
-    // Print final status of solver to buffer.
-    summary << std::endl;
-    summary << "Status of non-linear solver: " << gsl_strerror( solverStatus ) << std::endl;
-    summary << std::endl;
-
-    // Write buffer contents to solver status summary string.
-    solverStatusSummary = summary.str( );
+    numberOfIterations = ( counter > 0 ) ? counter - 1 : 0;
+
+    // Record final status of solver.
+    diagnostics.recordStatus( solverStatus );
+
+    // Determine status of conversion.
+    const SolverStatus conversionStatus
+        = ( solverStatus == GSL_SUCCESS ) ? solverConverged
+        : ( isCancelled ) ? solverCancelled
+        : ( solverStatus == GSL_CONTINUE ) ? solverMaximumIterationsReached
+        : ( parameters.isPropagationFailed ) ? solverPropagationFailed
+        : solverStuck;
+
+    // Store difference between converged mean elements and osculating elements to warm-start
+    // next conversion. Differences in angles are wrapped to [-pi, pi).
+    if ( solverStatus == GSL_SUCCESS )
+    {
+        for ( int i = 0; i < 6; i++ )
+        {
+            warmStart.elementOffsets[ i ]
+                = gsl_vector_get( workspace.x( ), i ) - keplerianElements[ i ];
+            if ( i >= astro::inclinationIndex )
+            {
+                warmStart.elementOffsets[ i ]
+                    = sml::computeModulo( warmStart.elementOffsets[ i ] + sml::SML_PI,
+                                          2.0 * sml::SML_PI ) - sml::SML_PI;
+            }
+        }
+        warmStart.hasElementOffsets = true;
+    }
 
     // Update TLE with converged mean elements.
-    newTle = updateTleMeanElements( solver->x, newTle, earthGravitationalParameter );
+    updateTleMeanElements( workspace.x( ), earthGravitationalParameter, parameters.workingTle );
 
-    // Free up memory.
-    gsl_multiroot_fsolver_free( solver );
-    gsl_vector_free( initialGuess );
+    // Store remaining statistics. The time that is not spent in the residual function is spent in
+    // the GSL solver.
+    if ( statistics != 0 )
+    {
+        statistics->numberOfIterations = numberOfIterations;
+        statistics->finalResidualNorm = computeResidualNorm< Real >( workspace.f( ) );
+        statistics->totalTime = getSolverClockTime( ) - startTime;
+        statistics->solverTime
+            = statistics->totalTime - statistics->propagationTime - statistics->conversionTime;
+    }
 
-    return newTle;
+    // Store converged TLE in cache.
+    if ( cache != 0 && conversionStatus == solverConverged )
+    {
+        cache->insert(
+            cartesianState, epoch, referenceTle, absoluteTolerance, parameters.workingTle );
+    }
+
+    return conversionStatus;
 }
 
 //! Convert Cartesian state to TLE (Two Line Elements).
@@ -276,10 +1090,10 @@ template< typename Real, typename Vector6 >
 const Tle convertCartesianStateToTwoLineElements( const Vector6& cartesianState,
                                                   const DateTime& epoch )
 {
-    std::string dummyString = "";
+    NoSolverDiagnostics diagnostics;
     int dummyint = 0;
     return convertCartesianStateToTwoLineElements< Real >(
-        cartesianState, epoch, dummyString, dummyint );
+        cartesianState, epoch, diagnostics, dummyint );
 }
 
 //! Compute residuals for converting Cartesian state to TLE.
@@ -288,56 +1102,142 @@ int computeCartesianToTwoLineElementResiduals( const gsl_vector* independentVari
                                                void* parameters,
                                                gsl_vector* residuals )
 {
-    // Store parameters locally.
-    const Vector6 targetState
-        = static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >(
-            parameters )->targetState;
+    // Access parameters by reference, to avoid copying them for every evaluation.
+    CartesianToTwoLineElementsParameters< Real, Vector6 >& cartesianToTleParameters
+        = *static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >( parameters );
 
-    const Real earthGravitationalParameter
-        = static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >(
-            parameters )->earthGravitationalParameter;
+    const Vector6& targetState = cartesianToTleParameters.targetState;
+    const Real earthGravitationalParameter = cartesianToTleParameters.earthGravitationalParameter;
+    const Real earthMeanRadius = cartesianToTleParameters.earthMeanRadius;
+    SolverStatistics< Real >* statistics = cartesianToTleParameters.statistics;
 
-    const Real earthMeanRadius
-        = static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >(
-            parameters )->earthMeanRadius;
+    if ( statistics != 0 )
+    {
+        ++statistics->numberOfResidualEvaluations;
+    }
 
-    const Tle referenceTle
-        = static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >(
-            parameters )->referenceTle;
+    // Compute circular velocity at Earth radius (scaling fact used to non-dimensionalize
+    // velocities) [km/s].
+    const Real circularVelocityEarthRadius = astro::computeCircularVelocity(
+        kXKMPER, earthGravitationalParameter );
 
-    // Update TLE mean elements and store as new TLE.
-    Tle newTle = updateTleMeanElements(
-        independentVariables, referenceTle, earthGravitationalParameter );
+    // Mean elements that the propagator rejects, e.g., a negative eccentricity or a perigee below
+    // the surface of the Earth, cause a runtime error to be thrown when the working TLE is
+    // initialized. The error is caught, flagged in the parameters and reported to the GSL solver as
+    // a failed evaluation, which stops iterating.
+    try
+    {
+        // Update mean elements of working TLE in place.
+        const double conversionStartTime = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+        updateTleMeanElements( independentVariables,
+                               earthGravitationalParameter,
+                               cartesianToTleParameters.workingTle );
+
+        // Propagate working TLE to epoch of TLE. The propagator is left initialized with the
+        // working TLE, such that the caller can propagate the converged TLE without initializing
+        // the propagator again.
+        MemoizedSgp4Propagator& propagator = cartesianToTleParameters.propagator;
+        propagator.setTle( cartesianToTleParameters.workingTle );
+        const double propagationStartTime = ( statistics != 0 ) ? getSolverClockTime( ) : 0.0;
+        Eci propagatedState = propagator.findPosition( 0.0 );
+        if ( statistics != 0 )
+        {
+            const double propagationEndTime = getSolverClockTime( );
+            statistics->conversionTime += propagationStartTime - conversionStartTime;
+            statistics->propagationTime += propagationEndTime - propagationStartTime;
+        }
+
+        // Evaluate system of non-linear equations and store residuals.
+        gsl_vector_set( residuals, 0,
+                        ( propagatedState.Position( ).x - targetState[ 0 ] ) / earthMeanRadius );
+        gsl_vector_set( residuals, 1,
+                        ( propagatedState.Position( ).y - targetState[ 1 ] ) / earthMeanRadius );
+        gsl_vector_set( residuals, 2,
+                        ( propagatedState.Position( ).z - targetState[ 2 ] ) / earthMeanRadius );
+        gsl_vector_set( residuals, 3,
+                        ( propagatedState.Velocity( ).x - targetState[ 3 ] )
+                        / circularVelocityEarthRadius );
+        gsl_vector_set( residuals, 4,
+                        ( propagatedState.Velocity( ).y - targetState[ 4 ] )
+                        / circularVelocityEarthRadius );
+        gsl_vector_set( residuals, 5,
+                        ( propagatedState.Velocity( ).z - targetState[ 5 ] )
+                        / circularVelocityEarthRadius );
+    }
+    catch ( const std::runtime_error& )
+    {
+        cartesianToTleParameters.isPropagationFailed = true;
+        return GSL_EFAILED;
+    }
+
+    return GSL_SUCCESS;
+}
 
-    // Propagate new TLE to epoch of TLE.
-    SGP4 sgp4( newTle );
-    Eci propagatedState = sgp4.FindPosition( 0.0 );
+//! Compute Jacobian for converting Cartesian state to TLE.
+template< typename Real, typename Vector6 >
+int computeCartesianToTwoLineElementJacobian( const gsl_vector* independentVariables,
+                                              void* parameters,
+                                              gsl_matrix* jacobian )
+{
+    const CartesianToTwoLineElementsParameters< Real, Vector6 >& cartesianToTleParameters
+        = *static_cast< CartesianToTwoLineElementsParameters< Real, Vector6 >* >( parameters );
+
+    // Compute partial derivatives of two-body Cartesian state with respect to Keplerian elements.
+    Real keplerianElements[ 6 ];
+    for ( int i = 0; i < 6; i++ )
+    {
+        keplerianElements[ i ] = gsl_vector_get( independentVariables, i );
+    }
+
+    if ( cartesianToTleParameters.statistics != 0 )
+    {
+        ++cartesianToTleParameters.statistics->numberOfJacobianEvaluations;
+    }
+
+    Real cartesianPartials[ 6 ][ 6 ];
+    computeKeplerianToCartesianJacobian( keplerianElements,
+                                         cartesianToTleParameters.earthGravitationalParameter,
+                                         cartesianPartials );
 
     // Compute circular velocity at Earth radius (scaling fact used to non-dimensionalize
     // velocities) [km/s].
     const Real circularVelocityEarthRadius = astro::computeCircularVelocity(
-        kXKMPER, earthGravitationalParameter );
+        kXKMPER, cartesianToTleParameters.earthGravitationalParameter );
 
-    // Evaluate system of non-linear equations and store residuals.
-    gsl_vector_set( residuals, 0,
-                    ( propagatedState.Position( ).x - targetState[ 0 ] ) / earthMeanRadius );
-    gsl_vector_set( residuals, 1,
-                    ( propagatedState.Position( ).y - targetState[ 1 ] ) / earthMeanRadius );
-    gsl_vector_set( residuals, 2,
-                    ( propagatedState.Position( ).z - targetState[ 2 ] ) / earthMeanRadius );
-    gsl_vector_set( residuals, 3,
-                    ( propagatedState.Velocity( ).x - targetState[ 3 ] )
-                    / circularVelocityEarthRadius );
-    gsl_vector_set( residuals, 4,
-                    ( propagatedState.Velocity( ).y - targetState[ 4 ] )
-                    / circularVelocityEarthRadius );
-    gsl_vector_set( residuals, 5,
-                    ( propagatedState.Velocity( ).z - targetState[ 5 ] )
-                    / circularVelocityEarthRadius );
+    // Scale partial derivatives in the same way as the residuals.
+    for ( int j = 0; j < 6; j++ )
+    {
+        for ( int i = 0; i < 3; i++ )
+        {
+            gsl_matrix_set( jacobian, i, j,
+                            cartesianPartials[ i ][ j ]
+                            / cartesianToTleParameters.earthMeanRadius );
+            gsl_matrix_set( jacobian, i + 3, j,
+                            cartesianPartials[ i + 3 ][ j ] / circularVelocityEarthRadius );
+        }
+    }
 
     return GSL_SUCCESS;
 }
 
+//! Compute residuals and Jacobian for converting Cartesian state to TLE.
+template< typename Real, typename Vector6 >
+int computeCartesianToTwoLineElementResidualsAndJacobian( const gsl_vector* independentVariables,
+                                                          void* parameters,
+                                                          gsl_vector* residuals,
+                                                          gsl_matrix* jacobian )
+{
+    const int residualStatus = computeCartesianToTwoLineElementResiduals< Real, Vector6 >(
+        independentVariables, parameters, residuals );
+    if ( residualStatus != GSL_SUCCESS )
+    {
+        return residualStatus;
+    }
+
+    return computeCartesianToTwoLineElementJacobian< Real, Vector6 >(
+        independentVariables, parameters, jacobian );
+}
+
 //! Update TLE mean elements.
 template< typename Real >
 const Tle updateTleMeanElements( const gsl_vector* newKeplerianElements,
@@ -347,6 +1247,18 @@ const Tle updateTleMeanElements( const gsl_vector* newKeplerianElements,
     // Copy old TLE to new object.
     Tle newTle( oldTle );
 
+    // Update mean elements of new TLE.
+    updateTleMeanElements( newKeplerianElements, earthGravitationalParameter, newTle );
+
+    return newTle;
+}
+
+//! Update TLE mean elements in place.
+template< typename Real >
+void updateTleMeanElements( const gsl_vector* newKeplerianElements,
+                            const Real earthGravitationalParameter,
+                            Tle& tle )
+{
     // Compute new mean inclination [deg].
     const Real newInclination
         = sml::computeModulo(
@@ -386,17 +1298,16 @@ const Tle updateTleMeanElements( const gsl_vector* newKeplerianElements,
     const Real newMeanMotion
         = astro::computeKeplerMeanMotion(
             gsl_vector_get( newKeplerianElements, astro::semiMajorAxisIndex ),
-            earthGravitationalParameter ) / ( 2.0 * sml::SML_PI ) * astro::ASTRO_JULIAN_DAY_IN_SECONDS;
+            earthGravitationalParameter )
+        / ( 2.0 * sml::SML_PI ) * astro::ASTRO_JULIAN_DAY_IN_SECONDS;
 
     // Update mean elements in TLE with osculating elements.
-    newTle.updateMeanElements( newInclination,
-                               newRightAscendingNode,
-                               newEccentricity,
-                               newArgumentPerigee,
-                               newMeanAnomaly,
-                               newMeanMotion );
-
-    return newTle;
+    tle.updateMeanElements( newInclination,
+                            newRightAscendingNode,
+                            newEccentricity,
+                            newArgumentPerigee,
+                            newMeanAnomaly,
+                            newMeanMotion );
 }
 
 //! Parameter struct used by Cartesian-to-TLE residual function.
@@ -407,26 +1318,41 @@ public:
 
     //! Constructor taking parameter values.
     /*!
-     * Default constructor, taking parameters for Cartesian-to-Two-Line-Elements conversion.
+     * Default constructor, taking parameters for Cartesian-to-Two-Line-Elements conversion. The
+     * target state is stored by reference and must outlive the parameters. The reference TLE is
+     * copied into the working TLE, which is updated in place by the residual function, such that
+     * evaluating the residual function does not allocate any memory.
      * @sa convertCartesianStateToTwoLineElements, computeCartesianToTwoLineElementResiduals
      * @param aTargetState                  Target Cartesian state [km; km/s]
      * @param anEarthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
      * @param anEarthMeanRadius             Earth mean radius [km]
      * @param aReferenceTle                 Reference Two-Line-Elements
+     * @param someStatistics                Statistics updated by residual function and Jacobian;
+     *                                      if it is not set, no statistics are collected
+     *                                      [default: 0]
+     * @param aPropagator                   SGP4/SDP4 propagator used by residual function; if it
+     *                                      is not set, the propagator owned by the parameters is
+     *                                      used [default: 0]
      */
     CartesianToTwoLineElementsParameters(
         const Vector6& aTargetState,
         const Real anEarthGravitationalParameter,
         const Real anEarthMeanRadius,
-        const Tle& aReferenceTle )
+        const Tle& aReferenceTle,
+        SolverStatistics< Real >* someStatistics = 0,
+        MemoizedSgp4Propagator* aPropagator = 0 )
         : targetState( aTargetState ),
           earthGravitationalParameter( anEarthGravitationalParameter ),
           earthMeanRadius( anEarthMeanRadius ),
-          referenceTle( aReferenceTle )
+          workingTle( aReferenceTle ),
+          statistics( someStatistics ),
+          isPropagationFailed( false ),
+          localPropagator( ),
+          propagator( ( aPropagator != 0 ) ? *aPropagator : localPropagator )
     { }
 
     //! Target state in Cartesian elements [km; km/s].
-    const Vector6 targetState;
+    const Vector6& targetState;
 
     //! Earth gravitational parameter [km^3 s^-2].
     const Real earthGravitationalParameter;
@@ -434,14 +1360,115 @@ public:
     //! Earth mean radius [km].
     const Real earthMeanRadius;
 
-    //! Reference TLE.
-    const Tle referenceTle;
+    //! Working TLE, updated with current mean elements by residual function.
+    Tle workingTle;
+
+    //! Statistics collected by residual function and Jacobian.
+    SolverStatistics< Real >* const statistics;
+
+    //! Flag indicating if the SGP4/SDP4 propagator failed during an evaluation.
+    bool isPropagationFailed;
+
+    //! SGP4/SDP4 propagator owned by parameters, used if no propagator is given.
+    MemoizedSgp4Propagator localPropagator;
+
+    //! SGP4/SDP4 propagator used by residual function, left initialized with the working TLE of
+    //! the last evaluation.
+    MemoizedSgp4Propagator& propagator;
 
 protected:
 
 private:
 };
 
+//! Warm-start state for Cartesian-to-TLE conversions.
+template< typename Real >
+struct TleFitWarmStart
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up warm-start state without previous conversion, such that the
+     * first conversion is started cold.
+     */
+    TleFitWarmStart( )
+        : hasElementOffsets( false )
+    {
+        for ( int i = 0; i < 6; i++ )
+        {
+            elementOffsets[ i ] = 0.0;
+        }
+    }
+
+    //! Flag indicating if element offsets have been set by a converged conversion.
+    bool hasElementOffsets;
+
+    //! Converged mean elements minus osculating elements [km, -, rad, rad, rad, rad].
+    Real elementOffsets[ 6 ];
+
+protected:
+
+private:
+};
+
+#ifdef ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
+//! Declare explicit instantiations of Cartesian-to-TLE conversion for given vector type.
+/*!
+ * Declares explicit instantiations of the Cartesian-to-TLE conversion, its converter class and
+ * its residual functions for Real set to double and the given type for 6-vector of reals.
+ *
+ * @sa precompiledInstantiations.hpp
+ */
+#define ATOM_EXTERN_TLE_CONVERSION_TEMPLATES( ... )                                                \
+    ATOM_EXTERN_TEMPLATE class TleFitter< double, __VA_ARGS__ >;                                   \
+    ATOM_EXTERN_TEMPLATE const Tle convertCartesianStateToTwoLineElements< double, __VA_ARGS__ >(  \
+        const __VA_ARGS__&, const DateTime&, std::string&, int&, const Tle&, const double,         \
+        const double, const double, const double, const int, const SolverType );                   \
+    ATOM_EXTERN_TEMPLATE const Tle convertCartesianStateToTwoLineElements< double, __VA_ARGS__ >(  \
+        const __VA_ARGS__&, const DateTime& );                                                     \
+    ATOM_EXTERN_TEMPLATE const Tle                                                                 \
+    convertCartesianStateToTwoLineElements< double, __VA_ARGS__, NoSolverDiagnostics >(            \
+        const __VA_ARGS__&, const DateTime&, NoSolverDiagnostics&, int&, const Tle&,               \
+        const double, const double, const double, const double, const int, const SolverType );     \
+    ATOM_EXTERN_TEMPLATE const Tle                                                                 \
+    convertCartesianStateToTwoLineElements< double, __VA_ARGS__, SolverSummaryTable >(             \
+        const __VA_ARGS__&, const DateTime&, SolverSummaryTable&, int&, const Tle&,                \
+        const double, const double, const double, const double, const int, const SolverType );     \
+    ATOM_EXTERN_TEMPLATE const Tle                                                                 \
+    convertCartesianStateToTwoLineElements< double, __VA_ARGS__, NoSolverDiagnostics >(            \
+        const __VA_ARGS__&, const DateTime&, SolverWorkspace&, TleFitWarmStart< double >&,         \
+        NoSolverDiagnostics&, int&, const Tle&, const double, const double, const double,          \
+        const double, const int, SolverStatistics< double >*, SolverStatus*,                       \
+        MemoizedSgp4Propagator*, TleConversionCache< double >*, const SolverCancellation* );       \
+    ATOM_EXTERN_TEMPLATE const Tle                                                                 \
+    convertCartesianStateToTwoLineElements< double, __VA_ARGS__, SolverSummaryTable >(             \
+        const __VA_ARGS__&, const DateTime&, SolverWorkspace&, TleFitWarmStart< double >&,         \
+        SolverSummaryTable&, int&, const Tle&, const double, const double, const double,           \
+        const double, const int, SolverStatistics< double >*, SolverStatus*,                       \
+        MemoizedSgp4Propagator*, TleConversionCache< double >*, const SolverCancellation* );       \
+    ATOM_EXTERN_TEMPLATE SolverStatus                                                              \
+    fitTwoLineElements< double, __VA_ARGS__, NoSolverDiagnostics >(                                \
+        CartesianToTwoLineElementsParameters< double, __VA_ARGS__ >&, const DateTime&,             \
+        SolverWorkspace&, TleFitWarmStart< double >&, NoSolverDiagnostics&, int&, const Tle&,      \
+        const double, const double, const int, TleConversionCache< double >*,                      \
+        const SolverCancellation* );                                                               \
+    ATOM_EXTERN_TEMPLATE int computeCartesianToTwoLineElementResiduals< double, __VA_ARGS__ >(     \
+        const gsl_vector*, void*, gsl_vector* );                                                   \
+    ATOM_EXTERN_TEMPLATE int computeCartesianToTwoLineElementJacobian< double, __VA_ARGS__ >(      \
+        const gsl_vector*, void*, gsl_matrix* );                                                   \
+    ATOM_EXTERN_TEMPLATE int                                                                       \
+    computeCartesianToTwoLineElementResidualsAndJacobian< double, __VA_ARGS__ >(                   \
+        const gsl_vector*, void*, gsl_vector*, gsl_matrix* );
+
+ATOM_EXTERN_TLE_CONVERSION_TEMPLATES( std::vector< double > )
+#ifdef ATOM_USE_PRECOMPILED_EIGEN_INSTANTIATIONS
+ATOM_EXTERN_TLE_CONVERSION_TEMPLATES( Eigen::VectorXd )
+#endif
+
+#endif // ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
 } // namespace atom
 
 #endif // ATOM_CONVERT_CARTESIAN_STATE_TO_TWO_LINE_ELEMENTS_H
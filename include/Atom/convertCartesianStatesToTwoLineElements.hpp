@@ -0,0 +1,559 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_CONVERT_CARTESIAN_STATES_TO_TWO_LINE_ELEMENTS_H
+#define ATOM_CONVERT_CARTESIAN_STATES_TO_TWO_LINE_ELEMENTS_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include <Atom/convertCartesianStateToTwoLineElements.hpp>
+#include <Atom/solverStatus.hpp>
+#include <Atom/solverWorkspace.hpp>
+
+namespace atom
+{
+
+//! Size of TLE record written by bulk Cartesian-to-TLE converter [characters].
+/*!
+ * Size of record containing the two lines of a TLE, each of which is 69 characters long and
+ * terminated by a newline character. Records are not null-terminated.
+ *
+ * @sa writeTwoLineElements, convertCartesianStatesToTwoLineElements
+ */
+const std::size_t kTwoLineElementsRecordSize = 140;
+
+//! Write TLE lines to record.
+/*!
+ * Writes the two lines of given TLE to a record of kTwoLineElementsRecordSize characters, in the
+ * fixed-width format defined by NORAD, including the checksums. The lines are formatted from the
+ * elements stored in the TLE into buffers on the stack, such that no memory is allocated. The
+ * classification and element set number are not stored in the elements of a TLE, so they are
+ * passed separately. If an element does not fit the width of its field, the record is cleared.
+ *
+ * @sa kTwoLineElementsRecordSize, convertCartesianStatesToTwoLineElements
+ * @param  tle              TLE to write
+ * @param  record           Pointer to first character of record, which must be able to hold
+ *                          kTwoLineElementsRecordSize characters
+ * @param  classification   Classification of TLE [default: 'U']
+ * @param  elementSetNumber Element set number of TLE [default: 0]
+ * @return                  Flag indicating if all elements fit the widths of their fields
+ */
+inline bool writeTwoLineElements( const Tle& tle,
+                                  char* record,
+                                  const char classification = 'U',
+                                  const int elementSetNumber = 0 );
+
+//! Clear TLE record.
+/*!
+ * Fills record with spaces, keeping the newline characters that terminate the lines.
+ *
+ * @sa writeTwoLineElements
+ * @param record Pointer to first character of record, which must be able to hold
+ *               kTwoLineElementsRecordSize characters
+ */
+inline void clearTwoLineElements( char* record );
+
+//! Write field in TLE exponential notation.
+/*!
+ * Writes value to 8-character field in the exponential notation used by TLEs, with an assumed
+ * leading decimal point, e.g., -11606-4 for -1.1606e-5, followed by a null character.
+ *
+ * @sa writeTwoLineElements
+ * @param  value Value to write
+ * @param  field Pointer to first character of field, which must be able to hold 9 characters
+ * @return       Flag indicating if value fits the width of the field
+ */
+inline bool writeTleExponentialField( const double value, char* field );
+
+//! Compute checksum of TLE line.
+/*!
+ * Computes checksum of first 68 characters of TLE line, which is the sum of all digits, counting
+ * minus signs as one, modulo 10.
+ *
+ * @sa writeTwoLineElements
+ * @param  line Pointer to first character of TLE line
+ * @return      Checksum character
+ */
+inline char computeTleChecksum( const char* line );
+
+//! Convert Cartesian states to TLEs in bulk.
+/*!
+ * Converts a contiguous array of Cartesian states to TLEs and writes the TLE lines to a
+ * preallocated buffer of records, for catalog-scale conversions of state vectors streamed from
+ * ephemeris feeds. Each state is read once. The states are distributed across a pool of threads
+ * in chunks of consecutive states, such that warm-started conversions start from the previous
+ * state in the input. Each thread owns one Cartesian-to-TLE converter, which is reused for all of
+ * the states that the thread converts. The TLE lines are formatted directly into the buffer,
+ * rather than through the lines stored as strings by the TLEs.
+ *
+ * Records are written in the same order as the states. States are converted without throwing
+ * exceptions, such that one failing conversion does not abort the conversion of the remaining
+ * states. The status of each conversion is stored; the records of conversions that have not
+ * converged are filled with spaces. The records of converged TLEs whose elements do not fit the
+ * TLE format are also filled with spaces, and their status is set to solverTleFormatFailed. The
+ * catalog
+ * number, international designator, drag terms, classification and element set number of the
+ * TLEs are taken from the reference TLE.
+ *
+ * Large catalogs can be streamed by calling this function for successive blocks of states,
+ * reusing the same buffers.
+ *
+ * @sa convertCartesianStateToTwoLineElements, TleFitter, writeTwoLineElements
+ * @tparam Real                        Type for reals
+ * @param  cartesianStates             Pointer to first element of contiguous array of Cartesian
+ *                                     states, stored as six consecutive elements per state
+ *                                     [km; km/s]
+ * @param  epochs                      Pointer to first epoch in contiguous array of epochs
+ *                                     associated with Cartesian states
+ * @param  numberOfStates              Number of states in array
+ * @param  records                     Pointer to first character of buffer of records, which must
+ *                                     be able to hold numberOfStates * kTwoLineElementsRecordSize
+ *                                     characters
+ * @param  statuses                    Pointer to first status in contiguous array of statuses,
+ *                                     which must be able to hold numberOfStates statuses
+ * @param  numberOfThreads             Number of threads used to convert states; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100]
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if each conversion is warm-started by the
+ *                                     previous conversion in the same chunk [default: false]
+ * @param  numberOfIterations          Pointer to first element in contiguous array of numbers of
+ *                                     iterations completed by solver per state; if it is not set,
+ *                                     the numbers of iterations are not stored [default: 0]
+ */
+template< typename Real >
+void convertCartesianStatesToTwoLineElements( const Real* cartesianStates,
+                                              const DateTime* epochs,
+                                              const std::size_t numberOfStates,
+                                              char* records,
+                                              SolverStatus* statuses,
+                                              const unsigned int numberOfThreads = 0,
+                                              const Tle& referenceTle = Tle( ),
+                                              const Real earthGravitationalParameter = kMU,
+                                              const Real earthMeanRadius = kXKMPER,
+                                              const Real absoluteTolerance = 1.0e-10,
+                                              const Real relativeTolerance = 1.0e-5,
+                                              const int maximumIterations = 100,
+                                              const SolverType solverType = hybridsSolver,
+                                              const bool isWarmStartEnabled = false,
+                                              int* numberOfIterations = 0 );
+
+//! Convert chunks of Cartesian states to TLEs until states are exhausted.
+/*!
+ * Converts chunks of consecutive Cartesian states to TLEs, using a converter that is allocated
+ * once per call. The index of the next chunk to convert is shared between all threads working on
+ * the same states.
+ *
+ * @sa convertCartesianStatesToTwoLineElements
+ * @tparam Real                        Type for reals
+ * @param  cartesianStates             Pointer to first element of contiguous array of Cartesian
+ *                                     states [km; km/s]
+ * @param  epochs                      Pointer to first epoch in contiguous array of epochs
+ * @param  numberOfStates              Number of states in array
+ * @param  records                     Pointer to first character of buffer of records
+ * @param  statuses                    Pointer to first status in contiguous array of statuses
+ * @param  numberOfIterations          Pointer to first element in contiguous array of numbers of
+ *                                     iterations (not stored if it is not set)
+ * @param  nextChunk                   Index of next chunk to convert, shared between threads
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used to check for convergence
+ * @param  relativeTolerance           Relative tolerance used to check for convergence
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ * @param  solverType                  Type of GSL solver
+ * @param  isWarmStartEnabled          Flag indicating if conversions are warm-started
+ * @param  classification              Classification written to TLE records
+ * @param  elementSetNumber            Element set number written to TLE records
+ */
+template< typename Real >
+void convertCartesianStateChunks( const Real* cartesianStates,
+                                  const DateTime* epochs,
+                                  const std::size_t numberOfStates,
+                                  char* records,
+                                  SolverStatus* statuses,
+                                  int* numberOfIterations,
+                                  std::atomic< std::size_t >& nextChunk,
+                                  const Tle& referenceTle,
+                                  const Real earthGravitationalParameter,
+                                  const Real earthMeanRadius,
+                                  const Real absoluteTolerance,
+                                  const Real relativeTolerance,
+                                  const int maximumIterations,
+                                  const SolverType solverType,
+                                  const bool isWarmStartEnabled,
+                                  const char classification,
+                                  const int elementSetNumber );
+
+//! Number of consecutive states in chunk converted by one thread.
+const std::size_t kCartesianStateChunkSize = 64;
+
+//! Write TLE lines to record.
+inline bool writeTwoLineElements( const Tle& tle,
+                                  char* record,
+                                  const char classification,
+                                  const int elementSetNumber )
+{
+    // Line buffer, holding 69 characters and null character written by snprintf.
+    char line[ 70 ];
+
+    // Compute epoch year and fractional day of year.
+    const DateTime epoch = tle.Epoch( );
+    const int epochYear = epoch.Year( );
+    const double epochDayOfYear
+        = 1.0 + ( epoch - DateTime( epochYear, 1, 1 ) ).TotalSeconds( ) / 86400.0;
+
+    // Write first time derivative of mean motion, divided by two, with assumed leading zero.
+    const double meanMotionDt2 = tle.MeanMotionDt2( );
+    long meanMotionDt2Digits = std::lround( std::fabs( meanMotionDt2 ) * 1.0e8 );
+    if ( meanMotionDt2Digits > 99999999 )
+    {
+        meanMotionDt2Digits = 99999999;
+    }
+
+    char meanMotionDdt6Field[ 9 ];
+    char bStarField[ 9 ];
+    if ( !writeTleExponentialField( tle.MeanMotionDdt6( ), meanMotionDdt6Field )
+         || !writeTleExponentialField( tle.BStar( ), bStarField ) )
+    {
+        clearTwoLineElements( record );
+        return false;
+    }
+
+    // International designator is short enough to be stored without allocating memory.
+    const std::string internationalDesignator = tle.IntDesignator( );
+
+    const int line1Length = std::snprintf(
+        line, sizeof( line ), "1 %05u%c %-8.8s %02d%012.8f %c.%08ld %s %s 0 %4d",
+        tle.NoradNumber( ) % 100000,
+        classification,
+        internationalDesignator.c_str( ),
+        epochYear % 100,
+        epochDayOfYear,
+        ( meanMotionDt2 < 0.0 ) ? '-' : ' ',
+        meanMotionDt2Digits,
+        meanMotionDdt6Field,
+        bStarField,
+        elementSetNumber % 10000 );
+    if ( line1Length != 68 )
+    {
+        clearTwoLineElements( record );
+        return false;
+    }
+    std::memcpy( record, line, 68 );
+    record[ 68 ] = computeTleChecksum( record );
+    record[ 69 ] = '\n';
+
+    // Write second line, with angles normalized to [0, 360) degrees.
+    double rightAscendingNode = std::fmod( tle.RightAscendingNode( true ), 360.0 );
+    if ( rightAscendingNode < 0.0 )
+    {
+        rightAscendingNode += 360.0;
+    }
+    double argumentPerigee = std::fmod( tle.ArgumentPerigee( true ), 360.0 );
+    if ( argumentPerigee < 0.0 )
+    {
+        argumentPerigee += 360.0;
+    }
+    double meanAnomaly = std::fmod( tle.MeanAnomaly( true ), 360.0 );
+    if ( meanAnomaly < 0.0 )
+    {
+        meanAnomaly += 360.0;
+    }
+
+    long eccentricityDigits = std::lround( tle.Eccentricity( ) * 1.0e7 );
+    if ( eccentricityDigits > 9999999 )
+    {
+        eccentricityDigits = 9999999;
+    }
+
+    const int line2Length = std::snprintf(
+        line, sizeof( line ), "2 %05u %8.4f %8.4f %07ld %8.4f %8.4f %11.8f%5u",
+        tle.NoradNumber( ) % 100000,
+        tle.Inclination( true ),
+        rightAscendingNode,
+        eccentricityDigits,
+        argumentPerigee,
+        meanAnomaly,
+        tle.MeanMotion( ),
+        tle.OrbitNumber( ) % 100000 );
+    if ( line2Length != 68 )
+    {
+        clearTwoLineElements( record );
+        return false;
+    }
+    std::memcpy( record + 70, line, 68 );
+    record[ 138 ] = computeTleChecksum( record + 70 );
+    record[ 139 ] = '\n';
+
+    return true;
+}
+
+//! Clear TLE record.
+inline void clearTwoLineElements( char* record )
+{
+    std::memset( record, ' ', kTwoLineElementsRecordSize );
+    record[ 69 ] = '\n';
+    record[ 139 ] = '\n';
+}
+
+//! Write field in TLE exponential notation.
+inline bool writeTleExponentialField( const double value, char* field )
+{
+    // Split magnitude into five-digit mantissa with assumed leading decimal point and exponent.
+    long mantissa = 0;
+    int exponent = 0;
+    const double magnitude = std::fabs( value );
+    if ( magnitude > 0.0 )
+    {
+        exponent = static_cast< int >( std::floor( std::log10( magnitude ) ) ) + 1;
+        mantissa = std::lround( magnitude * std::pow( 10.0, 5 - exponent ) );
+        if ( mantissa > 99999 )
+        {
+            mantissa /= 10;
+            ++exponent;
+        }
+
+        // Clamp values that cannot be represented by a single-digit exponent.
+        if ( exponent < -9 )
+        {
+            mantissa = 0;
+            exponent = 0;
+        }
+        else if ( exponent > 9 )
+        {
+            mantissa = 99999;
+            exponent = 9;
+        }
+    }
+
+    return std::snprintf( field, 9, "%c%05ld%c%d",
+                          ( value < 0.0 && mantissa > 0 ) ? '-' : ' ',
+                          mantissa,
+                          ( exponent > 0 ) ? '+' : '-',
+                          std::abs( exponent ) ) == 8;
+}
+
+//! Compute checksum of TLE line.
+inline char computeTleChecksum( const char* line )
+{
+    int checksum = 0;
+    for ( int i = 0; i < 68; i++ )
+    {
+        if ( line[ i ] >= '0' && line[ i ] <= '9' )
+        {
+            checksum += line[ i ] - '0';
+        }
+        else if ( line[ i ] == '-' )
+        {
+            checksum += 1;
+        }
+    }
+    return static_cast< char >( '0' + checksum % 10 );
+}
+
+//! Convert Cartesian states to TLEs in bulk.
+template< typename Real >
+void convertCartesianStatesToTwoLineElements( const Real* cartesianStates,
+                                              const DateTime* epochs,
+                                              const std::size_t numberOfStates,
+                                              char* records,
+                                              SolverStatus* statuses,
+                                              const unsigned int numberOfThreads,
+                                              const Tle& referenceTle,
+                                              const Real earthGravitationalParameter,
+                                              const Real earthMeanRadius,
+                                              const Real absoluteTolerance,
+                                              const Real relativeTolerance,
+                                              const int maximumIterations,
+                                              const SolverType solverType,
+                                              const bool isWarmStartEnabled,
+                                              int* numberOfIterations )
+{
+    // Read classification and element set number from reference TLE once.
+    char classification = 'U';
+    int elementSetNumber = 0;
+    const std::string referenceLine1 = referenceTle.Line1( );
+    if ( referenceLine1.size( ) >= 68 )
+    {
+        classification = referenceLine1[ 7 ];
+        elementSetNumber = std::atoi( referenceLine1.substr( 64, 4 ).c_str( ) );
+    }
+
+    // Set number of threads that are used, such that no thread is left without chunks.
+    const std::size_t numberOfChunks
+        = ( numberOfStates + kCartesianStateChunkSize - 1 ) / kCartesianStateChunkSize;
+    std::size_t threadCount = numberOfThreads;
+    if ( threadCount == 0 )
+    {
+        threadCount = std::thread::hardware_concurrency( );
+    }
+    if ( threadCount > numberOfChunks )
+    {
+        threadCount = numberOfChunks;
+    }
+    if ( threadCount == 0 )
+    {
+        threadCount = 1;
+    }
+
+    // Set index of next chunk to convert.
+    std::atomic< std::size_t > nextChunk( 0 );
+
+    // Launch worker threads; the calling thread also converts states.
+    std::vector< std::thread > workers;
+    workers.reserve( threadCount - 1 );
+    for ( std::size_t i = 1; i < threadCount; i++ )
+    {
+        workers.push_back( std::thread( &convertCartesianStateChunks< Real >,
+                                        cartesianStates,
+                                        epochs,
+                                        numberOfStates,
+                                        records,
+                                        statuses,
+                                        numberOfIterations,
+                                        std::ref( nextChunk ),
+                                        std::cref( referenceTle ),
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled,
+                                        classification,
+                                        elementSetNumber ) );
+    }
+
+    convertCartesianStateChunks( cartesianStates,
+                                 epochs,
+                                 numberOfStates,
+                                 records,
+                                 statuses,
+                                 numberOfIterations,
+                                 nextChunk,
+                                 referenceTle,
+                                 earthGravitationalParameter,
+                                 earthMeanRadius,
+                                 absoluteTolerance,
+                                 relativeTolerance,
+                                 maximumIterations,
+                                 solverType,
+                                 isWarmStartEnabled,
+                                 classification,
+                                 elementSetNumber );
+
+    // Wait for all worker threads to finish.
+    for ( std::size_t i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+}
+
+//! Convert chunks of Cartesian states to TLEs until states are exhausted.
+template< typename Real >
+void convertCartesianStateChunks( const Real* cartesianStates,
+                                  const DateTime* epochs,
+                                  const std::size_t numberOfStates,
+                                  char* records,
+                                  SolverStatus* statuses,
+                                  int* numberOfIterations,
+                                  std::atomic< std::size_t >& nextChunk,
+                                  const Tle& referenceTle,
+                                  const Real earthGravitationalParameter,
+                                  const Real earthMeanRadius,
+                                  const Real absoluteTolerance,
+                                  const Real relativeTolerance,
+                                  const int maximumIterations,
+                                  const SolverType solverType,
+                                  const bool isWarmStartEnabled,
+                                  const char classification,
+                                  const int elementSetNumber )
+{
+    typedef std::vector< Real > Vector6;
+
+    // Set up converter and state, which are reused for all states converted by this thread.
+    TleFitter< Real, Vector6 > fitter( referenceTle,
+                                       earthGravitationalParameter,
+                                       earthMeanRadius,
+                                       absoluteTolerance,
+                                       relativeTolerance,
+                                       maximumIterations,
+                                       solverType,
+                                       isWarmStartEnabled );
+    Vector6 cartesianState( 6 );
+    Tle tle( referenceTle );
+    NoSolverDiagnostics diagnostics;
+
+    for ( std::size_t chunk = nextChunk++;
+          chunk * kCartesianStateChunkSize < numberOfStates;
+          chunk = nextChunk++ )
+    {
+        // Start each chunk cold, since it does not follow on from the previous chunk.
+        fitter.resetWarmStart( );
+
+        const std::size_t firstState = chunk * kCartesianStateChunkSize;
+        std::size_t lastState = firstState + kCartesianStateChunkSize;
+        if ( lastState > numberOfStates )
+        {
+            lastState = numberOfStates;
+        }
+
+        for ( std::size_t i = firstState; i < lastState; i++ )
+        {
+            for ( int j = 0; j < 6; j++ )
+            {
+                cartesianState[ j ] = cartesianStates[ 6 * i + j ];
+            }
+
+            int iterations = 0;
+            statuses[ i ] = fitter.trySolve( cartesianState, epochs[ i ], tle, diagnostics,
+                                             iterations );
+            if ( numberOfIterations != 0 )
+            {
+                numberOfIterations[ i ] = iterations;
+            }
+
+            char* record = records + i * kTwoLineElementsRecordSize;
+            if ( statuses[ i ] == solverConverged )
+            {
+                if ( !writeTwoLineElements( tle, record, classification, elementSetNumber ) )
+                {
+                    statuses[ i ] = solverTleFormatFailed;
+                }
+            }
+            else
+            {
+                clearTwoLineElements( record );
+            }
+        }
+    }
+}
+
+} // namespace atom
+
+#endif // ATOM_CONVERT_CARTESIAN_STATES_TO_TWO_LINE_ELEMENTS_H
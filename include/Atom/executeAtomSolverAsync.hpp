@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_ASYNC_H
+#define ATOM_EXECUTE_ATOM_SOLVER_ASYNC_H
+
+#include <future>
+
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/solverCancellation.hpp"
+#include "Atom/solverWorkspace.hpp"
+#include "Atom/tleConversionCache.hpp"
+
+namespace atom
+{
+
+//! Execute Atom solver asynchronously.
+/*!
+ * Launches the Atom solver for a single transfer problem on a new thread and returns a future
+ * that holds the solution once the solver has finished. The calling thread is not blocked, such
+ * that the solve can be started from an event loop, which polls the future (e.g., using
+ * std::future::wait_for with a zero timeout) or waits on it when the solution is needed.
+ *
+ * If the cancellation token is set, it is checked between iterations of the Atom solver and
+ * between iterations of the nested Cartesian-to-TLE conversions. Latency is bounded by setting a
+ * deadline on the token, or by cancelling it. A cancelled solve finishes with status
+ * solverCancelled after the iteration that is currently executed, and its solution holds the best
+ * iterate found so far (see executeAtomSolver). The token must outlive the solve; since the
+ * destructor of the returned future waits for the solve to finish, it suffices that the token
+ * outlives the future.
+ *
+ * The problem is copied, such that it does not need to outlive the solve. The solver does not
+ * throw exceptions if it fails; the status of the solver is stored in the solution.
+ *
+ * @sa executeAtomSolver, executeAtomSolverBatch, SolverCancellation, AtomProblem, AtomSolution
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  problem                     Problem to solve
+ * @param  cancellation                Cancellation token checked between iterations; if it is not
+ *                                     set, the solve cannot be cancelled [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     which may be shared by concurrent solves; if it is not set,
+ *                                     no conversions are cached [default: 0]
+ * @return                             Future holding solution computed by solver
+ */
+template< typename Real, typename Vector3 >
+std::future< AtomSolution< Real, Vector3 > > executeAtomSolverAsync(
+    const AtomProblem< Real, Vector3 >& problem,
+    const SolverCancellation* cancellation = 0,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const bool isWarmStartEnabled = false,
+    TleConversionCache< Real >* tleCache = 0 );
+
+//! Execute Atom solver task.
+/*!
+ * Solves a single transfer problem, setting up a solver for the task. This function is executed
+ * on the thread launched by the asynchronous Atom solver.
+ *
+ * @sa executeAtomSolverAsync
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  problem                     Problem to solve
+ * @param  cancellation                Cancellation token checked between iterations
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used to check for convergence
+ * @param  relativeTolerance           Relative tolerance used to check for convergence
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ * @param  solverType                  Type of GSL solver
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions
+ * @return                             Solution computed by solver
+ */
+template< typename Real, typename Vector3 >
+AtomSolution< Real, Vector3 > executeAtomSolverTask(
+    const AtomProblem< Real, Vector3 >& problem,
+    const SolverCancellation* cancellation,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled,
+    TleConversionCache< Real >* tleCache );
+
+//! Execute Atom solver asynchronously.
+template< typename Real, typename Vector3 >
+std::future< AtomSolution< Real, Vector3 > > executeAtomSolverAsync(
+    const AtomProblem< Real, Vector3 >& problem,
+    const SolverCancellation* cancellation,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled,
+    TleConversionCache< Real >* tleCache )
+{
+    // Launch task on new thread; the problem and reference TLE are copied into the task.
+    return std::async( std::launch::async,
+                       &executeAtomSolverTask< Real, Vector3 >,
+                       problem,
+                       cancellation,
+                       referenceTle,
+                       earthGravitationalParameter,
+                       earthMeanRadius,
+                       absoluteTolerance,
+                       relativeTolerance,
+                       maximumIterations,
+                       solverType,
+                       isWarmStartEnabled,
+                       tleCache );
+}
+
+//! Execute Atom solver task.
+template< typename Real, typename Vector3 >
+AtomSolution< Real, Vector3 > executeAtomSolverTask(
+    const AtomProblem< Real, Vector3 >& problem,
+    const SolverCancellation* cancellation,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled,
+    TleConversionCache< Real >* tleCache )
+{
+    AtomSolver< Real, Vector3 > solver( referenceTle,
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled,
+                                        tleCache );
+
+    AtomSolution< Real, Vector3 > solution;
+    solveAtomProblem( solver, problem, solution, cancellation );
+    return solution;
+}
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_ASYNC_H
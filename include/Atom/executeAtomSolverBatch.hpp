@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_BATCH_H
+#define ATOM_EXECUTE_ATOM_SOLVER_BATCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/atomSolutionCache.hpp"
+#include "Atom/solverCancellation.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatistics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+#include "Atom/tleConversionCache.hpp"
+
+namespace atom
+{
+
+//! Problem descriptor for Atom solver.
+/*!
+ * Data structure containing the inputs that define a single transfer problem solved by the Atom
+ * solver.
+ *
+ * @sa executeAtomSolverBatch
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+struct AtomProblem;
+
+//! Solution computed by Atom solver.
+/*!
+ * Data structure containing the outputs of the Atom solver for a single transfer problem.
+ *
+ * @sa executeAtomSolverBatch
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+struct AtomSolution;
+
+//! Execute Atom solver for a batch of problems.
+/*!
+ * Executes the Atom solver for a contiguous array of independent transfer problems and writes the
+ * solutions to a contiguous array of the same size. The problems are distributed dynamically
+ * across a pool of threads. Each thread allocates one workspace for the Atom solver and one
+ * workspace for the nested Cartesian-to-TLE conversions, which are reused for all of the problems
+ * that the thread solves.
+ *
+ * The problems are solved without throwing exceptions, such that one failing problem does not
+ * abort the batch. The status of the solver is stored in each solution, together with the GSL
+ * flag returned by the solver (GSL_EFAILED if a nested conversion or the SGP4 propagator failed).
+ *
+ * @sa executeAtomSolver, AtomProblem, AtomSolution, AtomSolver
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  problems                    Pointer to first problem in contiguous array of problems
+ * @param  numberOfProblems            Number of problems in array
+ * @param  solutions                   Pointer to first solution in contiguous array of solutions,
+ *                                     which must be able to hold numberOfProblems solutions
+ * @param  numberOfThreads             Number of threads used to solve the batch; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     shared by all threads; if it is not set, no conversions are
+ *                                     cached [default: 0]
+ * @param  solutionCache               Cache of converged solutions, shared by all threads, such
+ *                                     that repeated problems are returned directly and nearby
+ *                                     problems are seeded; if it is not set, no solutions are
+ *                                     cached [default: 0]
+ */
+template< typename Real, typename Vector3 >
+void executeAtomSolverBatch( const AtomProblem< Real, Vector3 >* problems,
+                             const std::size_t numberOfProblems,
+                             AtomSolution< Real, Vector3 >* solutions,
+                             const unsigned int numberOfThreads = 0,
+                             const Tle& referenceTle = Tle( ),
+                             const Real earthGravitationalParameter = kMU,
+                             const Real earthMeanRadius = kXKMPER,
+                             const Real absoluteTolerance = 1.0e-10,
+                             const Real relativeTolerance = 1.0e-5,
+                             const int maximumIterations = 100,
+                             const SolverType solverType = hybridsSolver,
+                             const bool isWarmStartEnabled = false,
+                             TleConversionCache< Real >* tleCache = 0,
+                             AtomSolutionCache< Real, Vector3 >* solutionCache = 0 );
+
+//! Execute Atom solver for a batch of problems.
+/*!
+ * Executes the Atom solver for a batch of independent transfer problems, distributed across a
+ * pool of threads. This is a function overload that takes the problems stored in a vector and
+ * returns the solutions, stored in the same order.
+ *
+ * @sa executeAtomSolverBatch, executeAtomSolver
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  problems                    Problems to solve
+ * @param  numberOfThreads             Number of threads used to solve the batch; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     shared by all threads; if it is not set, no conversions are
+ *                                     cached [default: 0]
+ * @param  solutionCache               Cache of converged solutions, shared by all threads, such
+ *                                     that repeated problems are returned directly and nearby
+ *                                     problems are seeded; if it is not set, no solutions are
+ *                                     cached [default: 0]
+ * @return                             Solutions, stored in the same order as the problems
+ */
+template< typename Real, typename Vector3 >
+const std::vector< AtomSolution< Real, Vector3 > > executeAtomSolverBatch(
+    const std::vector< AtomProblem< Real, Vector3 > >& problems,
+    const unsigned int numberOfThreads = 0,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const bool isWarmStartEnabled = false,
+    TleConversionCache< Real >* tleCache = 0,
+    AtomSolutionCache< Real, Vector3 >* solutionCache = 0 );
+
+//! Solve problem using given solver.
+/*!
+ * Solves a single transfer problem using the given solver, without throwing exceptions, and
+ * stores the outputs of the solver, including its status, statistics and transfer, in the given
+ * solution.
+ *
+ * @sa executeAtomSolverBatch, executeAtomSolverAsync, AtomSolver
+ * @tparam Real         Type for reals
+ * @tparam Vector3      Type for 3-vector of reals
+ * @param  solver       Atom solver, owning workspaces that are reused for every problem
+ * @param  problem      Problem to solve
+ * @param  solution     Solution computed by solver
+ * @param  cancellation Cancellation token checked between iterations; if it is not set, the
+ *                      solve cannot be cancelled [default: 0]
+ */
+template< typename Real, typename Vector3 >
+void solveAtomProblem( AtomSolver< Real, Vector3 >& solver,
+                       const AtomProblem< Real, Vector3 >& problem,
+                       AtomSolution< Real, Vector3 >& solution,
+                       const SolverCancellation* cancellation = 0 );
+
+//! Solve problems from batch until batch is exhausted.
+/*!
+ * Solves problems from a batch, using workspaces that are allocated once per call. The index of
+ * the next problem to solve is shared between all threads working on the same batch.
+ *
+ * @sa executeAtomSolverBatch
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  problems                    Pointer to first problem in contiguous array of problems
+ * @param  numberOfProblems            Number of problems in array
+ * @param  solutions                   Pointer to first solution in contiguous array of solutions
+ * @param  nextProblem                 Index of next problem to solve, shared between threads
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used to check for convergence
+ * @param  relativeTolerance           Relative tolerance used to check for convergence
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ * @param  solverType                  Type of GSL solver
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions
+ * @param  solutionCache               Cache of converged solutions
+ */
+template< typename Real, typename Vector3 >
+void solveAtomProblems( const AtomProblem< Real, Vector3 >* problems,
+                        const std::size_t numberOfProblems,
+                        AtomSolution< Real, Vector3 >* solutions,
+                        std::atomic< std::size_t >& nextProblem,
+                        const Tle& referenceTle,
+                        const Real earthGravitationalParameter,
+                        const Real earthMeanRadius,
+                        const Real absoluteTolerance,
+                        const Real relativeTolerance,
+                        const int maximumIterations,
+                        const SolverType solverType,
+                        const bool isWarmStartEnabled,
+                        TleConversionCache< Real >* tleCache,
+                        AtomSolutionCache< Real, Vector3 >* solutionCache );
+
+//! Execute Atom solver for a batch of problems.
+template< typename Real, typename Vector3 >
+void executeAtomSolverBatch( const AtomProblem< Real, Vector3 >* problems,
+                             const std::size_t numberOfProblems,
+                             AtomSolution< Real, Vector3 >* solutions,
+                             const unsigned int numberOfThreads,
+                             const Tle& referenceTle,
+                             const Real earthGravitationalParameter,
+                             const Real earthMeanRadius,
+                             const Real absoluteTolerance,
+                             const Real relativeTolerance,
+                             const int maximumIterations,
+                             const SolverType solverType,
+                             const bool isWarmStartEnabled,
+                             TleConversionCache< Real >* tleCache,
+                             AtomSolutionCache< Real, Vector3 >* solutionCache )
+{
+    // Set number of threads that are used, such that no thread is left without problems.
+    std::size_t threadCount = numberOfThreads;
+    if ( threadCount == 0 )
+    {
+        threadCount = std::thread::hardware_concurrency( );
+    }
+    if ( threadCount > numberOfProblems )
+    {
+        threadCount = numberOfProblems;
+    }
+    if ( threadCount == 0 )
+    {
+        threadCount = 1;
+    }
+
+    // Set index of next problem to solve.
+    std::atomic< std::size_t > nextProblem( 0 );
+
+    // Launch worker threads; the calling thread also works on the batch.
+    std::vector< std::thread > workers;
+    workers.reserve( threadCount - 1 );
+    for ( std::size_t i = 1; i < threadCount; i++ )
+    {
+        workers.push_back( std::thread( &solveAtomProblems< Real, Vector3 >,
+                                        problems,
+                                        numberOfProblems,
+                                        solutions,
+                                        std::ref( nextProblem ),
+                                        std::cref( referenceTle ),
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled,
+                                        tleCache,
+                                        solutionCache ) );
+    }
+
+    solveAtomProblems( problems,
+                       numberOfProblems,
+                       solutions,
+                       nextProblem,
+                       referenceTle,
+                       earthGravitationalParameter,
+                       earthMeanRadius,
+                       absoluteTolerance,
+                       relativeTolerance,
+                       maximumIterations,
+                       solverType,
+                       isWarmStartEnabled,
+                       tleCache,
+                       solutionCache );
+
+    // Wait for all worker threads to finish.
+    for ( std::size_t i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+}
+
+//! Execute Atom solver for a batch of problems.
+template< typename Real, typename Vector3 >
+const std::vector< AtomSolution< Real, Vector3 > > executeAtomSolverBatch(
+    const std::vector< AtomProblem< Real, Vector3 > >& problems,
+    const unsigned int numberOfThreads,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled,
+    TleConversionCache< Real >* tleCache,
+    AtomSolutionCache< Real, Vector3 >* solutionCache )
+{
+    std::vector< AtomSolution< Real, Vector3 > > solutions( problems.size( ) );
+
+    if ( !problems.empty( ) )
+    {
+        executeAtomSolverBatch( &problems[ 0 ],
+                                problems.size( ),
+                                &solutions[ 0 ],
+                                numberOfThreads,
+                                referenceTle,
+                                earthGravitationalParameter,
+                                earthMeanRadius,
+                                absoluteTolerance,
+                                relativeTolerance,
+                                maximumIterations,
+                                solverType,
+                                isWarmStartEnabled,
+                                tleCache,
+                                solutionCache );
+    }
+
+    return solutions;
+}
+
+//! Solve problems from batch until batch is exhausted.
+template< typename Real, typename Vector3 >
+void solveAtomProblems( const AtomProblem< Real, Vector3 >* problems,
+                        const std::size_t numberOfProblems,
+                        AtomSolution< Real, Vector3 >* solutions,
+                        std::atomic< std::size_t >& nextProblem,
+                        const Tle& referenceTle,
+                        const Real earthGravitationalParameter,
+                        const Real earthMeanRadius,
+                        const Real absoluteTolerance,
+                        const Real relativeTolerance,
+                        const int maximumIterations,
+                        const SolverType solverType,
+                        const bool isWarmStartEnabled,
+                        TleConversionCache< Real >* tleCache,
+                        AtomSolutionCache< Real, Vector3 >* solutionCache )
+{
+    // Set up solver, owning workspaces that are reused for all problems solved by this thread.
+    AtomSolver< Real, Vector3 > solver( referenceTle,
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled,
+                                        tleCache,
+                                        solutionCache );
+
+    for ( std::size_t i = nextProblem++; i < numberOfProblems; i = nextProblem++ )
+    {
+        solveAtomProblem( solver, problems[ i ], solutions[ i ] );
+    }
+}
+
+//! Solve problem using given solver.
+template< typename Real, typename Vector3 >
+void solveAtomProblem( AtomSolver< Real, Vector3 >& solver,
+                       const AtomProblem< Real, Vector3 >& problem,
+                       AtomSolution< Real, Vector3 >& solution,
+                       const SolverCancellation* cancellation )
+{
+    FinalSolverStatus diagnostics;
+    std::pair< Vector3, Vector3 > velocities;
+    solution.numberOfIterations = 0;
+    solution.status = solver.trySolve( problem.departurePosition,
+                                       problem.departureEpoch,
+                                       problem.arrivalPosition,
+                                       problem.timeOfFlight,
+                                       problem.departureVelocityGuess,
+                                       velocities,
+                                       diagnostics,
+                                       solution.numberOfIterations,
+                                       cancellation );
+
+    solution.departureVelocity = velocities.first;
+    solution.arrivalVelocity = velocities.second;
+    solution.solverStatus = diagnostics.solverStatus;
+    solution.statistics = solver.statistics( );
+    solution.transfer = solver.transfer( );
+}
+
+//! Problem descriptor for Atom solver.
+template< typename Real, typename Vector3 >
+struct AtomProblem
+{
+public:
+
+    //! Default constructor.
+    AtomProblem( )
+        : departurePosition( ),
+          departureEpoch( ),
+          arrivalPosition( ),
+          timeOfFlight( 0.0 ),
+          departureVelocityGuess( )
+    { }
+
+    //! Constructor taking problem definition.
+    /*!
+     * Constructor taking inputs that define transfer problem.
+     * @sa executeAtomSolver
+     * @param aDeparturePosition      Cartesian position vector at departure [km]
+     * @param aDepartureEpoch         Modified Julian Date (MJD) of departure
+     * @param anArrivalPosition       Cartesian position vector at arrival [km]
+     * @param aTimeOfFlight           Time-of-Flight for orbital transfer [min]
+     * @param aDepartureVelocityGuess Initial guess for the departure velocity [km/s]
+     */
+    AtomProblem( const Vector3& aDeparturePosition,
+                 const DateTime& aDepartureEpoch,
+                 const Vector3& anArrivalPosition,
+                 const Real aTimeOfFlight,
+                 const Vector3& aDepartureVelocityGuess )
+        : departurePosition( aDeparturePosition ),
+          departureEpoch( aDepartureEpoch ),
+          arrivalPosition( anArrivalPosition ),
+          timeOfFlight( aTimeOfFlight ),
+          departureVelocityGuess( aDepartureVelocityGuess )
+    { }
+
+    //! Constructor taking problem definition, without initial guess.
+    /*!
+     * Constructor taking inputs that define transfer problem. The initial guess for the departure
+     * velocity is computed by solving the Lambert problem.
+     * @sa executeAtomSolver, computeAtomDepartureVelocityGuess
+     * @param aDeparturePosition            Cartesian position vector at departure [km]
+     * @param aDepartureEpoch               Modified Julian Date (MJD) of departure
+     * @param anArrivalPosition             Cartesian position vector at arrival [km]
+     * @param aTimeOfFlight                 Time-of-Flight for orbital transfer [min]
+     * @param anEarthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+     *                                      [default: mu_SGP]
+     */
+    AtomProblem( const Vector3& aDeparturePosition,
+                 const DateTime& aDepartureEpoch,
+                 const Vector3& anArrivalPosition,
+                 const Real aTimeOfFlight,
+                 const Real anEarthGravitationalParameter = kMU )
+        : departurePosition( aDeparturePosition ),
+          departureEpoch( aDepartureEpoch ),
+          arrivalPosition( anArrivalPosition ),
+          timeOfFlight( aTimeOfFlight ),
+          departureVelocityGuess(
+            computeAtomDepartureVelocityGuess( aDeparturePosition,
+                                               anArrivalPosition,
+                                               aTimeOfFlight,
+                                               anEarthGravitationalParameter ) )
+    { }
+
+    //! Departure position in Cartesian elements [km].
+    Vector3 departurePosition;
+
+    //! Departure epoch.
+    DateTime departureEpoch;
+
+    //! Arrival position in Cartesian elements [km].
+    Vector3 arrivalPosition;
+
+    //! Time-of-Flight (TOF) [min].
+    Real timeOfFlight;
+
+    //! Initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess;
+
+protected:
+
+private:
+};
+
+//! Solution computed by Atom solver.
+template< typename Real, typename Vector3 >
+struct AtomSolution
+{
+public:
+
+    //! Default constructor.
+    AtomSolution( )
+        : departureVelocity( ),
+          arrivalVelocity( ),
+          numberOfIterations( 0 ),
+          solverStatus( GSL_CONTINUE ),
+          status( solverMaximumIterationsReached ),
+          statistics( ),
+          transfer( ),
+          isRefined( false )
+    { }
+
+    //! Departure velocity [km/s].
+    Vector3 departureVelocity;
+
+    //! Arrival velocity [km/s].
+    Vector3 arrivalVelocity;
+
+    //! Number of iterations completed by solver.
+    int numberOfIterations;
+
+    //! GSL flag indicating status of solver (GSL_SUCCESS if solver converged).
+    int solverStatus;
+
+    //! Status of solver.
+    SolverStatus status;
+
+    //! Statistics collected by solver (partial if solver failed).
+    SolverStatistics< Real > statistics;
+
+    //! Converged transfer (departure TLE, arrival state and final residuals).
+    AtomTransfer< Real, Vector3 > transfer;
+
+    //! Flag indicating if solution has been refined by two-stage solver.
+    bool isRefined;
+
+protected:
+
+private:
+};
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_BATCH_H
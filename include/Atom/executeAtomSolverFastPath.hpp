@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_FAST_PATH_H
+#define ATOM_EXECUTE_ATOM_SOLVER_FAST_PATH_H
+
+#include <utility>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/analyticAtomSolver.hpp"
+#include "Atom/atom.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/twoBodyFunctions.hpp"
+
+namespace atom
+{
+
+//! Execute Atom solver using analytic fast path.
+/*!
+ * Executes the Atom solver in two stages. The analytic stage solves the Atom system approximated
+ * with an analytic propagation model instead of the nested Cartesian-to-TLE conversions and the
+ * SGP4/SDP4 propagator (see executeAnalyticAtomSolver), which is orders of magnitude cheaper to
+ * evaluate. The full-fidelity stage then executes the Atom solver starting from the departure
+ * velocity found by the analytic stage, such that only a few iterations of the full, expensive
+ * system are needed to correct for the differences between the analytic model and the SGP4/SDP4
+ * dynamics.
+ *
+ * The analytic stage can converge to a transfer with a different number of revolutions than the
+ * given initial guess, in particular for multi-revolution transfers close to the maximum number of
+ * revolutions. The numbers of revolutions are compared in the two-body approximation (see
+ * computeNumberOfRevolutions). If the analytic stage does not converge, if the analytic solution
+ * or the full-fidelity solution found from it has a different number of revolutions than the
+ * given initial guess, or if the full-fidelity stage does not converge from the analytic solution,
+ * the full-fidelity stage is repeated from the given initial guess. The result is then the same as
+ * that of the Atom solver started from the given initial guess, at the cost of the iterations
+ * spent on the analytic solution, which are included in the number of iterations returned.
+ *
+ * @sa executeAnalyticAtomSolver, executeAtomSolver, AtomSolver
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuess      Initial guess for the departure velocity [km/s]
+ * @param  numberOfIterations          Number of iterations completed by full-fidelity stage, in
+ *                                     total if the stage is repeated
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted in
+ *                                     full-fidelity stage [default: 100]
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  propagationModel            Analytic propagation model used in analytic stage
+ *                                     [default: j2SecularPropagationModel]
+ * @param  analyticStatus              Status of analytic stage; if it is not set, the status is
+ *                                     not returned [default: 0]
+ * @param  numberOfAnalyticIterations  Number of iterations completed by analytic stage; if it is
+ *                                     not set, the number of iterations is not returned
+ *                                     [default: 0]
+ * @param  isAnalyticSolutionUsed      Flag indicating if the returned velocities are found by the
+ *                                     full-fidelity stage started from the analytic solution; if
+ *                                     it is not set, the flag is not returned [default: 0]
+ * @return                             Departure and arrival velocities (stored in that order)
+ */
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolverFastPath(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    int& numberOfIterations,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const AnalyticPropagationModel propagationModel = j2SecularPropagationModel,
+    SolverStatus* analyticStatus = 0,
+    int* numberOfAnalyticIterations = 0,
+    bool* isAnalyticSolutionUsed = 0 );
+
+//! Execute Atom solver using analytic fast path.
+/*!
+ * Executes the Atom solver in two stages, starting the analytic stage from the solution of the
+ * Lambert problem for the given positions and time-of-flight. This is a function overload that
+ * computes the initial guess for the departure velocity.
+ *
+ * @sa executeAtomSolverFastPath, computeAtomDepartureVelocityGuess
+ * @tparam Real              Type for reals
+ * @tparam Vector3           Type for 3-vector of reals
+ * @param  departurePosition Cartesian position vector at departure [km]
+ * @param  departureEpoch    Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition   Cartesian position vector at arrival [km]
+ * @param  timeOfFlight      Time-of-Flight for orbital transfer [min]
+ * @return                   Departure and arrival velocities (stored in that order)
+ */
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolverFastPath( const Vector3& departurePosition,
+                                                               const DateTime& departureEpoch,
+                                                               const Vector3& arrivalPosition,
+                                                               const Real timeOfFlight );
+
+//! Execute Atom solver using analytic fast path.
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolverFastPath(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const Vector3& departureVelocityGuess,
+    int& numberOfIterations,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const AnalyticPropagationModel propagationModel,
+    SolverStatus* analyticStatus,
+    int* numberOfAnalyticIterations,
+    bool* isAnalyticSolutionUsed )
+{
+    // Execute analytic stage.
+    Vector3 analyticDepartureVelocity = createVector< Vector3 >( 3 );
+    int analyticIterations = 0;
+    const SolverStatus status = executeAnalyticAtomSolver( departurePosition,
+                                                           arrivalPosition,
+                                                           timeOfFlight,
+                                                           departureVelocityGuess,
+                                                           analyticDepartureVelocity,
+                                                           analyticIterations,
+                                                           propagationModel,
+                                                           earthGravitationalParameter,
+                                                           earthMeanRadius );
+
+    if ( analyticStatus != 0 )
+    {
+        *analyticStatus = status;
+    }
+
+    if ( numberOfAnalyticIterations != 0 )
+    {
+        *numberOfAnalyticIterations = analyticIterations;
+    }
+
+    if ( isAnalyticSolutionUsed != 0 )
+    {
+        *isAnalyticSolutionUsed = false;
+    }
+
+    AtomSolver< Real, Vector3 > solver( referenceTle,
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType );
+
+    // Compute number of revolutions of transfer that given initial guess is closest to.
+    const Real timeOfFlightInSeconds = timeOfFlight * kSECONDS_PER_DAY / kMINUTES_PER_DAY;
+    const int numberOfRevolutions = computeNumberOfRevolutions(
+        departurePosition, departureVelocityGuess, timeOfFlightInSeconds,
+        earthGravitationalParameter );
+
+    // Execute full-fidelity stage, starting from analytic solution if analytic stage converged to
+    // a transfer with the same number of revolutions.
+    numberOfIterations = 0;
+    if ( status == solverConverged
+         && computeNumberOfRevolutions( departurePosition, analyticDepartureVelocity,
+                                        timeOfFlightInSeconds, earthGravitationalParameter )
+            == numberOfRevolutions )
+    {
+        std::pair< Vector3, Vector3 > velocities;
+        NoSolverDiagnostics diagnostics;
+        const SolverStatus seededStatus = solver.trySolve( departurePosition,
+                                                           departureEpoch,
+                                                           arrivalPosition,
+                                                           timeOfFlight,
+                                                           analyticDepartureVelocity,
+                                                           velocities,
+                                                           diagnostics,
+                                                           numberOfIterations );
+
+        if ( seededStatus == solverConverged
+             && computeNumberOfRevolutions( departurePosition, velocities.first,
+                                            timeOfFlightInSeconds, earthGravitationalParameter )
+                == numberOfRevolutions )
+        {
+            if ( isAnalyticSolutionUsed != 0 )
+            {
+                *isAnalyticSolutionUsed = true;
+            }
+
+            return velocities;
+        }
+    }
+
+    // Repeat full-fidelity stage, starting from given initial guess.
+    int fallbackIterations = 0;
+    const std::pair< Vector3, Vector3 > velocities = solver.solve( departurePosition,
+                                                                   departureEpoch,
+                                                                   arrivalPosition,
+                                                                   timeOfFlight,
+                                                                   departureVelocityGuess,
+                                                                   fallbackIterations );
+    numberOfIterations += fallbackIterations;
+    return velocities;
+}
+
+//! Execute Atom solver using analytic fast path.
+template< typename Real, typename Vector3 >
+const std::pair< Vector3, Vector3 > executeAtomSolverFastPath( const Vector3& departurePosition,
+                                                               const DateTime& departureEpoch,
+                                                               const Vector3& arrivalPosition,
+                                                               const Real timeOfFlight )
+{
+    int dummyint = 0;
+    return executeAtomSolverFastPath( departurePosition,
+                                      departureEpoch,
+                                      arrivalPosition,
+                                      timeOfFlight,
+                                      computeAtomDepartureVelocityGuess( departurePosition,
+                                                                         arrivalPosition,
+                                                                         timeOfFlight ),
+                                      dummyint );
+}
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_FAST_PATH_H
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_MULTI_GUESS_H
+#define ATOM_EXECUTE_ATOM_SOLVER_MULTI_GUESS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/lambertSolver.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+#include "Atom/vectorTraits.hpp"
+
+namespace atom
+{
+
+//! Selection of solution from multiple initial guesses.
+/*!
+ * Criterion used to select the solution returned by executeAtomSolverMultiGuess from the
+ * solutions computed for multiple initial guesses.
+ *
+ * @sa executeAtomSolverMultiGuess
+ */
+enum GuessSelection
+{
+    //! Select converged solution with the lowest guess index; no guesses with a higher index are
+    //! solved once a guess has converged.
+    firstConvergedGuess,
+
+    //! Solve all guesses and select converged solution with the lowest final residual norm.
+    bestConvergedGuess
+};
+
+//! Generate initial guesses for departure velocity.
+/*!
+ * Generates a set of initial guesses for the departure velocity from a given base guess, e.g., a
+ * solution of the Lambert problem. The set starts with the base guess, followed by perturbed
+ * variants and, optionally, by the retrograde variant of the base guess (reversed velocity).
+ *
+ * The perturbed variants are generated by adding and subtracting a fraction of the magnitude of
+ * the base guess along each Cartesian axis in turn. Every six variants, the perturbation is
+ * increased by the given fraction.
+ *
+ * @sa executeAtomSolverMultiGuess
+ * @tparam Real                     Type for reals
+ * @tparam Vector3                  Type for 3-vector of reals
+ * @param  departureVelocityGuess   Base guess for the departure velocity [km/s]
+ * @param  numberOfPerturbedGuesses Number of perturbed variants of base guess [default: 6]
+ * @param  perturbationFraction     Fraction of magnitude of base guess added per perturbation
+ *                                  [default: 0.01]
+ * @param  isRetrogradeIncluded     Flag indicating if retrograde variant of base guess is
+ *                                  included [default: true]
+ * @return                          Initial guesses for the departure velocity [km/s]
+ */
+template< typename Real, typename Vector3 >
+const std::vector< Vector3 > generateDepartureVelocityGuesses(
+    const Vector3& departureVelocityGuess,
+    const int numberOfPerturbedGuesses = 6,
+    const Real perturbationFraction = 0.01,
+    const bool isRetrogradeIncluded = true );
+
+//! Generate initial guesses for departure velocity by solving Lambert problem.
+/*!
+ * Generates a set of initial guesses for the departure velocity by solving the Lambert problem for
+ * the given positions and time-of-flight. The set contains the prograde solutions for all feasible
+ * numbers of revolutions (both branches for multi-revolution solutions), ordered by increasing
+ * number of revolutions, followed by the retrograde solutions, if they are included.
+ *
+ * @sa executeAtomSolverMultiGuess, solveLambertProblem
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  maximumRevolutions          Maximum number of revolutions considered [default: 20]
+ * @param  isRetrogradeIncluded        Flag indicating if retrograde solutions are included
+ *                                     [default: true]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @return                             Initial guesses for the departure velocity [km/s]
+ */
+template< typename Real, typename Vector3 >
+const std::vector< Vector3 > generateLambertDepartureVelocityGuesses(
+    const Vector3& departurePosition,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const int maximumRevolutions = 20,
+    const bool isRetrogradeIncluded = true,
+    const Real earthGravitationalParameter = kMU );
+
+//! Execute Atom solver for multiple initial guesses.
+/*!
+ * Executes the Atom solver for a single transfer problem, starting from multiple initial guesses
+ * for the departure velocity. The guesses are distributed dynamically across a pool of threads,
+ * such that poorly conditioned geometries do not require a serial retry-on-failure loop. Each
+ * thread allocates one AtomSolver, which is reused for all of the guesses that the thread solves.
+ *
+ * If the first converged guess is selected, guesses are solved in order of increasing index and no
+ * guesses with a higher index than the lowest converged guess are started. Solves that are
+ * already running are completed, such that the selected solution is the same as the solution
+ * computed by a serial retry-on-failure loop over the guesses. If the best converged guess is
+ * selected, all guesses are solved.
+ *
+ * If no guess converged, the solution with the lowest final residual norm is selected, preferring
+ * solves that reached the maximum number of iterations over solves that failed. The guesses are
+ * solved without throwing exceptions; the status of the selected solve is stored in the solution.
+ *
+ * @sa executeAtomSolver, executeAtomSolverBatch, generateDepartureVelocityGuesses,
+ *     generateLambertDepartureVelocityGuesses, GuessSelection
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuesses    Initial guesses for the departure velocity [km/s]
+ * @param  selectedGuess               Index of guess corresponding to returned solution (number
+ *                                     of guesses if no guesses are given)
+ * @param  guessSelection              Criterion used to select solution
+ *                                     [default: firstConvergedGuess]
+ * @param  numberOfThreads             Number of threads used to solve the guesses; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started [default: false]
+ * @return                             Solution corresponding to selected guess
+ */
+template< typename Real, typename Vector3 >
+const AtomSolution< Real, Vector3 > executeAtomSolverMultiGuess(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const std::vector< Vector3 >& departureVelocityGuesses,
+    std::size_t& selectedGuess,
+    const GuessSelection guessSelection = firstConvergedGuess,
+    const unsigned int numberOfThreads = 0,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    const bool isWarmStartEnabled = false );
+
+//! Solve initial guesses until guesses are exhausted.
+/*!
+ * Solves initial guesses for a single transfer problem, using an AtomSolver that is allocated once
+ * per call. The index of the next guess to solve and the index of the lowest converged guess are
+ * shared between all threads working on the same problem.
+ *
+ * @sa executeAtomSolverMultiGuess
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departurePosition           Cartesian position vector at departure [km]
+ * @param  departureEpoch              Modified Julian Date (MJD) of departure
+ * @param  arrivalPosition             Cartesian position vector at arrival [km]
+ * @param  timeOfFlight                Time-of-Flight for orbital transfer [min]
+ * @param  departureVelocityGuesses    Initial guesses for the departure velocity [km/s]
+ * @param  solutions                   Solutions for all guesses
+ * @param  isSolved                    Flags indicating which guesses are solved
+ * @param  nextGuess                   Index of next guess to solve, shared between threads
+ * @param  firstConverged              Index of lowest converged guess, shared between threads
+ * @param  guessSelection              Criterion used to select solution
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used to check for convergence
+ * @param  relativeTolerance           Relative tolerance used to check for convergence
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ * @param  solverType                  Type of GSL solver
+ * @param  isWarmStartEnabled          Flag indicating if nested Cartesian-to-TLE conversions are
+ *                                     warm-started
+ */
+template< typename Real, typename Vector3 >
+void solveAtomGuesses( const Vector3& departurePosition,
+                       const DateTime& departureEpoch,
+                       const Vector3& arrivalPosition,
+                       const Real timeOfFlight,
+                       const std::vector< Vector3 >& departureVelocityGuesses,
+                       std::vector< AtomSolution< Real, Vector3 > >& solutions,
+                       std::vector< char >& isSolved,
+                       std::atomic< std::size_t >& nextGuess,
+                       std::atomic< std::size_t >& firstConverged,
+                       const GuessSelection guessSelection,
+                       const Tle& referenceTle,
+                       const Real earthGravitationalParameter,
+                       const Real earthMeanRadius,
+                       const Real absoluteTolerance,
+                       const Real relativeTolerance,
+                       const int maximumIterations,
+                       const SolverType solverType,
+                       const bool isWarmStartEnabled );
+
+//! Check if solution is preferred over other solution.
+/*!
+ * Checks if a given solution is preferred over another solution: converged solutions are
+ * preferred over solutions that reached the maximum number of iterations, which are preferred over
+ * solutions that failed. Solutions with the same status are ranked by their final residual norm.
+ *
+ * @sa executeAtomSolverMultiGuess
+ * @tparam Real     Type for reals
+ * @tparam Vector3  Type for 3-vector of reals
+ * @param  solution Solution to check
+ * @param  other    Solution to compare to
+ * @return          True if solution is preferred over other solution
+ */
+template< typename Real, typename Vector3 >
+bool isSolutionPreferred( const AtomSolution< Real, Vector3 >& solution,
+                          const AtomSolution< Real, Vector3 >& other );
+
+//! Generate initial guesses for departure velocity.
+template< typename Real, typename Vector3 >
+const std::vector< Vector3 > generateDepartureVelocityGuesses(
+    const Vector3& departureVelocityGuess,
+    const int numberOfPerturbedGuesses,
+    const Real perturbationFraction,
+    const bool isRetrogradeIncluded )
+{
+    std::vector< Vector3 > guesses;
+    guesses.reserve( numberOfPerturbedGuesses + 2 );
+    guesses.push_back( departureVelocityGuess );
+
+    // Compute magnitude of base guess [km/s].
+    const Real speed = std::sqrt( departureVelocityGuess[ 0 ] * departureVelocityGuess[ 0 ]
+                                  + departureVelocityGuess[ 1 ] * departureVelocityGuess[ 1 ]
+                                  + departureVelocityGuess[ 2 ] * departureVelocityGuess[ 2 ] );
+
+    // Add perturbed variants, cycling through positive and negative perturbations along each axis.
+    for ( int i = 0; i < numberOfPerturbedGuesses; i++ )
+    {
+        const int axis = ( i / 2 ) % 3;
+        const Real sign = ( i % 2 == 0 ) ? 1.0 : -1.0;
+        const Real perturbation = sign * ( i / 6 + 1 ) * perturbationFraction * speed;
+
+        Vector3 guess = departureVelocityGuess;
+        guess[ axis ] += perturbation;
+        guesses.push_back( guess );
+    }
+
+    // Add retrograde variant.
+    if ( isRetrogradeIncluded )
+    {
+        Vector3 guess = departureVelocityGuess;
+        for ( int i = 0; i < 3; i++ )
+        {
+            guess[ i ] = -departureVelocityGuess[ i ];
+        }
+        guesses.push_back( guess );
+    }
+
+    return guesses;
+}
+
+//! Generate initial guesses for departure velocity by solving Lambert problem.
+template< typename Real, typename Vector3 >
+const std::vector< Vector3 > generateLambertDepartureVelocityGuesses(
+    const Vector3& departurePosition,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const int maximumRevolutions,
+    const bool isRetrogradeIncluded,
+    const Real earthGravitationalParameter )
+{
+    // Convert time-of-flight from minutes to seconds, which are used by the Lambert solver.
+    const Real timeOfFlightInSeconds = timeOfFlight * kSECONDS_PER_DAY / kMINUTES_PER_DAY;
+
+    std::vector< Vector3 > guesses;
+    Real departureVelocity[ 3 ];
+    Real arrivalVelocity[ 3 ];
+
+    for ( int direction = 0; direction < ( isRetrogradeIncluded ? 2 : 1 ); direction++ )
+    {
+        const bool isRetrograde = ( direction == 1 );
+        const int numberOfRevolutions = std::min(
+            maximumRevolutions,
+            computeLambertMaximumRevolutions( departurePosition,
+                                              arrivalPosition,
+                                              timeOfFlightInSeconds,
+                                              earthGravitationalParameter,
+                                              isRetrograde ) );
+
+        for ( int revolutions = 0; revolutions <= numberOfRevolutions; revolutions++ )
+        {
+            for ( int branch = 0; branch < ( ( revolutions == 0 ) ? 1 : 2 ); branch++ )
+            {
+                if ( solveLambertProblem( departurePosition,
+                                          arrivalPosition,
+                                          timeOfFlightInSeconds,
+                                          earthGravitationalParameter,
+                                          departureVelocity,
+                                          arrivalVelocity,
+                                          revolutions,
+                                          isRetrograde,
+                                          branch == 1 ) )
+                {
+                    Vector3 guess = createVector< Vector3 >( 3 );
+                    for ( int i = 0; i < 3; i++ )
+                    {
+                        guess[ i ] = departureVelocity[ i ];
+                    }
+                    guesses.push_back( guess );
+                }
+            }
+        }
+    }
+
+    return guesses;
+}
+
+//! Execute Atom solver for multiple initial guesses.
+template< typename Real, typename Vector3 >
+const AtomSolution< Real, Vector3 > executeAtomSolverMultiGuess(
+    const Vector3& departurePosition,
+    const DateTime& departureEpoch,
+    const Vector3& arrivalPosition,
+    const Real timeOfFlight,
+    const std::vector< Vector3 >& departureVelocityGuesses,
+    std::size_t& selectedGuess,
+    const GuessSelection guessSelection,
+    const unsigned int numberOfThreads,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    const bool isWarmStartEnabled )
+{
+    const std::size_t numberOfGuesses = departureVelocityGuesses.size( );
+    selectedGuess = numberOfGuesses;
+    if ( numberOfGuesses == 0 )
+    {
+        return AtomSolution< Real, Vector3 >( );
+    }
+
+    // Set number of threads that are used, such that no thread is left without guesses.
+    std::size_t threadCount = numberOfThreads;
+    if ( threadCount == 0 )
+    {
+        threadCount = std::thread::hardware_concurrency( );
+    }
+    if ( threadCount > numberOfGuesses )
+    {
+        threadCount = numberOfGuesses;
+    }
+    if ( threadCount == 0 )
+    {
+        threadCount = 1;
+    }
+
+    // Set up solutions for all guesses, flags indicating which guesses are solved, index of next
+    // guess to solve and index of lowest converged guess (number of guesses if none converged).
+    std::vector< AtomSolution< Real, Vector3 > > solutions( numberOfGuesses );
+    std::vector< char > isSolved( numberOfGuesses, false );
+    std::atomic< std::size_t > nextGuess( 0 );
+    std::atomic< std::size_t > firstConverged( numberOfGuesses );
+
+    // Launch worker threads; the calling thread also works on the guesses.
+    std::vector< std::thread > workers;
+    workers.reserve( threadCount - 1 );
+    for ( std::size_t i = 1; i < threadCount; i++ )
+    {
+        workers.push_back( std::thread( &solveAtomGuesses< Real, Vector3 >,
+                                        std::cref( departurePosition ),
+                                        std::cref( departureEpoch ),
+                                        std::cref( arrivalPosition ),
+                                        timeOfFlight,
+                                        std::cref( departureVelocityGuesses ),
+                                        std::ref( solutions ),
+                                        std::ref( isSolved ),
+                                        std::ref( nextGuess ),
+                                        std::ref( firstConverged ),
+                                        guessSelection,
+                                        std::cref( referenceTle ),
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled ) );
+    }
+
+    solveAtomGuesses( departurePosition,
+                      departureEpoch,
+                      arrivalPosition,
+                      timeOfFlight,
+                      departureVelocityGuesses,
+                      solutions,
+                      isSolved,
+                      nextGuess,
+                      firstConverged,
+                      guessSelection,
+                      referenceTle,
+                      earthGravitationalParameter,
+                      earthMeanRadius,
+                      absoluteTolerance,
+                      relativeTolerance,
+                      maximumIterations,
+                      solverType,
+                      isWarmStartEnabled );
+
+    // Wait for all worker threads to finish.
+    for ( std::size_t i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+
+    // Select lowest converged guess if it is requested and available, else select preferred
+    // solution amongst solved guesses.
+    if ( guessSelection == firstConvergedGuess && firstConverged < numberOfGuesses )
+    {
+        selectedGuess = firstConverged;
+    }
+    else
+    {
+        for ( std::size_t i = 0; i < numberOfGuesses; i++ )
+        {
+            if ( isSolved[ i ]
+                 && ( selectedGuess == numberOfGuesses
+                      || isSolutionPreferred( solutions[ i ], solutions[ selectedGuess ] ) ) )
+            {
+                selectedGuess = i;
+            }
+        }
+    }
+
+    return solutions[ selectedGuess ];
+}
+
+//! Solve initial guesses until guesses are exhausted.
+template< typename Real, typename Vector3 >
+void solveAtomGuesses( const Vector3& departurePosition,
+                       const DateTime& departureEpoch,
+                       const Vector3& arrivalPosition,
+                       const Real timeOfFlight,
+                       const std::vector< Vector3 >& departureVelocityGuesses,
+                       std::vector< AtomSolution< Real, Vector3 > >& solutions,
+                       std::vector< char >& isSolved,
+                       std::atomic< std::size_t >& nextGuess,
+                       std::atomic< std::size_t >& firstConverged,
+                       const GuessSelection guessSelection,
+                       const Tle& referenceTle,
+                       const Real earthGravitationalParameter,
+                       const Real earthMeanRadius,
+                       const Real absoluteTolerance,
+                       const Real relativeTolerance,
+                       const int maximumIterations,
+                       const SolverType solverType,
+                       const bool isWarmStartEnabled )
+{
+    // Set up solver, owning workspaces that are reused for all guesses solved by this thread.
+    AtomSolver< Real, Vector3 > solver( referenceTle,
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType,
+                                        isWarmStartEnabled );
+
+    const std::size_t numberOfGuesses = departureVelocityGuesses.size( );
+    for ( std::size_t i = nextGuess++; i < numberOfGuesses; i = nextGuess++ )
+    {
+        // Stop early if a guess with a lower index has already converged. Since guesses are
+        // handed out in order, all remaining guesses also have a higher index.
+        if ( guessSelection == firstConvergedGuess && i > firstConverged )
+        {
+            break;
+        }
+
+        AtomSolution< Real, Vector3 >& solution = solutions[ i ];
+
+        FinalSolverStatus diagnostics;
+        std::pair< Vector3, Vector3 > velocities;
+        solution.status = solver.trySolve( departurePosition,
+                                           departureEpoch,
+                                           arrivalPosition,
+                                           timeOfFlight,
+                                           departureVelocityGuesses[ i ],
+                                           velocities,
+                                           diagnostics,
+                                           solution.numberOfIterations );
+
+        solution.departureVelocity = velocities.first;
+        solution.arrivalVelocity = velocities.second;
+        solution.solverStatus = diagnostics.solverStatus;
+        solution.statistics = solver.statistics( );
+        solution.transfer = solver.transfer( );
+        isSolved[ i ] = true;
+
+        // Update index of lowest converged guess.
+        if ( solution.status == solverConverged )
+        {
+            std::size_t converged = firstConverged;
+            while ( i < converged && !firstConverged.compare_exchange_weak( converged, i ) )
+            { }
+        }
+    }
+}
+
+//! Check if solution is preferred over other solution.
+template< typename Real, typename Vector3 >
+bool isSolutionPreferred( const AtomSolution< Real, Vector3 >& solution,
+                          const AtomSolution< Real, Vector3 >& other )
+{
+    // Rank solutions by status: converged, maximum iterations reached, failed.
+    const int rank = ( solution.status == solverConverged ) ? 0
+        : ( solution.status == solverMaximumIterationsReached ) ? 1 : 2;
+    const int otherRank = ( other.status == solverConverged ) ? 0
+        : ( other.status == solverMaximumIterationsReached ) ? 1 : 2;
+
+    if ( rank != otherRank )
+    {
+        return rank < otherRank;
+    }
+
+    return solution.statistics.finalResidualNorm < other.statistics.finalResidualNorm;
+}
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_MULTI_GUESS_H
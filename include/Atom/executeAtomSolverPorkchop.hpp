@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_PORKCHOP_H
+#define ATOM_EXECUTE_ATOM_SOLVER_PORKCHOP_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Eci.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+#include "Atom/vectorTraits.hpp"
+
+namespace atom
+{
+
+//! Point of porkchop grid computed by Atom solver.
+/*!
+ * Data structure containing the solution of the Atom solver for a single point of a porkchop grid
+ * (departure epoch and time-of-flight), together with the changes in velocity required to depart
+ * from the departure object and to arrive at the arrival object.
+ *
+ * @sa executeAtomSolverPorkchop
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+struct AtomPorkchopPoint;
+
+//! Execute Atom solver for porkchop grid.
+/*!
+ * Executes the Atom solver for a grid of departure epochs and times-of-flight, to compute a
+ * porkchop plot of transfers from a departure object to an arrival object, both defined by TLEs.
+ * For every point of the grid, the departure position is the position of the departure object at
+ * the departure epoch and the arrival position is the position of the arrival object at the
+ * departure epoch plus the time-of-flight, both computed using the SGP4/SDP4 propagator.
+ *
+ * The rows of the grid (one row per departure epoch) are distributed dynamically across a pool of
+ * threads. Each row is swept in order of the given times-of-flight. If continuation is enabled,
+ * the departure velocity of the last converged point of the row is used as the initial guess for
+ * the next point and the warm-start state of the nested Cartesian-to-TLE conversions is carried
+ * over from one point to the next, such that neighboring points, which have similar solutions,
+ * converge in a few iterations. The initial guess for the first point of a row, and for all points
+ * if continuation is disabled, is computed by solving the Lambert problem.
+ *
+ * The points are written to a dense, row-major array: the point for departure epoch i and
+ * time-of-flight j is stored at index i * numberOfTimesOfFlight + j. The points are solved without
+ * throwing exceptions, such that one failing point does not abort the sweep. If the SGP4/SDP4
+ * propagator cannot be initialized with the departure or arrival TLE, or fails to compute the
+ * state of an object, the status of the affected points is set to solverPropagationFailed and
+ * their velocities are set to NaN. The changes in velocity of every point that does not converge
+ * are set to NaN.
+ *
+ * @sa executeAtomSolver, executeAtomSolverBatch, AtomPorkchopPoint
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departureTle                TLE of departure object
+ * @param  arrivalTle                  TLE of arrival object
+ * @param  departureEpochs             Pointer to first departure epoch in contiguous array
+ * @param  numberOfDepartureEpochs     Number of departure epochs (rows of grid)
+ * @param  timesOfFlight               Pointer to first time-of-flight [min] in contiguous array,
+ *                                     ordered such that neighboring times-of-flight are close
+ * @param  numberOfTimesOfFlight       Number of times-of-flight (columns of grid)
+ * @param  points                      Pointer to first point in contiguous array of points, which
+ *                                     must be able to hold numberOfDepartureEpochs
+ *                                     * numberOfTimesOfFlight points
+ * @param  numberOfThreads             Number of threads used to sweep the grid; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  isContinuationEnabled       Flag indicating if converged points are used to initialize
+ *                                     next point of row [default: true]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ */
+template< typename Real, typename Vector3 >
+void executeAtomSolverPorkchop( const Tle& departureTle,
+                                const Tle& arrivalTle,
+                                const DateTime* departureEpochs,
+                                const std::size_t numberOfDepartureEpochs,
+                                const Real* timesOfFlight,
+                                const std::size_t numberOfTimesOfFlight,
+                                AtomPorkchopPoint< Real, Vector3 >* points,
+                                const unsigned int numberOfThreads = 0,
+                                const bool isContinuationEnabled = true,
+                                const Tle& referenceTle = Tle( ),
+                                const Real earthGravitationalParameter = kMU,
+                                const Real earthMeanRadius = kXKMPER,
+                                const Real absoluteTolerance = 1.0e-10,
+                                const Real relativeTolerance = 1.0e-5,
+                                const int maximumIterations = 100,
+                                const SolverType solverType = hybridsSolver );
+
+//! Execute Atom solver for porkchop grid.
+/*!
+ * Executes the Atom solver for a grid of departure epochs and times-of-flight. This is a function
+ * overload that takes the departure epochs and times-of-flight stored in vectors and returns the
+ * points of the grid, stored in row-major order.
+ *
+ * @sa executeAtomSolverPorkchop, AtomPorkchopPoint
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departureTle                TLE of departure object
+ * @param  arrivalTle                  TLE of arrival object
+ * @param  departureEpochs             Departure epochs (rows of grid)
+ * @param  timesOfFlight               Times-of-flight [min] (columns of grid)
+ * @param  numberOfThreads             Number of threads used to sweep the grid; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  isContinuationEnabled       Flag indicating if converged points are used to initialize
+ *                                     next point of row [default: true]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ *                                     [default: 100].
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @return                             Points of grid, stored in row-major order
+ */
+template< typename Real, typename Vector3 >
+const std::vector< AtomPorkchopPoint< Real, Vector3 > > executeAtomSolverPorkchop(
+    const Tle& departureTle,
+    const Tle& arrivalTle,
+    const std::vector< DateTime >& departureEpochs,
+    const std::vector< Real >& timesOfFlight,
+    const unsigned int numberOfThreads = 0,
+    const bool isContinuationEnabled = true,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver );
+
+//! Sweep rows of porkchop grid until grid is exhausted.
+/*!
+ * Sweeps rows of a porkchop grid, using workspaces that are allocated once per call. The index of
+ * the next row to sweep is shared between all threads working on the same grid.
+ *
+ * @sa executeAtomSolverPorkchop
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @param  departureTle                TLE of departure object
+ * @param  arrivalTle                  TLE of arrival object
+ * @param  departureEpochs             Pointer to first departure epoch in contiguous array
+ * @param  numberOfDepartureEpochs     Number of departure epochs (rows of grid)
+ * @param  timesOfFlight               Pointer to first time-of-flight [min] in contiguous array
+ * @param  numberOfTimesOfFlight       Number of times-of-flight (columns of grid)
+ * @param  points                      Pointer to first point in contiguous array of points
+ * @param  nextRow                     Index of next row to sweep, shared between threads
+ * @param  isContinuationEnabled       Flag indicating if converged points are used to initialize
+ *                                     next point of row
+ * @param  referenceTle                Reference Two Line Elements
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2]
+ * @param  earthMeanRadius             Earth mean radius [km]
+ * @param  absoluteTolerance           Absolute tolerance used to check for convergence
+ * @param  relativeTolerance           Relative tolerance used to check for convergence
+ * @param  maximumIterations           Maximum number of solver iterations permitted
+ * @param  solverType                  Type of GSL solver
+ */
+template< typename Real, typename Vector3 >
+void sweepAtomPorkchopRows( const Tle& departureTle,
+                            const Tle& arrivalTle,
+                            const DateTime* departureEpochs,
+                            const std::size_t numberOfDepartureEpochs,
+                            const Real* timesOfFlight,
+                            const std::size_t numberOfTimesOfFlight,
+                            AtomPorkchopPoint< Real, Vector3 >* points,
+                            std::atomic< std::size_t >& nextRow,
+                            const bool isContinuationEnabled,
+                            const Tle& referenceTle,
+                            const Real earthGravitationalParameter,
+                            const Real earthMeanRadius,
+                            const Real absoluteTolerance,
+                            const Real relativeTolerance,
+                            const int maximumIterations,
+                            const SolverType solverType );
+
+//! Execute Atom solver for porkchop grid.
+template< typename Real, typename Vector3 >
+void executeAtomSolverPorkchop( const Tle& departureTle,
+                                const Tle& arrivalTle,
+                                const DateTime* departureEpochs,
+                                const std::size_t numberOfDepartureEpochs,
+                                const Real* timesOfFlight,
+                                const std::size_t numberOfTimesOfFlight,
+                                AtomPorkchopPoint< Real, Vector3 >* points,
+                                const unsigned int numberOfThreads,
+                                const bool isContinuationEnabled,
+                                const Tle& referenceTle,
+                                const Real earthGravitationalParameter,
+                                const Real earthMeanRadius,
+                                const Real absoluteTolerance,
+                                const Real relativeTolerance,
+                                const int maximumIterations,
+                                const SolverType solverType )
+{
+    // Set number of threads that are used, such that no thread is left without rows.
+    std::size_t threadCount = numberOfThreads;
+    if ( threadCount == 0 )
+    {
+        threadCount = std::thread::hardware_concurrency( );
+    }
+    if ( threadCount > numberOfDepartureEpochs )
+    {
+        threadCount = numberOfDepartureEpochs;
+    }
+    if ( threadCount == 0 )
+    {
+        threadCount = 1;
+    }
+
+    // Set index of next row to sweep.
+    std::atomic< std::size_t > nextRow( 0 );
+
+    // Launch worker threads; the calling thread also works on the grid.
+    std::vector< std::thread > workers;
+    workers.reserve( threadCount - 1 );
+    for ( std::size_t i = 1; i < threadCount; i++ )
+    {
+        workers.push_back( std::thread( &sweepAtomPorkchopRows< Real, Vector3 >,
+                                        std::cref( departureTle ),
+                                        std::cref( arrivalTle ),
+                                        departureEpochs,
+                                        numberOfDepartureEpochs,
+                                        timesOfFlight,
+                                        numberOfTimesOfFlight,
+                                        points,
+                                        std::ref( nextRow ),
+                                        isContinuationEnabled,
+                                        std::cref( referenceTle ),
+                                        earthGravitationalParameter,
+                                        earthMeanRadius,
+                                        absoluteTolerance,
+                                        relativeTolerance,
+                                        maximumIterations,
+                                        solverType ) );
+    }
+
+    sweepAtomPorkchopRows( departureTle,
+                           arrivalTle,
+                           departureEpochs,
+                           numberOfDepartureEpochs,
+                           timesOfFlight,
+                           numberOfTimesOfFlight,
+                           points,
+                           nextRow,
+                           isContinuationEnabled,
+                           referenceTle,
+                           earthGravitationalParameter,
+                           earthMeanRadius,
+                           absoluteTolerance,
+                           relativeTolerance,
+                           maximumIterations,
+                           solverType );
+
+    // Wait for all worker threads to finish.
+    for ( std::size_t i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+}
+
+//! Execute Atom solver for porkchop grid.
+template< typename Real, typename Vector3 >
+const std::vector< AtomPorkchopPoint< Real, Vector3 > > executeAtomSolverPorkchop(
+    const Tle& departureTle,
+    const Tle& arrivalTle,
+    const std::vector< DateTime >& departureEpochs,
+    const std::vector< Real >& timesOfFlight,
+    const unsigned int numberOfThreads,
+    const bool isContinuationEnabled,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType )
+{
+    std::vector< AtomPorkchopPoint< Real, Vector3 > > points(
+        departureEpochs.size( ) * timesOfFlight.size( ) );
+
+    if ( !points.empty( ) )
+    {
+        executeAtomSolverPorkchop( departureTle,
+                                   arrivalTle,
+                                   &departureEpochs[ 0 ],
+                                   departureEpochs.size( ),
+                                   &timesOfFlight[ 0 ],
+                                   timesOfFlight.size( ),
+                                   &points[ 0 ],
+                                   numberOfThreads,
+                                   isContinuationEnabled,
+                                   referenceTle,
+                                   earthGravitationalParameter,
+                                   earthMeanRadius,
+                                   absoluteTolerance,
+                                   relativeTolerance,
+                                   maximumIterations,
+                                   solverType );
+    }
+
+    return points;
+}
+
+//! Sweep rows of porkchop grid until grid is exhausted.
+template< typename Real, typename Vector3 >
+void sweepAtomPorkchopRows( const Tle& departureTle,
+                            const Tle& arrivalTle,
+                            const DateTime* departureEpochs,
+                            const std::size_t numberOfDepartureEpochs,
+                            const Real* timesOfFlight,
+                            const std::size_t numberOfTimesOfFlight,
+                            AtomPorkchopPoint< Real, Vector3 >* points,
+                            std::atomic< std::size_t >& nextRow,
+                            const bool isContinuationEnabled,
+                            const Tle& referenceTle,
+                            const Real earthGravitationalParameter,
+                            const Real earthMeanRadius,
+                            const Real absoluteTolerance,
+                            const Real relativeTolerance,
+                            const int maximumIterations,
+                            const SolverType solverType )
+{
+    // Set up workspaces and propagators of departure and arrival objects, which are reused for all
+    // rows swept by this thread.
+    SolverWorkspace atomWorkspace( 3, solverType );
+    SolverWorkspace tleWorkspace( 6 );
+
+    // Initialize propagators of departure and arrival objects. The exception thrown if a TLE is
+    // invalid cannot be propagated out of this thread; instead, all points swept by this thread
+    // are flagged as propagation failures.
+    std::unique_ptr< SGP4 > departureSgp4;
+    std::unique_ptr< SGP4 > arrivalSgp4;
+    try
+    {
+        departureSgp4.reset( new SGP4( departureTle ) );
+        arrivalSgp4.reset( new SGP4( arrivalTle ) );
+    }
+    catch ( const std::runtime_error& )
+    {
+        departureSgp4.reset( );
+        arrivalSgp4.reset( );
+    }
+
+    Vector3 departurePosition = createVector< Vector3 >( 3 );
+    Vector3 departureObjectVelocity = createVector< Vector3 >( 3 );
+    Vector3 arrivalPosition = createVector< Vector3 >( 3 );
+    Vector3 arrivalObjectVelocity = createVector< Vector3 >( 3 );
+
+    // Set up velocities stored for points that cannot be solved, such that they are undefined.
+    Vector3 undefinedVelocity = createVector< Vector3 >( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        undefinedVelocity[ i ] = std::numeric_limits< Real >::quiet_NaN( );
+    }
+
+    for ( std::size_t row = nextRow++; row < numberOfDepartureEpochs; row = nextRow++ )
+    {
+        const DateTime& departureEpoch = departureEpochs[ row ];
+
+        // Reset continuation state at the start of every row.
+        TleFitWarmStart< Real > tleWarmStart;
+        bool hasConvergedNeighbor = false;
+        Vector3 departureVelocityGuess = createVector< Vector3 >( 3 );
+
+        for ( std::size_t column = 0; column < numberOfTimesOfFlight; column++ )
+        {
+            const Real timeOfFlight = timesOfFlight[ column ];
+            AtomPorkchopPoint< Real, Vector3 >& point
+                = points[ row * numberOfTimesOfFlight + column ];
+            AtomSolution< Real, Vector3 >& solution = point.solution;
+            solution.numberOfIterations = 0;
+
+            // Reset changes in velocity, which are only set if the point converges.
+            point.departureDeltaV = std::numeric_limits< Real >::quiet_NaN( );
+            point.arrivalDeltaV = std::numeric_limits< Real >::quiet_NaN( );
+
+            // Compute states of departure and arrival objects, unless a propagator could not be
+            // initialized.
+            bool isPropagationFailed = ( departureSgp4.get( ) == 0 || arrivalSgp4.get( ) == 0 );
+            if ( !isPropagationFailed )
+            {
+                try
+                {
+                    const Eci departureState = departureSgp4->FindPosition( departureEpoch );
+                    const Eci arrivalState
+                        = arrivalSgp4->FindPosition( departureEpoch.AddMinutes( timeOfFlight ) );
+
+                    departurePosition[ 0 ] = departureState.Position( ).x;
+                    departurePosition[ 1 ] = departureState.Position( ).y;
+                    departurePosition[ 2 ] = departureState.Position( ).z;
+                    departureObjectVelocity[ 0 ] = departureState.Velocity( ).x;
+                    departureObjectVelocity[ 1 ] = departureState.Velocity( ).y;
+                    departureObjectVelocity[ 2 ] = departureState.Velocity( ).z;
+                    arrivalPosition[ 0 ] = arrivalState.Position( ).x;
+                    arrivalPosition[ 1 ] = arrivalState.Position( ).y;
+                    arrivalPosition[ 2 ] = arrivalState.Position( ).z;
+                    arrivalObjectVelocity[ 0 ] = arrivalState.Velocity( ).x;
+                    arrivalObjectVelocity[ 1 ] = arrivalState.Velocity( ).y;
+                    arrivalObjectVelocity[ 2 ] = arrivalState.Velocity( ).z;
+                }
+                catch ( const std::runtime_error& )
+                {
+                    isPropagationFailed = true;
+                }
+            }
+
+            if ( isPropagationFailed )
+            {
+                solution.departureVelocity = undefinedVelocity;
+                solution.arrivalVelocity = undefinedVelocity;
+                solution.solverStatus = GSL_EFAILED;
+                solution.status = solverPropagationFailed;
+                continue;
+            }
+
+            // Use departure velocity of last converged point of row as initial guess, if it is
+            // available; else solve Lambert problem.
+            if ( !( isContinuationEnabled && hasConvergedNeighbor ) )
+            {
+                departureVelocityGuess = computeAtomDepartureVelocityGuess(
+                    departurePosition, arrivalPosition, timeOfFlight, earthGravitationalParameter );
+            }
+
+            FinalSolverStatus diagnostics;
+            const std::pair< Vector3, Vector3 > velocities
+                = executeAtomSolver( departurePosition,
+                                     departureEpoch,
+                                     arrivalPosition,
+                                     timeOfFlight,
+                                     departureVelocityGuess,
+                                     atomWorkspace,
+                                     tleWorkspace,
+                                     diagnostics,
+                                     solution.numberOfIterations,
+                                     referenceTle,
+                                     earthGravitationalParameter,
+                                     earthMeanRadius,
+                                     absoluteTolerance,
+                                     relativeTolerance,
+                                     maximumIterations,
+                                     isContinuationEnabled,
+                                     &solution.statistics,
+                                     &solution.status,
+                                     &tleWarmStart,
+                                     static_cast< TleConversionCache< Real >* >( 0 ),
+                                     &solution.transfer );
+
+            solution.departureVelocity = velocities.first;
+            solution.arrivalVelocity = velocities.second;
+            solution.solverStatus = diagnostics.solverStatus;
+
+            if ( solution.status == solverConverged )
+            {
+                Real departureDeltaVSquared = 0.0;
+                Real arrivalDeltaVSquared = 0.0;
+                for ( int i = 0; i < 3; i++ )
+                {
+                    const Real departureDeltaV
+                        = solution.departureVelocity[ i ] - departureObjectVelocity[ i ];
+                    const Real arrivalDeltaV
+                        = arrivalObjectVelocity[ i ] - solution.arrivalVelocity[ i ];
+                    departureDeltaVSquared += departureDeltaV * departureDeltaV;
+                    arrivalDeltaVSquared += arrivalDeltaV * arrivalDeltaV;
+                }
+                point.departureDeltaV = std::sqrt( departureDeltaVSquared );
+                point.arrivalDeltaV = std::sqrt( arrivalDeltaVSquared );
+
+                departureVelocityGuess = solution.departureVelocity;
+                hasConvergedNeighbor = true;
+            }
+        }
+    }
+}
+
+//! Point of porkchop grid computed by Atom solver.
+template< typename Real, typename Vector3 >
+struct AtomPorkchopPoint
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting changes in velocity to NaN, such that they are undefined if
+     * the solver does not converge.
+     */
+    AtomPorkchopPoint( )
+        : solution( ),
+          departureDeltaV( std::numeric_limits< Real >::quiet_NaN( ) ),
+          arrivalDeltaV( std::numeric_limits< Real >::quiet_NaN( ) )
+    { }
+
+    //! Get total change in velocity [km/s].
+    /*!
+     * Returns sum of changes in velocity at departure and arrival (NaN if the solver did not
+     * converge).
+     * @return Total change in velocity [km/s]
+     */
+    Real totalDeltaV( ) const
+    {
+        return departureDeltaV + arrivalDeltaV;
+    }
+
+    //! Solution computed by Atom solver.
+    AtomSolution< Real, Vector3 > solution;
+
+    //! Change in velocity to depart from departure object [km/s].
+    Real departureDeltaV;
+
+    //! Change in velocity to arrive at arrival object [km/s].
+    Real arrivalDeltaV;
+
+protected:
+
+private:
+};
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_PORKCHOP_H
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_EXECUTE_ATOM_SOLVER_TWO_STAGE_H
+#define ATOM_EXECUTE_ATOM_SOLVER_TWO_STAGE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/tleConversionCache.hpp"
+
+namespace atom
+{
+
+//! Candidate predicate that accepts all converged coarse solutions.
+/*!
+ * Predicate used by the two-stage Atom solver to select the coarse solutions that are refined.
+ * This predicate accepts all coarse solutions that have converged. Screening criteria, e.g., a
+ * maximum departure velocity, can be applied by passing a different predicate with the same call
+ * signature.
+ *
+ * @sa executeAtomSolverTwoStage
+ * @tparam Real    Type for reals
+ * @tparam Vector3 Type for 3-vector of reals
+ */
+template< typename Real, typename Vector3 >
+struct AcceptConvergedAtomSolutions
+{
+public:
+
+    //! Check if coarse solution is refined.
+    /*!
+     * Checks if coarse solution of transfer problem is refined.
+     * @param  problem        Transfer problem
+     * @param  coarseSolution Solution computed by coarse stage
+     * @return                Flag indicating if coarse solution is refined
+     */
+    bool operator( )( const AtomProblem< Real, Vector3 >& problem,
+                      const AtomSolution< Real, Vector3 >& coarseSolution ) const
+    {
+        static_cast< void >( problem );
+        return coarseSolution.status == solverConverged;
+    }
+
+protected:
+
+private:
+};
+
+//! Execute Atom solver for a batch of problems in two stages.
+/*!
+ * Executes the Atom solver for a contiguous array of independent transfer problems in two stages,
+ * for screening passes over large sets of problems. The coarse stage solves all problems with loose
+ * tolerances, which also loosen the tolerance of the nested Cartesian-to-TLE conversions. The
+ * refinement stage solves the problems that are selected by the candidate predicate from their
+ * coarse solutions again with tight tolerances, starting from the coarse departure velocities.
+ * Both stages are executed by the multi-threaded batch solver.
+ *
+ * The default tolerances of the coarse stage approximate the departure velocity to within a few
+ * m/s, which corresponds to arrival position errors of the order of 10 m for transfers in low
+ * Earth orbit. The default tolerances of the refinement stage are the same as the defaults of the
+ * Atom solver. Since GSL and the SGP4/SDP4 propagator are only available in double precision, both
+ * stages are executed in the precision set by Real.
+ *
+ * Solutions are stored in the same order as the problems. Refined solutions replace the coarse
+ * solutions and are flagged; the number of iterations of a refined solution includes the
+ * iterations of both stages. Solutions that are not refined keep the result of the coarse stage.
+ *
+ * @sa executeAtomSolverBatch, AcceptConvergedAtomSolutions, AtomSolution
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @tparam CandidatePredicate          Type for candidate predicate, callable as
+ *                                     bool( const AtomProblem&, const AtomSolution& )
+ * @param  problems                    Pointer to first problem in contiguous array of problems
+ * @param  numberOfProblems            Number of problems in array
+ * @param  solutions                   Pointer to first solution in contiguous array of solutions,
+ *                                     which must be able to hold numberOfProblems solutions
+ * @param  isCandidate                 Predicate that selects coarse solutions that are refined
+ * @param  numberOfThreads             Number of threads used to solve each stage; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  coarseAbsoluteTolerance     Absolute tolerance used to check if root-finder has
+ *                                     converged in coarse stage [default: 1.0e-6]
+ * @param  coarseRelativeTolerance     Relative tolerance used to check if root-finder has
+ *                                     converged in coarse stage [default: 1.0e-3]
+ * @param  coarseMaximumIterations     Maximum number of solver iterations permitted in coarse
+ *                                     stage [default: 50]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged in refinement stage [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged in refinement stage [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted in
+ *                                     refinement stage [default: 100]
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     used by refinement stage only, since all conversions stored
+ *                                     in a cache must share the same relative tolerance; if it is
+ *                                     not set, no conversions are cached [default: 0]
+ * @return                             Number of refined solutions
+ */
+template< typename Real, typename Vector3, typename CandidatePredicate >
+std::size_t executeAtomSolverTwoStage( const AtomProblem< Real, Vector3 >* problems,
+                                       const std::size_t numberOfProblems,
+                                       AtomSolution< Real, Vector3 >* solutions,
+                                       const CandidatePredicate& isCandidate,
+                                       const unsigned int numberOfThreads = 0,
+                                       const Tle& referenceTle = Tle( ),
+                                       const Real earthGravitationalParameter = kMU,
+                                       const Real earthMeanRadius = kXKMPER,
+                                       const Real coarseAbsoluteTolerance = 1.0e-6,
+                                       const Real coarseRelativeTolerance = 1.0e-3,
+                                       const int coarseMaximumIterations = 50,
+                                       const Real absoluteTolerance = 1.0e-10,
+                                       const Real relativeTolerance = 1.0e-5,
+                                       const int maximumIterations = 100,
+                                       const SolverType solverType = hybridsSolver,
+                                       TleConversionCache< Real >* tleCache = 0 );
+
+//! Execute Atom solver for a batch of problems in two stages.
+/*!
+ * Executes the Atom solver for a batch of independent transfer problems in two stages, refining
+ * the coarse solutions selected by the candidate predicate. This is a function overload that takes
+ * the problems stored in a vector and returns the solutions, stored in the same order.
+ *
+ * @sa executeAtomSolverTwoStage, AcceptConvergedAtomSolutions
+ * @tparam Real                        Type for reals
+ * @tparam Vector3                     Type for 3-vector of reals
+ * @tparam CandidatePredicate          Type for candidate predicate, callable as
+ *                                     bool( const AtomProblem&, const AtomSolution& )
+ * @param  problems                    Problems to solve
+ * @param  isCandidate                 Predicate that selects coarse solutions that are refined
+ * @param  numberOfThreads             Number of threads used to solve each stage; if it is set to
+ *                                     zero, the number of hardware threads is used [default: 0]
+ * @param  referenceTle                Reference Two Line Elements [default: 0-TLE]
+ * @param  earthGravitationalParameter Earth gravitational parameter [km^3 s^-2] [default: mu_SGP]
+ * @param  earthMeanRadius             Earth mean radius [km] [default: R_SGP]
+ * @param  coarseAbsoluteTolerance     Absolute tolerance used to check if root-finder has
+ *                                     converged in coarse stage [default: 1.0e-6]
+ * @param  coarseRelativeTolerance     Relative tolerance used to check if root-finder has
+ *                                     converged in coarse stage [default: 1.0e-3]
+ * @param  coarseMaximumIterations     Maximum number of solver iterations permitted in coarse
+ *                                     stage [default: 50]
+ * @param  absoluteTolerance           Absolute tolerance used to check if root-finder has
+ *                                     converged in refinement stage [default: 1.0e-10]
+ * @param  relativeTolerance           Relative tolerance used to check if root-finder has
+ *                                     converged in refinement stage [default: 1.0e-5]
+ * @param  maximumIterations           Maximum number of solver iterations permitted in
+ *                                     refinement stage [default: 100]
+ * @param  solverType                  Type of GSL solver [default: hybridsSolver]
+ * @param  tleCache                    Cache of converged nested Cartesian-to-TLE conversions,
+ *                                     used by refinement stage only, since all conversions stored
+ *                                     in a cache must share the same relative tolerance; if it is
+ *                                     not set, no conversions are cached [default: 0]
+ * @return                             Solutions, stored in the same order as the problems
+ */
+template< typename Real, typename Vector3, typename CandidatePredicate >
+const std::vector< AtomSolution< Real, Vector3 > > executeAtomSolverTwoStage(
+    const std::vector< AtomProblem< Real, Vector3 > >& problems,
+    const CandidatePredicate& isCandidate,
+    const unsigned int numberOfThreads = 0,
+    const Tle& referenceTle = Tle( ),
+    const Real earthGravitationalParameter = kMU,
+    const Real earthMeanRadius = kXKMPER,
+    const Real coarseAbsoluteTolerance = 1.0e-6,
+    const Real coarseRelativeTolerance = 1.0e-3,
+    const int coarseMaximumIterations = 50,
+    const Real absoluteTolerance = 1.0e-10,
+    const Real relativeTolerance = 1.0e-5,
+    const int maximumIterations = 100,
+    const SolverType solverType = hybridsSolver,
+    TleConversionCache< Real >* tleCache = 0 );
+
+//! Execute Atom solver for a batch of problems in two stages.
+template< typename Real, typename Vector3, typename CandidatePredicate >
+std::size_t executeAtomSolverTwoStage( const AtomProblem< Real, Vector3 >* problems,
+                                       const std::size_t numberOfProblems,
+                                       AtomSolution< Real, Vector3 >* solutions,
+                                       const CandidatePredicate& isCandidate,
+                                       const unsigned int numberOfThreads,
+                                       const Tle& referenceTle,
+                                       const Real earthGravitationalParameter,
+                                       const Real earthMeanRadius,
+                                       const Real coarseAbsoluteTolerance,
+                                       const Real coarseRelativeTolerance,
+                                       const int coarseMaximumIterations,
+                                       const Real absoluteTolerance,
+                                       const Real relativeTolerance,
+                                       const int maximumIterations,
+                                       const SolverType solverType,
+                                       TleConversionCache< Real >* tleCache )
+{
+    // Execute coarse stage for all problems. The cache of nested conversions is not used, since
+    // the coarse stage converges the conversions to a looser relative tolerance than the
+    // refinement stage, and a cache only holds conversions with the same relative tolerance.
+    executeAtomSolverBatch( problems,
+                            numberOfProblems,
+                            solutions,
+                            numberOfThreads,
+                            referenceTle,
+                            earthGravitationalParameter,
+                            earthMeanRadius,
+                            coarseAbsoluteTolerance,
+                            coarseRelativeTolerance,
+                            coarseMaximumIterations,
+                            solverType,
+                            false,
+                            static_cast< TleConversionCache< Real >* >( 0 ) );
+
+    // Select candidates, which are refined starting from their coarse departure velocities.
+    std::vector< std::size_t > candidateIndices;
+    std::vector< AtomProblem< Real, Vector3 > > candidateProblems;
+    for ( std::size_t i = 0; i < numberOfProblems; i++ )
+    {
+        solutions[ i ].isRefined = false;
+        if ( isCandidate( problems[ i ], solutions[ i ] ) )
+        {
+            candidateIndices.push_back( i );
+            candidateProblems.push_back(
+                AtomProblem< Real, Vector3 >( problems[ i ].departurePosition,
+                                              problems[ i ].departureEpoch,
+                                              problems[ i ].arrivalPosition,
+                                              problems[ i ].timeOfFlight,
+                                              solutions[ i ].departureVelocity ) );
+        }
+    }
+
+    // Execute refinement stage for candidates.
+    const std::vector< AtomSolution< Real, Vector3 > > refinedSolutions
+        = executeAtomSolverBatch( candidateProblems,
+                                  numberOfThreads,
+                                  referenceTle,
+                                  earthGravitationalParameter,
+                                  earthMeanRadius,
+                                  absoluteTolerance,
+                                  relativeTolerance,
+                                  maximumIterations,
+                                  solverType,
+                                  false,
+                                  tleCache );
+
+    // Replace coarse solutions of candidates with refined solutions.
+    for ( std::size_t j = 0; j < candidateIndices.size( ); j++ )
+    {
+        AtomSolution< Real, Vector3 >& solution = solutions[ candidateIndices[ j ] ];
+        const int coarseIterations = solution.numberOfIterations;
+        solution = refinedSolutions[ j ];
+        solution.numberOfIterations += coarseIterations;
+        solution.isRefined = true;
+    }
+
+    return candidateIndices.size( );
+}
+
+//! Execute Atom solver for a batch of problems in two stages.
+template< typename Real, typename Vector3, typename CandidatePredicate >
+const std::vector< AtomSolution< Real, Vector3 > > executeAtomSolverTwoStage(
+    const std::vector< AtomProblem< Real, Vector3 > >& problems,
+    const CandidatePredicate& isCandidate,
+    const unsigned int numberOfThreads,
+    const Tle& referenceTle,
+    const Real earthGravitationalParameter,
+    const Real earthMeanRadius,
+    const Real coarseAbsoluteTolerance,
+    const Real coarseRelativeTolerance,
+    const int coarseMaximumIterations,
+    const Real absoluteTolerance,
+    const Real relativeTolerance,
+    const int maximumIterations,
+    const SolverType solverType,
+    TleConversionCache< Real >* tleCache )
+{
+    std::vector< AtomSolution< Real, Vector3 > > solutions( problems.size( ) );
+
+    if ( !problems.empty( ) )
+    {
+        executeAtomSolverTwoStage( &problems[ 0 ],
+                                   problems.size( ),
+                                   &solutions[ 0 ],
+                                   isCandidate,
+                                   numberOfThreads,
+                                   referenceTle,
+                                   earthGravitationalParameter,
+                                   earthMeanRadius,
+                                   coarseAbsoluteTolerance,
+                                   coarseRelativeTolerance,
+                                   coarseMaximumIterations,
+                                   absoluteTolerance,
+                                   relativeTolerance,
+                                   maximumIterations,
+                                   solverType,
+                                   tleCache );
+    }
+
+    return solutions;
+}
+
+} // namespace atom
+
+#endif // ATOM_EXECUTE_ATOM_SOLVER_TWO_STAGE_H
@@ -0,0 +1,726 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_LAMBERT_SOLVER_H
+#define ATOM_LAMBERT_SOLVER_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "Atom/vectorTraits.hpp"
+
+namespace atom
+{
+
+//! Solve Lambert problem.
+/*!
+ * Solves the Lambert problem, i.e., computes the departure and arrival velocities of the conic
+ * section that connects two positions in a given time-of-flight, using the algorithm developed by
+ * Izzo (2014). The non-dimensional time-of-flight equation is solved for the Lancaster-Blanchard
+ * variable x using Householder's method, starting from the initial guesses given by Izzo (2014).
+ *
+ * The transfer is prograde if the angular momentum of the transfer points in the positive
+ * z-direction. For multi-revolution transfers, two solutions exist: the left branch (lower
+ * energy for short times-of-flight) and the right branch.
+ *
+ * This function does not allocate any memory.
+ *
+ * @sa computeLambertMaximumRevolutions, computeLambertDepartureVelocityGuess
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  departurePosition      Cartesian position vector at departure [km]
+ * @param  arrivalPosition        Cartesian position vector at arrival [km]
+ * @param  timeOfFlight           Time-of-Flight for transfer [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  departureVelocity      Computed Cartesian velocity at departure [km/s]
+ * @param  arrivalVelocity        Computed Cartesian velocity at arrival [km/s]
+ * @param  numberOfRevolutions    Number of complete revolutions of transfer [default: 0]
+ * @param  isRetrograde           Flag indicating if transfer is retrograde [default: false]
+ * @param  isRightBranch          Flag indicating if right branch of multi-revolution solutions
+ *                                is computed [default: false]
+ * @return                        True if solution exists; false if the time-of-flight is not
+ *                                positive, if the positions are collinear or if the given number
+ *                                of revolutions cannot be completed within the time-of-flight
+ */
+template< typename Real, typename Vector3 >
+bool solveLambertProblem( const Vector3& departurePosition,
+                          const Vector3& arrivalPosition,
+                          const Real timeOfFlight,
+                          const Real gravitationalParameter,
+                          Real departureVelocity[ 3 ],
+                          Real arrivalVelocity[ 3 ],
+                          const int numberOfRevolutions = 0,
+                          const bool isRetrograde = false,
+                          const bool isRightBranch = false );
+
+//! Compute maximum number of revolutions of Lambert problem.
+/*!
+ * Computes the maximum number of complete revolutions that a conic section connecting two
+ * positions can complete within a given time-of-flight (Izzo, 2014).
+ *
+ * @sa solveLambertProblem
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  departurePosition      Cartesian position vector at departure [km]
+ * @param  arrivalPosition        Cartesian position vector at arrival [km]
+ * @param  timeOfFlight           Time-of-Flight for transfer [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  isRetrograde           Flag indicating if transfer is retrograde [default: false]
+ * @return                        Maximum number of revolutions (-1 if no solution exists)
+ */
+template< typename Real, typename Vector3 >
+int computeLambertMaximumRevolutions( const Vector3& departurePosition,
+                                      const Vector3& arrivalPosition,
+                                      const Real timeOfFlight,
+                                      const Real gravitationalParameter,
+                                      const bool isRetrograde = false );
+
+//! Compute initial guess for departure velocity by solving Lambert problem.
+/*!
+ * Computes an initial guess for the departure velocity of a transfer connecting two positions,
+ * by solving the Lambert problem. All solutions in the given direction of motion, up to the given
+ * maximum number of revolutions, are computed and the solution with the lowest departure speed
+ * (lowest energy) is returned.
+ *
+ * @sa solveLambertProblem, executeAtomSolver
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  departurePosition      Cartesian position vector at departure [km]
+ * @param  arrivalPosition        Cartesian position vector at arrival [km]
+ * @param  timeOfFlight           Time-of-Flight for transfer [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  maximumRevolutions     Maximum number of revolutions considered [default: 20]
+ * @param  isRetrograde           Flag indicating if transfer is retrograde [default: false]
+ * @return                        Initial guess for departure velocity [km/s]; the zero vector if
+ *                                no solution exists
+ */
+template< typename Real, typename Vector3 >
+Vector3 computeLambertDepartureVelocityGuess( const Vector3& departurePosition,
+                                              const Vector3& arrivalPosition,
+                                              const Real timeOfFlight,
+                                              const Real gravitationalParameter,
+                                              const int maximumRevolutions = 20,
+                                              const bool isRetrograde = false );
+
+//! Compute geometry of Lambert problem.
+/*!
+ * Computes the non-dimensional parameters of the Lambert problem (Izzo, 2014) and the radial and
+ * tangential unit vectors at departure and arrival.
+ *
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  departurePosition      Cartesian position vector at departure [km]
+ * @param  arrivalPosition        Cartesian position vector at arrival [km]
+ * @param  timeOfFlight           Time-of-Flight for transfer [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  isRetrograde           Flag indicating if transfer is retrograde
+ * @param  lambda                 Computed geometry parameter lambda [-]
+ * @param  nonDimensionalTime     Computed non-dimensional time-of-flight T [-]
+ * @param  departureRadial        Computed radial unit vector at departure [-]
+ * @param  arrivalRadial          Computed radial unit vector at arrival [-]
+ * @param  departureTangential    Computed tangential unit vector at departure [-]
+ * @param  arrivalTangential      Computed tangential unit vector at arrival [-]
+ * @return                        True if geometry is defined, false if the time-of-flight is not
+ *                                positive or if the positions are collinear
+ */
+template< typename Real, typename Vector3 >
+bool computeLambertGeometry( const Vector3& departurePosition,
+                             const Vector3& arrivalPosition,
+                             const Real timeOfFlight,
+                             const Real gravitationalParameter,
+                             const bool isRetrograde,
+                             Real& lambda,
+                             Real& nonDimensionalTime,
+                             Real departureRadial[ 3 ],
+                             Real arrivalRadial[ 3 ],
+                             Real departureTangential[ 3 ],
+                             Real arrivalTangential[ 3 ] );
+
+//! Compute maximum number of revolutions of non-dimensional Lambert problem.
+/*!
+ * Computes the maximum number of revolutions that can be completed for a given geometry parameter
+ * and non-dimensional time-of-flight, using Halley's method to find the minimum time-of-flight of
+ * the highest number of revolutions (Izzo, 2014).
+ *
+ * @tparam Real               Type for reals
+ * @param  lambda             Geometry parameter lambda [-]
+ * @param  nonDimensionalTime Non-dimensional time-of-flight T [-]
+ * @return                    Maximum number of revolutions
+ */
+template< typename Real >
+int computeNonDimensionalLambertMaximumRevolutions( const Real lambda,
+                                                    const Real nonDimensionalTime );
+
+//! Compute non-dimensional time-of-flight of Lambert problem.
+/*!
+ * Computes the non-dimensional time-of-flight T(x) for a given Lancaster-Blanchard variable x,
+ * using the series expansion of Battin close to x = 1, Lagrange's expression near x = 1 and
+ * Lancaster's expression elsewhere (Izzo, 2014).
+ *
+ * @tparam Real                Type for reals
+ * @param  x                   Lancaster-Blanchard variable [-]
+ * @param  lambda              Geometry parameter lambda [-]
+ * @param  numberOfRevolutions Number of complete revolutions
+ * @return                     Non-dimensional time-of-flight [-]
+ */
+template< typename Real >
+Real computeNonDimensionalLambertTimeOfFlight( const Real x,
+                                               const Real lambda,
+                                               const int numberOfRevolutions );
+
+//! Compute derivatives of non-dimensional time-of-flight of Lambert problem.
+/*!
+ * Computes the first, second and third derivatives of the non-dimensional time-of-flight with
+ * respect to the Lancaster-Blanchard variable x (Izzo, 2014).
+ *
+ * @tparam Real               Type for reals
+ * @param  x                  Lancaster-Blanchard variable [-]
+ * @param  nonDimensionalTime Non-dimensional time-of-flight T(x) [-]
+ * @param  lambda             Geometry parameter lambda [-]
+ * @param  firstDerivative    Computed first derivative dT/dx [-]
+ * @param  secondDerivative   Computed second derivative d2T/dx2 [-]
+ * @param  thirdDerivative    Computed third derivative d3T/dx3 [-]
+ */
+template< typename Real >
+void computeNonDimensionalLambertTimeOfFlightDerivatives( const Real x,
+                                                          const Real nonDimensionalTime,
+                                                          const Real lambda,
+                                                          Real& firstDerivative,
+                                                          Real& secondDerivative,
+                                                          Real& thirdDerivative );
+
+//! Solve non-dimensional time-of-flight equation of Lambert problem.
+/*!
+ * Solves the non-dimensional time-of-flight equation T(x) = T for the Lancaster-Blanchard
+ * variable x, using Householder's method (Izzo, 2014).
+ *
+ * @tparam Real                Type for reals
+ * @param  nonDimensionalTime  Non-dimensional time-of-flight T [-]
+ * @param  initialGuess        Initial guess for Lancaster-Blanchard variable [-]
+ * @param  lambda              Geometry parameter lambda [-]
+ * @param  numberOfRevolutions Number of complete revolutions
+ * @param  tolerance           Tolerance on change of Lancaster-Blanchard variable [-]
+ * @param  maximumIterations   Maximum number of iterations
+ * @return                     Lancaster-Blanchard variable [-]
+ */
+template< typename Real >
+Real solveNonDimensionalLambertTimeOfFlight( const Real nonDimensionalTime,
+                                             const Real initialGuess,
+                                             const Real lambda,
+                                             const int numberOfRevolutions,
+                                             const Real tolerance,
+                                             const int maximumIterations );
+
+//! Solve Lambert problem.
+template< typename Real, typename Vector3 >
+bool solveLambertProblem( const Vector3& departurePosition,
+                          const Vector3& arrivalPosition,
+                          const Real timeOfFlight,
+                          const Real gravitationalParameter,
+                          Real departureVelocity[ 3 ],
+                          Real arrivalVelocity[ 3 ],
+                          const int numberOfRevolutions,
+                          const bool isRetrograde,
+                          const bool isRightBranch )
+{
+    Real lambda = 0.0;
+    Real nonDimensionalTime = 0.0;
+    Real departureRadial[ 3 ];
+    Real arrivalRadial[ 3 ];
+    Real departureTangential[ 3 ];
+    Real arrivalTangential[ 3 ];
+    if ( !computeLambertGeometry( departurePosition,
+                                  arrivalPosition,
+                                  timeOfFlight,
+                                  gravitationalParameter,
+                                  isRetrograde,
+                                  lambda,
+                                  nonDimensionalTime,
+                                  departureRadial,
+                                  arrivalRadial,
+                                  departureTangential,
+                                  arrivalTangential ) )
+    {
+        return false;
+    }
+
+    if ( numberOfRevolutions < 0
+         || numberOfRevolutions
+            > computeNonDimensionalLambertMaximumRevolutions( lambda, nonDimensionalTime ) )
+    {
+        return false;
+    }
+
+    const Real pi = 3.14159265358979323846;
+    const Real lambda2 = lambda * lambda;
+    const Real lambda3 = lambda2 * lambda;
+
+    // Compute initial guess for Lancaster-Blanchard variable and solve time-of-flight equation.
+    Real x = 0.0;
+    if ( numberOfRevolutions == 0 )
+    {
+        const Real timeOfFlight00 = std::acos( lambda ) + lambda * std::sqrt( 1.0 - lambda2 );
+        const Real timeOfFlight1 = 2.0 / 3.0 * ( 1.0 - lambda3 );
+        Real initialGuess = 0.0;
+        if ( nonDimensionalTime >= timeOfFlight00 )
+        {
+            initialGuess = -( nonDimensionalTime - timeOfFlight00 )
+                           / ( nonDimensionalTime - timeOfFlight00 + 4.0 );
+        }
+        else if ( nonDimensionalTime <= timeOfFlight1 )
+        {
+            initialGuess = timeOfFlight1 * ( timeOfFlight1 - nonDimensionalTime )
+                           / ( 0.4 * ( 1.0 - lambda2 * lambda3 ) * nonDimensionalTime ) + 1.0;
+        }
+        else
+        {
+            initialGuess = std::pow( nonDimensionalTime / timeOfFlight00,
+                                     0.69314718055994529
+                                     / std::log( timeOfFlight1 / timeOfFlight00 ) ) - 1.0;
+        }
+        x = solveNonDimensionalLambertTimeOfFlight(
+            nonDimensionalTime, initialGuess, lambda, 0, Real( 1.0e-5 ), 15 );
+    }
+    else
+    {
+        const Real revolutions = numberOfRevolutions;
+        const Real factor = isRightBranch
+            ? std::pow( 8.0 * nonDimensionalTime / ( revolutions * pi ), 2.0 / 3.0 )
+            : std::pow( ( revolutions * pi + pi ) / ( 8.0 * nonDimensionalTime ), 2.0 / 3.0 );
+        const Real initialGuess = ( factor - 1.0 ) / ( factor + 1.0 );
+        x = solveNonDimensionalLambertTimeOfFlight(
+            nonDimensionalTime, initialGuess, lambda, numberOfRevolutions, Real( 1.0e-8 ), 15 );
+    }
+
+    // Reconstruct departure and arrival velocities from Lancaster-Blanchard variable.
+    Real departureRadius = 0.0;
+    Real arrivalRadius = 0.0;
+    Real chord = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadius += departurePosition[ i ] * departurePosition[ i ];
+        arrivalRadius += arrivalPosition[ i ] * arrivalPosition[ i ];
+        chord += ( arrivalPosition[ i ] - departurePosition[ i ] )
+                 * ( arrivalPosition[ i ] - departurePosition[ i ] );
+    }
+    departureRadius = std::sqrt( departureRadius );
+    arrivalRadius = std::sqrt( arrivalRadius );
+    chord = std::sqrt( chord );
+    const Real semiPerimeter = 0.5 * ( chord + departureRadius + arrivalRadius );
+
+    const Real gamma = std::sqrt( gravitationalParameter * semiPerimeter / 2.0 );
+    const Real rho = ( departureRadius - arrivalRadius ) / chord;
+    const Real sigma = std::sqrt( 1.0 - rho * rho );
+    const Real y = std::sqrt( 1.0 - lambda2 + lambda2 * x * x );
+
+    const Real departureRadialVelocity
+        = gamma * ( ( lambda * y - x ) - rho * ( lambda * y + x ) ) / departureRadius;
+    const Real arrivalRadialVelocity
+        = -gamma * ( ( lambda * y - x ) + rho * ( lambda * y + x ) ) / arrivalRadius;
+    const Real tangentialVelocity = gamma * sigma * ( y + lambda * x );
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureVelocity[ i ] = departureRadialVelocity * departureRadial[ i ]
+                                 + tangentialVelocity / departureRadius * departureTangential[ i ];
+        arrivalVelocity[ i ] = arrivalRadialVelocity * arrivalRadial[ i ]
+                               + tangentialVelocity / arrivalRadius * arrivalTangential[ i ];
+    }
+
+    return true;
+}
+
+//! Compute maximum number of revolutions of Lambert problem.
+template< typename Real, typename Vector3 >
+int computeLambertMaximumRevolutions( const Vector3& departurePosition,
+                                      const Vector3& arrivalPosition,
+                                      const Real timeOfFlight,
+                                      const Real gravitationalParameter,
+                                      const bool isRetrograde )
+{
+    Real lambda = 0.0;
+    Real nonDimensionalTime = 0.0;
+    Real departureRadial[ 3 ];
+    Real arrivalRadial[ 3 ];
+    Real departureTangential[ 3 ];
+    Real arrivalTangential[ 3 ];
+    if ( !computeLambertGeometry( departurePosition,
+                                  arrivalPosition,
+                                  timeOfFlight,
+                                  gravitationalParameter,
+                                  isRetrograde,
+                                  lambda,
+                                  nonDimensionalTime,
+                                  departureRadial,
+                                  arrivalRadial,
+                                  departureTangential,
+                                  arrivalTangential ) )
+    {
+        return -1;
+    }
+
+    return computeNonDimensionalLambertMaximumRevolutions( lambda, nonDimensionalTime );
+}
+
+//! Compute initial guess for departure velocity by solving Lambert problem.
+template< typename Real, typename Vector3 >
+Vector3 computeLambertDepartureVelocityGuess( const Vector3& departurePosition,
+                                              const Vector3& arrivalPosition,
+                                              const Real timeOfFlight,
+                                              const Real gravitationalParameter,
+                                              const int maximumRevolutions,
+                                              const bool isRetrograde )
+{
+    Vector3 departureVelocityGuess = createVector< Vector3 >( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureVelocityGuess[ i ] = 0.0;
+    }
+
+    Real departureVelocity[ 3 ];
+    Real arrivalVelocity[ 3 ];
+    Real lowestSpeedSquared = -1.0;
+
+    // Loop over all feasible numbers of revolutions and both branches of the multi-revolution
+    // solutions.
+    const int numberOfRevolutions = std::min(
+        maximumRevolutions,
+        computeLambertMaximumRevolutions(
+            departurePosition, arrivalPosition, timeOfFlight, gravitationalParameter,
+            isRetrograde ) );
+
+    for ( int revolutions = 0; revolutions <= numberOfRevolutions; revolutions++ )
+    {
+        for ( int branch = 0; branch < ( ( revolutions == 0 ) ? 1 : 2 ); branch++ )
+        {
+            if ( !solveLambertProblem( departurePosition,
+                                       arrivalPosition,
+                                       timeOfFlight,
+                                       gravitationalParameter,
+                                       departureVelocity,
+                                       arrivalVelocity,
+                                       revolutions,
+                                       isRetrograde,
+                                       branch == 1 ) )
+            {
+                continue;
+            }
+
+            // Skip solutions for which the time-of-flight equation did not converge (NaN).
+            const Real speedSquared = departureVelocity[ 0 ] * departureVelocity[ 0 ]
+                                      + departureVelocity[ 1 ] * departureVelocity[ 1 ]
+                                      + departureVelocity[ 2 ] * departureVelocity[ 2 ];
+            if ( speedSquared == speedSquared
+                 && ( lowestSpeedSquared < 0.0 || speedSquared < lowestSpeedSquared ) )
+            {
+                lowestSpeedSquared = speedSquared;
+                for ( int i = 0; i < 3; i++ )
+                {
+                    departureVelocityGuess[ i ] = departureVelocity[ i ];
+                }
+            }
+        }
+    }
+
+    return departureVelocityGuess;
+}
+
+//! Compute geometry of Lambert problem.
+template< typename Real, typename Vector3 >
+bool computeLambertGeometry( const Vector3& departurePosition,
+                             const Vector3& arrivalPosition,
+                             const Real timeOfFlight,
+                             const Real gravitationalParameter,
+                             const bool isRetrograde,
+                             Real& lambda,
+                             Real& nonDimensionalTime,
+                             Real departureRadial[ 3 ],
+                             Real arrivalRadial[ 3 ],
+                             Real departureTangential[ 3 ],
+                             Real arrivalTangential[ 3 ] )
+{
+    if ( !( timeOfFlight > 0.0 ) )
+    {
+        return false;
+    }
+
+    // Compute radii, chord and semi-perimeter of transfer triangle.
+    Real departureRadius = 0.0;
+    Real arrivalRadius = 0.0;
+    Real chord = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadius += departurePosition[ i ] * departurePosition[ i ];
+        arrivalRadius += arrivalPosition[ i ] * arrivalPosition[ i ];
+        chord += ( arrivalPosition[ i ] - departurePosition[ i ] )
+                 * ( arrivalPosition[ i ] - departurePosition[ i ] );
+    }
+    departureRadius = std::sqrt( departureRadius );
+    arrivalRadius = std::sqrt( arrivalRadius );
+    chord = std::sqrt( chord );
+    const Real semiPerimeter = 0.5 * ( chord + departureRadius + arrivalRadius );
+
+    // Compute radial unit vectors and unit vector along angular momentum of transfer.
+    for ( int i = 0; i < 3; i++ )
+    {
+        departureRadial[ i ] = departurePosition[ i ] / departureRadius;
+        arrivalRadial[ i ] = arrivalPosition[ i ] / arrivalRadius;
+    }
+
+    Real angularMomentum[ 3 ];
+    angularMomentum[ 0 ] = departureRadial[ 1 ] * arrivalRadial[ 2 ]
+                           - departureRadial[ 2 ] * arrivalRadial[ 1 ];
+    angularMomentum[ 1 ] = departureRadial[ 2 ] * arrivalRadial[ 0 ]
+                           - departureRadial[ 0 ] * arrivalRadial[ 2 ];
+    angularMomentum[ 2 ] = departureRadial[ 0 ] * arrivalRadial[ 1 ]
+                           - departureRadial[ 1 ] * arrivalRadial[ 0 ];
+    const Real angularMomentumNorm = std::sqrt( angularMomentum[ 0 ] * angularMomentum[ 0 ]
+                                                + angularMomentum[ 1 ] * angularMomentum[ 1 ]
+                                                + angularMomentum[ 2 ] * angularMomentum[ 2 ] );
+
+    // The plane of the transfer is undefined if the positions are collinear.
+    if ( !( angularMomentumNorm > 1.0e-12 ) )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        angularMomentum[ i ] /= angularMomentumNorm;
+    }
+
+    // Compute geometry parameter and tangential unit vectors. The sign of lambda is negative if the
+    // transfer angle is larger than pi.
+    lambda = std::sqrt( std::max( 1.0 - chord / semiPerimeter, Real( 0.0 ) ) );
+    Real sign = 1.0;
+    if ( angularMomentum[ 2 ] < 0.0 )
+    {
+        lambda = -lambda;
+        sign = -1.0;
+    }
+    if ( isRetrograde )
+    {
+        lambda = -lambda;
+        sign = -sign;
+    }
+
+    departureTangential[ 0 ] = sign * ( angularMomentum[ 1 ] * departureRadial[ 2 ]
+                                        - angularMomentum[ 2 ] * departureRadial[ 1 ] );
+    departureTangential[ 1 ] = sign * ( angularMomentum[ 2 ] * departureRadial[ 0 ]
+                                        - angularMomentum[ 0 ] * departureRadial[ 2 ] );
+    departureTangential[ 2 ] = sign * ( angularMomentum[ 0 ] * departureRadial[ 1 ]
+                                        - angularMomentum[ 1 ] * departureRadial[ 0 ] );
+    arrivalTangential[ 0 ] = sign * ( angularMomentum[ 1 ] * arrivalRadial[ 2 ]
+                                      - angularMomentum[ 2 ] * arrivalRadial[ 1 ] );
+    arrivalTangential[ 1 ] = sign * ( angularMomentum[ 2 ] * arrivalRadial[ 0 ]
+                                      - angularMomentum[ 0 ] * arrivalRadial[ 2 ] );
+    arrivalTangential[ 2 ] = sign * ( angularMomentum[ 0 ] * arrivalRadial[ 1 ]
+                                      - angularMomentum[ 1 ] * arrivalRadial[ 0 ] );
+
+    // Compute non-dimensional time-of-flight.
+    nonDimensionalTime = std::sqrt( 2.0 * gravitationalParameter
+                                    / ( semiPerimeter * semiPerimeter * semiPerimeter ) )
+                         * timeOfFlight;
+
+    return true;
+}
+
+//! Compute maximum number of revolutions of non-dimensional Lambert problem.
+template< typename Real >
+int computeNonDimensionalLambertMaximumRevolutions( const Real lambda,
+                                                    const Real nonDimensionalTime )
+{
+    const Real pi = 3.14159265358979323846;
+
+    int maximumRevolutions = static_cast< int >( nonDimensionalTime / pi );
+    const Real timeOfFlight00
+        = std::acos( lambda ) + lambda * std::sqrt( 1.0 - lambda * lambda );
+    const Real timeOfFlight0 = timeOfFlight00 + maximumRevolutions * pi;
+
+    // Check if the minimum time-of-flight of the highest number of revolutions is smaller than the
+    // time-of-flight, using Halley's method to find the minimum time-of-flight.
+    if ( maximumRevolutions > 0 && nonDimensionalTime < timeOfFlight0 )
+    {
+        Real minimumTimeOfFlight = timeOfFlight0;
+        Real xOld = 0.0;
+        Real xNew = 0.0;
+        Real firstDerivative = 0.0;
+        Real secondDerivative = 0.0;
+        Real thirdDerivative = 0.0;
+        for ( int iteration = 0; ; iteration++ )
+        {
+            computeNonDimensionalLambertTimeOfFlightDerivatives(
+                xOld, minimumTimeOfFlight, lambda,
+                firstDerivative, secondDerivative, thirdDerivative );
+            if ( firstDerivative != 0.0 )
+            {
+                xNew = xOld - firstDerivative * secondDerivative
+                              / ( secondDerivative * secondDerivative
+                                  - firstDerivative * thirdDerivative / 2.0 );
+            }
+            if ( std::fabs( xOld - xNew ) < 1.0e-13 || iteration > 12 )
+            {
+                break;
+            }
+            minimumTimeOfFlight
+                = computeNonDimensionalLambertTimeOfFlight( xNew, lambda, maximumRevolutions );
+            xOld = xNew;
+        }
+
+        if ( minimumTimeOfFlight > nonDimensionalTime )
+        {
+            --maximumRevolutions;
+        }
+    }
+
+    return maximumRevolutions;
+}
+
+//! Compute non-dimensional time-of-flight of Lambert problem.
+template< typename Real >
+Real computeNonDimensionalLambertTimeOfFlight( const Real x,
+                                               const Real lambda,
+                                               const int numberOfRevolutions )
+{
+    const Real pi = 3.14159265358979323846;
+    const Real battinDistance = 0.01;
+    const Real lagrangeDistance = 0.2;
+    const Real distance = std::fabs( x - 1.0 );
+
+    // Use Lagrange's expression near x = 1.
+    if ( distance < lagrangeDistance && distance > battinDistance )
+    {
+        const Real a = 1.0 / ( 1.0 - x * x );
+        if ( a > 0.0 )
+        {
+            const Real alpha = 2.0 * std::acos( x );
+            Real beta = 2.0 * std::asin( std::sqrt( lambda * lambda / a ) );
+            if ( lambda < 0.0 )
+            {
+                beta = -beta;
+            }
+            return a * std::sqrt( a ) * ( ( alpha - std::sin( alpha ) )
+                                          - ( beta - std::sin( beta ) )
+                                          + 2.0 * pi * numberOfRevolutions ) / 2.0;
+        }
+
+        const Real alpha = 2.0 * std::acosh( x );
+        Real beta = 2.0 * std::asinh( std::sqrt( -lambda * lambda / a ) );
+        if ( lambda < 0.0 )
+        {
+            beta = -beta;
+        }
+        return -a * std::sqrt( -a ) * ( ( beta - std::sinh( beta ) )
+                                        - ( alpha - std::sinh( alpha ) ) ) / 2.0;
+    }
+
+    const Real k = lambda * lambda;
+    const Real e = x * x - 1.0;
+    const Real rho = std::fabs( e );
+    const Real z = std::sqrt( 1.0 + k * e );
+
+    // Use series expansion of Battin close to x = 1.
+    if ( distance < battinDistance )
+    {
+        const Real eta = z - lambda * x;
+        const Real s1 = 0.5 * ( 1.0 - lambda - x * eta );
+
+        // Evaluate hypergeometric function 2F1(3, 1, 5/2, s1).
+        Real hypergeometric = 1.0;
+        Real term = 1.0;
+        for ( int j = 0; std::fabs( term ) > 1.0e-11; j++ )
+        {
+            term *= ( 3.0 + j ) * ( 1.0 + j ) / ( 2.5 + j ) * s1 / ( j + 1.0 );
+            hypergeometric += term;
+        }
+        const Real q = 4.0 / 3.0 * hypergeometric;
+
+        Real timeOfFlight = ( eta * eta * eta * q + 4.0 * lambda * eta ) / 2.0;
+        if ( numberOfRevolutions > 0 )
+        {
+            timeOfFlight += numberOfRevolutions * pi / std::pow( rho, 1.5 );
+        }
+        return timeOfFlight;
+    }
+
+    // Use Lancaster's expression elsewhere.
+    const Real y = std::sqrt( rho );
+    const Real g = x * z - lambda * e;
+    Real d = 0.0;
+    if ( e < 0.0 )
+    {
+        d = numberOfRevolutions * pi + std::acos( g );
+    }
+    else
+    {
+        const Real f = y * ( z - lambda * x );
+        d = std::log( f + g );
+    }
+    return ( x - lambda * z - d / y ) / e;
+}
+
+//! Compute derivatives of non-dimensional time-of-flight of Lambert problem.
+template< typename Real >
+void computeNonDimensionalLambertTimeOfFlightDerivatives( const Real x,
+                                                          const Real nonDimensionalTime,
+                                                          const Real lambda,
+                                                          Real& firstDerivative,
+                                                          Real& secondDerivative,
+                                                          Real& thirdDerivative )
+{
+    const Real lambda2 = lambda * lambda;
+    const Real lambda3 = lambda2 * lambda;
+    const Real oneMinusX2 = 1.0 - x * x;
+    const Real y = std::sqrt( 1.0 - lambda2 * oneMinusX2 );
+    const Real y2 = y * y;
+    const Real y3 = y2 * y;
+
+    firstDerivative = ( 3.0 * nonDimensionalTime * x - 2.0 + 2.0 * lambda3 * x / y ) / oneMinusX2;
+    secondDerivative = ( 3.0 * nonDimensionalTime + 5.0 * x * firstDerivative
+                         + 2.0 * ( 1.0 - lambda2 ) * lambda3 / y3 ) / oneMinusX2;
+    thirdDerivative = ( 7.0 * x * secondDerivative + 8.0 * firstDerivative
+                        - 6.0 * ( 1.0 - lambda2 ) * lambda2 * lambda3 * x / y3 / y2 )
+                      / oneMinusX2;
+}
+
+//! Solve non-dimensional time-of-flight equation of Lambert problem.
+template< typename Real >
+Real solveNonDimensionalLambertTimeOfFlight( const Real nonDimensionalTime,
+                                             const Real initialGuess,
+                                             const Real lambda,
+                                             const int numberOfRevolutions,
+                                             const Real tolerance,
+                                             const int maximumIterations )
+{
+    Real x = initialGuess;
+    Real error = 1.0;
+    Real firstDerivative = 0.0;
+    Real secondDerivative = 0.0;
+    Real thirdDerivative = 0.0;
+
+    for ( int iteration = 0; error > tolerance && iteration < maximumIterations; iteration++ )
+    {
+        const Real timeOfFlight
+            = computeNonDimensionalLambertTimeOfFlight( x, lambda, numberOfRevolutions );
+        computeNonDimensionalLambertTimeOfFlightDerivatives(
+            x, timeOfFlight, lambda, firstDerivative, secondDerivative, thirdDerivative );
+
+        // Execute Householder iteration.
+        const Real delta = timeOfFlight - nonDimensionalTime;
+        const Real firstDerivative2 = firstDerivative * firstDerivative;
+        const Real xNew = x - delta * ( firstDerivative2 - delta * secondDerivative / 2.0 )
+                              / ( firstDerivative * ( firstDerivative2 - delta * secondDerivative )
+                                  + thirdDerivative * delta * delta / 6.0 );
+        error = std::fabs( x - xNew );
+        x = xNew;
+    }
+
+    return x;
+}
+
+} // namespace atom
+
+#endif // ATOM_LAMBERT_SOLVER_H
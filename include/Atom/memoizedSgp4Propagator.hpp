@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_MEMOIZED_SGP4_PROPAGATOR_H
+#define ATOM_MEMOIZED_SGP4_PROPAGATOR_H
+
+#include <cstddef>
+#include <memory>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Eci.h>
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
+
+namespace atom
+{
+
+//! SGP4/SDP4 propagator that memoizes the initialization for the last TLE.
+/*!
+ * Propagator handle that owns an SGP4/SDP4 propagator and the elements of the TLE it has been
+ * initialized with. Setting a TLE skips the SGP4/SDP4 initialization if all elements that are
+ * used by the initialization (epoch, mean elements, B* drag term and derivatives of mean motion)
+ * are bit-identical to the elements of the previous TLE. This memoizes the final, repeated
+ * propagation of the converged TLE of a nested Cartesian-to-TLE conversion by the Atom residual
+ * function, since the last evaluation of the nested residual function has already initialized the
+ * propagator with that TLE.
+ *
+ * Any other TLE triggers a full initialization, including the lunar-solar and resonance terms for
+ * deep-space orbits, since libsgp4 does not expose element-independent terms that could be cached.
+ *
+ * The propagator is allocated when the first TLE is set and is re-initialized in place for
+ * subsequent TLEs, such that no memory is allocated after the first TLE has been set. If the
+ * initialization fails, the exception thrown by the SGP4/SDP4 propagator is propagated and no TLE
+ * is set.
+ *
+ * Propagators cannot be copied, since they own the SGP4/SDP4 propagator.
+ *
+ * @sa computeCartesianToTwoLineElementResiduals, computeAtomResiduals
+ */
+class MemoizedSgp4Propagator
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up propagator without TLE.
+     */
+    MemoizedSgp4Propagator( )
+        : hasTle( false ),
+          epochTicks( 0 ),
+          inclination( 0.0 ),
+          rightAscendingNode( 0.0 ),
+          eccentricity( 0.0 ),
+          argumentPerigee( 0.0 ),
+          meanAnomaly( 0.0 ),
+          meanMotion( 0.0 ),
+          bStar( 0.0 ),
+          meanMotionDt2( 0.0 ),
+          meanMotionDdt6( 0.0 ),
+          initializationCounter( 0 ),
+          reuseCounter( 0 )
+    { }
+
+    //! Set TLE to propagate.
+    /*!
+     * Sets TLE to propagate, re-initializing the SGP4/SDP4 propagator only if the elements of the
+     * TLE differ from the elements of the TLE that has been set previously.
+     *
+     * @param  tle TLE to propagate
+     * @return     Flag indicating if the propagator has been re-initialized
+     */
+    bool setTle( const Tle& tle )
+    {
+        if ( hasTle && isTleEqual( tle ) )
+        {
+            ++reuseCounter;
+            return false;
+        }
+
+        // Unset TLE before initialization, such that no TLE is set if the initialization throws.
+        hasTle = false;
+        if ( propagator.get( ) == 0 )
+        {
+            propagator.reset( new SGP4( tle ) );
+        }
+        else
+        {
+            propagator->SetTle( tle );
+        }
+
+        epochTicks = tle.Epoch( ).Ticks( );
+        inclination = tle.Inclination( true );
+        rightAscendingNode = tle.RightAscendingNode( true );
+        eccentricity = tle.Eccentricity( );
+        argumentPerigee = tle.ArgumentPerigee( true );
+        meanAnomaly = tle.MeanAnomaly( true );
+        meanMotion = tle.MeanMotion( );
+        bStar = tle.BStar( );
+        meanMotionDt2 = tle.MeanMotionDt2( );
+        meanMotionDdt6 = tle.MeanMotionDdt6( );
+        hasTle = true;
+        ++initializationCounter;
+        return true;
+    }
+
+    //! Propagate TLE.
+    /*!
+     * Propagates TLE that has been set using the SGP4/SDP4 propagator. A TLE must have been set.
+     *
+     * @param  minutesSinceEpoch Time since epoch of TLE [min]
+     * @return                   Propagated Cartesian state
+     */
+    Eci findPosition( const double minutesSinceEpoch ) const
+    {
+        return propagator->FindPosition( minutesSinceEpoch );
+    }
+
+    //! Check if TLE has been set.
+    bool isTleSet( ) const
+    {
+        return hasTle;
+    }
+
+    //! Get number of initializations of SGP4/SDP4 propagator.
+    std::size_t numberOfInitializations( ) const
+    {
+        return initializationCounter;
+    }
+
+    //! Get number of TLEs set without re-initializing SGP4/SDP4 propagator.
+    std::size_t numberOfReuses( ) const
+    {
+        return reuseCounter;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    MemoizedSgp4Propagator( const MemoizedSgp4Propagator& );
+
+    //! Assignment operator (disabled).
+    MemoizedSgp4Propagator& operator=( const MemoizedSgp4Propagator& );
+
+    //! Check if elements of given TLE are equal to elements of TLE that has been set.
+    bool isTleEqual( const Tle& tle ) const
+    {
+        return tle.MeanAnomaly( true ) == meanAnomaly
+               && tle.MeanMotion( ) == meanMotion
+               && tle.Eccentricity( ) == eccentricity
+               && tle.ArgumentPerigee( true ) == argumentPerigee
+               && tle.RightAscendingNode( true ) == rightAscendingNode
+               && tle.Inclination( true ) == inclination
+               && tle.Epoch( ).Ticks( ) == epochTicks
+               && tle.BStar( ) == bStar
+               && tle.MeanMotionDt2( ) == meanMotionDt2
+               && tle.MeanMotionDdt6( ) == meanMotionDdt6;
+    }
+
+    //! SGP4/SDP4 propagator, allocated when first TLE is set.
+    std::unique_ptr< SGP4 > propagator;
+
+    //! Flag indicating if TLE has been set.
+    bool hasTle;
+
+    //! Epoch of TLE that has been set [ticks].
+    long long epochTicks;
+
+    //! Mean inclination of TLE that has been set [deg].
+    double inclination;
+
+    //! Mean right ascending node of TLE that has been set [deg].
+    double rightAscendingNode;
+
+    //! Mean eccentricity of TLE that has been set [-].
+    double eccentricity;
+
+    //! Mean argument of perigee of TLE that has been set [deg].
+    double argumentPerigee;
+
+    //! Mean mean anomaly of TLE that has been set [deg].
+    double meanAnomaly;
+
+    //! Mean motion of TLE that has been set [rev/day].
+    double meanMotion;
+
+    //! B* drag term of TLE that has been set.
+    double bStar;
+
+    //! First time derivative of mean motion of TLE that has been set, divided by two.
+    double meanMotionDt2;
+
+    //! Second time derivative of mean motion of TLE that has been set, divided by six.
+    double meanMotionDdt6;
+
+    //! Number of initializations of SGP4/SDP4 propagator.
+    std::size_t initializationCounter;
+
+    //! Number of TLEs set without re-initializing SGP4/SDP4 propagator.
+    std::size_t reuseCounter;
+};
+
+} // namespace atom
+
+#endif // ATOM_MEMOIZED_SGP4_PROPAGATOR_H
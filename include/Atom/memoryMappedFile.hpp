@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_MEMORY_MAPPED_FILE_H
+#define ATOM_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace atom
+{
+
+//! File mapped into memory.
+/*!
+ * File that is mapped into the address space of the process, such that it is read and written in
+ * place without buffered I/O. A file is either created with a given size and mapped for reading
+ * and writing, or an existing file is mapped for reading only. The mapping is released by the
+ * destructor, which also writes back any modified pages to the file.
+ *
+ * Concurrent writes to disjoint regions of the mapping do not need to be synchronized.
+ */
+class MemoryMappedFile
+{
+public:
+
+    //! Constructor that creates file of given size.
+    /*!
+     * Constructor that creates a file of the given size, or truncates an existing file to that
+     * size, and maps it for reading and writing. The contents of the created file are zero.
+     *
+     * @throws std::runtime_error If the file cannot be created or mapped
+     * @param  fileName  Name of file
+     * @param  aFileSize Size of file [bytes]
+     */
+    MemoryMappedFile( const std::string& fileName, const std::size_t aFileSize )
+        : fileData( 0 ),
+          fileSize( aFileSize ),
+          isWritable( true )
+    {
+        if ( fileSize == 0 )
+        {
+            throw std::runtime_error( "ERROR: Cannot map empty file " + fileName + "!" );
+        }
+
+#if defined( _WIN32 )
+        fileHandle = CreateFileA( fileName.c_str( ), GENERIC_READ | GENERIC_WRITE, 0, 0,
+                                  CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0 );
+        if ( fileHandle == INVALID_HANDLE_VALUE )
+        {
+            throw std::runtime_error( "ERROR: Cannot create file " + fileName + "!" );
+        }
+
+        const unsigned long long size = fileSize;
+        mappingHandle = CreateFileMappingA( fileHandle, 0, PAGE_READWRITE,
+                                            static_cast< DWORD >( size >> 32 ),
+                                            static_cast< DWORD >( size & 0xffffffffULL ), 0 );
+        if ( mappingHandle == 0 )
+        {
+            CloseHandle( fileHandle );
+            throw std::runtime_error( "ERROR: Cannot resize file " + fileName + "!" );
+        }
+
+        fileData = MapViewOfFile( mappingHandle, FILE_MAP_WRITE, 0, 0, fileSize );
+#else
+        fileDescriptor = open( fileName.c_str( ), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        if ( fileDescriptor < 0 )
+        {
+            throw std::runtime_error( "ERROR: Cannot create file " + fileName + "!" );
+        }
+
+        if ( ftruncate( fileDescriptor, static_cast< off_t >( fileSize ) ) != 0 )
+        {
+            close( fileDescriptor );
+            throw std::runtime_error( "ERROR: Cannot resize file " + fileName + "!" );
+        }
+
+        fileData = mmap( 0, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0 );
+        if ( fileData == MAP_FAILED )
+        {
+            fileData = 0;
+        }
+#endif
+
+        if ( fileData == 0 )
+        {
+            closeFile( );
+            throw std::runtime_error( "ERROR: Cannot map file " + fileName + "!" );
+        }
+    }
+
+    //! Constructor that maps existing file for reading.
+    /*!
+     * Constructor that maps an existing file for reading only.
+     *
+     * @throws std::runtime_error If the file cannot be opened or mapped, or if it is empty
+     * @param  fileName Name of file
+     */
+    explicit MemoryMappedFile( const std::string& fileName )
+        : fileData( 0 ),
+          fileSize( 0 ),
+          isWritable( false )
+    {
+#if defined( _WIN32 )
+        fileHandle = CreateFileA( fileName.c_str( ), GENERIC_READ, FILE_SHARE_READ, 0,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+        if ( fileHandle == INVALID_HANDLE_VALUE )
+        {
+            throw std::runtime_error( "ERROR: Cannot open file " + fileName + "!" );
+        }
+
+        LARGE_INTEGER size;
+        if ( GetFileSizeEx( fileHandle, &size ) == 0 || size.QuadPart == 0 )
+        {
+            CloseHandle( fileHandle );
+            throw std::runtime_error( "ERROR: Cannot map empty file " + fileName + "!" );
+        }
+        fileSize = static_cast< std::size_t >( size.QuadPart );
+
+        mappingHandle = CreateFileMappingA( fileHandle, 0, PAGE_READONLY, 0, 0, 0 );
+        if ( mappingHandle != 0 )
+        {
+            fileData = MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, fileSize );
+        }
+#else
+        fileDescriptor = open( fileName.c_str( ), O_RDONLY );
+        if ( fileDescriptor < 0 )
+        {
+            throw std::runtime_error( "ERROR: Cannot open file " + fileName + "!" );
+        }
+
+        struct stat fileStatus;
+        if ( fstat( fileDescriptor, &fileStatus ) != 0 || fileStatus.st_size == 0 )
+        {
+            close( fileDescriptor );
+            throw std::runtime_error( "ERROR: Cannot map empty file " + fileName + "!" );
+        }
+        fileSize = static_cast< std::size_t >( fileStatus.st_size );
+
+        fileData = mmap( 0, fileSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+        if ( fileData == MAP_FAILED )
+        {
+            fileData = 0;
+        }
+#endif
+
+        if ( fileData == 0 )
+        {
+            closeFile( );
+            throw std::runtime_error( "ERROR: Cannot map file " + fileName + "!" );
+        }
+    }
+
+    //! Destructor.
+    /*!
+     * Destructor, which writes back modified pages and releases the mapping.
+     */
+    ~MemoryMappedFile( )
+    {
+        flush( );
+#if defined( _WIN32 )
+        UnmapViewOfFile( fileData );
+#else
+        munmap( fileData, fileSize );
+#endif
+        closeFile( );
+    }
+
+    //! Write back modified pages to file.
+    /*!
+     * Writes back modified pages of the mapping to the file and waits until they are written.
+     * This has no effect if the file is mapped for reading only.
+     */
+    void flush( )
+    {
+        if ( !isWritable )
+        {
+            return;
+        }
+#if defined( _WIN32 )
+        FlushViewOfFile( fileData, 0 );
+        FlushFileBuffers( fileHandle );
+#else
+        msync( fileData, fileSize, MS_SYNC );
+#endif
+    }
+
+    //! Get pointer to start of mapping.
+    void* data( )
+    {
+        return fileData;
+    }
+
+    //! Get pointer to start of mapping.
+    const void* data( ) const
+    {
+        return fileData;
+    }
+
+    //! Get size of mapping [bytes].
+    std::size_t size( ) const
+    {
+        return fileSize;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    MemoryMappedFile( const MemoryMappedFile& );
+
+    //! Assignment operator (disabled).
+    MemoryMappedFile& operator=( const MemoryMappedFile& );
+
+    //! Close handles of file.
+    void closeFile( )
+    {
+#if defined( _WIN32 )
+        if ( mappingHandle != 0 )
+        {
+            CloseHandle( mappingHandle );
+        }
+        CloseHandle( fileHandle );
+#else
+        close( fileDescriptor );
+#endif
+    }
+
+#if defined( _WIN32 )
+    //! Handle of file.
+    HANDLE fileHandle;
+
+    //! Handle of file mapping.
+    HANDLE mappingHandle;
+#else
+    //! Descriptor of file.
+    int fileDescriptor;
+#endif
+
+    //! Pointer to start of mapping.
+    void* fileData;
+
+    //! Size of mapping [bytes].
+    std::size_t fileSize;
+
+    //! Flag indicating if file is mapped for reading and writing.
+    const bool isWritable;
+};
+
+} // namespace atom
+
+#endif // ATOM_MEMORY_MAPPED_FILE_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_PRECOMPILED_INSTANTIATIONS_H
+#define ATOM_PRECOMPILED_INSTANTIATIONS_H
+
+/*!
+ * Precompiled instantiations of the Atom solver and the Cartesian-to-TLE conversion.
+ *
+ * Atom is header-only by default. If ATOM_USE_PRECOMPILED_INSTANTIATIONS is defined, the headers
+ * declare explicit instantiations of the solvers, converters and residual functions for Real set
+ * to double and the vector types listed below, such that translation units that include the
+ * headers do not instantiate them again. The instantiations are compiled into the atom library
+ * (src/atom.cpp), which must then be linked. Other types are instantiated implicitly, as usual.
+ *
+ * The following vector types are instantiated:
+ *  - Atom solver: std::vector< double > and std::array< double, 3 >
+ *  - Cartesian-to-TLE conversion: std::vector< double >
+ *
+ * If ATOM_USE_PRECOMPILED_EIGEN_INSTANTIATIONS is also defined, Eigen::Vector3d (Atom solver) and
+ * Eigen::VectorXd (Cartesian-to-TLE conversion) are instantiated as well.
+ *
+ * The atom library defines ATOM_EXTERN_TEMPLATE as template before including the headers, which
+ * turns the explicit instantiation declarations into explicit instantiation definitions.
+ */
+#ifdef ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
+#ifndef ATOM_EXTERN_TEMPLATE
+#define ATOM_EXTERN_TEMPLATE extern template
+#endif
+
+#ifdef ATOM_USE_PRECOMPILED_EIGEN_INSTANTIATIONS
+#include <Eigen/Core>
+#endif
+
+#endif // ATOM_USE_PRECOMPILED_INSTANTIATIONS
+
+#endif // ATOM_PRECOMPILED_INSTANTIATIONS_H
@@ -4,12 +4,16 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 
 #include <gsl/gsl_multiroots.h>
+#include <gsl/gsl_vector.h>
 
 #ifndef ATOM_PRINT_FUNCTIONS_H
 #define ATOM_PRINT_FUNCTIONS_H
@@ -17,6 +21,19 @@
 namespace atom
 {
 
+//! Formats of rows written by allocation-free solver state formatters.
+enum SolverStateFormat
+{
+    //! Fixed-width table, with the same rows as printed by printSolverState.
+    tableSolverStateFormat,
+
+    //! Comma-separated values, with reals printed at full precision.
+    csvSolverStateFormat,
+
+    //! JSON object per line, with reals printed at full precision.
+    jsonLinesSolverStateFormat
+};
+
 //! Print Cartesian-state-to-TLE converter solver summary table header.
 /*!
  * Prints header to string for table containing summary of status of non-linear solver used to
@@ -63,6 +80,22 @@ inline std::string printAtomSolverStateTableHeader( );
 inline std::string printAtomSolverState(
   const int iteration, gsl_multiroot_fsolver* solver );
 
+//! Print summary of current state of non-linear solver.
+/*!
+ * Prints current state of a non-linear solver, given its independent variables and residuals, as
+ * row for a summary table. The iteration is printed first, followed by all independent variables
+ * and all residuals.
+ *
+ * @sa printCartesianToTleSolverState, printAtomSolverState
+ * @param  iteration            Current iteration of solver
+ * @param  independentVariables Current independent variables of solver
+ * @param  residuals            Residuals evaluated at current independent variables
+ * @return                      String containing row-data for non-linear solver status summary
+ *                              table
+ */
+inline std::string printSolverState(
+  const int iteration, const gsl_vector* independentVariables, const gsl_vector* residuals );
+
 //! Print data element to console.
 /*!
  * Prints a specified data element to string, given a specified width and a filler character.
@@ -79,6 +112,114 @@ inline std::string printAtomSolverState(
 template< typename DataType >
 inline std::string printElement( const DataType datum, const int width, const char filler = ' ' );
 
+//! Format header of solver state rows.
+/*!
+ * Formats the header of the rows written by formatSolverState to a caller-supplied buffer, given
+ * the names of the independent variables and residuals. The first column of the header is the
+ * iteration. No header is written for the JSON-lines format, since every row names its fields.
+ *
+ * Like std::snprintf, this function writes at most bufferSize characters, including the
+ * terminating null character, and returns the length of the full header. The header is truncated
+ * if the returned length is not smaller than the size of the buffer.
+ *
+ * @sa formatSolverState, formatCartesianToTleSolverStateHeader, formatAtomSolverStateHeader
+ * @param  columnNames     Names of independent variables, followed by names of residuals
+ * @param  numberOfColumns Number of names
+ * @param  format          Format of rows
+ * @param  buffer          Buffer that the header is written to
+ * @param  bufferSize      Size of buffer, in terms of number of characters
+ * @return                 Length of header, excluding the terminating null character
+ */
+inline std::size_t formatSolverStateHeader( const char* const columnNames[ ],
+                                            const int numberOfColumns,
+                                            const SolverStateFormat format,
+                                            char* buffer,
+                                            const std::size_t bufferSize );
+
+//! Format header of Cartesian-state-to-TLE converter solver state rows.
+/*!
+ * Formats the header of the rows written by formatSolverState for the non-linear solver used to
+ * convert a Cartesian state to a TLE, to a caller-supplied buffer. For the table format, the
+ * header is the same as printed by printCartesianToTleSolverStateTableHeader.
+ *
+ * @sa formatSolverStateHeader, printCartesianToTleSolverStateTableHeader
+ * @param  format     Format of rows
+ * @param  buffer     Buffer that the header is written to
+ * @param  bufferSize Size of buffer, in terms of number of characters
+ * @return            Length of header, excluding the terminating null character
+ */
+inline std::size_t formatCartesianToTleSolverStateHeader( const SolverStateFormat format,
+                                                          char* buffer,
+                                                          const std::size_t bufferSize );
+
+//! Format header of Atom solver state rows.
+/*!
+ * Formats the header of the rows written by formatSolverState for the non-linear solver used to
+ * execute the Atom solver, to a caller-supplied buffer. For the table format, the header is the
+ * same as printed by printAtomSolverStateTableHeader.
+ *
+ * @sa formatSolverStateHeader, printAtomSolverStateTableHeader
+ * @param  format     Format of rows
+ * @param  buffer     Buffer that the header is written to
+ * @param  bufferSize Size of buffer, in terms of number of characters
+ * @return            Length of header, excluding the terminating null character
+ */
+inline std::size_t formatAtomSolverStateHeader( const SolverStateFormat format,
+                                                char* buffer,
+                                                const std::size_t bufferSize );
+
+//! Format current state of non-linear solver.
+/*!
+ * Formats current state of a non-linear solver, given its independent variables and residuals, as
+ * row to a caller-supplied buffer. The iteration is written first, followed by all independent
+ * variables and all residuals. Since the buffer is reused for every row, no memory is allocated,
+ * unlike printSolverState, which allocates a string stream per element. For the table format, the
+ * row is the same as printed by printSolverState. For the CSV and JSON-lines formats, reals are
+ * written with 17 significant digits, such that they are read back exactly; non-finite reals are
+ * written as null in the JSON-lines format.
+ *
+ * Like std::snprintf, this function writes at most bufferSize characters, including the
+ * terminating null character, and returns the length of the full row. The row is truncated if the
+ * returned length is not smaller than the size of the buffer.
+ *
+ * @sa formatSolverStateHeader, printSolverState
+ * @param  iteration            Current iteration of solver
+ * @param  independentVariables Current independent variables of solver
+ * @param  residuals            Residuals evaluated at current independent variables
+ * @param  format               Format of row
+ * @param  buffer               Buffer that the row is written to
+ * @param  bufferSize           Size of buffer, in terms of number of characters
+ * @return                      Length of row, excluding the terminating null character
+ */
+inline std::size_t formatSolverState( const int iteration,
+                                      const gsl_vector* independentVariables,
+                                      const gsl_vector* residuals,
+                                      const SolverStateFormat format,
+                                      char* buffer,
+                                      const std::size_t bufferSize );
+
+//! Append formatted data element to buffer.
+/*!
+ * Appends a specified data element, formatted using a std::snprintf conversion specification, to
+ * a buffer that already holds a given number of characters, and updates the number of characters.
+ * Characters that do not fit in the buffer are counted, but not written. This function is
+ * auxilliary to the format-functions used to format the state of the non-linear solver.
+ *
+ * @sa formatSolverStateHeader, formatSolverState
+ * @tparam DataType   Type for specified data element
+ * @param  conversion Conversion specification used to format data element
+ * @param  datum      Specified data element to format
+ * @param  buffer     Buffer that the data element is appended to
+ * @param  bufferSize Size of buffer, in terms of number of characters
+ * @param  length     Number of characters held by buffer, which is updated
+ */
+template< typename DataType >
+inline void appendFormattedElement( const char* conversion,
+                                    const DataType datum,
+                                    char* buffer,
+                                    const std::size_t bufferSize,
+                                    std::size_t& length );
+
 //! Print Cartesian-state-to-TLE converter solver summary table header.
 inline std::string printCartesianToTleSolverStateTableHeader( )
 {
@@ -104,22 +245,7 @@ inline std::string printCartesianToTleSolverStateTableHeader( )
 inline std::string printCartesianToTleSolverState(
   const int iteration, gsl_multiroot_fsolver* solver )
 {
-    std::ostringstream buffer;
-    buffer << printElement( iteration, 3, ' ' )
-           << printElement( gsl_vector_get( solver->x, 0 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 1 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 2 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 3 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 4 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 5 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 0 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 1 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 2 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 3 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 4 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 5 ), 15, ' ' )
-           << std::endl;
-    return buffer.str( );
+    return printSolverState( iteration, solver->x, solver->f );
 }
 
 //! Print Atom solver summary table header.
@@ -140,16 +266,25 @@ inline std::string printAtomSolverStateTableHeader( )
 //! Print summary of current state of non-linear solver for Atom solver.
 inline std::string printAtomSolverState(
   const int iteration, gsl_multiroot_fsolver* solver )
+{
+    return printSolverState( iteration, solver->x, solver->f );
+}
+
+//! Print summary of current state of non-linear solver.
+inline std::string printSolverState(
+  const int iteration, const gsl_vector* independentVariables, const gsl_vector* residuals )
 {
     std::ostringstream buffer;
-    buffer << printElement( iteration, 3, ' ' )
-           << printElement( gsl_vector_get( solver->x, 0 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 1 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->x, 2 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 0 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 1 ), 15, ' ' )
-           << printElement( gsl_vector_get( solver->f, 2 ), 15, ' ' )
-           << std::endl;
+    buffer << printElement( iteration, 3, ' ' );
+    for ( unsigned int i = 0; i < independentVariables->size; i++ )
+    {
+        buffer << printElement( gsl_vector_get( independentVariables, i ), 15, ' ' );
+    }
+    for ( unsigned int i = 0; i < residuals->size; i++ )
+    {
+        buffer << printElement( gsl_vector_get( residuals, i ), 15, ' ' );
+    }
+    buffer << std::endl;
     return buffer.str( );
 }
 
@@ -162,6 +297,150 @@ inline std::string printElement( const DataType datum, const int width, const ch
     return buffer.str( );
 }
 
+//! Format header of solver state rows.
+inline std::size_t formatSolverStateHeader( const char* const columnNames[ ],
+                                            const int numberOfColumns,
+                                            const SolverStateFormat format,
+                                            char* buffer,
+                                            const std::size_t bufferSize )
+{
+    std::size_t length = 0;
+    if ( format == tableSolverStateFormat )
+    {
+        appendFormattedElement( "%-3s", "#", buffer, bufferSize, length );
+        for ( int i = 0; i < numberOfColumns; i++ )
+        {
+            appendFormattedElement( "%-15s", columnNames[ i ], buffer, bufferSize, length );
+        }
+        appendFormattedElement( "%s", "\n", buffer, bufferSize, length );
+    }
+    else if ( format == csvSolverStateFormat )
+    {
+        appendFormattedElement( "%s", "iteration", buffer, bufferSize, length );
+        for ( int i = 0; i < numberOfColumns; i++ )
+        {
+            appendFormattedElement( ",%s", columnNames[ i ], buffer, bufferSize, length );
+        }
+        appendFormattedElement( "%s", "\n", buffer, bufferSize, length );
+    }
+    else if ( bufferSize > 0 )
+    {
+        buffer[ 0 ] = '\0';
+    }
+    return length;
+}
+
+//! Format header of Cartesian-state-to-TLE converter solver state rows.
+inline std::size_t formatCartesianToTleSolverStateHeader( const SolverStateFormat format,
+                                                          char* buffer,
+                                                          const std::size_t bufferSize )
+{
+    static const char* const columnNames[ ]
+        = { "a", "e", "i", "AoP", "RAAN", "TA", "f1", "f2", "f3", "f4", "f5", "f6" };
+    return formatSolverStateHeader( columnNames, 12, format, buffer, bufferSize );
+}
+
+//! Format header of Atom solver state rows.
+inline std::size_t formatAtomSolverStateHeader( const SolverStateFormat format,
+                                                char* buffer,
+                                                const std::size_t bufferSize )
+{
+    static const char* const columnNames[ ] = { "v1_x", "v1_y", "v1_z", "f1", "f2", "f3" };
+    return formatSolverStateHeader( columnNames, 6, format, buffer, bufferSize );
+}
+
+//! Format current state of non-linear solver.
+inline std::size_t formatSolverState( const int iteration,
+                                      const gsl_vector* independentVariables,
+                                      const gsl_vector* residuals,
+                                      const SolverStateFormat format,
+                                      char* buffer,
+                                      const std::size_t bufferSize )
+{
+    std::size_t length = 0;
+    if ( format == tableSolverStateFormat )
+    {
+        appendFormattedElement( "%-3d", iteration, buffer, bufferSize, length );
+        for ( unsigned int i = 0; i < independentVariables->size; i++ )
+        {
+            appendFormattedElement(
+                "%-15g", gsl_vector_get( independentVariables, i ), buffer, bufferSize, length );
+        }
+        for ( unsigned int i = 0; i < residuals->size; i++ )
+        {
+            appendFormattedElement(
+                "%-15g", gsl_vector_get( residuals, i ), buffer, bufferSize, length );
+        }
+        appendFormattedElement( "%s", "\n", buffer, bufferSize, length );
+    }
+    else if ( format == csvSolverStateFormat )
+    {
+        appendFormattedElement( "%d", iteration, buffer, bufferSize, length );
+        for ( unsigned int i = 0; i < independentVariables->size; i++ )
+        {
+            appendFormattedElement(
+                ",%.17g", gsl_vector_get( independentVariables, i ), buffer, bufferSize, length );
+        }
+        for ( unsigned int i = 0; i < residuals->size; i++ )
+        {
+            appendFormattedElement(
+                ",%.17g", gsl_vector_get( residuals, i ), buffer, bufferSize, length );
+        }
+        appendFormattedElement( "%s", "\n", buffer, bufferSize, length );
+    }
+    else
+    {
+        const gsl_vector* vectors[ 2 ] = { independentVariables, residuals };
+        const char* const vectorKeys[ 2 ] = { ",\"x\":[", ",\"f\":[" };
+
+        appendFormattedElement( "{\"iteration\":%d", iteration, buffer, bufferSize, length );
+        for ( int j = 0; j < 2; j++ )
+        {
+            appendFormattedElement( "%s", vectorKeys[ j ], buffer, bufferSize, length );
+            for ( unsigned int i = 0; i < vectors[ j ]->size; i++ )
+            {
+                const double datum = gsl_vector_get( vectors[ j ], i );
+                const char* separator = ( i > 0 ) ? "," : "";
+                appendFormattedElement( "%s", separator, buffer, bufferSize, length );
+                if ( std::isfinite( datum ) )
+                {
+                    appendFormattedElement( "%.17g", datum, buffer, bufferSize, length );
+                }
+                else
+                {
+                    appendFormattedElement( "%s", "null", buffer, bufferSize, length );
+                }
+            }
+            appendFormattedElement( "%s", "]", buffer, bufferSize, length );
+        }
+        appendFormattedElement( "%s", "}\n", buffer, bufferSize, length );
+    }
+    return length;
+}
+
+//! Append formatted data element to buffer.
+template< typename DataType >
+inline void appendFormattedElement( const char* conversion,
+                                    const DataType datum,
+                                    char* buffer,
+                                    const std::size_t bufferSize,
+                                    std::size_t& length )
+{
+    char* position = 0;
+    std::size_t remainingSize = 0;
+    if ( length < bufferSize )
+    {
+        position = buffer + length;
+        remainingSize = bufferSize - length;
+    }
+
+    const int numberOfCharacters = std::snprintf( position, remainingSize, conversion, datum );
+    if ( numberOfCharacters > 0 )
+    {
+        length += static_cast< std::size_t >( numberOfCharacters );
+    }
+}
+
 } // namespace atom
 
 #endif // ATOM_PRINT_FUNCTIONS_H
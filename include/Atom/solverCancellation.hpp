@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLVER_CANCELLATION_H
+#define ATOM_SOLVER_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace atom
+{
+
+//! Cancellation token for non-linear solvers.
+/*!
+ * Token that is used to cancel a running Atom solve, or to bound its run time by a deadline. The
+ * token is checked by the Atom solver between its iterations and by the nested Cartesian-to-TLE
+ * conversions between their iterations. A cancelled solver stops at its current iterate, which is
+ * the best iterate found so far, and reports the solverCancelled status.
+ *
+ * The token can be cancelled, and its deadline can be set, by any thread while solves that check
+ * it are running. A single token can be shared by many solves, e.g., to cancel all solves that
+ * belong to the same request. The token must outlive the solves that check it.
+ *
+ * Tokens cannot be copied, since they are shared by reference.
+ *
+ * @sa executeAtomSolverAsync, executeAtomSolver, SolverStatus
+ */
+class SolverCancellation
+{
+public:
+
+    //! Type for clock used to measure deadlines.
+    typedef std::chrono::steady_clock Clock;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting up token that is not cancelled and has no deadline.
+     */
+    SolverCancellation( )
+        : isCancelRequested( false ),
+          deadlineTicks( std::numeric_limits< Clock::rep >::max( ) )
+    { }
+
+    //! Constructor taking deadline.
+    /*!
+     * Constructor taking deadline, after which solves that check the token are cancelled.
+     * @param aDeadline Deadline of solves
+     */
+    explicit SolverCancellation( const Clock::time_point& aDeadline )
+        : isCancelRequested( false ),
+          deadlineTicks( aDeadline.time_since_epoch( ).count( ) )
+    { }
+
+    //! Cancel solves.
+    /*!
+     * Requests cancellation of all solves that check the token. Solves stop at their next check,
+     * i.e., after the iteration that is currently executed.
+     */
+    void cancel( )
+    {
+        isCancelRequested.store( true, std::memory_order_relaxed );
+    }
+
+    //! Set deadline.
+    /*!
+     * Sets deadline, after which solves that check the token are cancelled. A deadline that has
+     * already been set is replaced.
+     * @param aDeadline Deadline of solves
+     */
+    void setDeadline( const Clock::time_point& aDeadline )
+    {
+        deadlineTicks.store( aDeadline.time_since_epoch( ).count( ), std::memory_order_relaxed );
+    }
+
+    //! Set timeout.
+    /*!
+     * Sets deadline to given time from now, after which solves that check the token are
+     * cancelled.
+     * @tparam Rep     Type for number of ticks of timeout
+     * @tparam Period  Type for tick period of timeout
+     * @param  timeout Time from now, after which solves are cancelled
+     */
+    template< typename Rep, typename Period >
+    void setTimeout( const std::chrono::duration< Rep, Period >& timeout )
+    {
+        setDeadline( Clock::now( ) + std::chrono::duration_cast< Clock::duration >( timeout ) );
+    }
+
+    //! Check if solves are cancelled.
+    /*!
+     * Checks if cancellation of solves has been requested, or if the deadline has expired. The
+     * clock is only read if a deadline has been set.
+     * @return True if solves that check the token must stop
+     */
+    bool isCancelled( ) const
+    {
+        if ( isCancelRequested.load( std::memory_order_relaxed ) )
+        {
+            return true;
+        }
+
+        const Clock::rep deadline = deadlineTicks.load( std::memory_order_relaxed );
+        return deadline != std::numeric_limits< Clock::rep >::max( )
+               && Clock::now( ).time_since_epoch( ).count( ) >= deadline;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    SolverCancellation( const SolverCancellation& );
+
+    //! Assignment operator (disabled).
+    SolverCancellation& operator=( const SolverCancellation& );
+
+    //! Flag indicating if cancellation has been requested.
+    std::atomic< bool > isCancelRequested;
+
+    //! Deadline, stored as number of clock ticks since clock epoch (maximum if it is not set).
+    std::atomic< Clock::rep > deadlineTicks;
+};
+
+} // namespace atom
+
+#endif // ATOM_SOLVER_CANCELLATION_H
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLVER_DIAGNOSTICS_H
+#define ATOM_SOLVER_DIAGNOSTICS_H
+
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+
+#include "Atom/printFunctions.hpp"
+
+namespace atom
+{
+
+//! Solver diagnostics policy that discards all solver information.
+/*!
+ * Default diagnostics policy used by the non-linear solvers. All member functions are empty and
+ * inline, such that tracing the state of the solver compiles away entirely. This policy is used
+ * for the nested Cartesian-to-TLE conversions executed by the Atom residual function.
+ *
+ * Any custom diagnostics policy has to provide the same member functions as this policy.
+ *
+ * @sa executeAtomSolver, convertCartesianStateToTwoLineElements
+ */
+struct NoSolverDiagnostics
+{
+public:
+
+    //! Record current state of non-linear solver.
+    /*!
+     * Records state of non-linear solver at the start of a given iteration.
+     *
+     * @param iteration            Current iteration of solver
+     * @param independentVariables Current independent variables of solver
+     * @param residuals            Residuals evaluated at current independent variables
+     * @param step                 Last step taken by solver
+     */
+    void recordIteration( const int iteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    { }
+
+    //! Record final status of non-linear solver.
+    /*!
+     * Records final status of non-linear solver, either after convergence, after the maximum
+     * number of iterations is reached or after the solver gets stuck.
+     *
+     * @param solverStatus GSL flag indicating status of non-linear solver
+     */
+    void recordStatus( const int solverStatus )
+    { }
+
+protected:
+
+private:
+};
+
+//! Solver diagnostics policy that only stores the final status of the solver.
+/*!
+ * Diagnostics policy that discards the state of the non-linear solver per iteration and only
+ * stores the final status of the solver. This is used, e.g., to report a status code per problem
+ * in batch runs.
+ *
+ * @sa NoSolverDiagnostics, executeAtomSolverBatch
+ */
+struct FinalSolverStatus
+{
+public:
+
+    //! Default constructor.
+    FinalSolverStatus( )
+        : solverStatus( GSL_CONTINUE )
+    { }
+
+    //! Record current state of non-linear solver.
+    void recordIteration( const int iteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    { }
+
+    //! Record final status of non-linear solver.
+    void recordStatus( const int aSolverStatus )
+    {
+        solverStatus = aSolverStatus;
+    }
+
+    //! Final status of non-linear solver.
+    int solverStatus;
+
+protected:
+
+private:
+};
+
+//! Record of state of non-linear solver at a given iteration.
+/*!
+ * Data structure containing the state of the non-linear solver at a given iteration, as stored by
+ * the SolverIterationTrace diagnostics policy.
+ *
+ * @sa SolverIterationTrace
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+struct SolverIterationRecord
+{
+public:
+
+    //! Iteration of solver.
+    int iteration;
+
+    //! Independent variables of solver.
+    std::vector< Real > independentVariables;
+
+    //! Residuals evaluated at independent variables.
+    std::vector< Real > residuals;
+
+    //! Last step taken by solver.
+    std::vector< Real > step;
+
+protected:
+
+private:
+};
+
+//! Solver diagnostics policy that stores a structured record per iteration.
+/*!
+ * Diagnostics policy that stores the state of the non-linear solver (iteration, independent
+ * variables, residuals, step) for each iteration, together with the final status of the solver.
+ *
+ * @sa NoSolverDiagnostics, SolverIterationRecord
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+class SolverIterationTrace
+{
+public:
+
+    //! Default constructor.
+    SolverIterationTrace( )
+        : solverStatus( GSL_CONTINUE )
+    { }
+
+    //! Record current state of non-linear solver.
+    void recordIteration( const int iteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    {
+        SolverIterationRecord< Real > record;
+        record.iteration = iteration;
+        record.independentVariables = copyGslVector( independentVariables );
+        record.residuals = copyGslVector( residuals );
+        record.step = copyGslVector( step );
+        iterationRecords.push_back( record );
+    }
+
+    //! Record final status of non-linear solver.
+    void recordStatus( const int aSolverStatus )
+    {
+        solverStatus = aSolverStatus;
+    }
+
+    //! Get records stored for all iterations.
+    const std::vector< SolverIterationRecord< Real > >& records( ) const
+    {
+        return iterationRecords;
+    }
+
+    //! Get final status of non-linear solver.
+    int status( ) const
+    {
+        return solverStatus;
+    }
+
+protected:
+
+private:
+
+    //! Copy GSL vector to STL vector.
+    static std::vector< Real > copyGslVector( const gsl_vector* vector )
+    {
+        std::vector< Real > copy( vector->size );
+        for ( unsigned int i = 0; i < vector->size; i++ )
+        {
+            copy[ i ] = gsl_vector_get( vector, i );
+        }
+        return copy;
+    }
+
+    //! Records stored for all iterations.
+    std::vector< SolverIterationRecord< Real > > iterationRecords;
+
+    //! Final status of non-linear solver.
+    int solverStatus;
+};
+
+//! Solver diagnostics policy that prints a summary table.
+/*!
+ * Diagnostics policy that prints the state of the non-linear solver per iteration as a row in a
+ * summary table, followed by the final status of the solver. This policy generates the solver
+ * status summary returned by the string-based solver interfaces.
+ *
+ * @sa NoSolverDiagnostics, printSolverState
+ */
+class SolverSummaryTable
+{
+public:
+
+    //! Constructor taking table header.
+    /*!
+     * Constructor taking table header, e.g., generated by printAtomSolverStateTableHeader.
+     *
+     * @param tableHeader Header printed at the top of the summary table
+     */
+    explicit SolverSummaryTable( const std::string& tableHeader )
+        : solverStatus( GSL_CONTINUE )
+    {
+        summary << tableHeader;
+    }
+
+    //! Record current state of non-linear solver.
+    void recordIteration( const int iteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    {
+        summary << printSolverState( iteration, independentVariables, residuals );
+    }
+
+    //! Record final status of non-linear solver.
+    void recordStatus( const int aSolverStatus )
+    {
+        solverStatus = aSolverStatus;
+        summary << std::endl;
+        summary << "Status of non-linear solver: " << gsl_strerror( solverStatus ) << std::endl;
+        summary << std::endl;
+    }
+
+    //! Get summary table printed to string.
+    std::string str( ) const
+    {
+        return summary.str( );
+    }
+
+    //! Get final status of non-linear solver.
+    int status( ) const
+    {
+        return solverStatus;
+    }
+
+protected:
+
+private:
+
+    //! Buffer to store solver status summary table.
+    std::ostringstream summary;
+
+    //! Final status of non-linear solver.
+    int solverStatus;
+};
+
+//! Solver diagnostics policy that writes a machine-readable trace to a stream.
+/*!
+ * Diagnostics policy that writes the state of the non-linear solver per iteration as a row to a
+ * given output stream, in CSV or JSON-lines format (see formatSolverState). Rows are formatted
+ * into a buffer owned by the policy and reused for all rows, such that tracing does not allocate
+ * memory, unless a row does not fit in the buffer, in which case the buffer is enlarged once.
+ * For the JSON-lines format, the final status of the solver is written as a last line, e.g.,
+ * {"status":0,"message":"success"}; no status is written for the CSV and table formats, such that
+ * all rows have the same columns.
+ *
+ * The policy does not own the stream, which must outlive the policy.
+ *
+ * @sa NoSolverDiagnostics, SolverSummaryTable, formatSolverState
+ */
+class SolverTraceWriter
+{
+public:
+
+    //! Constructor taking output stream and format of trace.
+    /*!
+     * Constructor taking output stream and format of trace, and optionally a header that is
+     * written to the stream, e.g., formatted by formatAtomSolverStateHeader.
+     *
+     * @param aStream     Output stream that trace is written to
+     * @param aFormat     Format of rows of trace
+     * @param header      Header written to stream; if it is not set, no header is written
+     *                    [default: 0]
+     * @param aBufferSize Initial size of buffer used to format rows, in terms of number of
+     *                    characters [default: 1024]
+     */
+    SolverTraceWriter( std::ostream& aStream,
+                       const SolverStateFormat aFormat,
+                       const char* header = 0,
+                       const std::size_t aBufferSize = 1024 )
+        : stream( aStream ),
+          format( aFormat ),
+          rowBuffer( aBufferSize > 0 ? aBufferSize : 1 ),
+          solverStatus( GSL_CONTINUE )
+    {
+        if ( header != 0 )
+        {
+            stream << header;
+        }
+    }
+
+    //! Record current state of non-linear solver.
+    void recordIteration( const int iteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    {
+        std::size_t length = formatSolverState( iteration,
+                                                independentVariables,
+                                                residuals,
+                                                format,
+                                                &rowBuffer[ 0 ],
+                                                rowBuffer.size( ) );
+        if ( length >= rowBuffer.size( ) )
+        {
+            rowBuffer.resize( length + 1 );
+            length = formatSolverState( iteration,
+                                        independentVariables,
+                                        residuals,
+                                        format,
+                                        &rowBuffer[ 0 ],
+                                        rowBuffer.size( ) );
+        }
+        stream.write( &rowBuffer[ 0 ], static_cast< std::streamsize >( length ) );
+    }
+
+    //! Record final status of non-linear solver.
+    void recordStatus( const int aSolverStatus )
+    {
+        solverStatus = aSolverStatus;
+        if ( format == jsonLinesSolverStateFormat )
+        {
+            stream << "{\"status\":" << solverStatus
+                   << ",\"message\":\"" << gsl_strerror( solverStatus ) << "\"}\n";
+        }
+    }
+
+    //! Get final status of non-linear solver.
+    int status( ) const
+    {
+        return solverStatus;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    SolverTraceWriter( const SolverTraceWriter& );
+
+    //! Assignment operator (disabled).
+    SolverTraceWriter& operator=( const SolverTraceWriter& );
+
+    //! Output stream that trace is written to.
+    std::ostream& stream;
+
+    //! Format of rows of trace.
+    const SolverStateFormat format;
+
+    //! Buffer reused to format rows.
+    std::vector< char > rowBuffer;
+
+    //! Final status of non-linear solver.
+    int solverStatus;
+};
+
+} // namespace atom
+
+#endif // ATOM_SOLVER_DIAGNOSTICS_H
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLVER_STATISTICS_H
+#define ATOM_SOLVER_STATISTICS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <gsl/gsl_vector.h>
+
+namespace atom
+{
+
+//! Get current time of clock used to time solvers.
+/*!
+ * Returns the current time of the monotonic clock used to time the solvers. Only differences
+ * between times returned by this function are meaningful.
+ *
+ * @sa SolverStatistics
+ * @return Current time [s]
+ */
+inline double getSolverClockTime( );
+
+//! Compute norm of residuals.
+/*!
+ * Computes the Euclidean norm of a vector of residuals computed by a residual function.
+ *
+ * @tparam Real      Type for reals
+ * @param  residuals Vector of residuals
+ * @return           Norm of residuals
+ */
+template< typename Real >
+Real computeResidualNorm( const gsl_vector* residuals );
+
+//! Statistics collected by non-linear solvers.
+/*!
+ * Data structure with statistics collected while executing the Atom solver or a Cartesian-to-TLE
+ * conversion: counters for iterations and for evaluations of the residual function and Jacobian,
+ * counters for the nested Cartesian-to-TLE conversions executed by the Atom residual function,
+ * the wall-clock time spent in the different stages of the solver and the norm of the residuals
+ * at the final iteration.
+ *
+ * The time spent in the SGP4/SDP4 propagator (SGP4::FindPosition) is stored as propagation time.
+ * The time spent converting between element sets (Cartesian-to-Keplerian conversion, updating the
+ * mean elements of the TLE and initializing the SGP4/SDP4 propagator) is stored as conversion time.
+ * The remaining time is spent in the GSL solver and is stored as solver time. The times of nested
+ * conversions are included in the times of the Atom solver.
+ *
+ * Collecting statistics only requires a few counter increments and clock reads per evaluation of
+ * the residual function, which is negligible compared to the cost of the SGP4/SDP4 propagator.
+ *
+ * @sa executeAtomSolver, convertCartesianStateToTwoLineElements, AtomSolver, TleFitter
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+struct SolverStatistics
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, setting all counters and times to zero.
+     */
+    SolverStatistics( )
+    {
+        reset( );
+    }
+
+    //! Reset statistics.
+    /*!
+     * Resets all counters and times to zero.
+     */
+    void reset( )
+    {
+        numberOfIterations = 0;
+        numberOfResidualEvaluations = 0;
+        numberOfJacobianEvaluations = 0;
+        numberOfNestedConversions = 0;
+        numberOfNestedIterations = 0;
+        maximumNestedIterations = 0;
+        numberOfNestedResidualEvaluations = 0;
+        totalTime = 0.0;
+        propagationTime = 0.0;
+        conversionTime = 0.0;
+        solverTime = 0.0;
+        finalResidualNorm = 0.0;
+    }
+
+    //! Record statistics of nested Cartesian-to-TLE conversion.
+    /*!
+     * Adds statistics of a nested Cartesian-to-TLE conversion, executed by the Atom residual
+     * function, to the nested counters and the propagation and conversion times.
+     *
+     * @param nestedStatistics Statistics collected by nested conversion
+     */
+    void recordNestedConversion( const SolverStatistics& nestedStatistics )
+    {
+        ++numberOfNestedConversions;
+        numberOfNestedIterations += nestedStatistics.numberOfIterations;
+        maximumNestedIterations
+            = std::max( maximumNestedIterations, nestedStatistics.numberOfIterations );
+        numberOfNestedResidualEvaluations += nestedStatistics.numberOfResidualEvaluations;
+        propagationTime += nestedStatistics.propagationTime;
+        conversionTime += nestedStatistics.conversionTime;
+    }
+
+    //! Number of iterations completed by solver.
+    int numberOfIterations;
+
+    //! Number of evaluations of residual function.
+    int numberOfResidualEvaluations;
+
+    //! Number of evaluations of analytical Jacobian (zero if finite differences are used).
+    int numberOfJacobianEvaluations;
+
+    //! Number of nested Cartesian-to-TLE conversions.
+    int numberOfNestedConversions;
+
+    //! Number of iterations completed by nested Cartesian-to-TLE conversions, summed.
+    int numberOfNestedIterations;
+
+    //! Maximum number of iterations completed by a single nested Cartesian-to-TLE conversion.
+    int maximumNestedIterations;
+
+    //! Number of evaluations of residual function of nested Cartesian-to-TLE conversions.
+    int numberOfNestedResidualEvaluations;
+
+    //! Total time spent by solver [s].
+    double totalTime;
+
+    //! Time spent in SGP4/SDP4 propagator [s].
+    double propagationTime;
+
+    //! Time spent converting between element sets [s].
+    double conversionTime;
+
+    //! Time spent in GSL solver [s].
+    double solverTime;
+
+    //! Norm of residuals at final iteration [-].
+    Real finalResidualNorm;
+
+protected:
+
+private:
+};
+
+//! Get current time of clock used to time solvers.
+inline double getSolverClockTime( )
+{
+    return std::chrono::duration< double >(
+        std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+//! Compute norm of residuals.
+template< typename Real >
+Real computeResidualNorm( const gsl_vector* residuals )
+{
+    Real residualNormSquared = 0.0;
+    for ( unsigned int i = 0; i < residuals->size; i++ )
+    {
+        residualNormSquared += gsl_vector_get( residuals, i ) * gsl_vector_get( residuals, i );
+    }
+    return std::sqrt( residualNormSquared );
+}
+
+} // namespace atom
+
+#endif // ATOM_SOLVER_STATISTICS_H
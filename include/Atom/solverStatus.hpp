@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLVER_STATUS_H
+#define ATOM_SOLVER_STATUS_H
+
+#include <string>
+
+namespace atom
+{
+
+//! Status of non-linear solver.
+/*!
+ * Status returned by the Atom solver and the Cartesian-to-TLE converter when they are executed
+ * without throwing exceptions. The GSL flag returned by the solver is passed to the diagnostics
+ * policy in all cases.
+ *
+ * @sa executeAtomSolver, convertCartesianStateToTwoLineElements, AtomSolver, TleFitter,
+ *     SolverCancellation
+ */
+enum SolverStatus
+{
+    //! Solver converged to root within tolerance.
+    solverConverged,
+
+    //! Solver reached maximum number of iterations permitted without converging.
+    solverMaximumIterationsReached,
+
+    //! Solver is stuck, i.e., the GSL solver iteration failed to make progress.
+    solverStuck,
+
+    //! SGP4/SDP4 propagator failed, e.g., because the satellite decayed.
+    solverPropagationFailed,
+
+    //! Nested Cartesian-to-TLE conversion executed by Atom residual function got stuck.
+    solverNestedConversionFailed,
+
+    //! Solver was cancelled, or its deadline expired, before it converged; the solver stopped at
+    //! the best iterate found so far.
+    solverCancelled,
+
+    //! Elements of converged TLE do not fit the fixed-width fields of the TLE format.
+    solverTleFormatFailed
+};
+
+//! Check if solver failed.
+/*!
+ * Checks if given solver status indicates that the solver failed, i.e., that it did not converge
+ * and did not complete the maximum number of iterations permitted.
+ *
+ * @param  status Status of non-linear solver
+ * @return        True if solver failed
+ */
+inline bool hasSolverFailed( const SolverStatus status );
+
+//! Print solver status.
+/*!
+ * Prints given solver status as a human-readable message.
+ *
+ * @param  status Status of non-linear solver
+ * @return        Message describing solver status
+ */
+inline std::string printSolverStatus( const SolverStatus status );
+
+//! Check if solver failed.
+inline bool hasSolverFailed( const SolverStatus status )
+{
+    return status != solverConverged && status != solverMaximumIterationsReached;
+}
+
+//! Print solver status.
+inline std::string printSolverStatus( const SolverStatus status )
+{
+    switch ( status )
+    {
+        case solverConverged:
+            return "Non-linear solver converged";
+
+        case solverMaximumIterationsReached:
+            return "Non-linear solver reached maximum number of iterations";
+
+        case solverStuck:
+            return "ERROR: Non-linear solver is stuck!";
+
+        case solverPropagationFailed:
+            return "ERROR: SGP4/SDP4 propagator failed!";
+
+        case solverNestedConversionFailed:
+            return "ERROR: Nested Cartesian-to-TLE conversion failed!";
+
+        case solverCancelled:
+            return "ERROR: Non-linear solver was cancelled before it converged!";
+
+        case solverTleFormatFailed:
+            return "ERROR: Elements of TLE do not fit TLE format!";
+    }
+
+    return "ERROR: Unknown solver status!";
+}
+
+} // namespace atom
+
+#endif // ATOM_SOLVER_STATUS_H
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_SOLVER_WORKSPACE_H
+#define ATOM_SOLVER_WORKSPACE_H
+
+#include <gsl/gsl_multiroots.h>
+#include <gsl/gsl_vector.h>
+
+namespace atom
+{
+
+//! Types of GSL non-linear solver.
+/*!
+ * Types of GSL non-linear solver that can be selected to execute the Atom solver and the
+ * Cartesian-to-TLE converter.
+ */
+enum SolverType
+{
+    //! Hybrid solver with finite-difference Jacobian (gsl_multiroot_fsolver_hybrids).
+    hybridsSolver,
+
+    //! Hybrid solver with Jacobian supplied by user (gsl_multiroot_fdfsolver_hybridsj).
+    hybridsjSolver
+};
+
+//! Workspace for GSL non-linear solver.
+/*!
+ * Workspace that owns the memory allocated for a GSL non-linear solver and its initial guess.
+ * The memory is allocated once on construction and freed on destruction, such that a workspace
+ * can be reused for any number of solves of the same dimension, e.g., one workspace per thread in
+ * a batch run.
+ *
+ * Depending on the solver type, either a derivative-free GSL solver or a GSL solver that uses a
+ * Jacobian supplied by the residual function is allocated. The member functions of the workspace
+ * dispatch to the GSL solver that has been allocated.
+ *
+ * Workspaces cannot be copied, since they own the GSL solver.
+ *
+ * @sa executeAtomSolver, convertCartesianStateToTwoLineElements, executeAtomSolverBatch
+ */
+class SolverWorkspace
+{
+public:
+
+    //! Constructor taking dimension of non-linear system.
+    /*!
+     * Constructor taking dimension of non-linear system, allocating memory for GSL solver.
+     *
+     * @param aDimension  Dimension of non-linear system, i.e., 3 for Atom solver and 6 for
+     *                    Cartesian-to-TLE converter
+     * @param aSolverType Type of GSL solver [default: hybridsSolver]
+     */
+    explicit SolverWorkspace( const int aDimension, const SolverType aSolverType = hybridsSolver )
+        : dimension( aDimension ),
+          solverType( aSolverType ),
+          solver( ( aSolverType == hybridsSolver )
+                  ? gsl_multiroot_fsolver_alloc( gsl_multiroot_fsolver_hybrids, aDimension ) : 0 ),
+          fdfSolver( ( aSolverType == hybridsjSolver )
+                     ? gsl_multiroot_fdfsolver_alloc( gsl_multiroot_fdfsolver_hybridsj, aDimension )
+                     : 0 ),
+          initialGuess( gsl_vector_alloc( aDimension ) )
+    { }
+
+    //! Destructor, freeing memory allocated for GSL solver.
+    ~SolverWorkspace( )
+    {
+        if ( solver != 0 )
+        {
+            gsl_multiroot_fsolver_free( solver );
+        }
+        if ( fdfSolver != 0 )
+        {
+            gsl_multiroot_fdfsolver_free( fdfSolver );
+        }
+        gsl_vector_free( initialGuess );
+    }
+
+    //! Set GSL solver to use given non-linear system and initial guess.
+    /*!
+     * Sets GSL solver to use given non-linear system and the initial guess stored in the
+     * workspace. The Jacobian functions of the system are only used if the workspace holds a
+     * solver that requires a Jacobian (hybridsjSolver). The system is copied into the workspace,
+     * such that it remains valid for as long as the solver is used.
+     *
+     * @param  system Non-linear system, with residual function and, optionally, Jacobian functions
+     * @return        GSL flag indicating success or failure
+     */
+    int set( const gsl_multiroot_function_fdf& system )
+    {
+        if ( solver != 0 )
+        {
+            function.f = system.f;
+            function.n = system.n;
+            function.params = system.params;
+            return gsl_multiroot_fsolver_set( solver, &function, initialGuess );
+        }
+
+        functionWithJacobian = system;
+        return gsl_multiroot_fdfsolver_set( fdfSolver, &functionWithJacobian, initialGuess );
+    }
+
+    //! Execute iteration of GSL solver.
+    /*!
+     * Executes iteration of GSL solver.
+     *
+     * @return GSL flag indicating success or failure
+     */
+    int iterate( )
+    {
+        return ( solver != 0 ) ? gsl_multiroot_fsolver_iterate( solver )
+                               : gsl_multiroot_fdfsolver_iterate( fdfSolver );
+    }
+
+    //! Get current independent variables of GSL solver.
+    gsl_vector* x( ) const
+    {
+        return ( solver != 0 ) ? solver->x : fdfSolver->x;
+    }
+
+    //! Get residuals evaluated at current independent variables of GSL solver.
+    gsl_vector* f( ) const
+    {
+        return ( solver != 0 ) ? solver->f : fdfSolver->f;
+    }
+
+    //! Get last step taken by GSL solver.
+    gsl_vector* dx( ) const
+    {
+        return ( solver != 0 ) ? solver->dx : fdfSolver->dx;
+    }
+
+    //! Dimension of non-linear system.
+    const int dimension;
+
+    //! Type of GSL solver.
+    const SolverType solverType;
+
+    //! Derivative-free GSL solver (only allocated for hybridsSolver).
+    gsl_multiroot_fsolver* const solver;
+
+    //! GSL solver that uses Jacobian (only allocated for hybridsjSolver).
+    gsl_multiroot_fdfsolver* const fdfSolver;
+
+    //! Initial guess passed to GSL solver.
+    gsl_vector* const initialGuess;
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    SolverWorkspace( const SolverWorkspace& );
+
+    //! Assignment operator (disabled).
+    SolverWorkspace& operator=( const SolverWorkspace& );
+
+    //! Non-linear system used by derivative-free GSL solver.
+    gsl_multiroot_function function;
+
+    //! Non-linear system used by GSL solver that uses Jacobian.
+    gsl_multiroot_function_fdf functionWithJacobian;
+};
+
+} // namespace atom
+
+#endif // ATOM_SOLVER_WORKSPACE_H
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_TLE_CONVERSION_CACHE_H
+#define ATOM_TLE_CONVERSION_CACHE_H
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+namespace atom
+{
+
+//! Bounded cache of converged Cartesian-to-TLE conversions.
+/*!
+ * Thread-safe cache that stores the TLEs found by converged Cartesian-to-TLE conversions, such
+ * that conversions of identical or nearly identical Cartesian states return the converged TLE
+ * directly instead of executing the non-linear solver again. Examples are the final conversion
+ * executed by the Atom solver once it has converged, which repeats the conversion of the last
+ * residual evaluation, and batches of transfers that share a departure state.
+ *
+ * Conversions are keyed on the Cartesian state, quantized to the given position and velocity
+ * resolutions, the epoch and the elements of the reference TLE that are copied into the converted
+ * TLE (catalog number, B* drag term and derivatives of mean motion). A stored TLE is only returned
+ * if it has been converged to an absolute tolerance at least as tight as the tolerance requested.
+ * A cache must only be shared by conversions that use the same Earth constants and relative
+ * tolerance. Once the capacity of the cache is reached, the least recently used conversion is
+ * evicted.
+ *
+ * A cache can be shared by many threads, e.g., the threads of a batch run, since all operations
+ * lock the cache. Caches cannot be copied, since they own the mutex.
+ *
+ * @sa convertCartesianStateToTwoLineElements, executeAtomSolver
+ * @tparam Real Type for reals
+ */
+template< typename Real >
+class TleConversionCache
+{
+public:
+
+    //! Constructor taking settings of cache.
+    /*!
+     * Constructor taking settings of cache, setting up empty cache.
+     *
+     * @param aCapacity           Maximum number of conversions stored; if it is set to zero, no
+     *                            conversions are stored [default: 1024]
+     * @param aPositionResolution Resolution used to quantize positions [km] [default: 1.0e-6]
+     * @param aVelocityResolution Resolution used to quantize velocities [km/s] [default: 1.0e-9]
+     */
+    explicit TleConversionCache( const std::size_t aCapacity = 1024,
+                                 const Real aPositionResolution = 1.0e-6,
+                                 const Real aVelocityResolution = 1.0e-9 )
+        : maximumSize( aCapacity ),
+          positionResolution( aPositionResolution ),
+          velocityResolution( aVelocityResolution ),
+          entries( ),
+          index( ),
+          hitCounter( 0 ),
+          missCounter( 0 )
+    { }
+
+    //! Find converged TLE for Cartesian state.
+    /*!
+     * Finds TLE stored for given Cartesian state, epoch and reference TLE, marking it as most
+     * recently used.
+     *
+     * @tparam Vector6           Type for 6-vector of reals
+     * @param  cartesianState    Cartesian state [km; km/s]
+     * @param  epoch             Epoch associated with Cartesian state
+     * @param  referenceTle      Reference Two Line Elements used by conversion
+     * @param  absoluteTolerance Absolute tolerance requested for conversion
+     * @param  tle               Converged TLE, only set if it is found
+     * @return                   Flag indicating if converged TLE has been found
+     */
+    template< typename Vector6 >
+    bool find( const Vector6& cartesianState,
+               const DateTime& epoch,
+               const Tle& referenceTle,
+               const Real absoluteTolerance,
+               Tle& tle )
+    {
+        const Key key = computeKey( cartesianState, epoch, referenceTle );
+
+        std::lock_guard< std::mutex > lock( mutex );
+        typename Index::iterator iterator = index.find( key );
+        if ( iterator == index.end( ) || iterator->second->absoluteTolerance > absoluteTolerance )
+        {
+            ++missCounter;
+            return false;
+        }
+
+        entries.splice( entries.begin( ), entries, iterator->second );
+        tle = iterator->second->tle;
+        ++hitCounter;
+        return true;
+    }
+
+    //! Insert converged TLE for Cartesian state.
+    /*!
+     * Inserts TLE found by converged conversion of given Cartesian state, epoch and reference TLE,
+     * replacing the TLE stored for the same key and evicting the least recently used conversion
+     * if the capacity of the cache is reached.
+     *
+     * @tparam Vector6           Type for 6-vector of reals
+     * @param  cartesianState    Cartesian state [km; km/s]
+     * @param  epoch             Epoch associated with Cartesian state
+     * @param  referenceTle      Reference Two Line Elements used by conversion
+     * @param  absoluteTolerance Absolute tolerance used by conversion
+     * @param  tle               Converged TLE
+     */
+    template< typename Vector6 >
+    void insert( const Vector6& cartesianState,
+                 const DateTime& epoch,
+                 const Tle& referenceTle,
+                 const Real absoluteTolerance,
+                 const Tle& tle )
+    {
+        if ( maximumSize == 0 )
+        {
+            return;
+        }
+
+        const Key key = computeKey( cartesianState, epoch, referenceTle );
+
+        std::lock_guard< std::mutex > lock( mutex );
+        typename Index::iterator iterator = index.find( key );
+        if ( iterator != index.end( ) )
+        {
+            iterator->second->tle = tle;
+            iterator->second->absoluteTolerance = absoluteTolerance;
+            entries.splice( entries.begin( ), entries, iterator->second );
+            return;
+        }
+
+        if ( entries.size( ) == maximumSize )
+        {
+            index.erase( entries.back( ).key );
+            entries.pop_back( );
+        }
+
+        entries.push_front( Entry( key, tle, absoluteTolerance ) );
+        index.insert( std::make_pair( key, entries.begin( ) ) );
+    }
+
+    //! Remove all stored conversions and reset counters.
+    void clear( )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        index.clear( );
+        entries.clear( );
+        hitCounter = 0;
+        missCounter = 0;
+    }
+
+    //! Get number of stored conversions.
+    std::size_t size( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return entries.size( );
+    }
+
+    //! Get maximum number of stored conversions.
+    std::size_t capacity( ) const
+    {
+        return maximumSize;
+    }
+
+    //! Get number of lookups that found a converged TLE.
+    std::size_t numberOfHits( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return hitCounter;
+    }
+
+    //! Get number of lookups that did not find a converged TLE.
+    std::size_t numberOfMisses( ) const
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return missCounter;
+    }
+
+protected:
+
+private:
+
+    //! Copy constructor (disabled).
+    TleConversionCache( const TleConversionCache& );
+
+    //! Assignment operator (disabled).
+    TleConversionCache& operator=( const TleConversionCache& );
+
+    //! Key of stored conversion.
+    struct Key
+    {
+    public:
+
+        //! Check if keys are equal.
+        bool operator==( const Key& otherKey ) const
+        {
+            for ( int i = 0; i < 6; i++ )
+            {
+                if ( quantizedState[ i ] != otherKey.quantizedState[ i ] )
+                {
+                    return false;
+                }
+            }
+
+            return epochTicks == otherKey.epochTicks
+                   && noradNumber == otherKey.noradNumber
+                   && bStar == otherKey.bStar
+                   && meanMotionDt2 == otherKey.meanMotionDt2
+                   && meanMotionDdt6 == otherKey.meanMotionDdt6;
+        }
+
+        //! Quantized Cartesian state [-].
+        long long quantizedState[ 6 ];
+
+        //! Epoch [ticks].
+        long long epochTicks;
+
+        //! Catalog number of reference TLE.
+        unsigned int noradNumber;
+
+        //! B* drag term of reference TLE.
+        double bStar;
+
+        //! First time derivative of mean motion of reference TLE, divided by two.
+        double meanMotionDt2;
+
+        //! Second time derivative of mean motion of reference TLE, divided by six.
+        double meanMotionDdt6;
+
+    protected:
+
+    private:
+    };
+
+    //! Hash function for keys of stored conversions.
+    struct KeyHash
+    {
+    public:
+
+        //! Compute hash of key.
+        std::size_t operator( )( const Key& key ) const
+        {
+            std::hash< long long > integerHash;
+            std::size_t hash = integerHash( key.epochTicks );
+            for ( int i = 0; i < 6; i++ )
+            {
+                hash ^= integerHash( key.quantizedState[ i ] )
+                        + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+            }
+            return hash;
+        }
+
+    protected:
+
+    private:
+    };
+
+    //! Stored conversion.
+    struct Entry
+    {
+    public:
+
+        //! Constructor taking stored conversion.
+        Entry( const Key& aKey, const Tle& aTle, const Real anAbsoluteTolerance )
+            : key( aKey ),
+              tle( aTle ),
+              absoluteTolerance( anAbsoluteTolerance )
+        { }
+
+        //! Key of conversion.
+        Key key;
+
+        //! Converged TLE.
+        Tle tle;
+
+        //! Absolute tolerance used by conversion.
+        Real absoluteTolerance;
+
+    protected:
+
+    private:
+    };
+
+    //! List of stored conversions, ordered from most to least recently used.
+    typedef std::list< Entry > Entries;
+
+    //! Index of stored conversions.
+    typedef std::unordered_map< Key, typename Entries::iterator, KeyHash > Index;
+
+    //! Compute key of conversion.
+    template< typename Vector6 >
+    Key computeKey( const Vector6& cartesianState,
+                    const DateTime& epoch,
+                    const Tle& referenceTle ) const
+    {
+        Key key;
+        for ( int i = 0; i < 6; i++ )
+        {
+            const Real resolution = ( i < 3 ) ? positionResolution : velocityResolution;
+            key.quantizedState[ i ] = std::llround( cartesianState[ i ] / resolution );
+        }
+        key.epochTicks = epoch.Ticks( );
+        key.noradNumber = referenceTle.NoradNumber( );
+        key.bStar = referenceTle.BStar( );
+        key.meanMotionDt2 = referenceTle.MeanMotionDt2( );
+        key.meanMotionDdt6 = referenceTle.MeanMotionDdt6( );
+        return key;
+    }
+
+    //! Maximum number of stored conversions.
+    const std::size_t maximumSize;
+
+    //! Resolution used to quantize positions [km].
+    const Real positionResolution;
+
+    //! Resolution used to quantize velocities [km/s].
+    const Real velocityResolution;
+
+    //! Stored conversions, ordered from most to least recently used.
+    Entries entries;
+
+    //! Index of stored conversions.
+    Index index;
+
+    //! Number of lookups that found a converged TLE.
+    std::size_t hitCounter;
+
+    //! Number of lookups that did not find a converged TLE.
+    std::size_t missCounter;
+
+    //! Mutex that locks cache.
+    mutable std::mutex mutex;
+};
+
+} // namespace atom
+
+#endif // ATOM_TLE_CONVERSION_CACHE_H
@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_TWO_BODY_FUNCTIONS_H
+#define ATOM_TWO_BODY_FUNCTIONS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Astro/astro.hpp>
+#include <SML/sml.hpp>
+
+namespace atom
+{
+
+//! Compute Stumpff functions.
+/*!
+ * Computes the Stumpff functions \f$C(z)\f$ and \f$S(z)\f$ used by the universal-variable
+ * formulation of the two-body problem (Curtis, 2005). Series expansions are used close to
+ * \f$z = 0\f$ to avoid loss of precision.
+ *
+ * @tparam Real               Type for reals
+ * @param  z                  Argument of Stumpff functions [-]
+ * @param  stumpffFunctionC   Computed Stumpff function C(z) [-]
+ * @param  stumpffFunctionS   Computed Stumpff function S(z) [-]
+ */
+template< typename Real >
+void computeStumpffFunctions( const Real z, Real& stumpffFunctionC, Real& stumpffFunctionS );
+
+//! Propagate Cartesian state using two-body (Kepler) dynamics.
+/*!
+ * Propagates a Cartesian state by a given time using the universal-variable formulation of the
+ * two-body problem (Curtis, 2005), which is valid for elliptical, parabolic and hyperbolic
+ * orbits. Kepler's equation in universal form is solved using Newton's method.
+ *
+ * This function does not allocate any memory and is used to compute cheap approximations of the
+ * SGP4/SDP4 dynamics, e.g., to approximate Jacobians of the Atom residual function.
+ *
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  initialPosition        Initial Cartesian position [km]
+ * @param  initialVelocity        Initial Cartesian velocity [km/s]
+ * @param  timeOfFlight           Propagation time [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  finalPosition          Propagated Cartesian position [km]
+ * @param  finalVelocity          Propagated Cartesian velocity [km/s]
+ * @param  tolerance              Tolerance used to solve Kepler's equation [default: 1.0e-12]
+ * @param  maximumIterations      Maximum number of Newton iterations [default: 100]
+ */
+template< typename Real, typename Vector3 >
+void propagateTwoBodyState( const Vector3& initialPosition,
+                            const Vector3& initialVelocity,
+                            const Real timeOfFlight,
+                            const Real gravitationalParameter,
+                            Real finalPosition[ 3 ],
+                            Real finalVelocity[ 3 ],
+                            const Real tolerance = 1.0e-12,
+                            const int maximumIterations = 100 );
+
+//! Propagate Cartesian state using two-body dynamics with secular J2 perturbations.
+/*!
+ * Propagates a Cartesian state by a given time using two-body dynamics, corrected for the secular
+ * first-order effects of the J2 zonal harmonic on the longitude of the ascending node, the
+ * argument of periapsis and the mean anomaly (Vallado, 2013). The mean semi-major axis is
+ * computed by removing the first-order short-period J2 variations from the osculating semi-major
+ * axis of the initial state; the other osculating elements are used as mean elements. The
+ * propagated two-body state, for a time scaled by the secular mean motion, is rotated about the
+ * initial angular-momentum vector by the change in argument of periapsis, and about the z-axis by
+ * the change in longitude of the ascending node.
+ *
+ * For hyperbolic and parabolic orbits, the state is propagated using two-body dynamics only. This
+ * function does not allocate any memory and is used as a cheap analytic approximation of the
+ * SGP4/SDP4 dynamics, e.g., to compute initial guesses for the Atom solver.
+ *
+ * @sa propagateTwoBodyState
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  initialPosition        Initial Cartesian position [km]
+ * @param  initialVelocity        Initial Cartesian velocity [km/s]
+ * @param  timeOfFlight           Propagation time [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  equatorialRadius       Equatorial radius of central body [km]
+ * @param  j2                     J2 zonal harmonic coefficient of central body [-]
+ * @param  finalPosition          Propagated Cartesian position [km]
+ * @param  finalVelocity          Propagated Cartesian velocity [km/s]
+ * @param  tolerance              Tolerance used to solve Kepler's equation [default: 1.0e-12]
+ * @param  maximumIterations      Maximum number of Newton iterations [default: 100]
+ */
+template< typename Real, typename Vector3 >
+void propagateJ2SecularState( const Vector3& initialPosition,
+                              const Vector3& initialVelocity,
+                              const Real timeOfFlight,
+                              const Real gravitationalParameter,
+                              const Real equatorialRadius,
+                              const Real j2,
+                              Real finalPosition[ 3 ],
+                              Real finalVelocity[ 3 ],
+                              const Real tolerance = 1.0e-12,
+                              const int maximumIterations = 100 );
+
+//! Rotate vector about axis.
+/*!
+ * Rotates a vector in place about a given unit axis by a given angle, using Rodrigues' rotation
+ * formula.
+ *
+ * @tparam Real   Type for reals
+ * @param  axis   Unit vector along axis of rotation
+ * @param  angle  Angle of rotation, positive counter-clockwise about axis [rad]
+ * @param  vector Vector that is rotated
+ */
+template< typename Real >
+void rotateVectorAboutAxis( const Real axis[ 3 ], const Real angle, Real vector[ 3 ] );
+
+//! Compute number of complete revolutions of two-body orbit.
+/*!
+ * Computes the number of complete revolutions that are made in the given time-of-flight along the
+ * two-body orbit of a Cartesian state, i.e., the time-of-flight divided by the orbital period,
+ * rounded down. For parabolic and hyperbolic orbits, no complete revolutions are made.
+ *
+ * @tparam Real                   Type for reals
+ * @tparam Vector3                Type for 3-vector of reals
+ * @param  position               Cartesian position vector [km]
+ * @param  velocity               Cartesian velocity vector [km/s]
+ * @param  timeOfFlight           Time-of-flight [s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @return                        Number of complete revolutions
+ */
+template< typename Real, typename Vector3 >
+int computeNumberOfRevolutions( const Vector3& position,
+                                const Vector3& velocity,
+                                const Real timeOfFlight,
+                                const Real gravitationalParameter );
+
+//! Compute Keplerian elements of Cartesian state.
+/*!
+ * Computes the osculating Keplerian elements of a Cartesian state, ordered as defined by the Astro
+ * library (semi-major axis, eccentricity, inclination, argument of periapsis, longitude of
+ * ascending node, true anomaly). The conventions of astro::convertCartesianToKeplerianElements are
+ * followed: for equatorial orbits the ascending node is placed on the x-axis, and for circular
+ * orbits the periapsis is placed at the ascending node. Angles are given in the range [0, 2pi).
+ *
+ * Unlike astro::convertCartesianToKeplerianElements, this function writes the elements to the
+ * given array and does not allocate any memory.
+ *
+ * @tparam Real                   Type for reals
+ * @tparam Vector6                Type for 6-vector of reals
+ * @param  cartesianState         Cartesian state [km; km/s]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  keplerianElements      Computed Keplerian elements [km, -, rad, rad, rad, rad]
+ */
+template< typename Real, typename Vector6 >
+void computeKeplerianElements( const Vector6& cartesianState,
+                               const Real gravitationalParameter,
+                               Real keplerianElements[ 6 ] );
+
+//! Compute Jacobian of Cartesian state with respect to Keplerian elements.
+/*!
+ * Computes the partial derivatives of the two-body Cartesian state with respect to the Keplerian
+ * elements, analytically. The Keplerian elements are ordered as defined by the Astro library
+ * (semi-major axis, eccentricity, inclination, argument of periapsis, longitude of ascending node,
+ * true anomaly), where angles are given in radians. Row i and column j of the Jacobian contains
+ * the partial derivative of Cartesian element i with respect to Keplerian element j.
+ *
+ * This function is only valid for non-circular, elliptical orbits. It does not allocate any
+ * memory.
+ *
+ * @tparam Real                   Type for reals
+ * @tparam Vector6                Type for 6-vector of reals
+ * @param  keplerianElements      Keplerian elements [km, -, rad, rad, rad, rad]
+ * @param  gravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+ * @param  jacobian               Computed Jacobian, stored row-major
+ */
+template< typename Real, typename Vector6 >
+void computeKeplerianToCartesianJacobian( const Vector6& keplerianElements,
+                                          const Real gravitationalParameter,
+                                          Real jacobian[ 6 ][ 6 ] );
+
+//! Compute Stumpff functions.
+template< typename Real >
+void computeStumpffFunctions( const Real z, Real& stumpffFunctionC, Real& stumpffFunctionS )
+{
+    if ( z > 1.0e-6 )
+    {
+        const Real squareRootZ = std::sqrt( z );
+        stumpffFunctionC = ( 1.0 - std::cos( squareRootZ ) ) / z;
+        stumpffFunctionS = ( squareRootZ - std::sin( squareRootZ ) ) / ( z * squareRootZ );
+    }
+    else if ( z < -1.0e-6 )
+    {
+        const Real squareRootMinusZ = std::sqrt( -z );
+        stumpffFunctionC = ( std::cosh( squareRootMinusZ ) - 1.0 ) / -z;
+        stumpffFunctionS = ( std::sinh( squareRootMinusZ ) - squareRootMinusZ )
+                           / ( -z * squareRootMinusZ );
+    }
+    else
+    {
+        stumpffFunctionC = 1.0 / 2.0 - z / 24.0 + z * z / 720.0;
+        stumpffFunctionS = 1.0 / 6.0 - z / 120.0 + z * z / 5040.0;
+    }
+}
+
+//! Propagate Cartesian state using two-body (Kepler) dynamics.
+template< typename Real, typename Vector3 >
+void propagateTwoBodyState( const Vector3& initialPosition,
+                            const Vector3& initialVelocity,
+                            const Real timeOfFlight,
+                            const Real gravitationalParameter,
+                            Real finalPosition[ 3 ],
+                            Real finalVelocity[ 3 ],
+                            const Real tolerance,
+                            const int maximumIterations )
+{
+    const Real squareRootMu = std::sqrt( gravitationalParameter );
+
+    // Compute initial radius, speed and radial velocity.
+    const Real initialRadius = std::sqrt( initialPosition[ 0 ] * initialPosition[ 0 ]
+                                          + initialPosition[ 1 ] * initialPosition[ 1 ]
+                                          + initialPosition[ 2 ] * initialPosition[ 2 ] );
+    const Real initialSpeedSquared = initialVelocity[ 0 ] * initialVelocity[ 0 ]
+                                     + initialVelocity[ 1 ] * initialVelocity[ 1 ]
+                                     + initialVelocity[ 2 ] * initialVelocity[ 2 ];
+    const Real radialVelocity = ( initialPosition[ 0 ] * initialVelocity[ 0 ]
+                                  + initialPosition[ 1 ] * initialVelocity[ 1 ]
+                                  + initialPosition[ 2 ] * initialVelocity[ 2 ] ) / initialRadius;
+
+    // Compute reciprocal of semi-major axis [km^-1].
+    const Real alpha = 2.0 / initialRadius - initialSpeedSquared / gravitationalParameter;
+
+    // Solve universal Kepler's equation for universal anomaly using Newton's method.
+    Real universalAnomaly = squareRootMu * std::fabs( alpha ) * timeOfFlight;
+    if ( std::fabs( alpha ) < 1.0e-12 )
+    {
+        universalAnomaly = squareRootMu * timeOfFlight / initialRadius;
+    }
+
+    Real stumpffFunctionC = 0.0;
+    Real stumpffFunctionS = 0.0;
+    Real z = 0.0;
+
+    for ( int i = 0; i < maximumIterations; i++ )
+    {
+        z = alpha * universalAnomaly * universalAnomaly;
+        computeStumpffFunctions( z, stumpffFunctionC, stumpffFunctionS );
+
+        const Real keplerFunction
+            = initialRadius * radialVelocity / squareRootMu
+              * universalAnomaly * universalAnomaly * stumpffFunctionC
+              + ( 1.0 - alpha * initialRadius )
+                * universalAnomaly * universalAnomaly * universalAnomaly * stumpffFunctionS
+              + initialRadius * universalAnomaly
+              - squareRootMu * timeOfFlight;
+
+        const Real keplerFunctionDerivative
+            = initialRadius * radialVelocity / squareRootMu
+              * universalAnomaly * ( 1.0 - z * stumpffFunctionS )
+              + ( 1.0 - alpha * initialRadius )
+                * universalAnomaly * universalAnomaly * stumpffFunctionC
+              + initialRadius;
+
+        const Real step = keplerFunction / keplerFunctionDerivative;
+        universalAnomaly -= step;
+
+        if ( std::fabs( step )
+             < tolerance * std::max( std::fabs( universalAnomaly ), Real( 1.0 ) ) )
+        {
+            break;
+        }
+    }
+
+    z = alpha * universalAnomaly * universalAnomaly;
+    computeStumpffFunctions( z, stumpffFunctionC, stumpffFunctionS );
+
+    // Compute Lagrange coefficients and propagated state.
+    const Real universalAnomalySquared = universalAnomaly * universalAnomaly;
+    const Real lagrangeF = 1.0 - universalAnomalySquared / initialRadius * stumpffFunctionC;
+    const Real lagrangeG = timeOfFlight
+                           - universalAnomalySquared * universalAnomaly * stumpffFunctionS
+                             / squareRootMu;
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        finalPosition[ i ] = lagrangeF * initialPosition[ i ] + lagrangeG * initialVelocity[ i ];
+    }
+
+    const Real finalRadius = std::sqrt( finalPosition[ 0 ] * finalPosition[ 0 ]
+                                        + finalPosition[ 1 ] * finalPosition[ 1 ]
+                                        + finalPosition[ 2 ] * finalPosition[ 2 ] );
+
+    const Real lagrangeFDot = squareRootMu / ( finalRadius * initialRadius )
+                              * ( z * stumpffFunctionS - 1.0 ) * universalAnomaly;
+    const Real lagrangeGDot = 1.0 - universalAnomalySquared / finalRadius * stumpffFunctionC;
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        finalVelocity[ i ] = lagrangeFDot * initialPosition[ i ]
+                             + lagrangeGDot * initialVelocity[ i ];
+    }
+}
+
+//! Propagate Cartesian state using two-body dynamics with secular J2 perturbations.
+template< typename Real, typename Vector3 >
+void propagateJ2SecularState( const Vector3& initialPosition,
+                              const Vector3& initialVelocity,
+                              const Real timeOfFlight,
+                              const Real gravitationalParameter,
+                              const Real equatorialRadius,
+                              const Real j2,
+                              Real finalPosition[ 3 ],
+                              Real finalVelocity[ 3 ],
+                              const Real tolerance,
+                              const int maximumIterations )
+{
+    // Compute angular-momentum vector, radius, speed and radial velocity of initial state.
+    Real angularMomentum[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        const int j = ( i + 1 ) % 3;
+        const int k = ( i + 2 ) % 3;
+        angularMomentum[ i ] = initialPosition[ j ] * initialVelocity[ k ]
+                               - initialPosition[ k ] * initialVelocity[ j ];
+    }
+    const Real angularMomentumNorm = std::sqrt( angularMomentum[ 0 ] * angularMomentum[ 0 ]
+                                                + angularMomentum[ 1 ] * angularMomentum[ 1 ]
+                                                + angularMomentum[ 2 ] * angularMomentum[ 2 ] );
+
+    const Real initialRadius = std::sqrt( initialPosition[ 0 ] * initialPosition[ 0 ]
+                                          + initialPosition[ 1 ] * initialPosition[ 1 ]
+                                          + initialPosition[ 2 ] * initialPosition[ 2 ] );
+    const Real initialSpeedSquared = initialVelocity[ 0 ] * initialVelocity[ 0 ]
+                                     + initialVelocity[ 1 ] * initialVelocity[ 1 ]
+                                     + initialVelocity[ 2 ] * initialVelocity[ 2 ];
+
+    // Compute reciprocal of semi-major axis [km^-1] and semi-latus rectum [km].
+    const Real alpha = 2.0 / initialRadius - initialSpeedSquared / gravitationalParameter;
+    const Real semiLatusRectum
+        = angularMomentumNorm * angularMomentumNorm / gravitationalParameter;
+    const Real eccentricitySquared = 1.0 - semiLatusRectum * alpha;
+
+    // Propagate using two-body dynamics only if orbit is not elliptical.
+    if ( alpha <= 0.0 || eccentricitySquared >= 1.0 || angularMomentumNorm == 0.0 )
+    {
+        propagateTwoBodyState( initialPosition,
+                               initialVelocity,
+                               timeOfFlight,
+                               gravitationalParameter,
+                               finalPosition,
+                               finalVelocity,
+                               tolerance,
+                               maximumIterations );
+        return;
+    }
+
+    // Compute mean semi-major axis [km], by removing first-order short-period J2 variations from
+    // osculating semi-major axis (Schaub and Junkins, 2003).
+    const Real cosineInclination = angularMomentum[ 2 ] / angularMomentumNorm;
+    const Real sineInclinationSquared = 1.0 - cosineInclination * cosineInclination;
+    const Real osculatingSemiMajorAxis = 1.0 / alpha;
+    const Real semiMajorAxisRadiusRatioCubed
+        = std::pow( osculatingSemiMajorAxis / initialRadius, 3 );
+    const Real etaCubed = std::pow( 1.0 - eccentricitySquared, 1.5 );
+    const Real gamma = 0.5 * j2 * equatorialRadius * equatorialRadius
+                       / ( osculatingSemiMajorAxis * osculatingSemiMajorAxis );
+    const Real zRadiusRatioSquared
+        = initialPosition[ 2 ] * initialPosition[ 2 ] / ( initialRadius * initialRadius );
+    const Real semiMajorAxis
+        = osculatingSemiMajorAxis
+          * ( 1.0 - gamma * ( ( 3.0 * cosineInclination * cosineInclination - 1.0 )
+                              * ( semiMajorAxisRadiusRatioCubed - 1.0 / etaCubed )
+                              + 3.0 * semiMajorAxisRadiusRatioCubed
+                                * ( sineInclinationSquared - 2.0 * zRadiusRatioSquared ) ) );
+
+    // Compute secular rates of longitude of ascending node, argument of periapsis and mean
+    // anomaly due to J2 [rad/s].
+    const Real meanMotion = std::sqrt( gravitationalParameter
+                                       / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) );
+    const Real radiusRatio = equatorialRadius / semiLatusRectum;
+    const Real rateFactor = 1.5 * j2 * radiusRatio * radiusRatio * meanMotion;
+
+    const Real longitudeOfAscendingNodeRate = -rateFactor * cosineInclination;
+    const Real argumentOfPeriapsisRate = rateFactor * ( 2.0 - 2.5 * sineInclinationSquared );
+    const Real meanAnomalyRateCorrection = rateFactor * std::sqrt( 1.0 - eccentricitySquared )
+                                           * ( 1.0 - 1.5 * sineInclinationSquared );
+
+    // Propagate using two-body dynamics, over time scaled by secular mean motion.
+    const Real osculatingMeanMotion = std::sqrt( gravitationalParameter * alpha * alpha * alpha );
+    propagateTwoBodyState( initialPosition,
+                           initialVelocity,
+                           timeOfFlight * ( meanMotion + meanAnomalyRateCorrection )
+                           / osculatingMeanMotion,
+                           gravitationalParameter,
+                           finalPosition,
+                           finalVelocity,
+                           tolerance,
+                           maximumIterations );
+
+    // Rotate propagated state in orbital plane, and about z-axis.
+    const Real angularMomentumUnitVector[ 3 ] = { angularMomentum[ 0 ] / angularMomentumNorm,
+                                                  angularMomentum[ 1 ] / angularMomentumNorm,
+                                                  angularMomentum[ 2 ] / angularMomentumNorm };
+    const Real zUnitVector[ 3 ] = { 0.0, 0.0, 1.0 };
+
+    const Real argumentOfPeriapsisChange = argumentOfPeriapsisRate * timeOfFlight;
+    const Real longitudeOfAscendingNodeChange = longitudeOfAscendingNodeRate * timeOfFlight;
+
+    rotateVectorAboutAxis( angularMomentumUnitVector, argumentOfPeriapsisChange, finalPosition );
+    rotateVectorAboutAxis( angularMomentumUnitVector, argumentOfPeriapsisChange, finalVelocity );
+    rotateVectorAboutAxis( zUnitVector, longitudeOfAscendingNodeChange, finalPosition );
+    rotateVectorAboutAxis( zUnitVector, longitudeOfAscendingNodeChange, finalVelocity );
+}
+
+//! Rotate vector about axis.
+template< typename Real >
+void rotateVectorAboutAxis( const Real axis[ 3 ], const Real angle, Real vector[ 3 ] )
+{
+    const Real cosineAngle = std::cos( angle );
+    const Real sineAngle = std::sin( angle );
+    const Real projection
+        = axis[ 0 ] * vector[ 0 ] + axis[ 1 ] * vector[ 1 ] + axis[ 2 ] * vector[ 2 ];
+
+    Real rotatedVector[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        rotatedVector[ i ]
+            = vector[ i ] * cosineAngle
+              + ( axis[ ( i + 1 ) % 3 ] * vector[ ( i + 2 ) % 3 ]
+                  - axis[ ( i + 2 ) % 3 ] * vector[ ( i + 1 ) % 3 ] ) * sineAngle
+              + axis[ i ] * projection * ( 1.0 - cosineAngle );
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        vector[ i ] = rotatedVector[ i ];
+    }
+}
+
+//! Compute number of complete revolutions of two-body orbit.
+template< typename Real, typename Vector3 >
+int computeNumberOfRevolutions( const Vector3& position,
+                                const Vector3& velocity,
+                                const Real timeOfFlight,
+                                const Real gravitationalParameter )
+{
+    const Real radius = std::sqrt( position[ 0 ] * position[ 0 ]
+                                   + position[ 1 ] * position[ 1 ]
+                                   + position[ 2 ] * position[ 2 ] );
+    const Real squaredSpeed = velocity[ 0 ] * velocity[ 0 ]
+                              + velocity[ 1 ] * velocity[ 1 ]
+                              + velocity[ 2 ] * velocity[ 2 ];
+
+    // Compute reciprocal of semi-major axis from vis-viva equation.
+    const Real inverseSemiMajorAxis = 2.0 / radius - squaredSpeed / gravitationalParameter;
+    if ( inverseSemiMajorAxis <= 0.0 )
+    {
+        return 0;
+    }
+
+    const Real semiMajorAxis = 1.0 / inverseSemiMajorAxis;
+    const Real orbitalPeriod = 2.0 * sml::SML_PI
+                               * std::sqrt( semiMajorAxis * semiMajorAxis * semiMajorAxis
+                                            / gravitationalParameter );
+    return static_cast< int >( std::floor( timeOfFlight / orbitalPeriod ) );
+}
+
+//! Compute Keplerian elements of Cartesian state.
+template< typename Real, typename Vector6 >
+void computeKeplerianElements( const Vector6& cartesianState,
+                               const Real gravitationalParameter,
+                               Real keplerianElements[ 6 ] )
+{
+    const Real tolerance = 10.0 * std::numeric_limits< Real >::epsilon( );
+    const Real twoPi = 2.0 * sml::SML_PI;
+
+    const Real position[ 3 ] = { cartesianState[ 0 ], cartesianState[ 1 ], cartesianState[ 2 ] };
+    const Real velocity[ 3 ] = { cartesianState[ 3 ], cartesianState[ 4 ], cartesianState[ 5 ] };
+    const Real radius = std::sqrt( position[ 0 ] * position[ 0 ]
+                                   + position[ 1 ] * position[ 1 ]
+                                   + position[ 2 ] * position[ 2 ] );
+
+    // Compute angular-momentum vector and its unit vector.
+    Real angularMomentum[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        angularMomentum[ i ] = position[ ( i + 1 ) % 3 ] * velocity[ ( i + 2 ) % 3 ]
+                               - position[ ( i + 2 ) % 3 ] * velocity[ ( i + 1 ) % 3 ];
+    }
+    const Real angularMomentumSquared = angularMomentum[ 0 ] * angularMomentum[ 0 ]
+                                        + angularMomentum[ 1 ] * angularMomentum[ 1 ]
+                                        + angularMomentum[ 2 ] * angularMomentum[ 2 ];
+    const Real angularMomentumNorm = std::sqrt( angularMomentumSquared );
+    Real angularMomentumUnitVector[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        angularMomentumUnitVector[ i ] = angularMomentum[ i ] / angularMomentumNorm;
+    }
+
+    // Compute eccentricity vector.
+    Real eccentricityVector[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        eccentricityVector[ i ] = ( velocity[ ( i + 1 ) % 3 ] * angularMomentum[ ( i + 2 ) % 3 ]
+                                    - velocity[ ( i + 2 ) % 3 ] * angularMomentum[ ( i + 1 ) % 3 ] )
+                                  / gravitationalParameter
+                                  - position[ i ] / radius;
+    }
+    const Real eccentricity = std::sqrt( eccentricityVector[ 0 ] * eccentricityVector[ 0 ]
+                                         + eccentricityVector[ 1 ] * eccentricityVector[ 1 ]
+                                         + eccentricityVector[ 2 ] * eccentricityVector[ 2 ] );
+
+    // Compute semi-major axis; for parabolic orbits, the semi-latus rectum is stored instead.
+    const Real semiLatusRectum = angularMomentumSquared / gravitationalParameter;
+    keplerianElements[ astro::semiMajorAxisIndex ]
+        = ( std::fabs( eccentricity - 1.0 ) < tolerance )
+          ? semiLatusRectum : semiLatusRectum / ( 1.0 - eccentricity * eccentricity );
+    keplerianElements[ astro::eccentricityIndex ] = eccentricity;
+
+    // Compute inclination.
+    const Real inclination
+        = std::acos( std::max( Real( -1.0 ),
+                               std::min( Real( 1.0 ), angularMomentumUnitVector[ 2 ] ) ) );
+    keplerianElements[ astro::inclinationIndex ] = inclination;
+
+    // Compute unit vector to ascending node, which is placed on the x-axis for equatorial orbits.
+    Real ascendingNodeUnitVector[ 3 ] = { 1.0, 0.0, 0.0 };
+    const Real ascendingNodeNorm = std::sqrt( angularMomentumUnitVector[ 0 ]
+                                              * angularMomentumUnitVector[ 0 ]
+                                              + angularMomentumUnitVector[ 1 ]
+                                              * angularMomentumUnitVector[ 1 ] );
+    if ( ascendingNodeNorm > tolerance )
+    {
+        ascendingNodeUnitVector[ 0 ] = -angularMomentumUnitVector[ 1 ] / ascendingNodeNorm;
+        ascendingNodeUnitVector[ 1 ] = angularMomentumUnitVector[ 0 ] / ascendingNodeNorm;
+    }
+
+    // Compute unit vector to periapsis, which is placed at the ascending node for circular orbits.
+    Real periapsisUnitVector[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        periapsisUnitVector[ i ] = ( eccentricity > tolerance )
+                                   ? eccentricityVector[ i ] / eccentricity
+                                   : ascendingNodeUnitVector[ i ];
+    }
+
+    // Compute angles in orbital plane, measured counter-clockwise about angular-momentum vector.
+    Real periapsisAngleSine = 0.0;
+    Real periapsisAngleCosine = 0.0;
+    Real trueAnomalySine = 0.0;
+    Real trueAnomalyCosine = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        const int j = ( i + 1 ) % 3;
+        const int k = ( i + 2 ) % 3;
+        periapsisAngleSine += angularMomentumUnitVector[ i ]
+                              * ( ascendingNodeUnitVector[ j ] * periapsisUnitVector[ k ]
+                                  - ascendingNodeUnitVector[ k ] * periapsisUnitVector[ j ] );
+        periapsisAngleCosine += ascendingNodeUnitVector[ i ] * periapsisUnitVector[ i ];
+        trueAnomalySine += angularMomentumUnitVector[ i ]
+                           * ( periapsisUnitVector[ j ] * position[ k ]
+                               - periapsisUnitVector[ k ] * position[ j ] );
+        trueAnomalyCosine += periapsisUnitVector[ i ] * position[ i ];
+    }
+
+    keplerianElements[ astro::argumentOfPeriapsisIndex ]
+        = sml::computeModulo( std::atan2( periapsisAngleSine, periapsisAngleCosine ), twoPi );
+    keplerianElements[ astro::longitudeOfAscendingNodeIndex ]
+        = sml::computeModulo( std::atan2( ascendingNodeUnitVector[ 1 ],
+                                          ascendingNodeUnitVector[ 0 ] ), twoPi );
+    keplerianElements[ astro::trueAnomalyIndex ]
+        = sml::computeModulo( std::atan2( trueAnomalySine, trueAnomalyCosine ), twoPi );
+}
+
+//! Compute Jacobian of Cartesian state with respect to Keplerian elements.
+template< typename Real, typename Vector6 >
+void computeKeplerianToCartesianJacobian( const Vector6& keplerianElements,
+                                          const Real gravitationalParameter,
+                                          Real jacobian[ 6 ][ 6 ] )
+{
+    const Real semiMajorAxis = keplerianElements[ astro::semiMajorAxisIndex ];
+    const Real eccentricity = keplerianElements[ astro::eccentricityIndex ];
+    const Real inclination = keplerianElements[ astro::inclinationIndex ];
+    const Real argumentOfPeriapsis = keplerianElements[ astro::argumentOfPeriapsisIndex ];
+    const Real longitudeOfAscendingNode
+        = keplerianElements[ astro::longitudeOfAscendingNodeIndex ];
+    const Real trueAnomaly = keplerianElements[ astro::trueAnomalyIndex ];
+
+    const Real cosineTrueAnomaly = std::cos( trueAnomaly );
+    const Real sineTrueAnomaly = std::sin( trueAnomaly );
+    const Real cosineInclination = std::cos( inclination );
+    const Real sineInclination = std::sin( inclination );
+    const Real cosineArgumentOfPeriapsis = std::cos( argumentOfPeriapsis );
+    const Real sineArgumentOfPeriapsis = std::sin( argumentOfPeriapsis );
+    const Real cosineLongitudeOfAscendingNode = std::cos( longitudeOfAscendingNode );
+    const Real sineLongitudeOfAscendingNode = std::sin( longitudeOfAscendingNode );
+
+    // Compute semi-latus rectum, radius and velocity scale.
+    const Real oneMinusEccentricitySquared = 1.0 - eccentricity * eccentricity;
+    const Real semiLatusRectum = semiMajorAxis * oneMinusEccentricitySquared;
+    const Real denominator = 1.0 + eccentricity * cosineTrueAnomaly;
+    const Real radius = semiLatusRectum / denominator;
+    const Real velocityScale = std::sqrt( gravitationalParameter / semiLatusRectum );
+
+    // Compute position and velocity in perifocal frame, with their partial derivatives with
+    // respect to semi-major axis, eccentricity and true anomaly.
+    const Real perifocalPosition[ 2 ] = { radius * cosineTrueAnomaly, radius * sineTrueAnomaly };
+    const Real perifocalVelocity[ 2 ]
+        = { -velocityScale * sineTrueAnomaly,
+            velocityScale * ( eccentricity + cosineTrueAnomaly ) };
+
+    const Real radiusEccentricityPartial
+        = semiMajorAxis * ( -2.0 * eccentricity * denominator
+                            - oneMinusEccentricitySquared * cosineTrueAnomaly )
+          / ( denominator * denominator );
+    const Real radiusTrueAnomalyPartial
+        = semiLatusRectum * eccentricity * sineTrueAnomaly / ( denominator * denominator );
+    const Real velocityScaleEccentricityFactor = eccentricity / oneMinusEccentricitySquared;
+
+    Real perifocalPositionPartials[ 2 ][ 3 ];
+    Real perifocalVelocityPartials[ 2 ][ 3 ];
+    for ( int i = 0; i < 2; i++ )
+    {
+        perifocalPositionPartials[ i ][ 0 ] = perifocalPosition[ i ] / semiMajorAxis;
+        perifocalVelocityPartials[ i ][ 0 ] = -0.5 * perifocalVelocity[ i ] / semiMajorAxis;
+        perifocalVelocityPartials[ i ][ 1 ]
+            = velocityScaleEccentricityFactor * perifocalVelocity[ i ];
+    }
+    perifocalPositionPartials[ 0 ][ 1 ] = radiusEccentricityPartial * cosineTrueAnomaly;
+    perifocalPositionPartials[ 1 ][ 1 ] = radiusEccentricityPartial * sineTrueAnomaly;
+    perifocalVelocityPartials[ 1 ][ 1 ] += velocityScale;
+    perifocalPositionPartials[ 0 ][ 2 ]
+        = radiusTrueAnomalyPartial * cosineTrueAnomaly - radius * sineTrueAnomaly;
+    perifocalPositionPartials[ 1 ][ 2 ]
+        = radiusTrueAnomalyPartial * sineTrueAnomaly + radius * cosineTrueAnomaly;
+    perifocalVelocityPartials[ 0 ][ 2 ] = -velocityScale * cosineTrueAnomaly;
+    perifocalVelocityPartials[ 1 ][ 2 ] = -velocityScale * sineTrueAnomaly;
+
+    // Compute perifocal unit vectors P and Q, expressed in the inertial frame, and their partial
+    // derivatives with respect to the orientation angles.
+    const Real unitVectorP[ 3 ]
+        = { cosineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis
+            - sineLongitudeOfAscendingNode * sineArgumentOfPeriapsis * cosineInclination,
+            sineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis
+            + cosineLongitudeOfAscendingNode * sineArgumentOfPeriapsis * cosineInclination,
+            sineArgumentOfPeriapsis * sineInclination };
+    const Real unitVectorQ[ 3 ]
+        = { -cosineLongitudeOfAscendingNode * sineArgumentOfPeriapsis
+            - sineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis * cosineInclination,
+            -sineLongitudeOfAscendingNode * sineArgumentOfPeriapsis
+            + cosineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis * cosineInclination,
+            cosineArgumentOfPeriapsis * sineInclination };
+
+    const Real unitVectorPInclinationPartial[ 3 ]
+        = { sineLongitudeOfAscendingNode * sineArgumentOfPeriapsis * sineInclination,
+            -cosineLongitudeOfAscendingNode * sineArgumentOfPeriapsis * sineInclination,
+            sineArgumentOfPeriapsis * cosineInclination };
+    const Real unitVectorQInclinationPartial[ 3 ]
+        = { sineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis * sineInclination,
+            -cosineLongitudeOfAscendingNode * cosineArgumentOfPeriapsis * sineInclination,
+            cosineArgumentOfPeriapsis * cosineInclination };
+
+    const int perifocalElementIndices[ 3 ] = { astro::semiMajorAxisIndex,
+                                               astro::eccentricityIndex,
+                                               astro::trueAnomalyIndex };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        // Partial derivatives with respect to semi-major axis, eccentricity and true anomaly.
+        for ( int j = 0; j < 3; j++ )
+        {
+            jacobian[ i ][ perifocalElementIndices[ j ] ]
+                = perifocalPositionPartials[ 0 ][ j ] * unitVectorP[ i ]
+                  + perifocalPositionPartials[ 1 ][ j ] * unitVectorQ[ i ];
+            jacobian[ i + 3 ][ perifocalElementIndices[ j ] ]
+                = perifocalVelocityPartials[ 0 ][ j ] * unitVectorP[ i ]
+                  + perifocalVelocityPartials[ 1 ][ j ] * unitVectorQ[ i ];
+        }
+
+        // Partial derivatives with respect to inclination.
+        jacobian[ i ][ astro::inclinationIndex ]
+            = perifocalPosition[ 0 ] * unitVectorPInclinationPartial[ i ]
+              + perifocalPosition[ 1 ] * unitVectorQInclinationPartial[ i ];
+        jacobian[ i + 3 ][ astro::inclinationIndex ]
+            = perifocalVelocity[ 0 ] * unitVectorPInclinationPartial[ i ]
+              + perifocalVelocity[ 1 ] * unitVectorQInclinationPartial[ i ];
+
+        // Partial derivatives with respect to argument of periapsis (dP = Q, dQ = -P).
+        jacobian[ i ][ astro::argumentOfPeriapsisIndex ]
+            = perifocalPosition[ 0 ] * unitVectorQ[ i ]
+              - perifocalPosition[ 1 ] * unitVectorP[ i ];
+        jacobian[ i + 3 ][ astro::argumentOfPeriapsisIndex ]
+            = perifocalVelocity[ 0 ] * unitVectorQ[ i ]
+              - perifocalVelocity[ 1 ] * unitVectorP[ i ];
+    }
+
+    // Compute inertial position and velocity.
+    Real position[ 3 ];
+    Real velocity[ 3 ];
+    for ( int i = 0; i < 3; i++ )
+    {
+        position[ i ] = perifocalPosition[ 0 ] * unitVectorP[ i ]
+                        + perifocalPosition[ 1 ] * unitVectorQ[ i ];
+        velocity[ i ] = perifocalVelocity[ 0 ] * unitVectorP[ i ]
+                        + perifocalVelocity[ 1 ] * unitVectorQ[ i ];
+    }
+
+    // Partial derivatives with respect to longitude of ascending node (rotation about z-axis).
+    jacobian[ 0 ][ astro::longitudeOfAscendingNodeIndex ] = -position[ 1 ];
+    jacobian[ 1 ][ astro::longitudeOfAscendingNodeIndex ] = position[ 0 ];
+    jacobian[ 2 ][ astro::longitudeOfAscendingNodeIndex ] = 0.0;
+    jacobian[ 3 ][ astro::longitudeOfAscendingNodeIndex ] = -velocity[ 1 ];
+    jacobian[ 4 ][ astro::longitudeOfAscendingNodeIndex ] = velocity[ 0 ];
+    jacobian[ 5 ][ astro::longitudeOfAscendingNodeIndex ] = 0.0;
+}
+
+} // namespace atom
+
+#endif // ATOM_TWO_BODY_FUNCTIONS_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef ATOM_VECTOR_TRAITS_H
+#define ATOM_VECTOR_TRAITS_H
+
+#include <array>
+#include <cstddef>
+
+namespace atom
+{
+
+//! Traits of vector types used by Atom solver.
+/*!
+ * Traits that define how vectors of the types passed to the Atom solver are created, such that
+ * temporaries follow the type chosen by the caller. By default, vectors are created by passing the
+ * size to the constructor, which supports dynamic-size vectors (e.g., std::vector, Eigen::VectorXd)
+ * and fixed-size Eigen vectors (e.g., Eigen::Vector3d), for which the size is only checked. The
+ * specialization for std::array creates the array without using the size, since its size is fixed
+ * at compile time. Fixed-size vectors are stored on the stack, such that no memory is allocated
+ * and loops over their elements can be unrolled by the compiler.
+ *
+ * Other vector types can be supported by specializing these traits.
+ *
+ * @sa createVector
+ * @tparam Vector Type for vector of reals
+ */
+template< typename Vector >
+struct VectorTraits
+{
+public:
+
+    //! Flag indicating if size of vector is fixed at compile time.
+    static const bool isFixedSize = false;
+
+    //! Create vector.
+    /*!
+     * Creates vector of given size.
+     * @param  size Size of vector
+     * @return      Vector of given size
+     */
+    static Vector create( const std::size_t size )
+    {
+        return Vector( size );
+    }
+
+protected:
+
+private:
+};
+
+//! Traits of std::array used by Atom solver.
+/*!
+ * Traits of std::array, which is a fixed-size vector.
+ *
+ * @sa VectorTraits, createVector
+ * @tparam Real Type for reals
+ * @tparam Size Size of array
+ */
+template< typename Real, std::size_t Size >
+struct VectorTraits< std::array< Real, Size > >
+{
+public:
+
+    //! Flag indicating if size of vector is fixed at compile time.
+    static const bool isFixedSize = true;
+
+    //! Create vector.
+    /*!
+     * Creates array, with elements set to zero. The given size must be equal to the size of the
+     * array.
+     * @return Array with elements set to zero
+     */
+    static std::array< Real, Size > create( const std::size_t )
+    {
+        std::array< Real, Size > vector;
+        vector.fill( Real( 0 ) );
+        return vector;
+    }
+
+protected:
+
+private:
+};
+
+//! Create vector.
+/*!
+ * Creates vector of given type and size, using the traits of the vector type.
+ *
+ * @sa VectorTraits
+ * @tparam Vector Type for vector of reals
+ * @param  size   Size of vector
+ * @return        Vector of given size
+ */
+template< typename Vector >
+inline Vector createVector( const std::size_t size )
+{
+    return VectorTraits< Vector >::create( size );
+}
+
+} // namespace atom
+
+#endif // ATOM_VECTOR_TRAITS_H
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+# Distributed under the MIT License.
+# See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+
+set -ev
+
+# Build Atom with profile-guided optimization, trained on the benchmark suite.
+# Usage: scripts/build_pgo.sh [build directory (default: build-pgo)] [CMake options]
+# The instrumented build is set up in <build directory>/generate and the optimized build, which
+# contains the optimized library and benchmark suite, in <build directory>/use.
+source_dir=$(cd "$(dirname "$0")/.." && pwd)
+build_dir=${1:-build-pgo}
+if [[ $# -gt 0 ]]; then
+  shift
+fi
+mkdir -p "${build_dir}/generate" "${build_dir}/use"
+build_dir=$(cd "${build_dir}" && pwd)
+profile_dir="${build_dir}/profiles"
+
+# Build instrumented benchmark suite and train profiles.
+cd "${build_dir}/generate"
+cmake "${source_dir}" -DBUILD_LIBRARY=ON -DBUILD_BENCHMARKS=ON -DPGO_MODE=GENERATE \
+  -DPGO_PROFILE_PATH="${profile_dir}" "$@"
+cmake --build .
+cmake --build . --target pgo_train
+
+# Build optimized library and benchmark suite using trained profiles.
+cd "${build_dir}/use"
+cmake "${source_dir}" -DBUILD_LIBRARY=ON -DBUILD_BENCHMARKS=ON -DPGO_MODE=USE \
+  -DPGO_PROFILE_PATH="${profile_dir}" "$@"
+cmake --build .
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Compile the explicit instantiations declared by the headers, by turning the explicit
+// instantiation declarations into explicit instantiation definitions.
+#ifndef ATOM_USE_PRECOMPILED_INSTANTIATIONS
+#define ATOM_USE_PRECOMPILED_INSTANTIATIONS
+#endif
+#define ATOM_EXTERN_TEMPLATE template
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
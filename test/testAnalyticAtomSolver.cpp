@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/Globals.h>
+
+#include "Atom/analyticAtomSolver.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+
+TEST_CASE( "Execute Atom solver using analytic propagation model", "[analytic-atom-solver]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 100.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    Vector3 solvedDepartureVelocity( 3 );
+    int numberOfIterations = 0;
+
+    SECTION( "Test two-body propagation model" )
+    {
+        // Compute arrival position using same model as solver.
+        Real arrivalState[ 6 ];
+        propagateTwoBodyState( departurePosition, departureVelocity, timeOfFlight * 60.0, kMU,
+                               arrivalState, arrivalState + 3 );
+        const Vector3 arrivalPosition( arrivalState, arrivalState + 3 );
+
+        const SolverStatus status = executeAnalyticAtomSolver( departurePosition,
+                                                               arrivalPosition,
+                                                               timeOfFlight,
+                                                               departureVelocityGuess,
+                                                               solvedDepartureVelocity,
+                                                               numberOfIterations,
+                                                               twoBodyPropagationModel );
+
+        REQUIRE( status == solverConverged );
+        REQUIRE( numberOfIterations > 0 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( solvedDepartureVelocity[ i ]
+                     == Approx( departureVelocity[ i ] ).epsilon( 1.0e-8 ) );
+        }
+    }
+
+    SECTION( "Test J2-secular propagation model" )
+    {
+        // Compute arrival position using same model as solver.
+        Real arrivalState[ 6 ];
+        propagateJ2SecularState( departurePosition, departureVelocity, timeOfFlight * 60.0, kMU,
+                                 kXKMPER, kXJ2, arrivalState, arrivalState + 3 );
+        const Vector3 arrivalPosition( arrivalState, arrivalState + 3 );
+
+        const SolverStatus status = executeAnalyticAtomSolver( departurePosition,
+                                                               arrivalPosition,
+                                                               timeOfFlight,
+                                                               departureVelocityGuess,
+                                                               solvedDepartureVelocity,
+                                                               numberOfIterations );
+
+        REQUIRE( status == solverConverged );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( solvedDepartureVelocity[ i ]
+                     == Approx( departureVelocity[ i ] ).epsilon( 1.0e-8 ) );
+        }
+
+        Real residuals[ 3 ];
+        const Real velocity[ 3 ] = { solvedDepartureVelocity[ 0 ],
+                                     solvedDepartureVelocity[ 1 ],
+                                     solvedDepartureVelocity[ 2 ] };
+        computeAnalyticAtomResiduals( departurePosition, velocity, arrivalPosition,
+                                      timeOfFlight * 60.0, j2SecularPropagationModel, kMU,
+                                      kXKMPER, kXJ2, residuals );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::fabs( residuals[ i ] ) < 1.0e-10 );
+        }
+    }
+
+    SECTION( "Test maximum iterations reached" )
+    {
+        Real arrivalState[ 6 ];
+        propagateJ2SecularState( departurePosition, departureVelocity, timeOfFlight * 60.0, kMU,
+                                 kXKMPER, kXJ2, arrivalState, arrivalState + 3 );
+        const Vector3 arrivalPosition( arrivalState, arrivalState + 3 );
+
+        const SolverStatus status = executeAnalyticAtomSolver( departurePosition,
+                                                               arrivalPosition,
+                                                               timeOfFlight,
+                                                               departureVelocityGuess,
+                                                               solvedDepartureVelocity,
+                                                               numberOfIterations,
+                                                               j2SecularPropagationModel,
+                                                               kMU,
+                                                               kXKMPER,
+                                                               kXJ2,
+                                                               1.0e-10,
+                                                               1 );
+
+        REQUIRE( status == solverMaximumIterationsReached );
+        REQUIRE( numberOfIterations == 1 );
+        REQUIRE( solvedDepartureVelocity.size( ) == 3 );
+    }
+}
+
+TEST_CASE( "Solve 3x3 linear system", "[analytic-atom-solver]" )
+{
+    const Real matrix[ 3 ][ 3 ] = { { 4.0, 1.0, 0.0 }, { 1.0, 3.0, 1.0 }, { 0.0, 1.0, 2.0 } };
+    const Real vector[ 3 ] = { 1.0, 2.0, 3.0 };
+    Real solution[ 3 ];
+
+    REQUIRE( solveLinearSystem3( matrix, vector, solution ) );
+    for ( int i = 0; i < 3; i++ )
+    {
+        REQUIRE( matrix[ i ][ 0 ] * solution[ 0 ]
+                 + matrix[ i ][ 1 ] * solution[ 1 ]
+                 + matrix[ i ][ 2 ] * solution[ 2 ] == Approx( vector[ i ] ) );
+    }
+
+    const Real singularMatrix[ 3 ][ 3 ]
+        = { { 1.0, 2.0, 3.0 }, { 2.0, 4.0, 6.0 }, { 0.0, 1.0, 2.0 } };
+    REQUIRE( !solveLinearSystem3( singularMatrix, vector, solution ) );
+}
+
+} // namespace tests
+} // namespace atom
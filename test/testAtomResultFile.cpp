@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/atomResultFile.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/solverDiagnostics.hpp"
+#include "Atom/solverStatus.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef std::pair< Vector3, Vector3 > Velocities;
+typedef AtomProblem< Real, Vector3 > Problem;
+typedef AtomSolution< Real, Vector3 > Solution;
+
+TEST_CASE( "Write and read Atom result file", "[atom-result-file]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 6.44661660560979 + 0.013;
+    departureVelocityGuess[ 1 ] = -1.14788435945363 - 0.074;
+    departureVelocityGuess[ 2 ] = 3.44659369332744 + 0.026;
+
+    // Solve transfer, and trace iterations of solver for same transfer.
+    std::vector< Problem > problems( 1, Problem( departurePosition,
+                                                 departureEpoch,
+                                                 arrivalPosition,
+                                                 timeOfFlight,
+                                                 departureVelocityGuess ) );
+    const Solution solution = executeAtomSolverBatch( problems, 1 )[ 0 ];
+    REQUIRE( solution.status == solverConverged );
+    REQUIRE( solution.transfer.isAvailable );
+
+    SolverIterationTrace< Real > trace;
+    int numberOfIterations = 0;
+    executeAtomSolver( departurePosition,
+                       departureEpoch,
+                       arrivalPosition,
+                       timeOfFlight,
+                       departureVelocityGuess,
+                       trace,
+                       numberOfIterations );
+    REQUIRE( trace.records( ).size( ) > 10 );
+
+    // Set failed solution.
+    Solution failedSolution;
+    failedSolution.departureVelocity = departureVelocityGuess;
+    failedSolution.arrivalVelocity = Vector3( 3, 0.0 );
+    failedSolution.numberOfIterations = 3;
+    failedSolution.solverStatus = GSL_EFAILED;
+    failedSolution.status = solverPropagationFailed;
+
+    // Write file with three records, of which the second record is not written.
+    const char* fileName = "testAtomResultFile.bin";
+    {
+        AtomResultWriter writer( fileName, 3, 10 );
+        REQUIRE( writer.numberOfRecords( ) == 3 );
+        REQUIRE( writer.traceCapacity( ) == 10 );
+        writer.write( 0, solution, 1.5, 2.5, &trace );
+        writer.write( 2, failedSolution );
+        REQUIRE_THROWS( writer.write( 3, solution ) );
+    }
+
+    AtomResultReader reader( fileName );
+    REQUIRE( reader.numberOfRecords( ) == 3 );
+    REQUIRE( reader.traceCapacity( ) == 10 );
+
+    SECTION( "Test records" )
+    {
+        REQUIRE( reader.isWritten( 0 ) );
+        REQUIRE( !reader.isWritten( 1 ) );
+        REQUIRE( reader.isWritten( 2 ) );
+        REQUIRE_THROWS( reader.isWritten( 3 ) );
+
+        // Check that solutions are read back exactly.
+        Solution readSolution;
+        reader.read( 0, readSolution );
+        REQUIRE( readSolution.numberOfIterations == solution.numberOfIterations );
+        REQUIRE( readSolution.status == solverConverged );
+        REQUIRE( readSolution.solverStatus == GSL_SUCCESS );
+        REQUIRE( !readSolution.transfer.isAvailable );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( readSolution.departureVelocity[ i ] == solution.departureVelocity[ i ] );
+            REQUIRE( readSolution.arrivalVelocity[ i ] == solution.arrivalVelocity[ i ] );
+        }
+
+        reader.read( 2, readSolution );
+        REQUIRE( readSolution.numberOfIterations == 3 );
+        REQUIRE( readSolution.status == solverPropagationFailed );
+        REQUIRE( readSolution.solverStatus == GSL_EFAILED );
+        REQUIRE( readSolution.departureVelocity[ 0 ] == departureVelocityGuess[ 0 ] );
+
+        // Check that departure TLE is recovered from reference TLE.
+        Tle departureTle;
+        REQUIRE( reader.readDepartureTle( 0, departureTle ) );
+        const Tle& tle = solution.transfer.departureTle;
+        REQUIRE( departureTle.Epoch( ).Ticks( ) == tle.Epoch( ).Ticks( ) );
+        REQUIRE( departureTle.Inclination( true ) == Approx( tle.Inclination( true ) ) );
+        REQUIRE( departureTle.Eccentricity( ) == Approx( tle.Eccentricity( ) ) );
+        REQUIRE( departureTle.MeanMotion( ) == Approx( tle.MeanMotion( ) ) );
+        REQUIRE( !reader.readDepartureTle( 2, departureTle ) );
+
+        // Check that trace is truncated to trace capacity.
+        std::vector< SolverIterationRecord< Real > > records;
+        reader.readTrace( 0, records );
+        REQUIRE( records.size( ) == 10 );
+        for ( unsigned int j = 0; j < records.size( ); j++ )
+        {
+            REQUIRE( records[ j ].iteration == trace.records( )[ j ].iteration );
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( records[ j ].independentVariables[ i ]
+                         == trace.records( )[ j ].independentVariables[ i ] );
+                REQUIRE( records[ j ].residuals[ i ] == trace.records( )[ j ].residuals[ i ] );
+            }
+        }
+        reader.readTrace( 2, records );
+        REQUIRE( records.empty( ) );
+    }
+
+    SECTION( "Test columns" )
+    {
+        const double* departureDeltaV = reader.column< double >( departureDeltaVColumn );
+        REQUIRE( departureDeltaV[ 0 ] == 1.5 );
+        REQUIRE( std::isnan( departureDeltaV[ 2 ] ) );
+        REQUIRE( reader.column< double >( arrivalDeltaVColumn )[ 0 ] == 2.5 );
+
+        const std::int32_t* status = reader.column< std::int32_t >( statusColumn );
+        REQUIRE( status[ 0 ] == solverConverged );
+        REQUIRE( status[ 2 ] == solverPropagationFailed );
+
+        // Check that column cannot be accessed as values of different size.
+        REQUIRE_THROWS( reader.column< double >( statusColumn ) );
+    }
+
+    std::remove( fileName );
+}
+
+TEST_CASE( "Read invalid Atom result file", "[atom-result-file]" )
+{
+    const char* fileName = "testAtomResultFileInvalid.bin";
+    {
+        std::ofstream file( fileName );
+        file << "This is not an Atom result file." << std::endl;
+    }
+
+    REQUIRE_THROWS( AtomResultReader( fileName ) );
+    REQUIRE_THROWS( AtomResultReader( "testAtomResultFileMissing.bin" ) );
+
+    std::remove( fileName );
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/atomSensitivities.hpp"
+#include "Atom/solverStatus.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef std::pair< Vector3, Vector3 > Velocities;
+
+TEST_CASE( "Compute sensitivities of converged Atom solution", "[atom-solver],[sensitivities]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 6.44661660560979 + 0.013;
+    departureVelocityGuess[ 1 ] = -1.14788435945363 - 0.074;
+    departureVelocityGuess[ 2 ] = 3.44659369332744 + 0.026;
+
+    // Solve transfer and compute sensitivities at converged departure velocity.
+    const Velocities velocities = executeAtomSolver( departurePosition,
+                                                     departureEpoch,
+                                                     arrivalPosition,
+                                                     timeOfFlight,
+                                                     departureVelocityGuess );
+
+    AtomSensitivities< Real > sensitivities;
+    REQUIRE( !sensitivities.isAvailable );
+    REQUIRE( std::isnan( sensitivities.jacobian[ 0 ][ 0 ] ) );
+
+    REQUIRE( computeAtomSensitivities( departurePosition,
+                                       departureEpoch,
+                                       arrivalPosition,
+                                       timeOfFlight,
+                                       velocities.first,
+                                       sensitivities ) == solverConverged );
+    REQUIRE( sensitivities.isAvailable );
+
+    SECTION( "Test sensitivities with respect to arrival position" )
+    {
+        // Check that Jacobian times sensitivities of departure velocity with respect to arrival
+        // position yields the identity matrix, scaled by the Earth mean radius.
+        for ( int i = 0; i < 3; i++ )
+        {
+            for ( int k = 0; k < 3; k++ )
+            {
+                Real product = 0.0;
+                for ( int j = 0; j < 3; j++ )
+                {
+                    product += sensitivities.jacobian[ i ][ j ]
+                               * sensitivities.departureVelocitySensitivities[ j ][
+                                    arrivalPositionInputIndex + k ];
+                }
+                REQUIRE( std::fabs( product - ( ( i == k ) ? 1.0 / kXKMPER : 0.0 ) )
+                         < 1.0e-9 / kXKMPER );
+                REQUIRE( std::isfinite( sensitivities.arrivalVelocitySensitivities[ i ][
+                                          arrivalPositionInputIndex + k ] ) );
+            }
+        }
+    }
+
+    SECTION( "Test sensitivities with respect to time-of-flight" )
+    {
+        // Solve transfer for shifted time-of-flight, starting from converged departure velocity,
+        // and check that the change in the velocities is predicted by the sensitivities.
+        const Real timeOfFlightShift = 1.0;
+        const Velocities shiftedVelocities = executeAtomSolver( departurePosition,
+                                                                departureEpoch,
+                                                                arrivalPosition,
+                                                                timeOfFlight + timeOfFlightShift,
+                                                                velocities.first );
+
+        Real departureVelocityChangeNorm = 0.0;
+        Real arrivalVelocityChangeNorm = 0.0;
+        for ( int i = 0; i < 3; i++ )
+        {
+            departureVelocityChangeNorm
+                += ( shiftedVelocities.first[ i ] - velocities.first[ i ] )
+                   * ( shiftedVelocities.first[ i ] - velocities.first[ i ] );
+            arrivalVelocityChangeNorm
+                += ( shiftedVelocities.second[ i ] - velocities.second[ i ] )
+                   * ( shiftedVelocities.second[ i ] - velocities.second[ i ] );
+        }
+        departureVelocityChangeNorm = std::sqrt( departureVelocityChangeNorm );
+        arrivalVelocityChangeNorm = std::sqrt( arrivalVelocityChangeNorm );
+        REQUIRE( departureVelocityChangeNorm > 0.0 );
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            const Real predictedDepartureVelocityChange
+                = sensitivities.departureVelocitySensitivities[ i ][ timeOfFlightInputIndex ]
+                  * timeOfFlightShift;
+            const Real predictedArrivalVelocityChange
+                = sensitivities.arrivalVelocitySensitivities[ i ][ timeOfFlightInputIndex ]
+                  * timeOfFlightShift;
+            REQUIRE( std::fabs( predictedDepartureVelocityChange
+                                - ( shiftedVelocities.first[ i ] - velocities.first[ i ] ) )
+                     < 5.0e-2 * departureVelocityChangeNorm );
+            REQUIRE( std::fabs( predictedArrivalVelocityChange
+                                - ( shiftedVelocities.second[ i ] - velocities.second[ i ] ) )
+                     < 5.0e-2 * arrivalVelocityChangeNorm );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace atom
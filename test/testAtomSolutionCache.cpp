@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/atomSolutionCache.hpp"
+#include "Atom/solverStatus.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef std::pair< Vector3, Vector3 > Velocities;
+typedef CachedAtomSolution< Real, Vector3 > Solution;
+
+TEST_CASE( "Cache converged Atom solutions", "[atom-solver],[cache]" )
+{
+    // Set departure and arrival positions [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    const DateTime departureEpoch( 63548650522376360 );
+    const Real timeOfFlight = 1000.0;
+
+    // Set converged solution, tagged by its departure velocity [km/s].
+    Solution solution;
+    solution.departureVelocity = Vector3( 3, 1.0 );
+    solution.arrivalVelocity = Vector3( 3, 2.0 );
+    solution.absoluteTolerance = 1.0e-10;
+
+    AtomSolutionCache< Real, Vector3 > cache( 4 );
+    REQUIRE( cache.capacity( ) == 4 );
+    REQUIRE( cache.size( ) == 0 );
+
+    Solution cachedSolution;
+    REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                         1.0e-10, cachedSolution ) == solutionCacheMiss );
+    cache.insert( departurePosition, departureEpoch, arrivalPosition, timeOfFlight, solution );
+    REQUIRE( cache.size( ) == 1 );
+
+    SECTION( "Test exact and nearby lookups" )
+    {
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 1.0 );
+        REQUIRE( cachedSolution.arrivalVelocity[ 0 ] == 2.0 );
+
+        // Check that shifted epochs, times-of-flight and positions seed the solver.
+        REQUIRE( cache.find( departurePosition, departureEpoch.AddSeconds( 1.0 ), arrivalPosition,
+                             timeOfFlight, 1.0e-10, cachedSolution ) == solutionCacheSeed );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.01, 1.0e-10, cachedSolution ) == solutionCacheSeed );
+        Vector3 shiftedPosition( arrivalPosition );
+        shiftedPosition[ 2 ] += 1.0;
+        REQUIRE( cache.find( departurePosition, departureEpoch, shiftedPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheSeed );
+
+        // Check that tighter tolerances seed the solver, and that distant transfers are not found.
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-12, cachedSolution ) == solutionCacheSeed );
+        shiftedPosition[ 2 ] += 1000.0;
+        REQUIRE( cache.find( departurePosition, departureEpoch, shiftedPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheMiss );
+        REQUIRE( cache.find( departurePosition, departureEpoch.AddDays( 1.0 ), arrivalPosition,
+                             timeOfFlight, 1.0e-10, cachedSolution ) == solutionCacheMiss );
+
+        REQUIRE( cache.numberOfHits( ) == 1 );
+        REQUIRE( cache.numberOfSeeds( ) == 4 );
+        REQUIRE( cache.numberOfMisses( ) == 3 );
+    }
+
+    SECTION( "Test nearest solution among many" )
+    {
+        // Insert solutions with shifted times-of-flight, tagged by their shift [min].
+        for ( int i = 1; i < 4; i++ )
+        {
+            solution.departureVelocity[ 0 ] = 1.0 + i;
+            cache.insert( departurePosition, departureEpoch, arrivalPosition,
+                          timeOfFlight + 0.1 * i, solution );
+        }
+        REQUIRE( cache.size( ) == 4 );
+
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.21, 1.0e-10, cachedSolution ) == solutionCacheSeed );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 3.0 );
+
+        // Check that inserting solution for stored transfer replaces it.
+        solution.departureVelocity[ 0 ] = 5.0;
+        cache.insert( departurePosition, departureEpoch, arrivalPosition, timeOfFlight, solution );
+        REQUIRE( cache.size( ) == 4 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 5.0 );
+
+        // Check that oldest half of solutions is evicted once capacity is reached, and that the
+        // rebuilt tree finds the remaining solutions.
+        solution.departureVelocity[ 0 ] = 6.0;
+        cache.insert( departurePosition, departureEpoch, arrivalPosition,
+                      timeOfFlight + 0.4, solution );
+        REQUIRE( cache.size( ) == 3 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.2, 1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 3.0 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.3, 1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 4.0 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.4, 1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 6.0 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition,
+                             timeOfFlight + 0.1, 1.0e-10, cachedSolution ) == solutionCacheSeed );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 3.0 );
+    }
+
+    SECTION( "Test stored solution converged to tighter tolerance" )
+    {
+        // Check that solution converged to looser tolerance does not replace stored solution.
+        solution.departureVelocity[ 0 ] = 5.0;
+        solution.absoluteTolerance = 1.0e-8;
+        cache.insert( departurePosition, departureEpoch, arrivalPosition, timeOfFlight, solution );
+        REQUIRE( cache.size( ) == 1 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 1.0 );
+        REQUIRE( cachedSolution.absoluteTolerance == 1.0e-10 );
+
+        // Check that solution converged to tighter tolerance replaces stored solution.
+        solution.absoluteTolerance = 1.0e-12;
+        cache.insert( departurePosition, departureEpoch, arrivalPosition, timeOfFlight, solution );
+        REQUIRE( cache.size( ) == 1 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-12, cachedSolution ) == solutionCacheHit );
+        REQUIRE( cachedSolution.departureVelocity[ 0 ] == 5.0 );
+    }
+
+    SECTION( "Test solutions inserted in sorted order" )
+    {
+        // Insert solutions with increasing times-of-flight, which would degenerate an
+        // unbalanced k-d tree into a chain, tagged by their index.
+        const int numberOfSolutions = 1000;
+        AtomSolutionCache< Real, Vector3 > sortedCache( 2 * numberOfSolutions );
+        for ( int i = 0; i < numberOfSolutions; i++ )
+        {
+            solution.departureVelocity[ 0 ] = i;
+            sortedCache.insert( departurePosition, departureEpoch, arrivalPosition,
+                                timeOfFlight + 0.1 * i, solution );
+        }
+        REQUIRE( sortedCache.size( ) == static_cast< std::size_t >( numberOfSolutions ) );
+
+        // Check that depth of tree is logarithmic in number of solutions.
+        REQUIRE( sortedCache.depth( )
+                 <= static_cast< std::size_t >(
+                    std::log( static_cast< double >( numberOfSolutions ) ) / std::log( 1.5 ) )
+                    + 1 );
+
+        // Check that all solutions are still found.
+        for ( int i = 0; i < numberOfSolutions; i++ )
+        {
+            REQUIRE( sortedCache.find( departurePosition, departureEpoch, arrivalPosition,
+                                       timeOfFlight + 0.1 * i, 1.0e-10, cachedSolution )
+                     == solutionCacheHit );
+            REQUIRE( cachedSolution.departureVelocity[ 0 ] == i );
+        }
+    }
+
+    SECTION( "Test cleared cache" )
+    {
+        cache.clear( );
+        REQUIRE( cache.size( ) == 0 );
+        REQUIRE( cache.find( departurePosition, departureEpoch, arrivalPosition, timeOfFlight,
+                             1.0e-10, cachedSolution ) == solutionCacheMiss );
+        REQUIRE( cache.numberOfMisses( ) == 1 );
+    }
+}
+
+TEST_CASE( "Execute Atom solver using cache of converged solutions", "[atom-solver],[cache]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    AtomSolutionCache< Real, Vector3 > cache;
+    AtomSolver< Real, Vector3 > solver(
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, hybridsSolver, false, 0, &cache );
+
+    // Solve transfer, which is not cached yet.
+    int numberOfIterations = 0;
+    const Velocities velocities = solver.solve( departurePosition,
+                                                departureEpoch,
+                                                arrivalPosition,
+                                                timeOfFlight,
+                                                departureVelocityGuess,
+                                                numberOfIterations );
+    REQUIRE( numberOfIterations == 57 );
+    REQUIRE( cache.size( ) == 1 );
+    REQUIRE( cache.numberOfMisses( ) == 1 );
+
+    SECTION( "Test repeated transfer" )
+    {
+        Velocities cachedVelocities;
+        int cachedNumberOfIterations = -1;
+        NoSolverDiagnostics diagnostics;
+        REQUIRE( solver.trySolve( departurePosition,
+                                  departureEpoch,
+                                  arrivalPosition,
+                                  timeOfFlight,
+                                  departureVelocityGuess,
+                                  cachedVelocities,
+                                  diagnostics,
+                                  cachedNumberOfIterations ) == solverConverged );
+
+        // Check that converged solution is returned without executing solver.
+        REQUIRE( cachedNumberOfIterations == 0 );
+        REQUIRE( cache.numberOfHits( ) == 1 );
+        REQUIRE( solver.statistics( ).numberOfResidualEvaluations == 0 );
+        REQUIRE( solver.transfer( ).isAvailable );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( cachedVelocities.first[ i ] == velocities.first[ i ] );
+            REQUIRE( cachedVelocities.second[ i ] == velocities.second[ i ] );
+        }
+    }
+
+    SECTION( "Test shifted transfer" )
+    {
+        // Solve transfer with departure epoch shifted by a few seconds from scratch, using a
+        // solver without cache.
+        const DateTime shiftedEpoch = departureEpoch.AddSeconds( 5.0 );
+        AtomSolver< Real, Vector3 > coldSolver;
+        int coldNumberOfIterations = 0;
+        const Velocities coldVelocities = coldSolver.solve( departurePosition,
+                                                            shiftedEpoch,
+                                                            arrivalPosition,
+                                                            timeOfFlight,
+                                                            departureVelocityGuess,
+                                                            coldNumberOfIterations );
+
+        // Check that solver seeded with nearby converged transfer converges to the same solution
+        // in fewer iterations.
+        int seededNumberOfIterations = 0;
+        const Velocities seededVelocities = solver.solve( departurePosition,
+                                                          shiftedEpoch,
+                                                          arrivalPosition,
+                                                          timeOfFlight,
+                                                          departureVelocityGuess,
+                                                          seededNumberOfIterations );
+        REQUIRE( cache.numberOfSeeds( ) == 1 );
+        REQUIRE( seededNumberOfIterations < coldNumberOfIterations );
+        REQUIRE( cache.size( ) == 2 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( seededVelocities.first[ i ]
+                     == Approx( coldVelocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( seededVelocities.second[ i ]
+                     == Approx( coldVelocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -4,13 +4,19 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <cmath>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <catch.hpp>
 
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
 #include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
 
 #include "Atom/atom.hpp"
 
@@ -52,7 +58,7 @@ TEST_CASE( "Execute Atom solver", "[atom-solver]")
     // Set departure epoch.
     DateTime departureEpoch( 63548650522376360 );
 
-    // Time-of-flight [s].
+    // Time-of-flight [min].
     const Real timeOfFlight = 1000.0;
 
     SECTION( "Test case with no iterations" )
@@ -111,6 +117,287 @@ TEST_CASE( "Execute Atom solver", "[atom-solver]")
         // Check that no iterations are required.
         REQUIRE( numberOfIterations == 57 );
     }
+
+    SECTION( "Test arbitrary case with iteration trace" )
+    {
+        // Set initial guess for departure velocity [km/s].
+        Vector3 departureVelocityGuess( 3 );
+        departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+        departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+        departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+        // Execute Atom solver and record state of solver per iteration.
+        SolverIterationTrace< Real > trace;
+        int numberOfIterations = 0;
+        const Velocities velocities = executeAtomSolver( departurePosition,
+                                                         departureEpoch,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         departureVelocityGuess,
+                                                         trace,
+                                                         numberOfIterations );
+
+        // Check that departure velocity matches results.
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ] == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        // Check that one record is stored per iteration, including the initial guess.
+        REQUIRE( trace.records( ).size( )
+                 == static_cast< unsigned int >( numberOfIterations + 1 ) );
+        REQUIRE( trace.records( ).front( ).independentVariables[ 0 ]
+                 == Approx( departureVelocityGuess[ 0 ] ) );
+        REQUIRE( trace.status( ) == GSL_SUCCESS );
+    }
+
+    SECTION( "Test arbitrary case with two-body Jacobian" )
+    {
+        // Set initial guess for departure velocity [km/s].
+        Vector3 departureVelocityGuess( 3 );
+        departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+        departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+        departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+        // Execute Atom solver using solver that uses Jacobians approximated with two-body
+        // dynamics.
+        FinalSolverStatus status;
+        int numberOfIterations = 0;
+        const Velocities velocities = executeAtomSolver( departurePosition,
+                                                         departureEpoch,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         departureVelocityGuess,
+                                                         status,
+                                                         numberOfIterations,
+                                                         Tle( ),
+                                                         kMU,
+                                                         kXKMPER,
+                                                         1.0e-10,
+                                                         1.0e-5,
+                                                         100,
+                                                         hybridsjSolver );
+
+        // Check that departure and arrival velocities match results.
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ] == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( arrivalVelocity[ i ] == Approx( velocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        REQUIRE( status.solverStatus == GSL_SUCCESS );
+    }
+
+    SECTION( "Test arbitrary case with warm-started nested conversions" )
+    {
+        // Set initial guess for departure velocity [km/s].
+        Vector3 departureVelocityGuess( 3 );
+        departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+        departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+        departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+        // Execute Atom solver, warm-starting nested Cartesian-to-TLE conversions.
+        FinalSolverStatus status;
+        int numberOfIterations = 0;
+        const Velocities velocities = executeAtomSolver( departurePosition,
+                                                         departureEpoch,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         departureVelocityGuess,
+                                                         status,
+                                                         numberOfIterations,
+                                                         Tle( ),
+                                                         kMU,
+                                                         kXKMPER,
+                                                         1.0e-10,
+                                                         1.0e-5,
+                                                         100,
+                                                         hybridsSolver,
+                                                         true );
+
+        // Check that departure and arrival velocities match results.
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ] == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( arrivalVelocity[ i ] == Approx( velocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        REQUIRE( status.solverStatus == GSL_SUCCESS );
+    }
+}
+
+TEST_CASE( "Execute Atom solver using solver object", "[atom-solver]")
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set arrival velocity [km/s].
+    Vector3 arrivalVelocity( 3 );
+    arrivalVelocity[ 0 ] = -5.7447123573464;
+    arrivalVelocity[ 1 ] = 1.63941146365299;
+    arrivalVelocity[ 2 ] = -4.17792707643158;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set up solver, which is reused for all solves.
+    AtomSolver< Real, Vector3 > solver;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    // Execute solver repeatedly, alternating between exact and arbitrary initial guesses, and check
+    // that the results are the same as for the free functions.
+    for ( int run = 0; run < 2; run++ )
+    {
+        int numberOfIterations = 0;
+        const Velocities exactVelocities = solver.solve( departurePosition,
+                                                         departureEpoch,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         departureVelocity,
+                                                         numberOfIterations );
+        REQUIRE( numberOfIterations == 0 );
+
+        const Velocities velocities = solver.solve( departurePosition,
+                                                    departureEpoch,
+                                                    arrivalPosition,
+                                                    timeOfFlight,
+                                                    departureVelocityGuess,
+                                                    numberOfIterations );
+        REQUIRE( numberOfIterations == 57 );
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ]
+                     == Approx( exactVelocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( departureVelocity[ i ] == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( arrivalVelocity[ i ] == Approx( velocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        // Check that converged transfer matches returned arrival velocity and arrival position.
+        const AtomTransfer< Real, Vector3 >& transfer = solver.transfer( );
+        REQUIRE( transfer.isAvailable );
+        REQUIRE( transfer.arrivalState.Velocity( ).x == velocities.second[ 0 ] );
+        REQUIRE( transfer.arrivalState.Velocity( ).y == velocities.second[ 1 ] );
+        REQUIRE( transfer.arrivalState.Velocity( ).z == velocities.second[ 2 ] );
+        REQUIRE( transfer.arrivalState.Position( ).x
+                 == Approx( arrivalPosition[ 0 ] ).epsilon( 1.0e-6 ) );
+        REQUIRE( transfer.arrivalState.Position( ).y
+                 == Approx( arrivalPosition[ 1 ] ).epsilon( 1.0e-6 ) );
+        REQUIRE( transfer.arrivalState.Position( ).z
+                 == Approx( arrivalPosition[ 2 ] ).epsilon( 1.0e-6 ) );
+        REQUIRE( transfer.departureTle.Epoch( ).Ticks( ) == departureEpoch.Ticks( ) );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::fabs( transfer.finalResiduals[ i ] ) < 1.0e-6 );
+        }
+    }
+}
+
+TEST_CASE( "Compute Atom Jacobian using two-body dynamics", "[atom-solver]")
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km]. The partial derivatives do not depend on the arrival position.
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min], which is short enough for the perturbations modelled by SGP4/SDP4 to
+    // have a negligible effect on the partial derivatives.
+    const Real timeOfFlight = 10.0;
+
+    AtomParameters< Real, Vector3 > parameters( departurePosition,
+                                                departureEpoch,
+                                                arrivalPosition,
+                                                timeOfFlight,
+                                                kMU,
+                                                kXKMPER,
+                                                Tle( ),
+                                                1.0e-10,
+                                                1.0e-5,
+                                                100 );
+
+    gsl_vector* independentVariables = gsl_vector_alloc( 3 );
+    gsl_vector* forwardResiduals = gsl_vector_alloc( 3 );
+    gsl_vector* backwardResiduals = gsl_vector_alloc( 3 );
+    gsl_matrix* jacobian = gsl_matrix_alloc( 3, 3 );
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        gsl_vector_set( independentVariables, i, departureVelocity[ i ] );
+    }
+
+    REQUIRE( computeAtomJacobian< Real, Vector3 >( independentVariables, &parameters, jacobian )
+             == GSL_SUCCESS );
+
+    // Check two-body partial derivatives against central differences of full-fidelity residuals.
+    const Real velocityStep = 1.0e-4;
+    for ( int j = 0; j < 3; j++ )
+    {
+        gsl_vector_set( independentVariables, j, departureVelocity[ j ] + velocityStep );
+        REQUIRE( computeAtomResiduals< Real, Vector3 >(
+                    independentVariables, &parameters, forwardResiduals ) == GSL_SUCCESS );
+
+        gsl_vector_set( independentVariables, j, departureVelocity[ j ] - velocityStep );
+        REQUIRE( computeAtomResiduals< Real, Vector3 >(
+                    independentVariables, &parameters, backwardResiduals ) == GSL_SUCCESS );
+
+        gsl_vector_set( independentVariables, j, departureVelocity[ j ] );
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            const Real centralDifference
+                = ( gsl_vector_get( forwardResiduals, i ) - gsl_vector_get( backwardResiduals, i ) )
+                  / ( 2.0 * velocityStep );
+
+            // The scaled position changes by about the time-of-flight in seconds divided by the
+            // Earth mean radius per unit change in velocity.
+            REQUIRE( std::fabs( gsl_matrix_get( jacobian, i, j ) - centralDifference )
+                     < 1.0e-2 * timeOfFlight * 60.0 / kXKMPER );
+        }
+    }
+
+    gsl_vector_free( independentVariables );
+    gsl_vector_free( forwardResiduals );
+    gsl_vector_free( backwardResiduals );
+    gsl_matrix_free( jacobian );
 }
 
 } // namespace tests
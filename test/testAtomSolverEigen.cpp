@@ -53,7 +53,7 @@ TEST_CASE( "Execute Atom solver", "[atom-solver]")
     // Set departure epoch.
     const DateTime departureEpoch( 63548650522376360 );
 
-    // Time-of-flight [s].
+    // Time-of-flight [min].
     const Real timeOfFlight = 1000.0;
 
     SECTION( "Test case with no iterations" )
@@ -112,6 +112,39 @@ TEST_CASE( "Execute Atom solver", "[atom-solver]")
         // Check that no iterations are required.
         REQUIRE( numberOfIterations == 57 );
     }
+
+    SECTION( "Test arbitrary case with iteration trace" )
+    {
+        // Set initial guess for departure velocity [km/s].
+        Vector3 departureVelocityGuess;
+        departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+        departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+        departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+        // Execute Atom solver and record state of solver per iteration.
+        SolverIterationTrace< Real > trace;
+        int numberOfIterations = 0;
+        const Velocities velocities = executeAtomSolver( departurePosition,
+                                                         departureEpoch,
+                                                         arrivalPosition,
+                                                         timeOfFlight,
+                                                         departureVelocityGuess,
+                                                         trace,
+                                                         numberOfIterations );
+
+        // Check that departure velocity matches results.
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ] == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        // Check that one record is stored per iteration, including the initial guess.
+        REQUIRE( trace.records( ).size( )
+                 == static_cast< unsigned int >( numberOfIterations + 1 ) );
+        REQUIRE( trace.records( ).front( ).independentVariables[ 0 ]
+                 == Approx( departureVelocityGuess[ 0 ] ) );
+        REQUIRE( trace.status( ) == GSL_SUCCESS );
+    }
 }
 
 } // namespace tests
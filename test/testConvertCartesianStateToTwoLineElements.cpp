@@ -9,11 +9,16 @@
 
 #include <catch.hpp>
 
+#include <gsl/gsl_vector.h>
+
 #include <libsgp4/DateTime.h>
 #include <libsgp4/Eci.h>
+#include <libsgp4/Globals.h>
 #include <libsgp4/SGP4.h>
 #include <libsgp4/Tle.h>
 
+#include <Astro/astro.hpp>
+
 #include "Atom/convertCartesianStateToTwoLineElements.hpp"
 
 namespace atom
@@ -35,9 +40,69 @@ TEST_CASE( "Convert Cartesian state to Two-Line-Elements", "[cartesian-to-TLE]")
     cartesianState[ 4 ] = -5.5;
     cartesianState[ 5 ] = 5.5;
 
-    // Convert Cartesian state to TLE. Note that the epoch is arbitrary.
-    Tle convertedTle = convertCartesianStateToTwoLineElements< Real, Vector6 >(
-        cartesianState, DateTime( ) );
+    Tle convertedTle;
+
+    SECTION( "Test conversion with finite-difference Jacobian" )
+    {
+        // Convert Cartesian state to TLE. Note that the epoch is arbitrary.
+        convertedTle = convertCartesianStateToTwoLineElements< Real, Vector6 >(
+            cartesianState, DateTime( ) );
+    }
+
+    SECTION( "Test conversion with two-body Jacobian" )
+    {
+        // Convert Cartesian state to TLE using solver that uses Jacobian approximated with
+        // two-body dynamics. Note that the epoch is arbitrary.
+        NoSolverDiagnostics diagnostics;
+        int numberOfIterations = 0;
+        convertedTle = convertCartesianStateToTwoLineElements< Real, Vector6 >(
+            cartesianState,
+            DateTime( ),
+            diagnostics,
+            numberOfIterations,
+            Tle( ),
+            kMU,
+            kXKMPER,
+            1.0e-10,
+            1.0e-5,
+            100,
+            hybridsjSolver );
+    }
+
+    SECTION( "Test repeated conversions using converter object" )
+    {
+        // Set up converter, which is reused for all conversions.
+        TleFitter< Real, Vector6 > fitter;
+
+        Vector6 perturbedCartesianState = cartesianState;
+        perturbedCartesianState[ 0 ] += 1.0;
+        perturbedCartesianState[ 4 ] -= 1.0e-3;
+
+        fitter.solve( perturbedCartesianState, DateTime( ) );
+        convertedTle = fitter.solve( cartesianState, DateTime( ) );
+    }
+
+    SECTION( "Test conversion warm-started by previous conversion" )
+    {
+        // Convert slightly perturbed Cartesian state to TLE to set up warm-start state.
+        Vector6 perturbedCartesianState = cartesianState;
+        perturbedCartesianState[ 0 ] += 1.0;
+        perturbedCartesianState[ 4 ] -= 1.0e-3;
+
+        SolverWorkspace workspace( 6 );
+        TleFitWarmStart< Real > warmStart;
+        NoSolverDiagnostics diagnostics;
+        int numberOfIterations = 0;
+        convertCartesianStateToTwoLineElements< Real, Vector6 >(
+            perturbedCartesianState, DateTime( ), workspace, warmStart, diagnostics,
+            numberOfIterations );
+
+        REQUIRE( warmStart.hasElementOffsets );
+
+        // Convert Cartesian state to TLE, warm-started by previous conversion.
+        convertedTle = convertCartesianStateToTwoLineElements< Real, Vector6 >(
+            cartesianState, DateTime( ), workspace, warmStart, diagnostics, numberOfIterations );
+    }
 
     // Propagate the converted TLE to the epoch of the TLE. This generates a Cartesian state.
     SGP4 sgp4( convertedTle );
@@ -58,5 +123,34 @@ TEST_CASE( "Convert Cartesian state to Two-Line-Elements", "[cartesian-to-TLE]")
              == Approx( cartesianState[ 5 ] ).epsilon( 1.0e-8 ) );
 }
 
+TEST_CASE( "Update TLE mean elements in place", "[cartesian-to-TLE]" )
+{
+    // Set Keplerian elements [km, -, rad, rad, rad, rad].
+    gsl_vector* keplerianElements = gsl_vector_alloc( 6 );
+    gsl_vector_set( keplerianElements, astro::semiMajorAxisIndex, 7.8e3 );
+    gsl_vector_set( keplerianElements, astro::eccentricityIndex, 0.05 );
+    gsl_vector_set( keplerianElements, astro::inclinationIndex, 0.9 );
+    gsl_vector_set( keplerianElements, astro::argumentOfPeriapsisIndex, 1.2 );
+    gsl_vector_set( keplerianElements, astro::longitudeOfAscendingNodeIndex, 2.3 );
+    gsl_vector_set( keplerianElements, astro::trueAnomalyIndex, 0.7 );
+
+    Tle tle;
+    updateTleMeanElements( keplerianElements, kMU, tle );
+    gsl_vector_free( keplerianElements );
+
+    // Check mean elements stored in TLE [deg, -, rev/day].
+    REQUIRE( tle.Inclination( true ) == Approx( 51.5662015618 ).epsilon( 1.0e-10 ) );
+    REQUIRE( tle.RightAscendingNode( true ) == Approx( 131.780292880 ).epsilon( 1.0e-10 ) );
+    REQUIRE( tle.Eccentricity( ) == Approx( 0.05 ).epsilon( 1.0e-12 ) );
+    REQUIRE( tle.ArgumentPerigee( true ) == Approx( 68.7549354157 ).epsilon( 1.0e-10 ) );
+    REQUIRE( tle.MeanAnomaly( true ) == Approx( 36.5198173331 ).epsilon( 1.0e-10 ) );
+    REQUIRE( tle.MeanMotion( ) == Approx( 12.6026261426 ).epsilon( 1.0e-10 ) );
+
+    // Check that angles read back in radians match the Keplerian elements.
+    REQUIRE( tle.Inclination( false ) == Approx( 0.9 ) );
+    REQUIRE( tle.RightAscendingNode( false ) == Approx( 2.3 ) );
+    REQUIRE( tle.ArgumentPerigee( false ) == Approx( 1.2 ) );
+}
+
 } // namespace tests
 } // namespace atom
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/convertCartesianStatesToTwoLineElements.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector6;
+
+TEST_CASE( "Write TLE lines to record", "[cartesian-to-TLE],[bulk]" )
+{
+    // Set TLE of the International Space Station.
+    const std::string line1
+        = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+    const std::string line2
+        = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+    const Tle tle( "ISS (ZARYA)", line1, line2 );
+
+    std::vector< char > record( kTwoLineElementsRecordSize );
+    REQUIRE( writeTwoLineElements( tle, &record[ 0 ], 'U', 292 ) );
+
+    REQUIRE( std::string( &record[ 0 ], 69 ) == line1 );
+    REQUIRE( record[ 69 ] == '\n' );
+    REQUIRE( std::string( &record[ 70 ], 69 ) == line2 );
+    REQUIRE( record[ 139 ] == '\n' );
+
+    // Check that record can be parsed again.
+    const Tle parsedTle( std::string( &record[ 0 ], 69 ), std::string( &record[ 70 ], 69 ) );
+    REQUIRE( parsedTle.MeanMotion( ) == Approx( tle.MeanMotion( ) ) );
+    REQUIRE( parsedTle.BStar( ) == Approx( tle.BStar( ) ) );
+}
+
+TEST_CASE( "Convert Cartesian states to TLEs in bulk", "[cartesian-to-TLE],[bulk]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector6 cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    // Set up stream of states, rotating target state about the z-axis per state.
+    const std::size_t numberOfStates = 100;
+    std::vector< Real > cartesianStates( 6 * numberOfStates );
+    std::vector< DateTime > epochs;
+    for ( std::size_t i = 0; i < numberOfStates; i++ )
+    {
+        const Real angle = 1.0e-3 * i;
+        for ( int j = 0; j < 6; j += 3 )
+        {
+            cartesianStates[ 6 * i + j ] = std::cos( angle ) * cartesianState[ j ]
+                                           - std::sin( angle ) * cartesianState[ j + 1 ];
+            cartesianStates[ 6 * i + j + 1 ] = std::sin( angle ) * cartesianState[ j ]
+                                               + std::cos( angle ) * cartesianState[ j + 1 ];
+            cartesianStates[ 6 * i + j + 2 ] = cartesianState[ j + 2 ];
+        }
+        epochs.push_back( DateTime( 63548650522376360 ).AddMinutes( static_cast< double >( i ) ) );
+    }
+
+    std::vector< char > records( numberOfStates * kTwoLineElementsRecordSize );
+    std::vector< SolverStatus > statuses( numberOfStates, solverStuck );
+    std::vector< int > numberOfIterations( numberOfStates, -1 );
+
+    convertCartesianStatesToTwoLineElements( &cartesianStates[ 0 ],
+                                             &epochs[ 0 ],
+                                             numberOfStates,
+                                             &records[ 0 ],
+                                             &statuses[ 0 ],
+                                             3,
+                                             Tle( ),
+                                             kMU,
+                                             kXKMPER,
+                                             1.0e-10,
+                                             1.0e-5,
+                                             100,
+                                             hybridsSolver,
+                                             false,
+                                             &numberOfIterations[ 0 ] );
+
+    // Check that records are stored in the same order as the states and match single conversions.
+    for ( std::size_t i = 0; i < numberOfStates; i += 33 )
+    {
+        const Vector6 state( cartesianStates.begin( ) + 6 * i,
+                             cartesianStates.begin( ) + 6 * i + 6 );
+        int iterations = 0;
+        std::string dummyString = "";
+        const Tle tle = convertCartesianStateToTwoLineElements< Real >(
+            state, epochs[ i ], dummyString, iterations );
+
+        std::vector< char > record( kTwoLineElementsRecordSize );
+        writeTwoLineElements( tle, &record[ 0 ] );
+
+        REQUIRE( statuses[ i ] == solverConverged );
+        REQUIRE( numberOfIterations[ i ] == iterations );
+        REQUIRE( std::string( &records[ i * kTwoLineElementsRecordSize ],
+                              kTwoLineElementsRecordSize )
+                 == std::string( &record[ 0 ], kTwoLineElementsRecordSize ) );
+    }
+}
+
+} // namespace tests
+} // namespace atom
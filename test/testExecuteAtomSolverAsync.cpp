@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+
+#include "Atom/executeAtomSolverAsync.hpp"
+#include "Atom/executeAtomSolverBatch.hpp"
+#include "Atom/solverCancellation.hpp"
+#include "Atom/solverStatus.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef AtomProblem< Real, Vector3 > Problem;
+typedef AtomSolution< Real, Vector3 > Solution;
+
+TEST_CASE( "Execute Atom solver asynchronously", "[atom-solver-async],[cancellation]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set arrival velocity [km/s].
+    Vector3 arrivalVelocity( 3 );
+    arrivalVelocity[ 0 ] = -5.7447123573464;
+    arrivalVelocity[ 1 ] = 1.63941146365299;
+    arrivalVelocity[ 2 ] = -4.17792707643158;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    const Problem problem( departurePosition,
+                           departureEpoch,
+                           arrivalPosition,
+                           timeOfFlight,
+                           departureVelocityGuess );
+
+    SECTION( "Test solve without cancellation token" )
+    {
+        std::future< Solution > future = executeAtomSolverAsync( problem );
+        const Solution solution = future.get( );
+
+        // Check that results are the same as for the blocking solver.
+        REQUIRE( solution.status == solverConverged );
+        REQUIRE( solution.solverStatus == GSL_SUCCESS );
+        REQUIRE( solution.numberOfIterations == 57 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ]
+                     == Approx( solution.departureVelocity[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( arrivalVelocity[ i ]
+                     == Approx( solution.arrivalVelocity[ i ] ).epsilon( 1.0e-6 ) );
+        }
+    }
+
+    SECTION( "Test solve with deadline that is not reached" )
+    {
+        SolverCancellation cancellation;
+        cancellation.setTimeout( std::chrono::hours( 1 ) );
+        std::future< Solution > future = executeAtomSolverAsync( problem, &cancellation );
+        const Solution solution = future.get( );
+
+        REQUIRE( solution.status == solverConverged );
+        REQUIRE( solution.numberOfIterations == 57 );
+    }
+
+    SECTION( "Test solve that is cancelled before it starts" )
+    {
+        SolverCancellation cancellation;
+        cancellation.cancel( );
+        std::future< Solution > future = executeAtomSolverAsync( problem, &cancellation );
+        const Solution solution = future.get( );
+
+        // Check that initial guess is returned as best iterate, without arrival velocity.
+        REQUIRE( solution.status == solverCancelled );
+        REQUIRE( solution.numberOfIterations == 0 );
+        REQUIRE( !solution.transfer.isAvailable );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( solution.departureVelocity[ i ] == departureVelocityGuess[ i ] );
+            REQUIRE( std::isnan( solution.arrivalVelocity[ i ] ) );
+        }
+    }
+
+    SECTION( "Test solve with expired deadline" )
+    {
+        const SolverCancellation cancellation(
+            SolverCancellation::Clock::now( ) - std::chrono::seconds( 1 ) );
+        std::future< Solution > future = executeAtomSolverAsync( problem, &cancellation );
+
+        REQUIRE( future.get( ).status == solverCancelled );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+
+#include "Atom/executeAtomSolverBatch.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef AtomProblem< Real, Vector3 > Problem;
+typedef AtomSolution< Real, Vector3 > Solution;
+
+TEST_CASE( "Execute Atom solver for batch of problems", "[atom-solver-batch]")
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set arrival velocity [km/s].
+    Vector3 arrivalVelocity( 3 );
+    arrivalVelocity[ 0 ] = -5.7447123573464;
+    arrivalVelocity[ 1 ] = 1.63941146365299;
+    arrivalVelocity[ 2 ] = -4.17792707643158;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    // Set up batch, alternating between exact and arbitrary initial guess.
+    std::vector< Problem > problems;
+    for ( int i = 0; i < 4; i++ )
+    {
+        problems.push_back( Problem( departurePosition,
+                                     departureEpoch,
+                                     arrivalPosition,
+                                     timeOfFlight,
+                                     ( i % 2 == 0 ) ? departureVelocity
+                                                    : departureVelocityGuess ) );
+    }
+
+    SECTION( "Test batch solved with multiple threads" )
+    {
+        const std::vector< Solution > solutions = executeAtomSolverBatch( problems, 3 );
+
+        REQUIRE( solutions.size( ) == problems.size( ) );
+
+        for ( unsigned int j = 0; j < solutions.size( ); j++ )
+        {
+            // Check that departure and arrival velocities match results.
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( departureVelocity[ i ]
+                         == Approx( solutions[ j ].departureVelocity[ i ] ).epsilon( 1.0e-6 ) );
+                REQUIRE( arrivalVelocity[ i ]
+                         == Approx( solutions[ j ].arrivalVelocity[ i ] ).epsilon( 1.0e-6 ) );
+            }
+
+            // Check that solutions are stored in the same order as the problems.
+            REQUIRE( solutions[ j ].numberOfIterations == ( ( j % 2 == 0 ) ? 0 : 57 ) );
+            REQUIRE( solutions[ j ].solverStatus == GSL_SUCCESS );
+            REQUIRE( solutions[ j ].status == solverConverged );
+        }
+    }
+
+    SECTION( "Test empty batch" )
+    {
+        const std::vector< Solution > solutions
+            = executeAtomSolverBatch( std::vector< Problem >( ) );
+
+        REQUIRE( solutions.empty( ) );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/executeAtomSolverFastPath.hpp"
+#include "Atom/twoBodyFunctions.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+
+TEST_CASE( "Execute Atom solver using analytic fast path", "[atom-solver-fast-path]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set arrival velocity [km/s].
+    Vector3 arrivalVelocity( 3 );
+    arrivalVelocity[ 0 ] = -5.7447123573464;
+    arrivalVelocity[ 1 ] = 1.63941146365299;
+    arrivalVelocity[ 2 ] = -4.17792707643158;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    SECTION( "Test J2-secular propagation model" )
+    {
+        int numberOfIterations = 0;
+        int numberOfAnalyticIterations = -1;
+        SolverStatus analyticStatus = solverConverged;
+        const std::pair< Vector3, Vector3 > velocities
+            = executeAtomSolverFastPath( departurePosition,
+                                         departureEpoch,
+                                         arrivalPosition,
+                                         timeOfFlight,
+                                         departureVelocityGuess,
+                                         numberOfIterations,
+                                         Tle( ),
+                                         kMU,
+                                         kXKMPER,
+                                         1.0e-10,
+                                         1.0e-5,
+                                         100,
+                                         hybridsSolver,
+                                         j2SecularPropagationModel,
+                                         &analyticStatus,
+                                         &numberOfAnalyticIterations );
+
+        REQUIRE( numberOfIterations > 0 );
+        REQUIRE( numberOfAnalyticIterations >= 0 );
+
+        // Check that velocities match results of Atom solver, since the full-fidelity stage is
+        // repeated from the given initial guess if it fails from the analytic solution.
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( departureVelocity[ i ]
+                     == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( arrivalVelocity[ i ]
+                     == Approx( velocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+    }
+
+    SECTION( "Test full-fidelity stage started from analytic solution" )
+    {
+        // Compute arrival position for short transfer using J2-secular propagation model, such
+        // that the analytic stage converges close to the solution of the full system.
+        const Real shortTimeOfFlight = 100.0;
+        Real arrivalState[ 6 ];
+        propagateJ2SecularState( departurePosition, departureVelocity, shortTimeOfFlight * 60.0,
+                                 kMU, kXKMPER, kXJ2, arrivalState, arrivalState + 3 );
+        const Vector3 shortArrivalPosition( arrivalState, arrivalState + 3 );
+
+        int numberOfIterations = 0;
+        SolverStatus analyticStatus = solverMaximumIterationsReached;
+        bool isAnalyticSolutionUsed = false;
+        const std::pair< Vector3, Vector3 > velocities
+            = executeAtomSolverFastPath( departurePosition,
+                                         departureEpoch,
+                                         shortArrivalPosition,
+                                         shortTimeOfFlight,
+                                         departureVelocityGuess,
+                                         numberOfIterations,
+                                         Tle( ),
+                                         kMU,
+                                         kXKMPER,
+                                         1.0e-10,
+                                         1.0e-5,
+                                         100,
+                                         hybridsSolver,
+                                         j2SecularPropagationModel,
+                                         &analyticStatus,
+                                         static_cast< int* >( 0 ),
+                                         &isAnalyticSolutionUsed );
+
+        REQUIRE( analyticStatus == solverConverged );
+        REQUIRE( isAnalyticSolutionUsed );
+
+        // Execute Atom solver from given initial guess.
+        int numberOfAtomIterations = 0;
+        std::string dummyString = "";
+        const std::pair< Vector3, Vector3 > atomVelocities
+            = executeAtomSolver( departurePosition,
+                                 departureEpoch,
+                                 shortArrivalPosition,
+                                 shortTimeOfFlight,
+                                 departureVelocityGuess,
+                                 dummyString,
+                                 numberOfAtomIterations );
+
+        // Check that full-fidelity stage needs fewer iterations than Atom solver and that
+        // velocities match.
+        REQUIRE( numberOfIterations > 0 );
+        REQUIRE( numberOfIterations < numberOfAtomIterations );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( atomVelocities.first[ i ]
+                     == Approx( velocities.first[ i ] ).epsilon( 1.0e-6 ) );
+            REQUIRE( atomVelocities.second[ i ]
+                     == Approx( velocities.second[ i ] ).epsilon( 1.0e-6 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/executeAtomSolverMultiGuess.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef AtomSolution< Real, Vector3 > Solution;
+
+TEST_CASE( "Generate initial guesses for departure velocity", "[atom-solver-multi-guess]" )
+{
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 3.0;
+    departureVelocityGuess[ 1 ] = 0.0;
+    departureVelocityGuess[ 2 ] = 4.0;
+
+    const std::vector< Vector3 > guesses
+        = generateDepartureVelocityGuesses( departureVelocityGuess, 8, 0.1 );
+
+    // Check that base guess, perturbed variants and retrograde variant are generated in order.
+    REQUIRE( guesses.size( ) == 10 );
+    REQUIRE( guesses[ 0 ] == departureVelocityGuess );
+    REQUIRE( guesses[ 1 ][ 0 ] == Approx( 3.5 ) );
+    REQUIRE( guesses[ 2 ][ 0 ] == Approx( 2.5 ) );
+    REQUIRE( guesses[ 3 ][ 1 ] == Approx( 0.5 ) );
+    REQUIRE( guesses[ 6 ][ 2 ] == Approx( 3.5 ) );
+    REQUIRE( guesses[ 7 ][ 0 ] == Approx( 4.0 ) );
+    REQUIRE( guesses[ 8 ][ 0 ] == Approx( 2.0 ) );
+    REQUIRE( guesses[ 9 ][ 0 ] == Approx( -3.0 ) );
+    REQUIRE( guesses[ 9 ][ 2 ] == Approx( -4.0 ) );
+}
+
+TEST_CASE( "Execute Atom solver for multiple initial guesses", "[atom-solver-multi-guess]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    // Set guesses, starting with arbitrary guess, which requires 57 iterations to converge.
+    std::vector< Vector3 > guesses;
+    guesses.push_back( departureVelocityGuess );
+    guesses.push_back( departureVelocity );
+
+    SECTION( "Test selection of first converged guess" )
+    {
+        std::size_t selectedGuess = 0;
+        const Solution solution = executeAtomSolverMultiGuess( departurePosition,
+                                                               departureEpoch,
+                                                               arrivalPosition,
+                                                               timeOfFlight,
+                                                               guesses,
+                                                               selectedGuess,
+                                                               firstConvergedGuess,
+                                                               2 );
+
+        REQUIRE( selectedGuess == 0 );
+        REQUIRE( solution.status == solverConverged );
+        REQUIRE( solution.solverStatus == GSL_SUCCESS );
+        REQUIRE( solution.numberOfIterations == 57 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( solution.departureVelocity[ i ]
+                     == Approx( departureVelocity[ i ] ).epsilon( 1.0e-6 ) );
+        }
+    }
+
+    SECTION( "Test selection of converged guess if other guesses do not converge" )
+    {
+        // Limit number of iterations, such that the arbitrary guess does not converge.
+        for ( int j = 0; j < 2; j++ )
+        {
+            std::size_t selectedGuess = 0;
+            const Solution solution
+                = executeAtomSolverMultiGuess( departurePosition,
+                                               departureEpoch,
+                                               arrivalPosition,
+                                               timeOfFlight,
+                                               guesses,
+                                               selectedGuess,
+                                               ( j == 0 ) ? firstConvergedGuess
+                                                          : bestConvergedGuess,
+                                               2,
+                                               Tle( ),
+                                               kMU,
+                                               kXKMPER,
+                                               1.0e-10,
+                                               1.0e-5,
+                                               5 );
+
+            REQUIRE( selectedGuess == 1 );
+            REQUIRE( solution.status == solverConverged );
+            REQUIRE( solution.numberOfIterations == 0 );
+        }
+    }
+
+    SECTION( "Test early stop after first converged guess" )
+    {
+        // Solve guesses serially in reverse order: the exact guess converges first, such that the
+        // arbitrary guess is not solved.
+        std::vector< Vector3 > reversedGuesses( guesses.rbegin( ), guesses.rend( ) );
+        std::size_t selectedGuess = 0;
+        const Solution solution = executeAtomSolverMultiGuess( departurePosition,
+                                                               departureEpoch,
+                                                               arrivalPosition,
+                                                               timeOfFlight,
+                                                               reversedGuesses,
+                                                               selectedGuess,
+                                                               firstConvergedGuess,
+                                                               1 );
+
+        REQUIRE( selectedGuess == 0 );
+        REQUIRE( solution.numberOfIterations == 0 );
+    }
+
+    SECTION( "Test empty set of guesses" )
+    {
+        std::size_t selectedGuess = 1;
+        executeAtomSolverMultiGuess( departurePosition,
+                                     departureEpoch,
+                                     arrivalPosition,
+                                     timeOfFlight,
+                                     std::vector< Vector3 >( ),
+                                     selectedGuess );
+
+        REQUIRE( selectedGuess == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace atom
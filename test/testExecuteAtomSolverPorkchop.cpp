@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/executeAtomSolverPorkchop.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef AtomPorkchopPoint< Real, Vector3 > Point;
+
+TEST_CASE( "Execute Atom solver for porkchop grid", "[atom-solver-porkchop]" )
+{
+    // Set TLE of the International Space Station as departure object.
+    const Tle departureTle(
+        "ISS (ZARYA)",
+        "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+        "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537" );
+
+    // Set arrival object, leading the departure object by 10 degrees in mean anomaly.
+    Tle arrivalTle( departureTle );
+    arrivalTle.updateMeanElements( departureTle.Inclination( true ),
+                                   departureTle.RightAscendingNode( true ),
+                                   departureTle.Eccentricity( ),
+                                   departureTle.ArgumentPerigee( true ),
+                                   departureTle.MeanAnomaly( true ) + 10.0,
+                                   departureTle.MeanMotion( ) );
+
+    // Set departure epochs and times-of-flight [min].
+    std::vector< DateTime > departureEpochs;
+    departureEpochs.push_back( departureTle.Epoch( ) );
+    departureEpochs.push_back( departureTle.Epoch( ).AddMinutes( 5.0 ) );
+
+    std::vector< Real > timesOfFlight;
+    timesOfFlight.push_back( 60.0 );
+    timesOfFlight.push_back( 62.0 );
+    timesOfFlight.push_back( 64.0 );
+
+    SECTION( "Test grid swept with continuation" )
+    {
+        const std::vector< Point > points = executeAtomSolverPorkchop< Real, Vector3 >(
+            departureTle, arrivalTle, departureEpochs, timesOfFlight, 2 );
+        const std::vector< Point > pointsWithoutContinuation
+            = executeAtomSolverPorkchop< Real, Vector3 >(
+                departureTle, arrivalTle, departureEpochs, timesOfFlight, 1, false );
+
+        REQUIRE( points.size( ) == departureEpochs.size( ) * timesOfFlight.size( ) );
+        REQUIRE( pointsWithoutContinuation.size( ) == points.size( ) );
+
+        for ( unsigned int j = 0; j < points.size( ); j++ )
+        {
+            REQUIRE( points[ j ].solution.solverStatus == GSL_SUCCESS );
+            REQUIRE( points[ j ].solution.status == solverConverged );
+            REQUIRE( pointsWithoutContinuation[ j ].solution.status == solverConverged );
+
+            // Check that continuation converges to the same transfers, stored in row-major order.
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( points[ j ].solution.departureVelocity[ i ]
+                         == Approx( pointsWithoutContinuation[ j ].solution.departureVelocity[ i ] )
+                            .epsilon( 1.0e-6 ) );
+                REQUIRE( points[ j ].solution.arrivalVelocity[ i ]
+                         == Approx( pointsWithoutContinuation[ j ].solution.arrivalVelocity[ i ] )
+                            .epsilon( 1.0e-6 ) );
+            }
+
+            REQUIRE( points[ j ].departureDeltaV
+                     == Approx( pointsWithoutContinuation[ j ].departureDeltaV )
+                        .epsilon( 1.0e-6 ) );
+            REQUIRE( points[ j ].arrivalDeltaV
+                     == Approx( pointsWithoutContinuation[ j ].arrivalDeltaV ).epsilon( 1.0e-6 ) );
+            REQUIRE( points[ j ].totalDeltaV( )
+                     == Approx( points[ j ].departureDeltaV + points[ j ].arrivalDeltaV ) );
+        }
+    }
+
+    SECTION( "Test grid with invalid arrival TLE" )
+    {
+        // Set eccentricity of arrival object outside range accepted by SGP4/SDP4 propagator.
+        Tle invalidArrivalTle( departureTle );
+        invalidArrivalTle.updateMeanElements( departureTle.Inclination( true ),
+                                              departureTle.RightAscendingNode( true ),
+                                              0.9995,
+                                              departureTle.ArgumentPerigee( true ),
+                                              departureTle.MeanAnomaly( true ),
+                                              departureTle.MeanMotion( ) );
+
+        // Set changes in velocity of points, which must be reset by the sweep.
+        std::vector< Point > points( departureEpochs.size( ) * timesOfFlight.size( ) );
+        for ( unsigned int j = 0; j < points.size( ); j++ )
+        {
+            points[ j ].departureDeltaV = 1.0;
+            points[ j ].arrivalDeltaV = 1.0;
+        }
+
+        executeAtomSolverPorkchop( departureTle,
+                                   invalidArrivalTle,
+                                   &departureEpochs[ 0 ],
+                                   departureEpochs.size( ),
+                                   &timesOfFlight[ 0 ],
+                                   timesOfFlight.size( ),
+                                   &points[ 0 ],
+                                   2 );
+
+        for ( unsigned int j = 0; j < points.size( ); j++ )
+        {
+            REQUIRE( points[ j ].solution.status == solverPropagationFailed );
+            REQUIRE( points[ j ].solution.solverStatus == GSL_EFAILED );
+            REQUIRE( std::isnan( points[ j ].departureDeltaV ) );
+            REQUIRE( std::isnan( points[ j ].arrivalDeltaV ) );
+        }
+    }
+
+    SECTION( "Test grid swept again with invalid arrival TLE" )
+    {
+        // Sweep grid, such that all points converge.
+        std::vector< Point > points( departureEpochs.size( ) * timesOfFlight.size( ) );
+        executeAtomSolverPorkchop( departureTle,
+                                   arrivalTle,
+                                   &departureEpochs[ 0 ],
+                                   departureEpochs.size( ),
+                                   &timesOfFlight[ 0 ],
+                                   timesOfFlight.size( ),
+                                   &points[ 0 ],
+                                   2 );
+
+        for ( unsigned int j = 0; j < points.size( ); j++ )
+        {
+            REQUIRE( points[ j ].solution.status == solverConverged );
+        }
+
+        // Sweep same grid again with arrival object that cannot be propagated.
+        Tle invalidArrivalTle( departureTle );
+        invalidArrivalTle.updateMeanElements( departureTle.Inclination( true ),
+                                              departureTle.RightAscendingNode( true ),
+                                              0.9995,
+                                              departureTle.ArgumentPerigee( true ),
+                                              departureTle.MeanAnomaly( true ),
+                                              departureTle.MeanMotion( ) );
+
+        executeAtomSolverPorkchop( departureTle,
+                                   invalidArrivalTle,
+                                   &departureEpochs[ 0 ],
+                                   departureEpochs.size( ),
+                                   &timesOfFlight[ 0 ],
+                                   timesOfFlight.size( ),
+                                   &points[ 0 ],
+                                   2 );
+
+        // Check that velocities and changes in velocity of previous sweep are not kept.
+        for ( unsigned int j = 0; j < points.size( ); j++ )
+        {
+            REQUIRE( points[ j ].solution.status == solverPropagationFailed );
+            REQUIRE( points[ j ].solution.numberOfIterations == 0 );
+            REQUIRE( std::isnan( points[ j ].departureDeltaV ) );
+            REQUIRE( std::isnan( points[ j ].arrivalDeltaV ) );
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( std::isnan( points[ j ].solution.departureVelocity[ i ] ) );
+                REQUIRE( std::isnan( points[ j ].solution.arrivalVelocity[ i ] ) );
+            }
+        }
+    }
+
+    SECTION( "Test empty grid" )
+    {
+        const std::vector< Point > points = executeAtomSolverPorkchop< Real, Vector3 >(
+            departureTle, arrivalTle, departureEpochs, std::vector< Real >( ) );
+
+        REQUIRE( points.empty( ) );
+    }
+
+    SECTION( "Test default point" )
+    {
+        const Point point;
+
+        REQUIRE( std::isnan( point.departureDeltaV ) );
+        REQUIRE( std::isnan( point.arrivalDeltaV ) );
+        REQUIRE( std::isnan( point.totalDeltaV( ) ) );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/executeAtomSolverTwoStage.hpp"
+#include "Atom/tleConversionCache.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef AtomProblem< Real, Vector3 > Problem;
+typedef AtomSolution< Real, Vector3 > Solution;
+
+//! Candidate predicate that rejects all coarse solutions.
+struct RejectAtomSolutions
+{
+public:
+
+    bool operator( )( const Problem&, const Solution& ) const
+    {
+        return false;
+    }
+
+protected:
+
+private:
+};
+
+TEST_CASE( "Execute Atom solver for batch of problems in two stages", "[atom-solver-two-stage]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set departure velocity [km/s].
+    Vector3 departureVelocity( 3 );
+    departureVelocity[ 0 ] = 6.44661660560979;
+    departureVelocity[ 1 ] = -1.14788435945363;
+    departureVelocity[ 2 ] = 3.44659369332744;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set arrival velocity [km/s].
+    Vector3 arrivalVelocity( 3 );
+    arrivalVelocity[ 0 ] = -5.7447123573464;
+    arrivalVelocity[ 1 ] = 1.63941146365299;
+    arrivalVelocity[ 2 ] = -4.17792707643158;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector3 departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = departureVelocity[ 0 ] + 0.013;
+    departureVelocityGuess[ 1 ] = departureVelocity[ 1 ] - 0.074;
+    departureVelocityGuess[ 2 ] = departureVelocity[ 2 ] + 0.026;
+
+    std::vector< Problem > problems;
+    for ( int i = 0; i < 3; i++ )
+    {
+        problems.push_back( Problem( departurePosition,
+                                     departureEpoch,
+                                     arrivalPosition,
+                                     timeOfFlight,
+                                     departureVelocityGuess ) );
+    }
+
+    SECTION( "Test batch refined after coarse stage" )
+    {
+        std::vector< Solution > solutions( problems.size( ) );
+        const std::size_t numberOfRefinedSolutions = executeAtomSolverTwoStage(
+            &problems[ 0 ], problems.size( ), &solutions[ 0 ],
+            AcceptConvergedAtomSolutions< Real, Vector3 >( ), 2 );
+
+        REQUIRE( numberOfRefinedSolutions == problems.size( ) );
+
+        for ( unsigned int j = 0; j < solutions.size( ); j++ )
+        {
+            REQUIRE( solutions[ j ].isRefined );
+            REQUIRE( solutions[ j ].solverStatus == GSL_SUCCESS );
+            REQUIRE( solutions[ j ].status == solverConverged );
+            REQUIRE( solutions[ j ].numberOfIterations > 0 );
+
+            // Check that refined velocities match results of single-stage solver.
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( departureVelocity[ i ]
+                         == Approx( solutions[ j ].departureVelocity[ i ] ).epsilon( 1.0e-6 ) );
+                REQUIRE( arrivalVelocity[ i ]
+                         == Approx( solutions[ j ].arrivalVelocity[ i ] ).epsilon( 1.0e-6 ) );
+            }
+        }
+    }
+
+    SECTION( "Test batch screened without refinement" )
+    {
+        const std::vector< Solution > solutions
+            = executeAtomSolverTwoStage( problems, RejectAtomSolutions( ), 2 );
+
+        REQUIRE( solutions.size( ) == problems.size( ) );
+
+        for ( unsigned int j = 0; j < solutions.size( ); j++ )
+        {
+            REQUIRE( !solutions[ j ].isRefined );
+            REQUIRE( solutions[ j ].status == solverConverged );
+
+            // Check that coarse velocities are accurate to within screening accuracy [km/s].
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( departureVelocity[ i ]
+                         == Approx( solutions[ j ].departureVelocity[ i ] ).epsilon( 1.0e-3 ) );
+                REQUIRE( arrivalVelocity[ i ]
+                         == Approx( solutions[ j ].arrivalVelocity[ i ] ).epsilon( 1.0e-3 ) );
+            }
+        }
+    }
+
+    SECTION( "Test cache of nested conversions used by refinement stage only" )
+    {
+        // Screen batch without refinement, such that only the coarse stage is executed.
+        TleConversionCache< Real > tleCache;
+        const std::vector< Solution > coarseSolutions
+            = executeAtomSolverTwoStage( problems, RejectAtomSolutions( ), 2, Tle( ), kMU,
+                                         kXKMPER, 1.0e-6, 1.0e-3, 50, 1.0e-10, 1.0e-5, 100,
+                                         hybridsSolver, &tleCache );
+
+        REQUIRE( coarseSolutions[ 0 ].status == solverConverged );
+        REQUIRE( tleCache.size( ) == 0 );
+
+        // Refine batch, such that the refinement stage stores its converged conversions.
+        const std::vector< Solution > solutions
+            = executeAtomSolverTwoStage( problems, AcceptConvergedAtomSolutions< Real, Vector3 >( ),
+                                         2, Tle( ), kMU, kXKMPER, 1.0e-6, 1.0e-3, 50, 1.0e-10,
+                                         1.0e-5, 100, hybridsSolver, &tleCache );
+
+        REQUIRE( tleCache.size( ) > 0 );
+        for ( unsigned int j = 0; j < solutions.size( ); j++ )
+        {
+            REQUIRE( solutions[ j ].status == solverConverged );
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( departureVelocity[ i ]
+                         == Approx( solutions[ j ].departureVelocity[ i ] ).epsilon( 1.0e-6 ) );
+            }
+        }
+    }
+
+    SECTION( "Test empty batch" )
+    {
+        const std::vector< Solution > solutions = executeAtomSolverTwoStage(
+            std::vector< Problem >( ), AcceptConvergedAtomSolutions< Real, Vector3 >( ) );
+
+        REQUIRE( solutions.empty( ) );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/Globals.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/executeAtomSolverMultiGuess.hpp"
+#include "Atom/lambertSolver.hpp"
+#include "Atom/twoBodyFunctions.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+//! Check that departure velocity connects positions within time-of-flight using two-body dynamics.
+void checkLambertSolution( const Vector& departurePosition,
+                           const Vector& arrivalPosition,
+                           const Real timeOfFlight,
+                           const Real gravitationalParameter,
+                           const Vector& departureVelocity )
+{
+    Real finalPosition[ 3 ];
+    Real finalVelocity[ 3 ];
+    propagateTwoBodyState( departurePosition,
+                           departureVelocity,
+                           timeOfFlight,
+                           gravitationalParameter,
+                           finalPosition,
+                           finalVelocity );
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        REQUIRE( std::fabs( finalPosition[ i ] - arrivalPosition[ i ] ) < 1.0e-6 );
+    }
+}
+
+TEST_CASE( "Solve Lambert problem", "[lambert]" )
+{
+    // Set departure and arrival positions [km] (Curtis, 2005; Example 5.2).
+    Vector departurePosition( 3 );
+    departurePosition[ 0 ] = 5000.0;
+    departurePosition[ 1 ] = 10000.0;
+    departurePosition[ 2 ] = 2100.0;
+
+    Vector arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = -14600.0;
+    arrivalPosition[ 1 ] = 2500.0;
+    arrivalPosition[ 2 ] = 7000.0;
+
+    const Real gravitationalParameter = 398600.0;
+
+    Real departureVelocity[ 3 ];
+    Real arrivalVelocity[ 3 ];
+
+    SECTION( "Test single-revolution prograde transfer" )
+    {
+        REQUIRE( solveLambertProblem( departurePosition,
+                                      arrivalPosition,
+                                      3600.0,
+                                      gravitationalParameter,
+                                      departureVelocity,
+                                      arrivalVelocity ) );
+
+        REQUIRE( departureVelocity[ 0 ] == Approx( -5.9925 ).epsilon( 1.0e-4 ) );
+        REQUIRE( departureVelocity[ 1 ] == Approx( 1.9254 ).epsilon( 1.0e-4 ) );
+        REQUIRE( departureVelocity[ 2 ] == Approx( 3.2456 ).epsilon( 1.0e-4 ) );
+        REQUIRE( arrivalVelocity[ 0 ] == Approx( -3.3125 ).epsilon( 1.0e-4 ) );
+        REQUIRE( arrivalVelocity[ 1 ] == Approx( -4.1966 ).epsilon( 1.0e-4 ) );
+        REQUIRE( arrivalVelocity[ 2 ] == Approx( -0.38529 ).epsilon( 1.0e-4 ) );
+    }
+
+    SECTION( "Test single-revolution retrograde transfer" )
+    {
+        REQUIRE( solveLambertProblem( departurePosition,
+                                      arrivalPosition,
+                                      3600.0,
+                                      gravitationalParameter,
+                                      departureVelocity,
+                                      arrivalVelocity,
+                                      0,
+                                      true ) );
+
+        checkLambertSolution( departurePosition,
+                              arrivalPosition,
+                              3600.0,
+                              gravitationalParameter,
+                              Vector( departureVelocity, departureVelocity + 3 ) );
+    }
+
+    SECTION( "Test infeasible transfers" )
+    {
+        // Check that solution does not exist if time-of-flight is too short to complete
+        // revolution.
+        REQUIRE( computeLambertMaximumRevolutions(
+                    departurePosition, arrivalPosition, 3600.0, gravitationalParameter ) == 0 );
+        REQUIRE( !solveLambertProblem( departurePosition,
+                                       arrivalPosition,
+                                       3600.0,
+                                       gravitationalParameter,
+                                       departureVelocity,
+                                       arrivalVelocity,
+                                       1 ) );
+
+        // Check that solution does not exist if time-of-flight is not positive.
+        REQUIRE( !solveLambertProblem( departurePosition,
+                                       arrivalPosition,
+                                       0.0,
+                                       gravitationalParameter,
+                                       departureVelocity,
+                                       arrivalVelocity ) );
+
+        // Check that solution does not exist if positions are collinear.
+        Vector collinearPosition( departurePosition );
+        for ( int i = 0; i < 3; i++ )
+        {
+            collinearPosition[ i ] *= 2.0;
+        }
+        REQUIRE( !solveLambertProblem( departurePosition,
+                                       collinearPosition,
+                                       3600.0,
+                                       gravitationalParameter,
+                                       departureVelocity,
+                                       arrivalVelocity ) );
+    }
+}
+
+TEST_CASE( "Solve multi-revolution Lambert problem", "[lambert]" )
+{
+    // Set departure and arrival positions [km] of Atom solver test fixture.
+    Vector departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    Vector arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+    const Real timeOfFlightInSeconds = timeOfFlight * 60.0;
+
+    SECTION( "Test both branches for all feasible numbers of revolutions" )
+    {
+        const int maximumRevolutions = computeLambertMaximumRevolutions(
+            departurePosition, arrivalPosition, timeOfFlightInSeconds, kMU );
+        REQUIRE( maximumRevolutions == 9 );
+
+        Real departureVelocity[ 3 ];
+        Real arrivalVelocity[ 3 ];
+        for ( int revolutions = 0; revolutions <= maximumRevolutions; revolutions++ )
+        {
+            for ( int branch = 0; branch < 2; branch++ )
+            {
+                REQUIRE( solveLambertProblem( departurePosition,
+                                              arrivalPosition,
+                                              timeOfFlightInSeconds,
+                                              kMU,
+                                              departureVelocity,
+                                              arrivalVelocity,
+                                              revolutions,
+                                              false,
+                                              branch == 1 ) );
+
+                checkLambertSolution( departurePosition,
+                                      arrivalPosition,
+                                      timeOfFlightInSeconds,
+                                      kMU,
+                                      Vector( departureVelocity, departureVelocity + 3 ) );
+            }
+        }
+    }
+
+    SECTION( "Test initial guess for Atom solver" )
+    {
+        // Check that lowest-energy solution is selected, which completes the maximum number of
+        // revolutions for the near-circular transfer of the fixture.
+        const Vector departureVelocityGuess = computeAtomDepartureVelocityGuess(
+            departurePosition, arrivalPosition, timeOfFlight );
+        checkLambertSolution( departurePosition,
+                              arrivalPosition,
+                              timeOfFlightInSeconds,
+                              kMU,
+                              departureVelocityGuess );
+
+        REQUIRE( departureVelocityGuess[ 0 ] == Approx( 6.25343 ).epsilon( 1.0e-4 ) );
+        REQUIRE( departureVelocityGuess[ 1 ] == Approx( -2.12513 ).epsilon( 1.0e-4 ) );
+        REQUIRE( departureVelocityGuess[ 2 ] == Approx( 3.32744 ).epsilon( 1.0e-4 ) );
+    }
+
+    SECTION( "Test initial guesses for multi-guess Atom solver" )
+    {
+        // Check that prograde and retrograde solutions for 0 to 9 revolutions are generated.
+        const std::vector< Vector > guesses = generateLambertDepartureVelocityGuesses(
+            departurePosition, arrivalPosition, timeOfFlight );
+        REQUIRE( guesses.size( ) == 38 );
+
+        for ( unsigned int i = 0; i < guesses.size( ); i++ )
+        {
+            checkLambertSolution( departurePosition,
+                                  arrivalPosition,
+                                  timeOfFlightInSeconds,
+                                  kMU,
+                                  guesses[ i ] );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace atom
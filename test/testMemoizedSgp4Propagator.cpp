@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch.hpp>
+
+#include <libsgp4/Eci.h>
+#include <libsgp4/SGP4.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/memoizedSgp4Propagator.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+//! Check that state propagated by propagator handle is equal to state propagated by SGP4.
+void checkPropagatedState( const MemoizedSgp4Propagator& propagator,
+                           const Tle& tle,
+                           const double minutesSinceEpoch )
+{
+    const Eci propagatedState = propagator.findPosition( minutesSinceEpoch );
+    SGP4 sgp4( tle );
+    const Eci expectedState = sgp4.FindPosition( minutesSinceEpoch );
+
+    REQUIRE( propagatedState.Position( ).x == expectedState.Position( ).x );
+    REQUIRE( propagatedState.Position( ).y == expectedState.Position( ).y );
+    REQUIRE( propagatedState.Position( ).z == expectedState.Position( ).z );
+    REQUIRE( propagatedState.Velocity( ).x == expectedState.Velocity( ).x );
+    REQUIRE( propagatedState.Velocity( ).y == expectedState.Velocity( ).y );
+    REQUIRE( propagatedState.Velocity( ).z == expectedState.Velocity( ).z );
+}
+
+TEST_CASE( "Reuse SGP4/SDP4 propagator", "[sgp4-propagator]" )
+{
+    // Set TLE of the International Space Station.
+    const Tle tle( "ISS (ZARYA)",
+                   "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+                   "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537" );
+
+    MemoizedSgp4Propagator propagator;
+    REQUIRE( !propagator.isTleSet( ) );
+
+    // Check that propagator is initialized when first TLE is set.
+    REQUIRE( propagator.setTle( tle ) );
+    REQUIRE( propagator.isTleSet( ) );
+    checkPropagatedState( propagator, tle, 0.0 );
+    checkPropagatedState( propagator, tle, 360.0 );
+
+    SECTION( "Test reuse of propagator for same TLE" )
+    {
+        const Tle copiedTle( tle );
+        REQUIRE( !propagator.setTle( copiedTle ) );
+        REQUIRE( propagator.numberOfInitializations( ) == 1 );
+        REQUIRE( propagator.numberOfReuses( ) == 1 );
+        checkPropagatedState( propagator, copiedTle, 360.0 );
+    }
+
+    SECTION( "Test re-initialization of propagator for changed mean elements" )
+    {
+        Tle perturbedTle( tle );
+        perturbedTle.updateMeanElements( tle.Inclination( true ),
+                                         tle.RightAscendingNode( true ),
+                                         tle.Eccentricity( ),
+                                         tle.ArgumentPerigee( true ),
+                                         tle.MeanAnomaly( true ) + 1.0e-6,
+                                         tle.MeanMotion( ) );
+
+        REQUIRE( propagator.setTle( perturbedTle ) );
+        REQUIRE( propagator.numberOfInitializations( ) == 2 );
+        REQUIRE( propagator.numberOfReuses( ) == 0 );
+        checkPropagatedState( propagator, perturbedTle, 360.0 );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -4,7 +4,10 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <cstddef>
+#include <limits>
 #include <sstream>
+#include <string>
 
 #include <catch.hpp>
 
@@ -125,6 +128,101 @@ TEST_CASE( "Print Atom solver state", "[print]" )
     REQUIRE( printAtomSolverState( 0, solver ) == tableRow.str( ) );
 }
 
+TEST_CASE( "Print solver state", "[print]" )
+{
+    // Set independent variables and residuals.
+    gsl_vector* independentVariables = gsl_vector_alloc( 2 );
+    gsl_vector_set( independentVariables, 0, 0.1 );
+    gsl_vector_set( independentVariables, 1, 0.2 );
+
+    gsl_vector* residuals = gsl_vector_alloc( 2 );
+    gsl_vector_set( residuals, 0, 1.2 );
+    gsl_vector_set( residuals, 1, 2.3 );
+
+    // Set expected output string.
+    std::ostringstream tableRow;
+    tableRow << "3  0.1            0.2            1.2            2.3            "
+             << std::endl;
+
+    REQUIRE( printSolverState( 3, independentVariables, residuals ) == tableRow.str( ) );
+
+    gsl_vector_free( independentVariables );
+    gsl_vector_free( residuals );
+}
+
+TEST_CASE( "Format solver state", "[print]" )
+{
+    // Set independent variables and residuals.
+    gsl_vector* independentVariables = gsl_vector_alloc( 2 );
+    gsl_vector_set( independentVariables, 0, 0.1 );
+    gsl_vector_set( independentVariables, 1, 0.25 );
+
+    gsl_vector* residuals = gsl_vector_alloc( 2 );
+    gsl_vector_set( residuals, 0, 1.5 );
+    gsl_vector_set( residuals, 1, -2.0 );
+
+    char buffer[ 256 ];
+
+    SECTION( "Test table format" )
+    {
+        const std::size_t length = formatSolverState(
+            3, independentVariables, residuals, tableSolverStateFormat, buffer, 256 );
+
+        const std::string row = printSolverState( 3, independentVariables, residuals );
+        REQUIRE( std::string( buffer ) == row );
+        REQUIRE( length == row.size( ) );
+    }
+
+    SECTION( "Test CSV format" )
+    {
+        const std::size_t length = formatSolverState(
+            3, independentVariables, residuals, csvSolverStateFormat, buffer, 256 );
+
+        const std::string row = "3,0.10000000000000001,0.25,1.5,-2\n";
+        REQUIRE( std::string( buffer ) == row );
+        REQUIRE( length == row.size( ) );
+    }
+
+    SECTION( "Test JSON-lines format" )
+    {
+        gsl_vector_set( residuals, 1, std::numeric_limits< double >::quiet_NaN( ) );
+        formatSolverState(
+            3, independentVariables, residuals, jsonLinesSolverStateFormat, buffer, 256 );
+
+        REQUIRE( std::string( buffer )
+                 == "{\"iteration\":3,\"x\":[0.10000000000000001,0.25],\"f\":[1.5,null]}\n" );
+    }
+
+    SECTION( "Test truncated row" )
+    {
+        const std::size_t length = formatSolverState(
+            3, independentVariables, residuals, csvSolverStateFormat, buffer, 8 );
+
+        REQUIRE( length == std::string( "3,0.10000000000000001,0.25,1.5,-2\n" ).size( ) );
+        REQUIRE( std::string( buffer ) == "3,0.100" );
+    }
+
+    gsl_vector_free( independentVariables );
+    gsl_vector_free( residuals );
+}
+
+TEST_CASE( "Format solver state headers", "[print]" )
+{
+    char buffer[ 256 ];
+
+    formatCartesianToTleSolverStateHeader( tableSolverStateFormat, buffer, 256 );
+    REQUIRE( std::string( buffer ) == printCartesianToTleSolverStateTableHeader( ) );
+
+    formatAtomSolverStateHeader( tableSolverStateFormat, buffer, 256 );
+    REQUIRE( std::string( buffer ) == printAtomSolverStateTableHeader( ) );
+
+    formatAtomSolverStateHeader( csvSolverStateFormat, buffer, 256 );
+    REQUIRE( std::string( buffer ) == "iteration,v1_x,v1_y,v1_z,f1,f2,f3\n" );
+
+    REQUIRE( formatAtomSolverStateHeader( jsonLinesSolverStateFormat, buffer, 256 ) == 0 );
+    REQUIRE( std::string( buffer ).empty( ) );
+}
+
 TEST_CASE( "Print element", "[print]" )
 {
     REQUIRE( printElement( "test", 10 ) == "test      " );
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/solverStatistics.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+//! Number of heap allocations executed through global operator new.
+std::atomic< std::size_t > numberOfAllocations( 0 );
+
+} // namespace tests
+} // namespace atom
+
+// Replace global operator new to count heap allocations executed by the test executable.
+void* operator new( std::size_t size )
+{
+    ++atom::tests::numberOfAllocations;
+    void* pointer = std::malloc( size == 0 ? 1 : size );
+    if ( pointer == 0 )
+    {
+        throw std::bad_alloc( );
+    }
+    return pointer;
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector3;
+typedef std::vector< Real > Vector6;
+
+TEST_CASE( "Evaluate Cartesian-to-TLE residual function without allocating memory",
+           "[cartesian-to-TLE],[allocations]" )
+{
+    // Set target cartesian state [km; km/s].
+    Vector6 cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    // Set up parameters for residual function.
+    CartesianToTwoLineElementsParameters< Real, Vector6 > parameters(
+        cartesianState, kMU, kXKMPER, Tle( ) );
+    parameters.workingTle.updateEpoch( DateTime( ) );
+
+    // Set independent variables (Keplerian elements) [km, -, rad, rad, rad, rad].
+    gsl_vector* independentVariables = gsl_vector_alloc( 6 );
+    gsl_vector_set( independentVariables, astro::semiMajorAxisIndex, 7.8e3 );
+    gsl_vector_set( independentVariables, astro::eccentricityIndex, 0.05 );
+    gsl_vector_set( independentVariables, astro::inclinationIndex, 0.9 );
+    gsl_vector_set( independentVariables, astro::argumentOfPeriapsisIndex, 1.2 );
+    gsl_vector_set( independentVariables, astro::longitudeOfAscendingNodeIndex, 2.3 );
+    gsl_vector_set( independentVariables, astro::trueAnomalyIndex, 0.7 );
+
+    gsl_vector* residuals = gsl_vector_alloc( 6 );
+    gsl_matrix* jacobian = gsl_matrix_alloc( 6, 6 );
+
+    // Evaluate residual function once before counting allocations.
+    computeCartesianToTwoLineElementResidualsAndJacobian< Real, Vector6 >(
+        independentVariables, &parameters, residuals, jacobian );
+
+    // Count heap allocations executed by repeated evaluations of residual function and Jacobian.
+    const std::size_t initialNumberOfAllocations = numberOfAllocations;
+    for ( int i = 0; i < 10; i++ )
+    {
+        gsl_vector_set( independentVariables, astro::trueAnomalyIndex, 0.7 + 0.01 * i );
+        computeCartesianToTwoLineElementResiduals< Real, Vector6 >(
+            independentVariables, &parameters, residuals );
+        computeCartesianToTwoLineElementJacobian< Real, Vector6 >(
+            independentVariables, &parameters, jacobian );
+    }
+    const std::size_t finalNumberOfAllocations = numberOfAllocations;
+
+    gsl_matrix_free( jacobian );
+    gsl_vector_free( residuals );
+    gsl_vector_free( independentVariables );
+
+    REQUIRE( finalNumberOfAllocations == initialNumberOfAllocations );
+}
+
+TEST_CASE( "Evaluate Atom residual function without allocating memory",
+           "[atom-solver],[allocations]" )
+{
+    // Set departure position [km].
+    Vector3 departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector3 arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set up parameters for residual function, reusing a propagator for the nested
+    // Cartesian-to-TLE conversions and collecting statistics. No workspace is given, such that the
+    // workspace owned by the parameters is used.
+    const DateTime departureEpoch( 63548650522376360 );
+    MemoizedSgp4Propagator propagator;
+    SolverStatistics< Real > statistics;
+    AtomParameters< Real, Vector3 > parameters( departurePosition,
+                                                departureEpoch,
+                                                arrivalPosition,
+                                                1000.0,
+                                                kMU,
+                                                kXKMPER,
+                                                Tle( ),
+                                                1.0e-10,
+                                                1.0e-5,
+                                                100,
+                                                0,
+                                                0,
+                                                false,
+                                                &statistics,
+                                                0,
+                                                0,
+                                                &propagator );
+
+    // Set independent variables (departure velocity) [km/s].
+    gsl_vector* independentVariables = gsl_vector_alloc( 3 );
+    gsl_vector_set( independentVariables, 0, 6.44661660560979 );
+    gsl_vector_set( independentVariables, 1, -1.14788435945363 );
+    gsl_vector_set( independentVariables, 2, 3.44659369332744 );
+
+    gsl_vector* residuals = gsl_vector_alloc( 3 );
+
+    // Evaluate residual function once before counting allocations.
+    REQUIRE( computeAtomResiduals< Real, Vector3 >( independentVariables, &parameters, residuals )
+             == GSL_SUCCESS );
+
+    // Count heap allocations executed by repeated evaluations of residual function.
+    const std::size_t initialNumberOfAllocations = numberOfAllocations;
+    for ( int i = 0; i < 10; i++ )
+    {
+        gsl_vector_set( independentVariables, 0, 6.44661660560979 + 0.001 * i );
+        computeAtomResiduals< Real, Vector3 >( independentVariables, &parameters, residuals );
+    }
+    const std::size_t finalNumberOfAllocations = numberOfAllocations;
+
+    gsl_vector_free( residuals );
+    gsl_vector_free( independentVariables );
+
+    REQUIRE( finalNumberOfAllocations == initialNumberOfAllocations );
+}
+
+} // namespace tests
+} // namespace atom
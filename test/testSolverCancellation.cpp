@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/solverCancellation.hpp"
+#include "Atom/solverStatistics.hpp"
+#include "Atom/solverStatus.hpp"
+#include "Atom/solverWorkspace.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+//! Diagnostics policy that cancels solver at given iteration.
+struct CancelAtIteration
+{
+public:
+
+    //! Constructor taking cancellation token and iteration at which solver is cancelled.
+    CancelAtIteration( SolverCancellation& aCancellation, const int anIteration )
+        : cancellation( aCancellation ),
+          iteration( anIteration ),
+          initialResidualNorm( -1.0 )
+    { }
+
+    //! Record current state of non-linear solver, cancelling solver at given iteration.
+    void recordIteration( const int currentIteration,
+                          const gsl_vector* independentVariables,
+                          const gsl_vector* residuals,
+                          const gsl_vector* step )
+    {
+        if ( currentIteration == 0 )
+        {
+            initialResidualNorm = computeResidualNorm< Real >( residuals );
+        }
+
+        if ( currentIteration == iteration )
+        {
+            cancellation.cancel( );
+        }
+    }
+
+    //! Record final status of non-linear solver.
+    void recordStatus( const int solverStatus )
+    { }
+
+    //! Cancellation token.
+    SolverCancellation& cancellation;
+
+    //! Iteration at which solver is cancelled.
+    const int iteration;
+
+    //! Norm of residuals at initial guess.
+    Real initialResidualNorm;
+
+protected:
+
+private:
+};
+
+TEST_CASE( "Cancellation token", "[cancellation]" )
+{
+    SECTION( "Test token without deadline" )
+    {
+        SolverCancellation cancellation;
+        REQUIRE( !cancellation.isCancelled( ) );
+
+        cancellation.cancel( );
+        REQUIRE( cancellation.isCancelled( ) );
+    }
+
+    SECTION( "Test token with expired deadline" )
+    {
+        const SolverCancellation cancellation(
+            SolverCancellation::Clock::now( ) - std::chrono::seconds( 1 ) );
+        REQUIRE( cancellation.isCancelled( ) );
+    }
+
+    SECTION( "Test token with timeout" )
+    {
+        SolverCancellation cancellation;
+        cancellation.setTimeout( std::chrono::hours( 1 ) );
+        REQUIRE( !cancellation.isCancelled( ) );
+
+        cancellation.setTimeout( std::chrono::milliseconds( 0 ) );
+        REQUIRE( cancellation.isCancelled( ) );
+    }
+}
+
+TEST_CASE( "Cancel Cartesian-to-TLE conversion", "[cancellation],[cartesian-to-TLE]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    SolverWorkspace workspace( 6 );
+    TleFitWarmStart< Real > warmStart;
+    NoSolverDiagnostics diagnostics;
+    SolverStatus status = solverConverged;
+    int numberOfIterations = 0;
+
+    SolverCancellation cancellation;
+    cancellation.cancel( );
+
+    convertCartesianStateToTwoLineElements< Real >(
+        cartesianState, DateTime( ), workspace, warmStart, diagnostics, numberOfIterations,
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, 0, &status, 0, 0, &cancellation );
+
+    // Check that conversion stopped at initial guess and did not update warm-start state.
+    REQUIRE( status == solverCancelled );
+    REQUIRE( numberOfIterations == 0 );
+    REQUIRE( !warmStart.hasElementOffsets );
+}
+
+TEST_CASE( "Cancel Atom solver between iterations", "[cancellation],[atom-solver]" )
+{
+    // Set departure position [km].
+    Vector departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    // Set initial guess for departure velocity [km/s]. Arbitrary values are added to the
+    // expected departure velocity.
+    Vector departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 6.44661660560979 + 0.013;
+    departureVelocityGuess[ 1 ] = -1.14788435945363 - 0.074;
+    departureVelocityGuess[ 2 ] = 3.44659369332744 + 0.026;
+
+    SolverWorkspace atomWorkspace( 3 );
+    SolverWorkspace tleWorkspace( 6 );
+    SolverCancellation cancellation;
+    CancelAtIteration diagnostics( cancellation, 10 );
+    SolverStatus status = solverConverged;
+    AtomTransfer< Real, Vector > transfer;
+    int numberOfIterations = 0;
+
+    const std::pair< Vector, Vector > velocities = executeAtomSolver< Real >(
+        departurePosition, departureEpoch, arrivalPosition, timeOfFlight, departureVelocityGuess,
+        atomWorkspace, tleWorkspace, diagnostics, numberOfIterations,
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, false, 0, &status, 0, 0, &transfer,
+        &cancellation );
+
+    // Check that solver stopped before converging, at an iterate that improves on the initial
+    // guess.
+    REQUIRE( status == solverCancelled );
+    REQUIRE( numberOfIterations < 57 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        REQUIRE( !std::isnan( velocities.first[ i ] ) );
+    }
+
+    const Real finalResidualNorm = std::sqrt( transfer.finalResiduals[ 0 ]
+                                              * transfer.finalResiduals[ 0 ]
+                                              + transfer.finalResiduals[ 1 ]
+                                              * transfer.finalResiduals[ 1 ]
+                                              + transfer.finalResiduals[ 2 ]
+                                              * transfer.finalResiduals[ 2 ] );
+    REQUIRE( finalResidualNorm < diagnostics.initialResidualNorm );
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <sstream>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_multiroots.h>
+#include <gsl/gsl_vector.h>
+
+#include "Atom/printFunctions.hpp"
+#include "Atom/solverDiagnostics.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+int computeSolverDiagnosticsTestFunction(
+    const gsl_vector* independentVariables, void* parameters, gsl_vector* residuals )
+{
+    gsl_vector_set( residuals, 0, 1.2 );
+    gsl_vector_set( residuals, 1, 2.3 );
+    gsl_vector_set( residuals, 2, 3.4 );
+    return GSL_SUCCESS;
+}
+
+struct DiagnosticsParameters{ };
+
+TEST_CASE( "Solver diagnostics", "[diagnostics]" )
+{
+    // Set initial guess for GSL solver.
+    gsl_vector* initialGuess = gsl_vector_alloc( 3 );
+    gsl_vector_set( initialGuess, 0, 0.1 );
+    gsl_vector_set( initialGuess, 1, 0.2 );
+    gsl_vector_set( initialGuess, 2, 0.3 );
+
+    // Set up dummy GSL solver.
+    DiagnosticsParameters parameters;
+
+    gsl_multiroot_function testFunction
+        = { &computeSolverDiagnosticsTestFunction, 3, &parameters };
+
+    const gsl_multiroot_fsolver_type* solverType = gsl_multiroot_fsolver_hybrids;
+    gsl_multiroot_fsolver* solver = gsl_multiroot_fsolver_alloc( solverType, 3 );
+    gsl_multiroot_fsolver_set( solver, &testFunction, initialGuess );
+
+    SECTION( "Test iteration trace" )
+    {
+        SolverIterationTrace< double > trace;
+        trace.recordIteration( 0, solver->x, solver->f, solver->dx );
+        trace.recordIteration( 1, solver->x, solver->f, solver->dx );
+        trace.recordStatus( GSL_SUCCESS );
+
+        const std::vector< SolverIterationRecord< double > >& records = trace.records( );
+        REQUIRE( records.size( ) == 2 );
+        REQUIRE( records[ 1 ].iteration == 1 );
+        REQUIRE( records[ 1 ].independentVariables.size( ) == 3 );
+        REQUIRE( records[ 1 ].independentVariables[ 2 ] == Approx( 0.3 ) );
+        REQUIRE( records[ 1 ].residuals[ 0 ] == Approx( 1.2 ) );
+        REQUIRE( records[ 1 ].step.size( ) == 3 );
+        REQUIRE( trace.status( ) == GSL_SUCCESS );
+    }
+
+    SECTION( "Test summary table" )
+    {
+        SolverSummaryTable summary( printAtomSolverStateTableHeader( ) );
+        summary.recordIteration( 0, solver->x, solver->f, solver->dx );
+        summary.recordStatus( GSL_SUCCESS );
+
+        // Set expected output string.
+        std::ostringstream table;
+        table << printAtomSolverStateTableHeader( )
+              << printAtomSolverState( 0, solver )
+              << std::endl
+              << "Status of non-linear solver: " << gsl_strerror( GSL_SUCCESS ) << std::endl
+              << std::endl;
+
+        REQUIRE( summary.str( ) == table.str( ) );
+        REQUIRE( summary.status( ) == GSL_SUCCESS );
+    }
+
+    SECTION( "Test CSV trace" )
+    {
+        char header[ 256 ];
+        formatAtomSolverStateHeader( csvSolverStateFormat, header, 256 );
+
+        std::ostringstream stream;
+        SolverTraceWriter trace( stream, csvSolverStateFormat, header );
+        trace.recordIteration( 0, solver->x, solver->f, solver->dx );
+        trace.recordIteration( 1, solver->x, solver->f, solver->dx );
+        trace.recordStatus( GSL_SUCCESS );
+
+        // Set expected output string.
+        char row[ 256 ];
+        std::ostringstream expectedTrace;
+        expectedTrace << header;
+        formatSolverState( 0, solver->x, solver->f, csvSolverStateFormat, row, 256 );
+        expectedTrace << row;
+        formatSolverState( 1, solver->x, solver->f, csvSolverStateFormat, row, 256 );
+        expectedTrace << row;
+
+        REQUIRE( stream.str( ) == expectedTrace.str( ) );
+        REQUIRE( trace.status( ) == GSL_SUCCESS );
+    }
+
+    SECTION( "Test JSON-lines trace with enlarged buffer" )
+    {
+        std::ostringstream stream;
+        SolverTraceWriter trace( stream, jsonLinesSolverStateFormat, 0, 4 );
+        trace.recordIteration( 0, solver->x, solver->f, solver->dx );
+        trace.recordStatus( GSL_SUCCESS );
+
+        // Set expected output string.
+        char row[ 256 ];
+        formatSolverState( 0, solver->x, solver->f, jsonLinesSolverStateFormat, row, 256 );
+        std::ostringstream expectedTrace;
+        expectedTrace << row
+                      << "{\"status\":" << GSL_SUCCESS
+                      << ",\"message\":\"" << gsl_strerror( GSL_SUCCESS ) << "\"}\n";
+
+        REQUIRE( stream.str( ) == expectedTrace.str( ) );
+    }
+
+    gsl_multiroot_fsolver_free( solver );
+    gsl_vector_free( initialGuess );
+}
+
+} // namespace tests
+} // namespace atom
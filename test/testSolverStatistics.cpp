@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_vector.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/solverStatistics.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+TEST_CASE( "Solver statistics", "[statistics]" )
+{
+    SECTION( "Test recording of nested conversions" )
+    {
+        SolverStatistics< Real > nestedStatistics;
+        nestedStatistics.numberOfIterations = 4;
+        nestedStatistics.numberOfResidualEvaluations = 11;
+        nestedStatistics.propagationTime = 2.0;
+        nestedStatistics.conversionTime = 1.0;
+
+        SolverStatistics< Real > statistics;
+        statistics.recordNestedConversion( nestedStatistics );
+        nestedStatistics.numberOfIterations = 2;
+        statistics.recordNestedConversion( nestedStatistics );
+
+        REQUIRE( statistics.numberOfNestedConversions == 2 );
+        REQUIRE( statistics.numberOfNestedIterations == 6 );
+        REQUIRE( statistics.maximumNestedIterations == 4 );
+        REQUIRE( statistics.numberOfNestedResidualEvaluations == 22 );
+        REQUIRE( statistics.propagationTime == Approx( 4.0 ) );
+        REQUIRE( statistics.conversionTime == Approx( 2.0 ) );
+
+        statistics.reset( );
+        REQUIRE( statistics.numberOfNestedConversions == 0 );
+        REQUIRE( statistics.propagationTime == 0.0 );
+    }
+
+    SECTION( "Test norm of residuals" )
+    {
+        gsl_vector* residuals = gsl_vector_alloc( 3 );
+        gsl_vector_set( residuals, 0, 1.0 );
+        gsl_vector_set( residuals, 1, -2.0 );
+        gsl_vector_set( residuals, 2, 2.0 );
+
+        REQUIRE( computeResidualNorm< Real >( residuals ) == Approx( 3.0 ) );
+
+        gsl_vector_free( residuals );
+    }
+}
+
+TEST_CASE( "Collect statistics of Cartesian-to-TLE conversion", "[statistics]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    TleFitter< Real, Vector > fitter( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, hybridsjSolver );
+    int numberOfIterations = 0;
+    fitter.solve( cartesianState, DateTime( ), numberOfIterations );
+
+    const SolverStatistics< Real >& statistics = fitter.statistics( );
+    REQUIRE( statistics.numberOfIterations == numberOfIterations );
+    REQUIRE( statistics.numberOfResidualEvaluations > 0 );
+    REQUIRE( statistics.numberOfJacobianEvaluations > 0 );
+    REQUIRE( statistics.numberOfNestedConversions == 0 );
+    REQUIRE( statistics.finalResidualNorm < 1.0e-6 );
+    REQUIRE( statistics.propagationTime >= 0.0 );
+    REQUIRE( statistics.conversionTime >= 0.0 );
+    REQUIRE( statistics.totalTime
+             >= statistics.propagationTime + statistics.conversionTime );
+    REQUIRE( statistics.solverTime == Approx( statistics.totalTime - statistics.propagationTime
+                                              - statistics.conversionTime ) );
+}
+
+TEST_CASE( "Collect statistics of Atom solver", "[statistics]" )
+{
+    // Set departure position [km].
+    Vector departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 6.44661660560979 + 0.013;
+    departureVelocityGuess[ 1 ] = -1.14788435945363 - 0.074;
+    departureVelocityGuess[ 2 ] = 3.44659369332744 + 0.026;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    AtomSolver< Real, Vector > solver;
+    int numberOfIterations = 0;
+    solver.solve( departurePosition,
+                  departureEpoch,
+                  arrivalPosition,
+                  timeOfFlight,
+                  departureVelocityGuess,
+                  numberOfIterations );
+
+    // Check that every evaluation of the residual function executes one nested conversion, and that
+    // the final conversion of the departure state is also counted.
+    const SolverStatistics< Real >& statistics = solver.statistics( );
+    REQUIRE( statistics.numberOfIterations == 57 );
+    REQUIRE( statistics.numberOfResidualEvaluations > statistics.numberOfIterations );
+    REQUIRE( statistics.numberOfJacobianEvaluations == 0 );
+    REQUIRE( statistics.numberOfNestedConversions
+             == statistics.numberOfResidualEvaluations + 1 );
+    REQUIRE( statistics.maximumNestedIterations <= statistics.numberOfNestedIterations );
+    REQUIRE( statistics.numberOfNestedResidualEvaluations
+             >= statistics.numberOfNestedIterations );
+    REQUIRE( statistics.finalResidualNorm < 1.0e-4 );
+    REQUIRE( statistics.propagationTime > 0.0 );
+    REQUIRE( statistics.totalTime
+             >= statistics.propagationTime + statistics.conversionTime );
+
+    // Check that statistics are reset by the next solve.
+    const int numberOfResidualEvaluations = statistics.numberOfResidualEvaluations;
+    solver.solve( departurePosition,
+                  departureEpoch,
+                  arrivalPosition,
+                  timeOfFlight,
+                  departureVelocityGuess,
+                  numberOfIterations );
+    REQUIRE( solver.statistics( ).numberOfIterations == 57 );
+    REQUIRE( solver.statistics( ).numberOfResidualEvaluations == numberOfResidualEvaluations );
+}
+
+} // namespace tests
+} // namespace atom
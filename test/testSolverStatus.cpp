@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <gsl/gsl_errno.h>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Globals.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/atom.hpp"
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/solverStatus.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+TEST_CASE( "Solver status", "[status]" )
+{
+    SECTION( "Test check for failure of solver" )
+    {
+        REQUIRE( !hasSolverFailed( solverConverged ) );
+        REQUIRE( !hasSolverFailed( solverMaximumIterationsReached ) );
+        REQUIRE( hasSolverFailed( solverStuck ) );
+        REQUIRE( hasSolverFailed( solverPropagationFailed ) );
+        REQUIRE( hasSolverFailed( solverNestedConversionFailed ) );
+        REQUIRE( hasSolverFailed( solverCancelled ) );
+        REQUIRE( hasSolverFailed( solverTleFormatFailed ) );
+    }
+
+    SECTION( "Test printing of solver status" )
+    {
+        REQUIRE( printSolverStatus( solverStuck ) == "ERROR: Non-linear solver is stuck!" );
+        REQUIRE( printSolverStatus( solverPropagationFailed )
+                 == "ERROR: SGP4/SDP4 propagator failed!" );
+        REQUIRE( printSolverStatus( solverTleFormatFailed )
+                 == "ERROR: Elements of TLE do not fit TLE format!" );
+    }
+}
+
+TEST_CASE( "Convert Cartesian state to TLE without throwing exceptions", "[status]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    SECTION( "Test converged conversion" )
+    {
+        TleFitter< Real, Vector > fitter;
+        Tle tle;
+        REQUIRE( fitter.trySolve( cartesianState, DateTime( ), tle ) == solverConverged );
+
+        // Check that TLE matches TLE computed by throwing converter.
+        const Tle expectedTle = fitter.solve( cartesianState, DateTime( ) );
+        REQUIRE( tle.MeanMotion( ) == Approx( expectedTle.MeanMotion( ) ) );
+        REQUIRE( tle.Eccentricity( ) == Approx( expectedTle.Eccentricity( ) ) );
+    }
+
+    SECTION( "Test conversion that reaches maximum number of iterations" )
+    {
+        TleFitter< Real, Vector > fitter( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 1 );
+        Tle tle;
+        REQUIRE( fitter.trySolve( cartesianState, DateTime( ), tle )
+                 == solverMaximumIterationsReached );
+    }
+}
+
+TEST_CASE( "Execute Atom solver without throwing exceptions", "[status]" )
+{
+    // Set departure position [km].
+    Vector departurePosition( 3 );
+    departurePosition[ 0 ] = -3680.20448307549;
+    departurePosition[ 1 ] = -2573.44661796266;
+    departurePosition[ 2 ] = 5800.72628190982;
+
+    // Set arrival position [km].
+    Vector arrivalPosition( 3 );
+    arrivalPosition[ 0 ] = 4496.59209320659;
+    arrivalPosition[ 1 ] = 2339.99159226651;
+    arrivalPosition[ 2 ] = -5455.56445926525;
+
+    // Set initial guess for departure velocity [km/s].
+    Vector departureVelocityGuess( 3 );
+    departureVelocityGuess[ 0 ] = 6.44661660560979 + 0.013;
+    departureVelocityGuess[ 1 ] = -1.14788435945363 - 0.074;
+    departureVelocityGuess[ 2 ] = 3.44659369332744 + 0.026;
+
+    // Set departure epoch.
+    DateTime departureEpoch( 63548650522376360 );
+
+    // Time-of-flight [min].
+    const Real timeOfFlight = 1000.0;
+
+    SECTION( "Test converged solve" )
+    {
+        AtomSolver< Real, Vector > solver;
+        std::pair< Vector, Vector > velocities;
+        FinalSolverStatus diagnostics;
+        int numberOfIterations = 0;
+        REQUIRE( solver.trySolve( departurePosition,
+                                  departureEpoch,
+                                  arrivalPosition,
+                                  timeOfFlight,
+                                  departureVelocityGuess,
+                                  velocities,
+                                  diagnostics,
+                                  numberOfIterations ) == solverConverged );
+        REQUIRE( numberOfIterations == 57 );
+        REQUIRE( diagnostics.solverStatus == GSL_SUCCESS );
+
+        // Check that velocities match velocities computed by throwing solver.
+        const std::pair< Vector, Vector > expectedVelocities
+            = solver.solve( departurePosition,
+                            departureEpoch,
+                            arrivalPosition,
+                            timeOfFlight,
+                            departureVelocityGuess );
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( velocities.first[ i ] == Approx( expectedVelocities.first[ i ] ) );
+            REQUIRE( velocities.second[ i ] == Approx( expectedVelocities.second[ i ] ) );
+        }
+    }
+
+    SECTION( "Test solve that reaches maximum number of iterations" )
+    {
+        AtomSolver< Real, Vector > solver( Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 5 );
+        std::pair< Vector, Vector > velocities;
+        REQUIRE( solver.trySolve( departurePosition,
+                                  departureEpoch,
+                                  arrivalPosition,
+                                  timeOfFlight,
+                                  departureVelocityGuess,
+                                  velocities ) == solverMaximumIterationsReached );
+        REQUIRE( velocities.first.size( ) == 3 );
+        REQUIRE( velocities.second.size( ) == 3 );
+    }
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/DateTime.h>
+#include <libsgp4/Tle.h>
+
+#include "Atom/convertCartesianStateToTwoLineElements.hpp"
+#include "Atom/tleConversionCache.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector6;
+
+TEST_CASE( "Cache Cartesian-to-TLE conversions", "[cartesian-to-TLE],[cache]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector6 cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    const DateTime epoch( 63548650522376360 );
+
+    // Set TLE of the International Space Station, used as converged TLE.
+    const Tle tle( "ISS (ZARYA)",
+                   "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+                   "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537" );
+
+    TleConversionCache< Real > cache( 2 );
+    REQUIRE( cache.capacity( ) == 2 );
+    REQUIRE( cache.size( ) == 0 );
+
+    Tle cachedTle;
+    REQUIRE( !cache.find( cartesianState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+    cache.insert( cartesianState, epoch, Tle( ), 1.0e-10, tle );
+    REQUIRE( cache.size( ) == 1 );
+
+    SECTION( "Test lookup of quantized state" )
+    {
+        Vector6 nearbyState( cartesianState );
+        nearbyState[ 0 ] += 1.0e-8;
+        nearbyState[ 5 ] -= 1.0e-11;
+
+        REQUIRE( cache.find( nearbyState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+        REQUIRE( cachedTle.Line1( ) == tle.Line1( ) );
+        REQUIRE( cachedTle.Line2( ) == tle.Line2( ) );
+
+        // Check that different states and epochs, and tighter tolerances, are not found.
+        Vector6 distantState( cartesianState );
+        distantState[ 1 ] += 1.0e-3;
+        REQUIRE( !cache.find( distantState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+        REQUIRE( !cache.find( cartesianState, epoch.AddMinutes( 1.0 ), Tle( ), 1.0e-10,
+                              cachedTle ) );
+        REQUIRE( !cache.find( cartesianState, epoch, Tle( ), 1.0e-12, cachedTle ) );
+        REQUIRE( !cache.find( cartesianState, epoch, tle, 1.0e-10, cachedTle ) );
+
+        REQUIRE( cache.numberOfHits( ) == 1 );
+        REQUIRE( cache.numberOfMisses( ) == 5 );
+    }
+
+    SECTION( "Test eviction of least recently used conversion" )
+    {
+        Vector6 secondState( cartesianState );
+        secondState[ 0 ] += 1.0;
+        Vector6 thirdState( cartesianState );
+        thirdState[ 0 ] += 2.0;
+
+        cache.insert( secondState, epoch, Tle( ), 1.0e-10, tle );
+        REQUIRE( cache.find( cartesianState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+        cache.insert( thirdState, epoch, Tle( ), 1.0e-10, tle );
+
+        REQUIRE( cache.size( ) == 2 );
+        REQUIRE( cache.find( cartesianState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+        REQUIRE( cache.find( thirdState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+        REQUIRE( !cache.find( secondState, epoch, Tle( ), 1.0e-10, cachedTle ) );
+
+        cache.clear( );
+        REQUIRE( cache.size( ) == 0 );
+        REQUIRE( cache.numberOfHits( ) == 0 );
+        REQUIRE( cache.numberOfMisses( ) == 0 );
+    }
+}
+
+TEST_CASE( "Convert Cartesian state to TLE using cache", "[cartesian-to-TLE],[cache]" )
+{
+    // Set target Cartesian state [km; km/s].
+    Vector6 cartesianState( 6 );
+    cartesianState[ 0 ] = -7.1e3;
+    cartesianState[ 1 ] = 2.7e3;
+    cartesianState[ 2 ] = 1.3e3;
+    cartesianState[ 3 ] = -2.5;
+    cartesianState[ 4 ] = -5.5;
+    cartesianState[ 5 ] = 5.5;
+
+    const DateTime epoch( 63548650522376360 );
+
+    SolverWorkspace workspace( 6 );
+    TleFitWarmStart< Real > warmStart;
+    NoSolverDiagnostics diagnostics;
+    TleConversionCache< Real > cache;
+    SolverStatus status = solverStuck;
+    int numberOfIterations = 0;
+
+    const Tle convertedTle = convertCartesianStateToTwoLineElements< Real >(
+        cartesianState, epoch, workspace, warmStart, diagnostics, numberOfIterations,
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, 0, &status, 0, &cache );
+
+    REQUIRE( status == solverConverged );
+    REQUIRE( numberOfIterations > 0 );
+    REQUIRE( cache.size( ) == 1 );
+
+    // Check that repeated conversion returns cached TLE without executing solver.
+    status = solverStuck;
+    const Tle cachedTle = convertCartesianStateToTwoLineElements< Real >(
+        cartesianState, epoch, workspace, warmStart, diagnostics, numberOfIterations,
+        Tle( ), kMU, kXKMPER, 1.0e-10, 1.0e-5, 100, 0, &status, 0, &cache );
+
+    REQUIRE( status == solverConverged );
+    REQUIRE( numberOfIterations == 0 );
+    REQUIRE( cache.numberOfHits( ) == 1 );
+    REQUIRE( cachedTle.Line1( ) == convertedTle.Line1( ) );
+    REQUIRE( cachedTle.Line2( ) == convertedTle.Line2( ) );
+}
+
+} // namespace tests
+} // namespace atom
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <libsgp4/Globals.h>
+
+#include <Astro/astro.hpp>
+#include <SML/sml.hpp>
+
+#include "Atom/twoBodyFunctions.hpp"
+
+namespace atom
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+TEST_CASE( "Compute Stumpff functions", "[two-body]" )
+{
+    Real stumpffFunctionC = 0.0;
+    Real stumpffFunctionS = 0.0;
+
+    SECTION( "Test z = 0" )
+    {
+        computeStumpffFunctions( 0.0, stumpffFunctionC, stumpffFunctionS );
+        REQUIRE( stumpffFunctionC == Approx( 0.5 ) );
+        REQUIRE( stumpffFunctionS == Approx( 1.0 / 6.0 ) );
+    }
+
+    SECTION( "Test z > 0" )
+    {
+        const Real z = 2.5;
+        computeStumpffFunctions( z, stumpffFunctionC, stumpffFunctionS );
+        REQUIRE( stumpffFunctionC == Approx( ( 1.0 - std::cos( std::sqrt( z ) ) ) / z ) );
+        REQUIRE( stumpffFunctionS
+                 == Approx( ( std::sqrt( z ) - std::sin( std::sqrt( z ) ) )
+                            / std::pow( z, 1.5 ) ) );
+    }
+
+    SECTION( "Test z < 0" )
+    {
+        const Real z = -2.5;
+        computeStumpffFunctions( z, stumpffFunctionC, stumpffFunctionS );
+        REQUIRE( stumpffFunctionC == Approx( ( std::cosh( std::sqrt( -z ) ) - 1.0 ) / -z ) );
+        REQUIRE( stumpffFunctionS
+                 == Approx( ( std::sinh( std::sqrt( -z ) ) - std::sqrt( -z ) )
+                            / std::pow( -z, 1.5 ) ) );
+    }
+}
+
+TEST_CASE( "Propagate two-body state", "[two-body]" )
+{
+    // Set up circular orbit.
+    const Real radius = 7000.0;
+    const Real circularVelocity = std::sqrt( kMU / radius );
+    const Real orbitalPeriod = 2.0 * sml::SML_PI * std::sqrt( radius * radius * radius / kMU );
+
+    Vector initialPosition( 3 );
+    initialPosition[ 0 ] = radius;
+    initialPosition[ 1 ] = 0.0;
+    initialPosition[ 2 ] = 0.0;
+
+    Vector initialVelocity( 3 );
+    initialVelocity[ 0 ] = 0.0;
+    initialVelocity[ 1 ] = circularVelocity;
+    initialVelocity[ 2 ] = 0.0;
+
+    Real finalPosition[ 3 ];
+    Real finalVelocity[ 3 ];
+
+    SECTION( "Test quarter orbital period" )
+    {
+        propagateTwoBodyState(
+            initialPosition, initialVelocity, 0.25 * orbitalPeriod, kMU,
+            finalPosition, finalVelocity );
+
+        REQUIRE( std::fabs( finalPosition[ 0 ] ) < 1.0e-6 );
+        REQUIRE( finalPosition[ 1 ] == Approx( radius ) );
+        REQUIRE( std::fabs( finalPosition[ 2 ] ) < 1.0e-6 );
+        REQUIRE( finalVelocity[ 0 ] == Approx( -circularVelocity ) );
+        REQUIRE( std::fabs( finalVelocity[ 1 ] ) < 1.0e-9 );
+        REQUIRE( std::fabs( finalVelocity[ 2 ] ) < 1.0e-9 );
+    }
+
+    SECTION( "Test full orbital period" )
+    {
+        propagateTwoBodyState(
+            initialPosition, initialVelocity, orbitalPeriod, kMU, finalPosition, finalVelocity );
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::fabs( finalPosition[ i ] - initialPosition[ i ] ) < 1.0e-6 );
+            REQUIRE( std::fabs( finalVelocity[ i ] - initialVelocity[ i ] ) < 1.0e-9 );
+        }
+    }
+}
+
+TEST_CASE( "Propagate state with secular J2 perturbations", "[two-body]" )
+{
+    // Set up inclined circular orbit.
+    const Real radius = 7000.0;
+    const Real circularVelocity = std::sqrt( kMU / radius );
+    const Real inclination = sml::SML_PI / 4.0;
+    const Real orbitalPeriod = 2.0 * sml::SML_PI * std::sqrt( radius * radius * radius / kMU );
+
+    Vector initialPosition( 3 );
+    initialPosition[ 0 ] = radius;
+    initialPosition[ 1 ] = 0.0;
+    initialPosition[ 2 ] = 0.0;
+
+    Vector initialVelocity( 3 );
+    initialVelocity[ 0 ] = 0.0;
+    initialVelocity[ 1 ] = circularVelocity * std::cos( inclination );
+    initialVelocity[ 2 ] = circularVelocity * std::sin( inclination );
+
+    const Real timeOfFlight = 10.3 * orbitalPeriod;
+
+    Real finalPosition[ 3 ];
+    Real finalVelocity[ 3 ];
+
+    SECTION( "Test J2 = 0" )
+    {
+        Real twoBodyPosition[ 3 ];
+        Real twoBodyVelocity[ 3 ];
+        propagateTwoBodyState(
+            initialPosition, initialVelocity, timeOfFlight, kMU, twoBodyPosition, twoBodyVelocity );
+        propagateJ2SecularState( initialPosition, initialVelocity, timeOfFlight, kMU, kXKMPER,
+                                 0.0, finalPosition, finalVelocity );
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            REQUIRE( finalPosition[ i ] == Approx( twoBodyPosition[ i ] ) );
+            REQUIRE( finalVelocity[ i ] == Approx( twoBodyVelocity[ i ] ) );
+        }
+    }
+
+    SECTION( "Test nodal regression" )
+    {
+        propagateJ2SecularState( initialPosition, initialVelocity, timeOfFlight, kMU, kXKMPER,
+                                 kXJ2, finalPosition, finalVelocity );
+
+        // Compute angular-momentum vector of propagated state.
+        Real angularMomentum[ 3 ];
+        for ( int i = 0; i < 3; i++ )
+        {
+            const int j = ( i + 1 ) % 3;
+            const int k = ( i + 2 ) % 3;
+            angularMomentum[ i ] = finalPosition[ j ] * finalVelocity[ k ]
+                                   - finalPosition[ k ] * finalVelocity[ j ];
+        }
+        const Real angularMomentumNorm = std::sqrt( angularMomentum[ 0 ] * angularMomentum[ 0 ]
+                                                    + angularMomentum[ 1 ] * angularMomentum[ 1 ]
+                                                    + angularMomentum[ 2 ] * angularMomentum[ 2 ] );
+
+        // Check that inclination and angular momentum are conserved.
+        REQUIRE( std::acos( angularMomentum[ 2 ] / angularMomentumNorm )
+                 == Approx( inclination ) );
+        REQUIRE( angularMomentumNorm == Approx( radius * circularVelocity ) );
+
+        // Check change in longitude of ascending node against first-order secular rate
+        // (Vallado, 2013).
+        const Real meanMotion = 2.0 * sml::SML_PI / orbitalPeriod;
+        const Real radiusRatio = kXKMPER / radius;
+        const Real expectedNodeChange = -1.5 * kXJ2 * radiusRatio * radiusRatio * meanMotion
+                                        * std::cos( inclination ) * timeOfFlight;
+        const Real nodeChange = std::atan2( angularMomentum[ 0 ], -angularMomentum[ 1 ] );
+        REQUIRE( nodeChange == Approx( expectedNodeChange ).epsilon( 1.0e-2 ) );
+    }
+}
+
+TEST_CASE( "Rotate vector about axis", "[two-body]" )
+{
+    const Real axis[ 3 ] = { 0.0, 0.0, 1.0 };
+    Real vector[ 3 ] = { 1.0, 0.0, 2.0 };
+    rotateVectorAboutAxis( axis, sml::SML_PI / 2.0, vector );
+
+    REQUIRE( std::fabs( vector[ 0 ] ) < 1.0e-15 );
+    REQUIRE( vector[ 1 ] == Approx( 1.0 ) );
+    REQUIRE( vector[ 2 ] == Approx( 2.0 ) );
+}
+
+TEST_CASE( "Compute number of revolutions of two-body orbit", "[two-body]" )
+{
+    // Set up circular orbit.
+    const Real radius = 7000.0;
+    const Real circularVelocity = std::sqrt( kMU / radius );
+    const Real orbitalPeriod = 2.0 * sml::SML_PI * std::sqrt( radius * radius * radius / kMU );
+
+    Vector position( 3 );
+    position[ 0 ] = radius;
+    position[ 1 ] = 0.0;
+    position[ 2 ] = 0.0;
+
+    Vector velocity( 3 );
+    velocity[ 0 ] = 0.0;
+    velocity[ 1 ] = circularVelocity;
+    velocity[ 2 ] = 0.0;
+
+    SECTION( "Test elliptical orbit" )
+    {
+        REQUIRE( computeNumberOfRevolutions( position, velocity, 0.9 * orbitalPeriod, kMU ) == 0 );
+        REQUIRE( computeNumberOfRevolutions( position, velocity, 1.1 * orbitalPeriod, kMU ) == 1 );
+        REQUIRE( computeNumberOfRevolutions( position, velocity, 10.3 * orbitalPeriod, kMU )
+                 == 10 );
+    }
+
+    SECTION( "Test hyperbolic orbit" )
+    {
+        velocity[ 1 ] = 1.5 * circularVelocity;
+        REQUIRE( computeNumberOfRevolutions( position, velocity, 10.3 * orbitalPeriod, kMU ) == 0 );
+    }
+}
+
+TEST_CASE( "Compute Keplerian elements of Cartesian state", "[two-body]" )
+{
+    // Set Keplerian elements [km, -, rad, rad, rad, rad].
+    Vector keplerianElements( 6 );
+    keplerianElements[ astro::semiMajorAxisIndex ] = 7500.0;
+    keplerianElements[ astro::eccentricityIndex ] = 0.1;
+    keplerianElements[ astro::inclinationIndex ] = 0.9;
+    keplerianElements[ astro::argumentOfPeriapsisIndex ] = 4.2;
+    keplerianElements[ astro::longitudeOfAscendingNodeIndex ] = 2.3;
+    keplerianElements[ astro::trueAnomalyIndex ] = 5.7;
+
+    const Vector cartesianState
+        = astro::convertKeplerianToCartesianElements( keplerianElements, kMU );
+
+    // Check that Keplerian elements are recovered from Cartesian state.
+    Real computedKeplerianElements[ 6 ];
+    computeKeplerianElements( cartesianState, kMU, computedKeplerianElements );
+    for ( int i = 0; i < 6; i++ )
+    {
+        REQUIRE( computedKeplerianElements[ i ] == Approx( keplerianElements[ i ] ) );
+    }
+}
+
+TEST_CASE( "Compute Keplerian-to-Cartesian Jacobian", "[two-body]" )
+{
+    // Set Keplerian elements [km, -, rad, rad, rad, rad].
+    Vector keplerianElements( 6 );
+    keplerianElements[ astro::semiMajorAxisIndex ] = 7500.0;
+    keplerianElements[ astro::eccentricityIndex ] = 0.1;
+    keplerianElements[ astro::inclinationIndex ] = 0.9;
+    keplerianElements[ astro::argumentOfPeriapsisIndex ] = 1.2;
+    keplerianElements[ astro::longitudeOfAscendingNodeIndex ] = 2.3;
+    keplerianElements[ astro::trueAnomalyIndex ] = 0.7;
+
+    Real jacobian[ 6 ][ 6 ];
+    computeKeplerianToCartesianJacobian( keplerianElements, kMU, jacobian );
+
+    // Check analytical partial derivatives against central differences.
+    for ( int j = 0; j < 6; j++ )
+    {
+        const Real step = 1.0e-6 * std::max( std::fabs( keplerianElements[ j ] ), 1.0 );
+
+        Vector forwardElements = keplerianElements;
+        forwardElements[ j ] += step;
+        const Vector forwardState
+            = astro::convertKeplerianToCartesianElements( forwardElements, kMU );
+
+        Vector backwardElements = keplerianElements;
+        backwardElements[ j ] -= step;
+        const Vector backwardState
+            = astro::convertKeplerianToCartesianElements( backwardElements, kMU );
+
+        for ( int i = 0; i < 6; i++ )
+        {
+            const Real centralDifference
+                = ( forwardState[ i ] - backwardState[ i ] ) / ( 2.0 * step );
+            REQUIRE( std::fabs( jacobian[ i ][ j ] - centralDifference )
+                     < 1.0e-5 * std::max( std::fabs( centralDifference ), 1.0 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace atom